@@ -0,0 +1,285 @@
+/**
+ * Natural-Number Limb Arithmetic
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#include "bignum.h"
+
+#include <string.h>
+
+__extension__ typedef unsigned __int128 bn_dlimb;
+
+bn_limb bn_add(bn_limb *r, const bn_limb *a, size_t an, const bn_limb *b, size_t bn) {
+    bn_limb carry = 0;
+    size_t i = 0;
+
+    for (; i < bn; i++) {
+        bn_limb sum = a[i] + carry;
+        carry = sum < carry;
+        r[i] = sum + b[i];
+        carry += r[i] < sum;
+    }
+    return bn_add_1(r + i, a + i, an - i, carry);
+}
+
+bn_limb bn_sub(bn_limb *r, const bn_limb *a, size_t an, const bn_limb *b, size_t bn) {
+    bn_limb borrow = 0;
+    size_t i = 0;
+
+    for (; i < bn; i++) {
+        bn_limb x = a[i];
+        bn_limb y = b[i] + borrow;
+        borrow = (y < borrow) | (x < y);
+        r[i] = x - y;
+    }
+    return bn_sub_1(r + i, a + i, an - i, borrow);
+}
+
+bn_limb bn_add_1(bn_limb *r, const bn_limb *a, size_t n, bn_limb b) {
+    size_t i = 0;
+
+    for (; i < n && b != 0; i++) {
+        r[i] = a[i] + b;
+        b = r[i] < b;
+    }
+    if (r != a) {
+        memcpy(r + i, a + i, (n - i) * sizeof(bn_limb));
+    }
+    return b;
+}
+
+bn_limb bn_sub_1(bn_limb *r, const bn_limb *a, size_t n, bn_limb b) {
+    size_t i = 0;
+
+    for (; i < n && b != 0; i++) {
+        bn_limb x = a[i];
+        r[i] = x - b;
+        b = x < b;
+    }
+    if (r != a) {
+        memcpy(r + i, a + i, (n - i) * sizeof(bn_limb));
+    }
+    return b;
+}
+
+bn_limb bn_lshift(bn_limb *r, const bn_limb *a, size_t n, unsigned shift) {
+    bn_limb out = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        bn_limb limb = a[i];
+        r[i] = (limb << shift) | out;
+        out = limb >> (64 - shift);
+    }
+    return out;
+}
+
+size_t bn_normalize(const bn_limb *a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) {
+        n--;
+    }
+    return n;
+}
+
+int bn_cmp(const bn_limb *a, size_t an, const bn_limb *b, size_t bn) {
+    an = bn_normalize(a, an);
+    bn = bn_normalize(b, bn);
+    if (an != bn) {
+        return an < bn ? -1 : 1;
+    }
+    while (an-- > 0) {
+        if (a[an] != b[an]) {
+            return a[an] < b[an] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * r[0..n) += a[0..n) * b; returns the carry limb
+ */
+static bn_limb addmul_1(bn_limb *r, const bn_limb *a, size_t n, bn_limb b) {
+    bn_limb carry = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        bn_dlimb t = (bn_dlimb)a[i] * b + r[i] + carry;
+        r[i] = (bn_limb)t;
+        carry = (bn_limb)(t >> 64);
+    }
+    return carry;
+}
+
+static void mul_basecase(bn_limb *r, const bn_limb *a, size_t an, const bn_limb *b, size_t bn) {
+    memset(r, 0, (an + bn) * sizeof(bn_limb));
+    for (size_t j = 0; j < bn; j++) {
+        r[an + j] = addmul_1(r + j, a, an, b[j]);
+    }
+}
+
+/**
+ * Off-diagonal products once, doubled, plus the squares a[i]^2: about
+ * half the multiplies of mul_basecase(a, a)
+ */
+static void sqr_basecase(bn_limb *r, const bn_limb *a, size_t n) {
+    memset(r, 0, 2 * n * sizeof(bn_limb));
+    for (size_t i = 0; i + 1 < n; i++) {
+        r[n + i] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+    }
+    r[2 * n - 1] = bn_lshift(r, r, 2 * n - 1, 1);
+
+    bn_limb carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        bn_dlimb sq = (bn_dlimb)a[i] * a[i];
+        bn_dlimb lo = (bn_dlimb)r[2 * i] + (bn_limb)sq + carry;
+        bn_dlimb hi = (bn_dlimb)r[2 * i + 1] + (bn_limb)(sq >> 64) + (bn_limb)(lo >> 64);
+        r[2 * i] = (bn_limb)lo;
+        r[2 * i + 1] = (bn_limb)hi;
+        carry = (bn_limb)(hi >> 64);
+    }
+}
+
+/**
+ * r[h..) += z1[0..zn), where r is total limbs long; the Karatsuba
+ * middle term never carries out of the product
+ */
+static void add_middle(bn_limb *r, size_t total, size_t h, const bn_limb *z1, size_t zn) {
+    zn = bn_normalize(z1, zn);
+    bn_add(r + h, r + h, total - h, z1, zn);
+}
+
+/**
+ * Balanced Karatsuba, n >= BN_KARATSUBA_THRESHOLD: with a = a1 B^h + a0,
+ * a * b = z2 B^2h + ((a0 + a1)(b0 + b1) - z0 - z2) B^h + z0
+ */
+static void mul_karatsuba(bn_limb *r, const bn_limb *a, const bn_limb *b, size_t n,
+                          arena *scratch) {
+    size_t h = n / 2;
+    size_t m = n - h;  // High halves, m >= h
+    size_t mark = arena_mark(scratch);
+    bn_limb *ta = arena_alloc(scratch, (m + 1) * sizeof(bn_limb));
+    bn_limb *tb = arena_alloc(scratch, (m + 1) * sizeof(bn_limb));
+    bn_limb *z1 = arena_alloc(scratch, 2 * (m + 1) * sizeof(bn_limb));
+
+    ta[m] = bn_add(ta, a + h, m, a, h);
+    tb[m] = bn_add(tb, b + h, m, b, h);
+    bn_mul(r, a, h, b, h, scratch);                  // z0 -> r[0..2h)
+    bn_mul(r + 2 * h, a + h, m, b + h, m, scratch);  // z2 -> r[2h..2n)
+    bn_mul(z1, ta, m + 1, tb, m + 1, scratch);
+
+    bn_sub(z1, z1, 2 * (m + 1), r, 2 * h);
+    bn_sub(z1, z1, 2 * (m + 1), r + 2 * h, 2 * m);
+    add_middle(r, 2 * n, h, z1, 2 * (m + 1));
+    arena_release(scratch, mark);
+}
+
+void bn_mul(bn_limb *r, const bn_limb *a, size_t an, const bn_limb *b, size_t bn,
+            arena *scratch) {
+    if (bn < BN_KARATSUBA_THRESHOLD) {
+        mul_basecase(r, a, an, b, bn);
+        return;
+    }
+    if (an == bn) {
+        mul_karatsuba(r, a, b, bn, scratch);
+        return;
+    }
+
+    // Unbalanced: balanced bn x bn products of successive slices of a
+    size_t mark = arena_mark(scratch);
+    bn_limb *t = arena_alloc(scratch, 2 * bn * sizeof(bn_limb));
+
+    mul_karatsuba(r, a, b, bn, scratch);
+    memset(r + 2 * bn, 0, (an - bn) * sizeof(bn_limb));
+    for (size_t i = bn; i < an; i += bn) {
+        size_t chunk = an - i < bn ? an - i : bn;
+        if (chunk == bn) {
+            mul_karatsuba(t, a + i, b, bn, scratch);
+        } else {
+            bn_mul(t, b, bn, a + i, chunk, scratch);
+        }
+        bn_add(r + i, r + i, an + bn - i, t, chunk + bn);
+    }
+    arena_release(scratch, mark);
+}
+
+void bn_sqr(bn_limb *r, const bn_limb *a, size_t n, arena *scratch) {
+    if (n < BN_KARATSUBA_THRESHOLD) {
+        sqr_basecase(r, a, n);
+        return;
+    }
+
+    size_t h = n / 2;
+    size_t m = n - h;
+    size_t mark = arena_mark(scratch);
+    bn_limb *t = arena_alloc(scratch, (m + 1) * sizeof(bn_limb));
+    bn_limb *z1 = arena_alloc(scratch, 2 * (m + 1) * sizeof(bn_limb));
+
+    t[m] = bn_add(t, a + h, m, a, h);
+    bn_sqr(r, a, h, scratch);
+    bn_sqr(r + 2 * h, a + h, m, scratch);
+    bn_sqr(z1, t, m + 1, scratch);
+
+    bn_sub(z1, z1, 2 * (m + 1), r, 2 * h);
+    bn_sub(z1, z1, 2 * (m + 1), r + 2 * h, 2 * m);
+    add_middle(r, 2 * n, h, z1, 2 * (m + 1));
+    arena_release(scratch, mark);
+}
+
+size_t bn_mul_scratch(size_t n) {
+    // Slice products of nested unbalanced calls (their sizes shrink like
+    // Euclid's remainders, summing to under 8n), then one Karatsuba
+    // frame per level
+    size_t bytes = 8 * n * sizeof(bn_limb);
+    size_t count = 2 * 64;
+
+    while (n >= BN_KARATSUBA_THRESHOLD) {
+        size_t m = n - n / 2;
+        bytes += 4 * (m + 1) * sizeof(bn_limb);
+        count += 3;
+        n = m + 1;
+    }
+    return arena_capacity_for(bytes, count);
+}
+
+size_t bn_decimal_scratch(size_t n) {
+    // 64 log10(2) < 19.3 digits per limb
+    return arena_capacity_for(n * sizeof(bn_limb) + n * 20 + 2, 2);
+}
+
+char *bn_to_decimal(const bn_limb *a, size_t n, arena *scratch) {
+    n = bn_normalize(a, n);
+    size_t capacity = n * 20 + 2;
+    bn_limb *q = arena_alloc(scratch, (n > 0 ? n : 1) * sizeof(bn_limb));
+    char *digits = arena_alloc(scratch, capacity);
+
+    if (q == NULL || digits == NULL) {
+        return NULL;
+    }
+    memcpy(q, a, n * sizeof(bn_limb));
+
+    // Peel 9 digits per pass from the bottom, dividing the 32-bit halves
+    // so every step is a 64-bit division by a constant
+    char *end = digits + capacity - 1;
+    char *p = end;
+    *p = '\0';
+    while (n > 0) {
+        uint64_t rem = 0;
+        for (size_t i = n; i-- > 0;) {
+            uint64_t hi = (rem << 32) | (q[i] >> 32);
+            rem = hi % 1000000000u;
+            uint64_t lo = (rem << 32) | (q[i] & 0xffffffffu);
+            rem = lo % 1000000000u;
+            q[i] = (hi / 1000000000u) << 32 | lo / 1000000000u;
+        }
+        n = bn_normalize(q, n);
+        for (int k = 0; k < 9 && (n > 0 || rem > 0); k++) {
+            *--p = (char)('0' + rem % 10);
+            rem /= 10;
+        }
+    }
+    if (p == end) {
+        *--p = '0';
+    }
+    memmove(digits, p, (size_t)(end - p) + 1);
+    return digits;
+}
@@ -0,0 +1,93 @@
+/**
+ * Natural-Number Limb Arithmetic
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Little-endian arrays of 64-bit limbs with explicit lengths, in the
+ * style of GMP's mpn layer: the caller owns every buffer, and the only
+ * temporaries (Karatsuba partial products, decimal conversion) come from
+ * a caller-supplied arena, so a hot loop never reaches malloc().
+ *
+ * Values may carry high zero limbs; bn_normalize() trims them.
+ */
+
+#ifndef ROSETTA_BIGNUM_H
+#define ROSETTA_BIGNUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+
+typedef uint64_t bn_limb;
+
+// Operands shorter than this many limbs multiply/square by schoolbook
+#define BN_KARATSUBA_THRESHOLD 32
+
+/**
+ * r = a + b for an >= bn; r has an limbs and may alias a. Returns the
+ * carry out of the top limb.
+ */
+bn_limb bn_add(bn_limb *r, const bn_limb *a, size_t an, const bn_limb *b, size_t bn);
+
+/**
+ * r = a - b for an >= bn; r has an limbs and may alias a. Returns the
+ * borrow out of the top limb (1 when b > a).
+ */
+bn_limb bn_sub(bn_limb *r, const bn_limb *a, size_t an, const bn_limb *b, size_t bn);
+
+/**
+ * r = a + b / a - b for a single-limb b, with carry / borrow out
+ */
+bn_limb bn_add_1(bn_limb *r, const bn_limb *a, size_t n, bn_limb b);
+bn_limb bn_sub_1(bn_limb *r, const bn_limb *a, size_t n, bn_limb b);
+
+/**
+ * r = a << shift for 0 < shift < 64; r may alias a. Returns the bits
+ * shifted out of the top limb.
+ */
+bn_limb bn_lshift(bn_limb *r, const bn_limb *a, size_t n, unsigned shift);
+
+/**
+ * r = a * b for an >= bn >= 1; r has an + bn limbs and must not overlap
+ * a or b. Schoolbook below BN_KARATSUBA_THRESHOLD, Karatsuba above.
+ * scratch must hold bn_mul_scratch(an) bytes.
+ */
+void bn_mul(bn_limb *r, const bn_limb *a, size_t an, const bn_limb *b, size_t bn,
+            arena *scratch);
+
+/**
+ * r = a * a; r has 2n limbs and must not overlap a. Squaring skips the
+ * symmetric half of the partial products (schoolbook) or one of the
+ * three sub-products' operand sums (Karatsuba).
+ */
+void bn_sqr(bn_limb *r, const bn_limb *a, size_t n, arena *scratch);
+
+/**
+ * Arena bytes bn_mul() / bn_sqr() take for operands of up to n limbs
+ */
+size_t bn_mul_scratch(size_t n);
+
+/**
+ * Length of a without high zero limbs (0 for zero)
+ */
+size_t bn_normalize(const bn_limb *a, size_t n);
+
+/**
+ * -1, 0 or 1 as a < b, a == b, a > b (normalized or not)
+ */
+int bn_cmp(const bn_limb *a, size_t an, const bn_limb *b, size_t bn);
+
+/**
+ * Decimal digits of a, NUL-terminated, in a buffer taken from scratch
+ * (NULL if it does not fit). Quadratic: repeated division by 10^9.
+ */
+char *bn_to_decimal(const bn_limb *a, size_t n, arena *scratch);
+
+/**
+ * Arena bytes bn_to_decimal() takes for an n-limb value
+ */
+size_t bn_decimal_scratch(size_t n);
+
+#endif  // ROSETTA_BIGNUM_H
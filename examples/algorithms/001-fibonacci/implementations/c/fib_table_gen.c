@@ -0,0 +1,37 @@
+/**
+ * Fibonacci Lookup Table Generator
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Build step: writes fib_table.h to stdout with F(0)..F(93), every value
+ * that fits in uint64_t, as a constant array. The Makefile regenerates
+ * the header whenever this file changes.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define FIB_TABLE_LAST 93
+
+int main(void) {
+    uint64_t prev = 0;
+    uint64_t curr = 1;
+
+    printf("// Generated by fib_table_gen.c - do not edit\n\n");
+    printf("#ifndef ROSETTA_FIB_TABLE_H\n#define ROSETTA_FIB_TABLE_H\n\n");
+    printf("#include <stdint.h>\n\n");
+    printf("#define FIB_TABLE_SIZE %d\n\n", FIB_TABLE_LAST + 1);
+    printf("// F(0)..F(%d), plus a trailing 0 that out-of-range lookups clamp to\n",
+           FIB_TABLE_LAST);
+    printf("static const uint64_t FIB_TABLE[FIB_TABLE_SIZE + 1] = {\n");
+    for (int n = 0; n <= FIB_TABLE_LAST; n++) {
+        printf("    UINT64_C(%" PRIu64 "),\n", prev);
+        uint64_t next = prev + curr;
+        prev = curr;
+        curr = next;
+    }
+    printf("    0,\n};\n\n#endif  // ROSETTA_FIB_TABLE_H\n");
+    return 0;
+}
@@ -1,10 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include <stdint.h>
 #include <inttypes.h>
 
+#include "bench.h"
+#include "bignum.h"
+#include "fib_table.h"
+
+#ifdef ROSETTA_HAVE_GMP
+#include <gmp.h>
+#endif
+
 // Maximum supported value for standard uint64_t
 #define MAX_FIB_N 93
 
@@ -28,26 +35,24 @@ uint64_t fib_iterative(int n) {
     return curr;
 }
 
-// Memoized Fibonacci using static array
+// Memoized Fibonacci: every uint64 value memoized at build time in
+// FIB_TABLE (fib_table.h), so lookups are thread-safe and never recurse
 uint64_t fib_memoized(int n) {
-    static uint64_t cache[MAX_FIB_N + 1] = {0};
-    static int initialized = 0;
-    
-    if (!initialized) {
-        memset(cache, 0, sizeof(cache));
-        cache[0] = 0;
-        cache[1] = 1;
-        initialized = 1;
-    }
-    
-    if (n <= 1) return n;
-    
-    if (cache[n] != 0 || n == 0) {
-        return cache[n];
+    return FIB_TABLE[n];
+}
+
+// out[i] = F(ns[i]) from the table; returns 0, or -1 if some ns[i] is
+// outside [0, MAX_FIB_N] (its out[i] is 0). Branch-free, so the loop
+// vectorizes into gathers.
+int fib_batch(const int* ns, uint64_t* out, size_t k) {
+    unsigned invalid = 0;
+    for (size_t i = 0; i < k; i++) {
+        unsigned n = (unsigned)ns[i];
+        unsigned bad = n > MAX_FIB_N;
+        invalid |= bad;
+        out[i] = FIB_TABLE[bad ? FIB_TABLE_SIZE : n];
     }
-    
-    cache[n] = fib_memoized(n - 1) + fib_memoized(n - 2);
-    return cache[n];
+    return invalid ? -1 : 0;
 }
 
 // Matrix multiplication for 2x2 matrices
@@ -115,16 +120,338 @@ uint64_t fib_optimized(int n) {
     return b;
 }
 
-// Benchmark function
-double benchmark(const char* name, int n, uint64_t (*func)(int)) {
-    clock_t start = clock();
-    uint64_t result = func(n);
-    clock_t end = clock();
-    
-    double cpu_time = ((double)(end - start)) / CLOCKS_PER_SEC * 1000000000; // Convert to nanoseconds
-    
-    printf("%s: fib(%d) = %" PRIu64 ", time = %.0f ns\n", name, n, result, cpu_time);
-    return cpu_time;
+// Arbitrary-precision fast doubling: from (F(k-1), F(k)),
+//   F(2k-1) = F(k)^2 + F(k-1)^2
+//   F(2k+1) = 4F(k)^2 - F(k-1)^2 + 2(-1)^k
+//   F(2k)   = F(2k+1) - F(2k-1)
+// two squarings per bit of n (GMP's mpz_fib_ui recurrence), rather than
+// the three multiplies of F(2k) = F(k)(2F(k+1) - F(k)).
+// All four values live in buffers sized once for max_n and rotated by
+// pointer; squaring temporaries come from the arena, so the loop never
+// allocates.
+typedef struct {
+    arena scratch;
+    bn_limb* buf[4];
+    size_t capacity;  // Limbs per buffer
+    uint64_t max_n;
+} fib_big_engine;
+
+// Limbs of F(n): log2(phi) = 0.6942 bits per index
+static size_t fib_big_limbs(uint64_t n) {
+    return (size_t)((double)n * 0.6942419136306174 / 64.0) + 2;
+}
+
+int fib_big_init(fib_big_engine* engine, uint64_t max_n) {
+    size_t limbs = fib_big_limbs(max_n) + 4;
+    size_t bytes = 4 * limbs * sizeof(bn_limb);
+
+    if (arena_init(&engine->scratch, arena_capacity_for(bytes, 4) + bn_mul_scratch(limbs / 2 + 2)) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 4; i++) {
+        engine->buf[i] = arena_alloc(&engine->scratch, limbs * sizeof(bn_limb));
+    }
+    engine->capacity = limbs;
+    engine->max_n = max_n;
+    return 0;
+}
+
+void fib_big_destroy(fib_big_engine* engine) {
+    arena_destroy(&engine->scratch);
+}
+
+// F(n) for n <= max_n: returns its limb count; *out stays valid until the
+// next call on the engine
+size_t fib_big(fib_big_engine* engine, uint64_t n, const bn_limb** out) {
+    bn_limb* a = engine->buf[0];  // F(k - 1)
+    bn_limb* b = engine->buf[1];  // F(k)
+    bn_limb* s0 = engine->buf[2];
+    bn_limb* s1 = engine->buf[3];
+    size_t an = 0;
+    size_t bn = 1;
+
+    *out = b;
+    if (n == 0) {
+        b[0] = 0;
+        return 1;
+    }
+    b[0] = 1;  // k = 1
+
+    int bit = 63;
+    while (!((n >> bit) & 1)) {
+        bit--;
+    }
+    int k_odd = 1;
+    for (bit--; bit >= 0; bit--) {
+        size_t len = 2 * bn + 1;
+        bn_sqr(s1, b, bn, &engine->scratch);
+        s1[2 * bn] = 0;
+        if (an > 0) {
+            bn_sqr(s0, a, an, &engine->scratch);
+        }
+        memset(s0 + 2 * an, 0, (len - 2 * an) * sizeof(bn_limb));
+
+        bn_add(a, s1, len, s0, len);  // F(2k - 1)
+        bn_lshift(s1, s1, len, 2);
+        bn_sub(s1, s1, len, s0, len);
+        if (k_odd) {
+            bn_sub_1(s1, s1, len, 2);  // F(2k + 1)
+        } else {
+            bn_add_1(s1, s1, len, 2);
+        }
+        bn_sub(b, s1, len, a, len);  // F(2k)
+
+        k_odd = (n >> bit) & 1;
+        if (k_odd) {
+            // (F(2k), F(2k + 1)); the old F(2k - 1) becomes scratch
+            bn_limb* free_buf = a;
+            a = b;
+            b = s1;
+            s1 = free_buf;
+        }
+        an = bn_normalize(a, len);
+        bn = bn_normalize(b, len);
+    }
+
+    engine->buf[0] = a;
+    engine->buf[1] = b;
+    engine->buf[2] = s0;
+    engine->buf[3] = s1;
+    *out = b;
+    return bn;
+}
+
+// F(n) mod m by fast doubling over (F(k), F(k+1)):
+//   F(2k) = F(k)(2F(k+1) - F(k)),  F(2k+1) = F(k)^2 + F(k+1)^2
+// Moduli below 2^32 reduce the 64-bit products with Barrett's
+// precomputed reciprocal (a multiply-high and a correction) instead of a
+// hardware divide; wider moduli fall back to a 128-bit remainder.
+__extension__ typedef unsigned __int128 fib_u128;
+
+typedef struct {
+    uint64_t m;
+    uint64_t mu;  // floor((2^64 - 1) / m), for m < 2^32
+} fib_modulus;
+
+static inline fib_modulus fib_modulus_make(uint64_t m) {
+    fib_modulus mod = {m, UINT64_MAX / m};
+    return mod;
+}
+
+static inline uint64_t fib_mulmod(fib_modulus mod, uint64_t a, uint64_t b, int wide) {
+    if (wide) {
+        return (uint64_t)((fib_u128)a * b % mod.m);
+    }
+    uint64_t x = a * b;  // a, b < m < 2^32
+    uint64_t q = (uint64_t)(((fib_u128)x * mod.mu) >> 64);
+    uint64_t r = x - q * mod.m;  // q is at most 2 short
+    r = r >= mod.m ? r - mod.m : r;
+    return r >= mod.m ? r - mod.m : r;
+}
+
+static inline uint64_t fib_addmod(uint64_t a, uint64_t b, uint64_t m) {
+    return a >= m - b ? a - (m - b) : a + b;
+}
+
+static inline uint64_t fib_mod_doubling(uint64_t n, fib_modulus mod, int wide) {
+    uint64_t m = mod.m;
+    uint64_t a = 0;  // F(k)
+    uint64_t b = 1;  // F(k + 1)
+
+    if (m == 1) {
+        return 0;
+    }
+    for (int bit = 63 - (n ? __builtin_clzll(n) : 63); bit >= 0; bit--) {
+        uint64_t t = fib_addmod(b, b, m);
+        t = t >= a ? t - a : t + (m - a);
+        uint64_t c = fib_mulmod(mod, a, t, wide);
+        uint64_t d = fib_addmod(fib_mulmod(mod, a, a, wide), fib_mulmod(mod, b, b, wide), m);
+        uint64_t e = fib_addmod(c, d, m);
+        uint64_t odd = -((n >> bit) & 1);  // Random bits: select, don't branch
+        a = (d & odd) | (c & ~odd);
+        b = (e & odd) | (d & ~odd);
+    }
+    return a;
+}
+
+// F(n) mod m for m >= 1 (0 when m == 0)
+uint64_t fib_mod(uint64_t n, uint64_t m) {
+    if (m == 0) {
+        return 0;
+    }
+    fib_modulus mod = fib_modulus_make(m);
+    return m >> 32 ? fib_mod_doubling(n, mod, 1) : fib_mod_doubling(n, mod, 0);
+}
+
+// Pisano periods of recently seen small moduli: F(n) mod m repeats with
+// period pi(m) <= 6m, so a cached period shrinks n below 6m and the
+// doubling to about 20 steps instead of 64. Direct-mapped and owned by
+// the caller (one per thread), unlike a hidden static cache.
+#define FIB_PISANO_MAX_M 65536  // Largest modulus whose period is cached
+#define FIB_PISANO_SLOTS 256
+
+typedef struct {
+    uint32_t m[FIB_PISANO_SLOTS];  // 0: empty slot
+    uint32_t period[FIB_PISANO_SLOTS];
+} fib_mod_cache;
+
+void fib_mod_cache_init(fib_mod_cache* cache) {
+    memset(cache, 0, sizeof(*cache));
+}
+
+// pi(m): first i > 0 with (F(i), F(i+1)) = (0, 1) mod m, at most 6m steps
+static uint32_t pisano_period(uint32_t m) {
+    uint32_t a = 0;
+    uint32_t b = 1 % m;
+    for (uint32_t i = 1;; i++) {
+        uint32_t next = a + b >= m ? a + b - m : a + b;
+        a = b;
+        b = next;
+        if (a == 0 && b == 1 % m) {
+            return i;
+        }
+    }
+}
+
+uint64_t fib_mod_cached(fib_mod_cache* cache, uint64_t n, uint64_t m) {
+    if (m == 0 || m > FIB_PISANO_MAX_M) {
+        return fib_mod(n, m);
+    }
+    uint32_t slot = ((uint32_t)m * 2654435761u) >> 24;
+    if (cache->m[slot] != m) {
+        cache->m[slot] = (uint32_t)m;
+        cache->period[slot] = pisano_period((uint32_t)m);
+    }
+    return fib_mod_doubling(n % cache->period[slot], fib_modulus_make(m), 0);
+}
+
+// out[i] = F(ns[i]) mod ms[i], reusing cache across the batch
+void fib_mod_batch(const uint64_t* ns, const uint64_t* ms, uint64_t* out, size_t k,
+                   fib_mod_cache* cache) {
+    for (size_t i = 0; i < k; i++) {
+        out[i] = fib_mod_cached(cache, ns[i], ms[i]);
+    }
+}
+
+// Queries per benchmark sample: throughput, not single-call latency
+#define FIB_QUERIES 4096
+
+// Benchmark context passed through the shared harness
+typedef struct {
+    uint64_t (*func)(int);
+    const int* ns;
+    int count;
+    uint64_t checksum;
+} fib_bench_ctx;
+
+static void fib_bench_body(void* ctx) {
+    fib_bench_ctx* c = ctx;
+    uint64_t sum = 0;
+    for (int i = 0; i < c->count; i++) {
+        sum += c->func(c->ns[i]);
+    }
+    c->checksum = sum;
+    BENCH_DO_NOT_OPTIMIZE(c->checksum);
+}
+
+// Print the throughput of one benchmarked batch of count queries
+static double report_throughput(const char* name, const bench_result* result, int count) {
+    double per_query = result->median_ns / count;
+    printf("%-24s %9.2f M queries/s  (%.1f ns/query, p99 %.1f, n=%d x %llu)\n", name,
+           1e3 / per_query, per_query, result->p99_ns / count, result->sample_count,
+           (unsigned long long)result->iterations);
+    return 1e9 / per_query;
+}
+
+// Benchmark function: queries/s of func over ns[0..count)
+double benchmark(const char* name, const int* ns, int count, uint64_t (*func)(int)) {
+    fib_bench_ctx ctx = {func, ns, count, 0};
+    bench_config config = bench_default_config();
+    bench_result result;
+
+    if (bench_run(name, fib_bench_body, NULL, &ctx, &config, &result) != 0) {
+        fprintf(stderr, "Error: Benchmark %s failed\n", name);
+        return -1.0;
+    }
+    bench_record(&result);
+    return report_throughput(name, &result, count);
+}
+
+typedef struct {
+    const int* ns;
+    uint64_t* out;
+} fib_batch_bench_ctx;
+
+static void fib_batch_bench_body(void* ctx) {
+    fib_batch_bench_ctx* c = ctx;
+    fib_batch(c->ns, c->out, FIB_QUERIES);
+    BENCH_DO_NOT_OPTIMIZE(c->out[0]);
+}
+
+typedef struct {
+    const uint64_t* ns;
+    const uint64_t* ms;
+    uint64_t* out;
+    fib_mod_cache* cache;  // NULL: fib_mod() per query
+    int generic;           // 128-bit remainder even for small moduli
+} fib_mod_bench_ctx;
+
+static void fib_mod_bench_body(void* ctx) {
+    fib_mod_bench_ctx* c = ctx;
+    if (c->cache != NULL) {
+        fib_mod_batch(c->ns, c->ms, c->out, FIB_QUERIES, c->cache);
+    } else if (c->generic) {
+        for (int i = 0; i < FIB_QUERIES; i++) {
+            c->out[i] = fib_mod_doubling(c->ns[i], fib_modulus_make(c->ms[i]), 1);
+        }
+    } else {
+        for (int i = 0; i < FIB_QUERIES; i++) {
+            c->out[i] = fib_mod(c->ns[i], c->ms[i]);
+        }
+    }
+    BENCH_DO_NOT_OPTIMIZE(c->out[0]);
+}
+
+// Random 64-bit values, so the query mix is reproducible
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// fib_mod() throughput on random 64-bit n for moduli below 2^32
+// (Barrett), wide moduli, and repeated small moduli through the cache
+int run_mod_benchmark(void) {
+    static const char* const names[5] = {"fib_mod/generic", "fib_mod/barrett", "fib_mod/wide",
+                                         "fib_mod/repeated", "fib_mod_batch/cached"};
+    uint64_t ns[FIB_QUERIES];
+    uint64_t ms[5][FIB_QUERIES];
+    uint64_t out[FIB_QUERIES];
+    uint64_t state = 42;
+    fib_mod_cache cache;
+    bench_config config = bench_default_config();
+    bench_result result;
+
+    for (int i = 0; i < FIB_QUERIES; i++) {
+        ns[i] = next_random(&state);
+        ms[0][i] = ms[1][i] = (next_random(&state) >> 32) | 1;
+        ms[2][i] = next_random(&state) | (UINT64_C(1) << 63);
+        ms[3][i] = ms[4][i] = 2 + next_random(&state) % 64 * 1000;  // 64 distinct moduli
+    }
+
+    printf("Modular Fibonacci throughput (random 64-bit n):\n");
+    fib_mod_cache_init(&cache);
+    for (int v = 0; v < 5; v++) {
+        fib_mod_bench_ctx ctx = {ns, ms[v], out, v == 4 ? &cache : NULL, v == 0};
+        if (bench_run(names[v], fib_mod_bench_body, NULL, &ctx, &config, &result) != 0) {
+            fprintf(stderr, "Error: Benchmark %s failed\n", names[v]);
+            return 1;
+        }
+        bench_record(&result);
+        report_throughput(names[v], &result, FIB_QUERIES);
+    }
+    return 0;
 }
 
 // Test function
@@ -164,6 +491,314 @@ void test_implementation(const char* name, uint64_t (*func)(int)) {
     printf("  %d/%d tests passed\n", passed, num_tests);
 }
 
+// Copy of F(n) in a fresh malloc() buffer of its limb count + 1
+static bn_limb* fib_big_copy(fib_big_engine* engine, uint64_t n, size_t* limbs) {
+    const bn_limb* value;
+    *limbs = fib_big(engine, n, &value);
+    bn_limb* copy = calloc(*limbs + 1, sizeof(bn_limb));
+    if (copy != NULL) {
+        memcpy(copy, value, *limbs * sizeof(bn_limb));
+    }
+    return copy;
+}
+
+// Cassini's identity F(n-1) F(n+1) = F(n)^2 + (-1)^n, checked with bn_mul()
+// against bn_sqr(), so Karatsuba multiply and square test each other
+static int check_cassini(fib_big_engine* engine, uint64_t n) {
+    size_t ln, lp, lq;
+    bn_limb* fm = fib_big_copy(engine, n - 1, &lq);
+    bn_limb* fn = fib_big_copy(engine, n, &ln);
+    bn_limb* fp = fib_big_copy(engine, n + 1, &lp);
+    bn_limb* lhs = calloc(lp + lq + 1, sizeof(bn_limb));
+    bn_limb* rhs = calloc(lp + lq + 1, sizeof(bn_limb));
+    arena scratch;
+    int ok = 0;
+
+    if (fm != NULL && fn != NULL && fp != NULL && lhs != NULL && rhs != NULL &&
+        arena_init(&scratch, bn_mul_scratch(lp)) == 0) {
+        bn_mul(lhs, fp, lp, fm, lq, &scratch);
+        bn_sqr(rhs, fn, ln, &scratch);
+        if (n % 2 == 0) {
+            bn_add_1(rhs, rhs, lp + lq, 1);
+        } else {
+            bn_sub_1(rhs, rhs, lp + lq, 1);
+        }
+        ok = bn_cmp(lhs, lp + lq, rhs, lp + lq) == 0;
+        arena_destroy(&scratch);
+    }
+    free(fm);
+    free(fn);
+    free(fp);
+    free(lhs);
+    free(rhs);
+    return ok;
+}
+
+static int check_decimal(fib_big_engine* engine, uint64_t n, const char* prefix,
+                         const char* suffix, size_t digits) {
+    const bn_limb* value;
+    size_t limbs = fib_big(engine, n, &value);
+    arena scratch;
+    int ok = 0;
+
+    if (arena_init(&scratch, bn_decimal_scratch(limbs)) == 0) {
+        const char* text = bn_to_decimal(value, limbs, &scratch);
+        size_t len = text != NULL ? strlen(text) : 0;
+        ok = len == digits && strncmp(text, prefix, strlen(prefix)) == 0 &&
+             strcmp(text + len - strlen(suffix), suffix) == 0;
+        arena_destroy(&scratch);
+    }
+    return ok;
+}
+
+// Fast-doubling bignum engine: uint64 range, decimal values, and Cassini's
+// identity at sizes that exercise Karatsuba
+int test_big(void) {
+    fib_big_engine engine;
+    int passed = 0;
+    int num_tests = 0;
+
+    printf("Testing big:\n");
+    if (fib_big_init(&engine, 1000001) != 0) {
+        printf("  FAIL: engine allocation\n");
+        return 1;
+    }
+
+    num_tests++;
+    int exact = 1;
+    for (int n = 0; n <= MAX_FIB_N; n++) {
+        const bn_limb* value;
+        size_t limbs = fib_big(&engine, (uint64_t)n, &value);
+        exact &= bn_normalize(value, limbs) <= 1 && value[0] == fib_iterative(n);
+    }
+    passed += exact;
+
+    static const struct {
+        uint64_t n;
+        const char* prefix;
+        const char* suffix;
+        size_t digits;
+    } decimal_cases[] = {
+        {0, "0", "0", 1},
+        {100, "354224848179261915075", "354224848179261915075", 21},
+        {1000, "4346655768693745643568852767504062580256466051737178040248172908953655541794",
+         "3704476137795166849228875", 209},
+        {100000, "25974069347221724166", "49895374653428746875", 20899},
+    };
+    for (size_t i = 0; i < sizeof(decimal_cases) / sizeof(decimal_cases[0]); i++) {
+        num_tests++;
+        if (check_decimal(&engine, decimal_cases[i].n, decimal_cases[i].prefix,
+                          decimal_cases[i].suffix, decimal_cases[i].digits)) {
+            passed++;
+        } else {
+            printf("  FAIL: decimal fib(%" PRIu64 ")\n", decimal_cases[i].n);
+        }
+    }
+
+    static const uint64_t cassini_cases[] = {94, 1001, 40000, 1000000};
+    for (size_t i = 0; i < sizeof(cassini_cases) / sizeof(cassini_cases[0]); i++) {
+        num_tests++;
+        if (check_cassini(&engine, cassini_cases[i])) {
+            passed++;
+        } else {
+            printf("  FAIL: Cassini identity at n = %" PRIu64 "\n", cassini_cases[i]);
+        }
+    }
+
+    fib_big_destroy(&engine);
+    printf("  %d/%d tests passed\n", passed, num_tests);
+    return passed == num_tests ? 0 : 1;
+}
+
+// a mod m for a limb array, most significant limb first
+static uint64_t bn_mod_u64(const bn_limb* a, size_t n, uint64_t m) {
+    fib_u128 rem = 0;
+    while (n-- > 0) {
+        rem = ((rem << 64) | a[n]) % m;
+    }
+    return (uint64_t)rem;
+}
+
+// Table, batch and modular API: fib_batch() against the iterative
+// values, fib_mod() against F(n) mod m from the table and the bignum
+// engine, and the Pisano cache against uncached fib_mod()
+int test_mod(void) {
+    static const uint64_t moduli[] = {1, 2, 3, 10, 1000, 65536, 65537, 2147483647u, 4294967295u,
+                                      UINT64_C(4294967296), UINT64_C(4294967311),
+                                      UINT64_C(9223372036854775837), UINT64_MAX};
+    size_t num_moduli = sizeof(moduli) / sizeof(moduli[0]);
+    int passed = 0;
+    int num_tests = 0;
+
+    printf("Testing batch/mod:\n");
+
+    int ns[MAX_FIB_N + 3];
+    uint64_t out[MAX_FIB_N + 3];
+    for (int n = 0; n <= MAX_FIB_N; n++) {
+        ns[n] = n;
+    }
+    ns[MAX_FIB_N + 1] = -1;
+    ns[MAX_FIB_N + 2] = MAX_FIB_N + 1;
+    num_tests++;
+    int ok = fib_batch(ns, out, MAX_FIB_N + 1) == 0 &&
+             fib_batch(ns, out, MAX_FIB_N + 3) == -1 && out[MAX_FIB_N + 1] == 0 &&
+             out[MAX_FIB_N + 2] == 0;
+    for (int n = 0; n <= MAX_FIB_N; n++) {
+        ok &= out[n] == fib_iterative(n);
+    }
+    passed += ok;
+    if (!ok) {
+        printf("  FAIL: fib_batch\n");
+    }
+
+    num_tests++;
+    ok = 1;
+    for (size_t j = 0; j < num_moduli; j++) {
+        for (int n = 0; n <= MAX_FIB_N; n++) {
+            ok &= fib_mod((uint64_t)n, moduli[j]) == FIB_TABLE[n] % moduli[j];
+        }
+    }
+    passed += ok;
+    if (!ok) {
+        printf("  FAIL: fib_mod for n <= %d\n", MAX_FIB_N);
+    }
+
+    num_tests++;
+    fib_big_engine engine;
+    ok = fib_big_init(&engine, 1000000) == 0;
+    if (ok) {
+        const bn_limb* value;
+        size_t limbs = fib_big(&engine, 1000000, &value);
+        for (size_t j = 0; j < num_moduli; j++) {
+            ok &= fib_mod(1000000, moduli[j]) == bn_mod_u64(value, limbs, moduli[j]);
+        }
+        fib_big_destroy(&engine);
+    }
+    passed += ok;
+    if (!ok) {
+        printf("  FAIL: fib_mod(10^6, m) against the bignum engine\n");
+    }
+
+    num_tests++;
+    fib_mod_cache cache;
+    uint64_t state = 7;
+    fib_mod_cache_init(&cache);
+    ok = fib_mod_cached(&cache, 60, 10) == 0 && fib_mod_cached(&cache, 61, 10) == 1;
+    for (int i = 0; i < 20000; i++) {
+        uint64_t n = next_random(&state);
+        uint64_t m = 1 + next_random(&state) % (FIB_PISANO_MAX_M + 1000);
+        ok &= fib_mod_cached(&cache, n, m) == fib_mod(n, m);
+    }
+    passed += ok;
+    if (!ok) {
+        printf("  FAIL: Pisano-cached fib_mod\n");
+    }
+
+    printf("  %d/%d tests passed\n", passed, num_tests);
+    return passed == num_tests ? 0 : 1;
+}
+
+typedef struct {
+    fib_big_engine* engine;
+    uint64_t n;
+    size_t limbs;
+} fib_big_bench_ctx;
+
+static void fib_big_bench_body(void* ctx) {
+    fib_big_bench_ctx* c = ctx;
+    const bn_limb* value;
+    c->limbs = fib_big(c->engine, c->n, &value);
+    BENCH_DO_NOT_OPTIMIZE(value);
+}
+
+#ifdef ROSETTA_HAVE_GMP
+typedef struct {
+    mpz_t value;
+    uint64_t n;
+} fib_gmp_bench_ctx;
+
+static void fib_gmp_bench_body(void* ctx) {
+    fib_gmp_bench_ctx* c = ctx;
+    mpz_fib_ui(c->value, (unsigned long)c->n);
+    BENCH_DO_NOT_OPTIMIZE(c->value);
+}
+#endif
+
+// Fast doubling against GMP's mpz_fib_ui() for n = 10^3 .. max_n
+int run_big_sweep(uint64_t max_n) {
+    fib_big_engine engine;
+    bench_config config = bench_default_config();
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    if (fib_big_init(&engine, max_n) != 0) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        return 1;
+    }
+
+    printf("Big Fibonacci sweep (fast doubling, Karatsuba above %d limbs):\n",
+           BN_KARATSUBA_THRESHOLD);
+    bench_begin("algorithms/001-fibonacci");
+    for (uint64_t n = 1000; n <= max_n; n *= 10) {
+        fib_big_bench_ctx ctx = {&engine, n, 0};
+        snprintf(name, sizeof(name), "fib_big/n=%" PRIu64, n);
+        bench_run(name, fib_big_bench_body, NULL, &ctx, &config, &result);
+        bench_record(&result);
+        double ours_ns = result.median_ns;
+        printf("  n=%-10" PRIu64 " %8zu limbs  fib_big %12.0f ns", n, ctx.limbs, ours_ns);
+
+#ifdef ROSETTA_HAVE_GMP
+        fib_gmp_bench_ctx gmp;
+        mpz_init(gmp.value);
+        gmp.n = n;
+        snprintf(name, sizeof(name), "mpz_fib_ui/n=%" PRIu64, n);
+        bench_run(name, fib_gmp_bench_body, NULL, &gmp, &config, &result);
+        bench_record(&result);
+        mpz_clear(gmp.value);
+        printf("  GMP %12.0f ns  (%.2fx GMP's time)", result.median_ns, ours_ns / result.median_ns);
+#endif
+        printf("\n");
+    }
+#ifndef ROSETTA_HAVE_GMP
+    printf("  (GMP not found at build time: no mpz_fib_ui comparison)\n");
+#endif
+
+    fib_big_destroy(&engine);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+// Print F(n) in decimal via the bignum engine, with its compute time
+int print_big(uint64_t n) {
+    fib_big_engine engine;
+    arena scratch;
+
+    if (fib_big_init(&engine, n) != 0) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        return 1;
+    }
+    uint64_t start = bench_now_ns();
+    const bn_limb* value;
+    size_t limbs = fib_big(&engine, n, &value);
+    double compute_ms = (bench_now_ns() - start) / 1e6;
+
+    if (arena_init(&scratch, bn_decimal_scratch(limbs)) != 0) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        fib_big_destroy(&engine);
+        return 1;
+    }
+    const char* text = bn_to_decimal(value, limbs, &scratch);
+    printf("Big: fib(%" PRIu64 ") = %s\n", n, text);
+    printf("Big: %zu digits, %zu limbs, computed in %.3f ms\n", strlen(text), limbs, compute_ms);
+
+    arena_destroy(&scratch);
+    fib_big_destroy(&engine);
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     if (argc == 2 && strcmp(argv[1], "test") == 0) {
         // Run tests
@@ -173,61 +808,126 @@ int main(int argc, char* argv[]) {
         test_implementation("matrix", fib_matrix);
         test_implementation("tail_recursive", fib_tail_recursive);
         test_implementation("optimized", fib_optimized);
-        return 0;
+        int failed = test_big();
+        failed |= test_mod();
+        return failed;
+    }
+
+    // "big [max_n]": fast doubling vs GMP for n = 10^3 .. max_n
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "big") == 0) {
+        uint64_t max_n = argc == 3 ? strtoull(argv[2], NULL, 10) : 10000000;
+        if (max_n < 1000) {
+            fprintf(stderr, "Error: max_n must be at least 1000\n");
+            return 1;
+        }
+        return run_big_sweep(max_n);
     }
     
     if (argc == 2 && strcmp(argv[1], "benchmark") == 0) {
-        // Run benchmarks
+        // Run benchmarks: queries/s over batches of FIB_QUERIES
+        static int fixed[FIB_QUERIES];
+        static int mixed[FIB_QUERIES];
+        static uint64_t out[FIB_QUERIES];
+        uint64_t state = 42;
+        for (int i = 0; i < FIB_QUERIES; i++) {
+            fixed[i] = 40;
+            mixed[i] = (int)(next_random(&state) % (MAX_FIB_N + 1));
+        }
+
         printf("C Fibonacci Benchmarks\n");
         printf("======================\n");
+        bench_begin("algorithms/001-fibonacci");
         
-        benchmark("Iterative", 40, fib_iterative);
-        benchmark("Memoized", 40, fib_memoized);
-        benchmark("Matrix", 40, fib_matrix);
-        benchmark("TailRecursive", 40, fib_tail_recursive);
-        benchmark("Optimized", 40, fib_optimized);
-        
-        printf("\nLarge number test:\n");
-        benchmark("Iterative", 90, fib_iterative);
+        printf("Fixed n = 40:\n");
+        benchmark("Iterative", fixed, FIB_QUERIES, fib_iterative);
+        benchmark("Memoized", fixed, FIB_QUERIES, fib_memoized);
+        benchmark("Matrix", fixed, FIB_QUERIES, fib_matrix);
+        benchmark("TailRecursive", fixed, FIB_QUERIES, fib_tail_recursive);
+        benchmark("Optimized", fixed, FIB_QUERIES, fib_optimized);
         
-        return 0;
+        printf("\nMixed n in [0, %d]:\n", MAX_FIB_N);
+        benchmark("Iterative/mixed", mixed, FIB_QUERIES, fib_iterative);
+        benchmark("Memoized/mixed", mixed, FIB_QUERIES, fib_memoized);
+        benchmark("Matrix/mixed", mixed, FIB_QUERIES, fib_matrix);
+        benchmark("Optimized/mixed", mixed, FIB_QUERIES, fib_optimized);
+
+        fib_batch_bench_ctx batch = {mixed, out};
+        bench_config config = bench_default_config();
+        bench_result result;
+        if (bench_run("fib_batch/mixed", fib_batch_bench_body, NULL, &batch, &config, &result) == 0) {
+            bench_record(&result);
+            report_throughput("fib_batch/mixed", &result, FIB_QUERIES);
+        }
+
+        printf("\n");
+        if (run_mod_benchmark() != 0) {
+            return 1;
+        }
+        return bench_end() == 0 ? 0 : 1;
     }
     
     if (argc < 2) {
         printf("Usage: %s <n> [variant]\n", argv[0]);
         printf("       %s test\n", argv[0]);
         printf("       %s benchmark\n", argv[0]);
-        printf("Variants: recursive, iterative, memoized, matrix, tail, optimized\n");
+        printf("       %s big [max_n]\n", argv[0]);
+        printf("Variants: recursive, iterative, memoized, matrix, tail, optimized, big\n");
         return 1;
     }
     
+    const char* variant = argc > 2 ? argv[2] : "iterative";
+    if (strcmp(variant, "big") == 0) {
+        char* end;
+        uint64_t big_n = strtoull(argv[1], &end, 10);
+        if (*end != '\0' || argv[1][0] == '-') {
+            fprintf(stderr, "Error: n must be a non-negative integer\n");
+            return 1;
+        }
+        return print_big(big_n);
+    }
+
     int n = atoi(argv[1]);
     if (n < 0 || n > MAX_FIB_N) {
-        fprintf(stderr, "Error: n must be between 0 and %d\n", MAX_FIB_N);
+        fprintf(stderr, "Error: n must be between 0 and %d (use the big variant beyond)\n", MAX_FIB_N);
         return 1;
     }
     
-    const char* variant = argc > 2 ? argv[2] : "iterative";
-    
+    const char* name;
+    uint64_t (*func)(int);
     if (strcmp(variant, "recursive") == 0) {
         if (n > 40) {
             fprintf(stderr, "Warning: recursive is very slow for n > 40\n");
         }
-        benchmark("Recursive", n, fib_recursive);
+        name = "Recursive";
+        func = fib_recursive;
     } else if (strcmp(variant, "iterative") == 0) {
-        benchmark("Iterative", n, fib_iterative);
+        name = "Iterative";
+        func = fib_iterative;
     } else if (strcmp(variant, "memoized") == 0) {
-        benchmark("Memoized", n, fib_memoized);
+        name = "Memoized";
+        func = fib_memoized;
     } else if (strcmp(variant, "matrix") == 0) {
-        benchmark("Matrix", n, fib_matrix);
+        name = "Matrix";
+        func = fib_matrix;
     } else if (strcmp(variant, "tail") == 0) {
-        benchmark("TailRecursive", n, fib_tail_recursive);
+        name = "TailRecursive";
+        func = fib_tail_recursive;
     } else if (strcmp(variant, "optimized") == 0) {
-        benchmark("Optimized", n, fib_optimized);
+        name = "Optimized";
+        func = fib_optimized;
     } else {
         fprintf(stderr, "Unknown variant: %s\n", variant);
         return 1;
     }
-    
-    return 0;
-}
\ No newline at end of file
+
+    // One query per sample for the exponential variant, a batch otherwise
+    static int ns[FIB_QUERIES];
+    int count = func == fib_recursive ? 1 : FIB_QUERIES;
+    for (int i = 0; i < count; i++) {
+        ns[i] = n;
+    }
+    printf("%s: fib(%d) = %" PRIu64 "\n", name, n, func(n));
+    bench_begin("algorithms/001-fibonacci");
+    benchmark(name, ns, count, func);
+    return bench_end() == 0 ? 0 : 1;
+}
@@ -1,30 +1,62 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include <stdbool.h>
+#include <limits.h>
+#include <assert.h>
 
-// Function prototypes
-void quicksort_inplace(int arr[], int size);
+#include "arena.h"
+#include "bench.h"
+#include "heap_sort.h"
+#include "quicksort.h"
+#include "sortnet.h"
+#include "task_pool.h"
+#include "topology.h"
+
+// Ranges at or below this size are finished by the sorting-network kernel
+#define INTRO_LEAF_THRESHOLD SORTNET_MAX
+// Ranges above this size use Tukey's ninther instead of median-of-three
+#define INTRO_NINTHER_THRESHOLD 128
+
+// Elements classified per block in the branchless block partition
+#define BLOCK_PARTITION_SIZE 64
+// Block quicksort finishes ranges at or below this size with the
+// sorting-network kernel
+#define BLOCK_LEAF_THRESHOLD SORTNET_MAX
+// Element moves allowed before partial insertion sort gives up
+#define PARTIAL_INSERTION_LIMIT 8
+
+// Parallel quicksort: ranges at or below this size are sorted sequentially
+#define PARALLEL_SORT_THRESHOLD 32768
+
+// Function prototypes (public entry points are in quicksort.h)
 void quicksort_range(int arr[], int low, int high);
 int partition(int arr[], int low, int high);
 
-int* quicksort_functional(int arr[], int size);
 int* merge_arrays(int* arr1, int size1, int* arr2, int size2, int* arr3, int size3);
 
-void quicksort_three_way(int arr[], int size);
+int* quicksort_functional_arena(int arr[], int size);
+int quicksort_functional_into(const int arr[], int size, int out[], arena* scratch);
+
 void three_way_partition_sort(int arr[], int low, int high);
 
+int hoare_partition(int arr[], int low, int high);
+
+void block_sort_loop(int arr[], int low, int high, int bad_allowed, bool leftmost);
+bool partial_insertion_sort(int arr[], int low, int high);
+
 bool is_sorted(int arr[], int size);
 void print_array(int arr[], int size);
 void copy_array(int dest[], int src[], int size);
 
+#ifndef ROSETTA_NO_MAIN
 // Comparison function for qsort
 int compare_ints(const void *a, const void *b) {
     int ia = *(const int*)a;
     int ib = *(const int*)b;
     return (ia > ib) - (ia < ib);
 }
+#endif  // ROSETTA_NO_MAIN
 
 // In-place quicksort implementation
 void quicksort_inplace(int arr[], int size) {
@@ -156,6 +188,90 @@ int* merge_arrays(int* arr1, int size1, int* arr2, int size2, int* arr3, int siz
     return result;
 }
 
+// Arena-backed functional quicksort: same contract as quicksort_functional()
+// (input untouched, caller frees the returned sorted array) but without the
+// per-level less/equal/greater/merge allocations
+int* quicksort_functional_arena(int arr[], int size) {
+    int* result = malloc((size > 0 ? size : 1) * sizeof(int));
+    if (result == NULL) return NULL;
+    
+    arena scratch;
+    if (arena_init(&scratch, arena_capacity_for((size_t)size * sizeof(int), 1)) != 0) {
+        free(result);
+        return NULL;
+    }
+    
+    int status = quicksort_functional_into(arr, size, result, &scratch);
+    arena_destroy(&scratch);
+    
+    if (status != 0) {
+        free(result);
+        return NULL;
+    }
+    return result;
+}
+
+// Partition in[0..size) into buffers[target] at `offset` (less | equal |
+// greater), then sort each side into the other buffer. Reads and writes
+// alternate between the result (buffers[0]) and one scratch buffer of the
+// same length, so no level allocates; equal keys are copied to the result
+// as soon as their final position is known.
+static void functional_partition_sort(const int* in, int offset, int size,
+                                      int* buffers[2], int target) {
+    int* result = buffers[0] + offset;
+    
+    if (size <= 1) {
+        if (size == 1 && in != result) result[0] = in[0];
+        return;
+    }
+    
+    int pivot = in[size / 2];
+    
+    int less_count = 0, equal_count = 0;
+    for (int i = 0; i < size; i++) {
+        less_count += in[i] < pivot;
+        equal_count += in[i] == pivot;
+    }
+    
+    int* out = buffers[target] + offset;
+    int less_idx = 0, equal_idx = less_count, greater_idx = less_count + equal_count;
+    for (int i = 0; i < size; i++) {
+        if (in[i] < pivot) {
+            out[less_idx++] = in[i];
+        } else if (in[i] == pivot) {
+            out[equal_idx++] = in[i];
+        } else {
+            out[greater_idx++] = in[i];
+        }
+    }
+    
+    if (target != 0) {
+        memcpy(result + less_count, out + less_count, equal_count * sizeof(int));
+    }
+    
+    int greater_start = less_count + equal_count;
+    functional_partition_sort(out, offset, less_count, buffers, 1 - target);
+    functional_partition_sort(out + greater_start, offset + greater_start,
+                              size - greater_start, buffers, 1 - target);
+}
+
+// Sort arr into out using one size-element buffer bump-allocated from
+// scratch (released before returning). With a reused arena this performs
+// no heap allocation at all. Returns 0, or -1 if the arena is too small.
+int quicksort_functional_into(const int arr[], int size, int out[], arena* scratch) {
+    if (size <= 0) return 0;
+    
+    size_t mark = arena_mark(scratch);
+    int* buffer = arena_alloc(scratch, (size_t)size * sizeof(int));
+    if (buffer == NULL) return -1;
+    
+    int* buffers[2] = {out, buffer};
+    functional_partition_sort(arr, 0, size, buffers, 1);
+    
+    arena_release(scratch, mark);
+    return 0;
+}
+
 // Three-way quicksort implementation
 void quicksort_three_way(int arr[], int size) {
     if (size <= 1) return;
@@ -195,6 +311,372 @@ void three_way_partition_sort(int arr[], int low, int high) {
     three_way_partition_sort(arr, gt + 1, high);
 }
 
+// Introsort: Hoare partitioning with median-of-three / ninther pivots,
+// insertion sort for small ranges and a heap sort fallback once recursion
+// depth exceeds 2*log2(n), which bounds the worst case at O(n log n)
+void quicksort_intro(int arr[], int size) {
+    if (size <= 1) return;
+    
+    int depth_limit = 0;
+    for (int n = size; n > 1; n >>= 1) {
+        depth_limit += 2;
+    }
+    
+    introsort_loop(arr, 0, size - 1, depth_limit);
+}
+
+void introsort_loop(int arr[], int low, int high, int depth_limit) {
+    while (high - low + 1 > INTRO_LEAF_THRESHOLD) {
+        if (depth_limit == 0) {
+            heap_sort(arr + low, high - low + 1);
+            return;
+        }
+        depth_limit--;
+        
+        int split = hoare_partition(arr, low, high);
+        
+        // Recurse into the smaller side and loop on the larger one,
+        // so stack depth stays O(log n)
+        if (split - low < high - split) {
+            introsort_loop(arr, low, split, depth_limit);
+            low = split + 1;
+        } else {
+            introsort_loop(arr, split + 1, high, depth_limit);
+            high = split;
+        }
+    }
+    
+    sortnet_sort(arr + low, (size_t)(high - low + 1));
+}
+
+static int median_of_three(int arr[], int a, int b, int c) {
+    if (arr[a] < arr[b]) {
+        if (arr[b] < arr[c]) return b;
+        return arr[a] < arr[c] ? c : a;
+    }
+    if (arr[a] < arr[c]) return a;
+    return arr[b] < arr[c] ? c : b;
+}
+
+int choose_pivot(int arr[], int low, int high) {
+    int size = high - low + 1;
+    int mid = low + size / 2;
+    
+    if (size <= INTRO_NINTHER_THRESHOLD) {
+        return median_of_three(arr, low, mid, high);
+    }
+    
+    // Tukey's ninther: median of three medians-of-three
+    int step = size / 8;
+    int m1 = median_of_three(arr, low, low + step, low + 2 * step);
+    int m2 = median_of_three(arr, mid - step, mid, mid + step);
+    int m3 = median_of_three(arr, high - 2 * step, high - step, high);
+    return median_of_three(arr, m1, m2, m3);
+}
+
+// Hoare partition around the chosen pivot value.
+// Returns split such that arr[low..split] <= pivot <= arr[split+1..high],
+// with low <= split < high.
+int hoare_partition(int arr[], int low, int high) {
+    int pivot_index = choose_pivot(arr, low, high);
+    
+    // Moving the pivot to the front guarantees split < high
+    int temp = arr[low];
+    arr[low] = arr[pivot_index];
+    arr[pivot_index] = temp;
+    
+    int pivot = arr[low];
+    int i = low - 1;
+    int j = high + 1;
+    
+    while (true) {
+        do {
+            i++;
+        } while (arr[i] < pivot);
+        
+        do {
+            j--;
+        } while (arr[j] > pivot);
+        
+        if (i >= j) return j;
+        
+        temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+void insertion_sort_range(int arr[], int low, int high) {
+    for (int i = low + 1; i <= high; i++) {
+        int key = arr[i];
+        int j = i - 1;
+        while (j >= low && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+// Block quicksort (pdqsort-style): comparison results are buffered into
+// offset arrays and misplaced elements swapped in bulk, so the partition
+// loop has no data-dependent branches. Sorted and descending inputs are
+// detected up front and finished in O(n); runs of equal keys and nearly
+// sorted partitions are also handled without full recursion.
+void quicksort_block(int arr[], int size) {
+    if (size <= 1) return;
+    
+    int run = 1;
+    while (run < size && arr[run - 1] <= arr[run]) run++;
+    if (run == size) return;
+    
+    if (run == 1) {
+        int desc = 1;
+        while (desc < size && arr[desc - 1] >= arr[desc]) desc++;
+        if (desc == size) {
+            for (int i = 0, j = size - 1; i < j; i++, j--) {
+                int temp = arr[i];
+                arr[i] = arr[j];
+                arr[j] = temp;
+            }
+            return;
+        }
+    }
+    
+    int bad_allowed = 0;
+    for (int n = size; n > 1; n >>= 1) {
+        bad_allowed++;
+    }
+    
+    block_sort_loop(arr, 0, size - 1, bad_allowed, true);
+}
+
+static void swap_elements(int arr[], int a, int b) {
+    int temp = arr[a];
+    arr[a] = arr[b];
+    arr[b] = temp;
+}
+
+void block_sort_loop(int arr[], int low, int high, int bad_allowed, bool leftmost) {
+    while (true) {
+        int size = high - low + 1;
+        if (size <= BLOCK_LEAF_THRESHOLD) {
+            sortnet_sort(arr + low, (size_t)size);
+            return;
+        }
+        
+        swap_elements(arr, low, choose_pivot(arr, low, high));
+        
+        // The predecessor is <= everything here; if it equals the pivot the
+        // whole left side would be equal keys, so strip them in one pass
+        if (!leftmost && arr[low - 1] >= arr[low]) {
+            low = partition_equal_left(arr, low, high) + 1;
+            continue;
+        }
+        
+        bool already_partitioned;
+        int mid = block_partition(arr, low, high, &already_partitioned);
+        int left_size = mid - low;
+        int right_size = high - mid;
+        
+        if (left_size < size / 8 || right_size < size / 8) {
+            // Bad split: fall back to heap sort after log2(n) of them,
+            // otherwise perturb the pivot candidates to break the pattern
+            if (--bad_allowed == 0) {
+                heap_sort(arr + low, size);
+                return;
+            }
+            if (left_size >= BLOCK_LEAF_THRESHOLD) {
+                swap_elements(arr, low, low + left_size / 4);
+                swap_elements(arr, mid - 1, mid - left_size / 4);
+            }
+            if (right_size >= BLOCK_LEAF_THRESHOLD) {
+                swap_elements(arr, mid + 1, mid + 1 + right_size / 4);
+                swap_elements(arr, high, high - right_size / 4);
+            }
+        } else if (already_partitioned &&
+                   partial_insertion_sort(arr, low, mid - 1) &&
+                   partial_insertion_sort(arr, mid + 1, high)) {
+            return;
+        }
+        
+        if (left_size < right_size) {
+            block_sort_loop(arr, low, mid - 1, bad_allowed, leftmost);
+            low = mid + 1;
+            leftmost = false;
+        } else {
+            block_sort_loop(arr, mid + 1, high, bad_allowed, false);
+            high = mid - 1;
+        }
+    }
+}
+
+// Partition arr[low+1..high] around the pivot at arr[low] and move the
+// pivot to its final slot, which is returned. Elements < pivot end up left,
+// elements >= pivot right.
+int block_partition(int arr[], int low, int high, bool* already_partitioned) {
+    int pivot = arr[low];
+    unsigned char offsets_l[BLOCK_PARTITION_SIZE];
+    unsigned char offsets_r[BLOCK_PARTITION_SIZE];
+    int num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+    int moved = 0;
+    
+    // Unclassified region is [l, r)
+    int l = low + 1;
+    int r = high + 1;
+    
+    while (r - l > 2 * BLOCK_PARTITION_SIZE) {
+        if (num_l == 0) {
+            start_l = 0;
+            for (int k = 0; k < BLOCK_PARTITION_SIZE; k++) {
+                offsets_l[num_l] = (unsigned char)k;
+                num_l += arr[l + k] >= pivot;
+            }
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            for (int k = 0; k < BLOCK_PARTITION_SIZE; k++) {
+                offsets_r[num_r] = (unsigned char)(k + 1);
+                num_r += arr[r - 1 - k] < pivot;
+            }
+        }
+        
+        int num = num_l < num_r ? num_l : num_r;
+        for (int k = 0; k < num; k++) {
+            swap_elements(arr, l + offsets_l[start_l + k], r - offsets_r[start_r + k]);
+        }
+        moved |= num;
+        
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) l += BLOCK_PARTITION_SIZE;
+        if (num_r == 0) r -= BLOCK_PARTITION_SIZE;
+    }
+    
+    // Finish the remaining <= 2 blocks with a branchless Lomuto pass:
+    // always swap, advance the boundary by the comparison result
+    int i = l;
+    for (int j = l; j < r; j++) {
+        int value = arr[j];
+        int less = value < pivot;
+        arr[j] = arr[i];
+        arr[i] = value;
+        moved |= less & (i != j);
+        i += less;
+    }
+    
+    swap_elements(arr, low, i - 1);
+    *already_partitioned = moved == 0;
+    return i - 1;
+}
+
+// Partition with keys equal to the pivot going left; used when the pivot
+// equals its predecessor, so everything left of the result is final.
+int partition_equal_left(int arr[], int low, int high) {
+    int pivot = arr[low];
+    int i = low + 1;
+    
+    for (int j = low + 1; j <= high; j++) {
+        int value = arr[j];
+        int not_greater = value <= pivot;
+        arr[j] = arr[i];
+        arr[i] = value;
+        i += not_greater;
+    }
+    
+    swap_elements(arr, low, i - 1);
+    return i - 1;
+}
+
+// Insertion sort that gives up after PARTIAL_INSERTION_LIMIT moves.
+// Returns true if the range ended up sorted.
+bool partial_insertion_sort(int arr[], int low, int high) {
+    int moves = 0;
+    
+    for (int i = low + 1; i <= high; i++) {
+        int key = arr[i];
+        if (arr[i - 1] <= key) continue;
+        
+        int j = i - 1;
+        while (j >= low && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+        
+        moves += i - (j + 1);
+        if (moves > PARTIAL_INSERTION_LIMIT) return false;
+    }
+    
+    return true;
+}
+
+// Parallel quicksort task: partition, push one side onto this worker's
+// deque for idle workers to steal, keep going on the other side.
+// Ranges at or below PARALLEL_SORT_THRESHOLD finish with introsort.
+static void parallel_sort_task(task_pool* pool, void* ctx, size_t begin, size_t end,
+                               unsigned depth) {
+    int* arr = ctx;
+    
+    while (end - begin > PARALLEL_SORT_THRESHOLD) {
+        if (depth == 0) {
+            heap_sort(arr + begin, (int)(end - begin));
+            return;
+        }
+        depth--;
+        
+        size_t mid = (size_t)hoare_partition(arr, (int)begin, (int)(end - 1)) + 1;
+        
+        // Thieves take the oldest (larger) piece; the owner keeps the
+        // smaller one while it is still in cache
+        if (mid - begin > end - mid) {
+            task_pool_spawn(pool, parallel_sort_task, arr, begin, mid, depth);
+            begin = mid;
+        } else {
+            task_pool_spawn(pool, parallel_sort_task, arr, mid, end, depth);
+            end = mid;
+        }
+    }
+    
+    if (end - begin > 1) {
+        introsort_loop(arr, (int)begin, (int)(end - 1), (int)depth);
+    }
+}
+
+// Sort with up to `threads` workers (<= 0 means one per online CPU).
+// Returns 0 on success, -1 if n exceeds the int indices of the
+// sequential kernels. Falls back to introsort if the pool cannot start.
+int quicksort_parallel(int* arr, size_t n, int threads) {
+    if (n > (size_t)INT_MAX) return -1;
+    if (n <= 1) return 0;
+    
+    unsigned depth_limit = 0;
+    for (size_t m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+    
+    if (threads <= 0) {
+        threads = task_pool_cpu_count();
+    }
+    
+    task_pool* pool = NULL;
+    if (threads > 1 && n > PARALLEL_SORT_THRESHOLD) {
+        pool = task_pool_acquire(threads);
+    }
+    if (pool == NULL) {
+        introsort_loop(arr, 0, (int)n - 1, (int)depth_limit);
+        return 0;
+    }
+    
+    task_pool_run(pool, parallel_sort_task, arr, 0, n, depth_limit);
+    task_pool_release(pool);
+    return 0;
+}
+
+#ifndef ROSETTA_NO_MAIN
+
 // Utility functions
 bool is_sorted(int arr[], int size) {
     for (int i = 0; i < size - 1; i++) {
@@ -220,6 +702,11 @@ void copy_array(int dest[], int src[], int size) {
     }
 }
 
+// Four workers regardless of core count, so the stealing path is exercised
+static void quicksort_parallel_4(int arr[], int size) {
+    quicksort_parallel(arr, (size_t)size, 4);
+}
+
 // Test function
 void run_tests() {
     printf("Running Quicksort Tests...\n\n");
@@ -248,6 +735,7 @@ void run_tests() {
             printf("  In-place:    ");
             print_array(arr1, sizes[t]);
             printf("\n");
+            assert(is_sorted(arr1, sizes[t]));
             free(arr1);
             
             // Functional test
@@ -255,8 +743,17 @@ void run_tests() {
             printf("  Functional:  ");
             print_array(arr2, sizes[t]);
             printf("\n");
+            assert(is_sorted(arr2, sizes[t]));
             free(arr2);
             
+            // Arena-backed functional test
+            int* arr2a = quicksort_functional_arena(tests[t], sizes[t]);
+            printf("  Func-arena:  ");
+            print_array(arr2a, sizes[t]);
+            printf("\n");
+            assert(is_sorted(arr2a, sizes[t]));
+            free(arr2a);
+            
             // Three-way test
             int* arr3 = malloc(sizes[t] * sizeof(int));
             copy_array(arr3, tests[t], sizes[t]);
@@ -264,13 +761,164 @@ void run_tests() {
             printf("  Three-way:   ");
             print_array(arr3, sizes[t]);
             printf("\n");
+            assert(is_sorted(arr3, sizes[t]));
             free(arr3);
+            
+            // Introsort test
+            int* arr4 = malloc(sizes[t] * sizeof(int));
+            copy_array(arr4, tests[t], sizes[t]);
+            quicksort_intro(arr4, sizes[t]);
+            printf("  Introsort:   ");
+            print_array(arr4, sizes[t]);
+            printf("\n");
+            assert(is_sorted(arr4, sizes[t]));
+            free(arr4);
+            
+            // Block quicksort test
+            int* arr5 = malloc(sizes[t] * sizeof(int));
+            copy_array(arr5, tests[t], sizes[t]);
+            quicksort_block(arr5, sizes[t]);
+            printf("  Block:       ");
+            print_array(arr5, sizes[t]);
+            printf("\n");
+            assert(is_sorted(arr5, sizes[t]));
+            free(arr5);
+            
+            // Parallel quicksort test
+            int* arr6 = malloc(sizes[t] * sizeof(int));
+            copy_array(arr6, tests[t], sizes[t]);
+            quicksort_parallel(arr6, (size_t)sizes[t], 4);
+            printf("  Parallel:    ");
+            print_array(arr6, sizes[t]);
+            printf("\n");
+            assert(is_sorted(arr6, sizes[t]));
+            free(arr6);
         } else {
             printf("  (Empty array - skipping detailed tests)\n");
         }
         
         printf("\n");
     }
+    
+    // Adversarial inputs that drive the Lomuto variants quadratic
+    const int stress_size = 100000;
+    int* stress = malloc(stress_size * sizeof(int));
+    assert(stress != NULL);
+    
+    const char* sorter_names[] = {"Introsort", "Block", "Parallel"};
+    void (*sorters[])(int[], int) = {quicksort_intro, quicksort_block, quicksort_parallel_4};
+    const char* patterns[] = {"sorted", "reversed", "organ-pipe", "few-unique", "random"};
+    for (int s = 0; s < 3; s++) {
+        for (int p = 0; p < 5; p++) {
+            for (int i = 0; i < stress_size; i++) {
+                switch (p) {
+                    case 0: stress[i] = i; break;
+                    case 1: stress[i] = stress_size - i; break;
+                    case 2: stress[i] = i < stress_size / 2 ? i : stress_size - i; break;
+                    case 3: stress[i] = (i * 7919) % 5; break;
+                    default: stress[i] = (int)(((unsigned)i * 2654435761u) % 1000003u); break;
+                }
+            }
+            sorters[s](stress, stress_size);
+            printf("%s %s (%d elements): %s\n", sorter_names[s], patterns[p], stress_size,
+                   is_sorted(stress, stress_size) ? "sorted" : "NOT SORTED");
+            assert(is_sorted(stress, stress_size));
+        }
+    }
+    free(stress);
+    printf("\n");
+}
+
+// Benchmark context: pristine input plus a scratch copy restored before each run
+typedef struct {
+    const int* input;
+    int* work;
+    int size;
+    arena* scratch;
+} sort_bench_ctx;
+
+static void restore_input(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    copy_array(c->work, (int*)c->input, c->size);
+}
+
+static void bench_inplace(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    quicksort_inplace(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_functional(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    int* sorted = quicksort_functional((int*)c->input, c->size);
+    bench_escape(sorted);
+    free(sorted);
+}
+
+static void bench_functional_arena(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    int* sorted = quicksort_functional_arena((int*)c->input, c->size);
+    bench_escape(sorted);
+    free(sorted);
+}
+
+static void bench_functional_into(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    quicksort_functional_into(c->input, c->size, c->work, c->scratch);
+    bench_escape(c->work);
+}
+
+static void bench_three_way(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    quicksort_three_way(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_intro(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    quicksort_intro(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_block(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    quicksort_block(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_qsort(void* ctx) {
+    sort_bench_ctx* c = ctx;
+    qsort(c->work, c->size, sizeof(int), compare_ints);
+    bench_escape(c->work);
+}
+
+// Leaf kernel benchmark: every block of `block` elements in work is sorted
+typedef struct {
+    const int* input;
+    int* work;
+    int size;
+    int block;
+} leaf_bench_ctx;
+
+static void restore_leaf_input(void* ctx) {
+    leaf_bench_ctx* c = ctx;
+    memcpy(c->work, c->input, c->size * sizeof(int));
+}
+
+static void bench_leaf_insertion(void* ctx) {
+    leaf_bench_ctx* c = ctx;
+    for (int low = 0; low + c->block <= c->size; low += c->block) {
+        insertion_sort_range(c->work, low, low + c->block - 1);
+    }
+    bench_escape(c->work);
+}
+
+static void bench_leaf_sortnet(void* ctx) {
+    leaf_bench_ctx* c = ctx;
+    for (int low = 0; low + c->block <= c->size; low += c->block) {
+        sortnet_sort(c->work + low, (size_t)c->block);
+    }
+    bench_escape(c->work);
 }
 
 // Performance benchmark
@@ -279,53 +927,201 @@ void benchmark() {
     
     const int size = 10000;
     int* large_array = malloc(size * sizeof(int));
+    int* work = malloc(size * sizeof(int));
+    if (large_array == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(large_array);
+        free(work);
+        return;
+    }
     
     // Generate test data
-    srand(42);
     for (int i = 0; i < size; i++) {
         large_array[i] = (i * 37 + 11) % 1000;
     }
     
     printf("  Array size: %d\n", size);
     
-    // Benchmark in-place quicksort
-    int* arr_copy = malloc(size * sizeof(int));
-    copy_array(arr_copy, large_array, size);
-    
-    clock_t start = clock();
-    quicksort_inplace(arr_copy, size);
-    clock_t end = clock();
-    double duration = ((double)(end - start)) / CLOCKS_PER_SEC;
-    printf("  In-place time: %.4f seconds\n", duration);
-    free(arr_copy);
-    
-    // Benchmark functional quicksort
-    start = clock();
-    int* sorted_functional = quicksort_functional(large_array, size);
-    end = clock();
-    duration = ((double)(end - start)) / CLOCKS_PER_SEC;
-    printf("  Functional time: %.4f seconds\n", duration);
-    free(sorted_functional);
-    
-    // Benchmark standard library qsort
-    arr_copy = malloc(size * sizeof(int));
-    copy_array(arr_copy, large_array, size);
-    
-    start = clock();
-    qsort(arr_copy, size, sizeof(int), compare_ints);
-    end = clock();
-    duration = ((double)(end - start)) / CLOCKS_PER_SEC;
-    printf("  qsort time: %.4f seconds\n", duration);
-    free(arr_copy);
+    arena scratch;
+    if (arena_init(&scratch, arena_capacity_for(size * sizeof(int), 1)) != 0) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(large_array);
+        free(work);
+        return;
+    }
+    
+    sort_bench_ctx ctx = {large_array, work, size, &scratch};
+    bench_begin("algorithms/002-quicksort");
+    bench_measure("quicksort_inplace", bench_inplace, restore_input, &ctx);
+    bench_measure("quicksort_functional", bench_functional, NULL, &ctx);
+    bench_measure("quicksort_functional_arena", bench_functional_arena, NULL, &ctx);
+    bench_measure("quicksort_functional_into", bench_functional_into, NULL, &ctx);
+    bench_measure("quicksort_three_way", bench_three_way, restore_input, &ctx);
+    bench_measure("quicksort_intro", bench_intro, restore_input, &ctx);
+    bench_measure("quicksort_block", bench_block, restore_input, &ctx);
+    bench_measure("qsort", bench_qsort, restore_input, &ctx);
+    
+    // Uniform random keys: the partition branch mispredicts ~50% here,
+    // run with BENCH_PERF=1 to see branch_misses per sort
+    bench_fill_random(large_array, size, 42, 0);
+    printf("  Random input:\n");
+    bench_measure("quicksort_inplace/random", bench_inplace, restore_input, &ctx);
+    bench_measure("quicksort_three_way/random", bench_three_way, restore_input, &ctx);
+    bench_measure("quicksort_intro/random", bench_intro, restore_input, &ctx);
+    bench_measure("quicksort_block/random", bench_block, restore_input, &ctx);
+    bench_measure("qsort/random", bench_qsort, restore_input, &ctx);
     
+    // Already-sorted input: the Lomuto variants go quadratic here
+    for (int i = 0; i < size; i++) {
+        large_array[i] = i;
+    }
+    printf("  Sorted input:\n");
+    bench_measure("quicksort_intro/sorted", bench_intro, restore_input, &ctx);
+    bench_measure("quicksort_block/sorted", bench_block, restore_input, &ctx);
+    bench_measure("qsort/sorted", bench_qsort, restore_input, &ctx);
+    
+    // Leaf kernels: 8..64-element blocks at every instruction set this CPU has
+    bench_fill_random(large_array, size, 7, 0);
+    leaf_bench_ctx leaf = {large_array, work, size, 0};
+    char name[BENCH_NAME_LEN];
+    sortnet_isa best = sortnet_detect();
+    printf("  Leaf kernels (%d-element array, best ISA %s):\n", size, sortnet_isa_name(best));
+    for (int block = 8; block <= SORTNET_MAX; block *= 2) {
+        leaf.block = block;
+        snprintf(name, sizeof(name), "leaf_insertion/block=%d", block);
+        bench_measure(name, bench_leaf_insertion, restore_leaf_input, &leaf);
+        for (int isa = SORTNET_SCALAR; isa <= (int)best; isa++) {
+            sortnet_force((sortnet_isa)isa);
+            snprintf(name, sizeof(name), "leaf_sortnet_%s/block=%d", sortnet_isa_name(isa), block);
+            bench_measure(name, bench_leaf_sortnet, restore_leaf_input, &leaf);
+        }
+        sortnet_force(best);
+    }
+    bench_end();
+    
+    arena_destroy(&scratch);
+    free(work);
     free(large_array);
 }
 
-int main() {
+// Scaling benchmark context
+typedef struct {
+    const int* input;
+    int* work;
+    size_t size;
+    int threads;
+} parallel_bench_ctx;
+
+static void restore_parallel_input(void* ctx) {
+    parallel_bench_ctx* c = ctx;
+    memcpy(c->work, c->input, c->size * sizeof(int));
+}
+
+static void bench_parallel(void* ctx) {
+    parallel_bench_ctx* c = ctx;
+    quicksort_parallel(c->work, c->size, c->threads);
+    bench_escape(c->work);
+}
+
+// Strong scaling of quicksort_parallel: sizes 1e5, 1e6, ... up to max_size,
+// threads 1, 2, 4, ... up to max_threads. Speedup is relative to the
+// single-thread run of the same size (plain introsort) and left out when
+// that run failed; efficiency is speedup / threads. Every multi-threaded
+// point runs twice, with workers left to the scheduler and pinned in NUMA
+// node blocks; the sorted copy is placed in matching node blocks. Needs
+// 8 bytes per element (input + work copy).
+void scaling_benchmark(int max_threads, size_t max_size) {
+    printf("Parallel quicksort scaling (random input, up to %d threads):\n", max_threads);
+    topology_report(stdout);
+    
+    int* input = malloc(max_size * sizeof(int));
+    int* work = topology_alloc(max_size * sizeof(int), TOPOLOGY_BLOCKED | TOPOLOGY_HUGE_PAGES);
+    if (input == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(input);
+        topology_free(work, max_size * sizeof(int));
+        return;
+    }
+    
+    // Each sample at 1e9 takes seconds; a few per point is enough
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) config.samples = 5;
+    
+    bench_begin("algorithms/002-quicksort");
+    task_pool_set_default_affinity(TASK_POOL_AFFINITY_NONE);
+    for (size_t size = 100000; size <= max_size; size *= 10) {
+        bench_fill_random(input, size, 42, 0);
+        parallel_bench_ctx ctx = {input, work, size, 1};
+        double serial_ns = 0.0;
+        
+        for (int threads = 1;; threads *= 2) {
+            if (threads > max_threads) threads = max_threads;
+            ctx.threads = threads;
+            
+            bench_result result;
+            char name[BENCH_NAME_LEN];
+            snprintf(name, sizeof(name), "quicksort_parallel/n=%zu/t=%d", size, threads);
+            if (bench_run(name, bench_parallel, restore_parallel_input, &ctx, &config, &result) != 0) {
+                // Still reach the exit check below, or the clamp repeats max_threads forever
+                fprintf(stderr, "Error: %s failed\n", name);
+            } else {
+                bench_record(&result);
+                
+                if (threads == 1) serial_ns = result.median_ns;
+                double unpinned_ns = result.median_ns;
+                printf("  n=%-11zu threads=%-3d median %10.3f ms", size, threads,
+                       unpinned_ns / 1e6);
+                if (serial_ns > 0.0) {
+                    double speedup = serial_ns / unpinned_ns;
+                    printf("  speedup %5.2fx  efficiency %5.1f%%", speedup,
+                           100.0 * speedup / threads);
+                }
+                
+                if (threads > 1) {
+                    task_pool_set_default_affinity(TASK_POOL_AFFINITY_PINNED);
+                    snprintf(name, sizeof(name), "quicksort_parallel/n=%zu/t=%d/pinned", size,
+                             threads);
+                    if (bench_run(name, bench_parallel, restore_parallel_input, &ctx, &config,
+                                  &result) == 0) {
+                        bench_record(&result);
+                        printf("  pinned %10.3f ms (%5.2fx)", result.median_ns / 1e6,
+                               unpinned_ns / result.median_ns);
+                    }
+                    task_pool_set_default_affinity(TASK_POOL_AFFINITY_NONE);
+                }
+                printf("\n");
+            }
+            
+            if (threads == max_threads) break;
+        }
+    }
+    task_pool_set_default_affinity(TASK_POOL_AFFINITY_AUTO);
+    bench_end();
+    
+    topology_free(work, max_size * sizeof(int));
+    free(input);
+}
+
+int main(int argc, char* argv[]) {
+    // ./quicksort scaling [max_threads] [max_size]
+    if (argc > 1 && strcmp(argv[1], "scaling") == 0) {
+        int max_threads = argc > 2 ? atoi(argv[2]) : task_pool_cpu_count();
+        size_t max_size = argc > 3 ? (size_t)strtoull(argv[3], NULL, 10) : 10000000;
+        if (max_threads < 1 || max_size < 100000 || max_size > (size_t)INT_MAX) {
+            fprintf(stderr, "Usage: %s scaling [max_threads] [max_size (1e5..%d)]\n", argv[0], INT_MAX);
+            return 1;
+        }
+        scaling_benchmark(max_threads, max_size);
+        return 0;
+    }
+    
     printf("Quicksort Implementations Demo\n\n");
     
     run_tests();
     benchmark();
     
     return 0;
-}
\ No newline at end of file
+}
+
+#endif  // ROSETTA_NO_MAIN
@@ -0,0 +1,81 @@
+/**
+ * Quicksort Algorithms - Public Interface
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Other implementations link quicksort.c compiled with -DROSETTA_NO_MAIN,
+ * which drops the test/benchmark driver and keeps only the sorts. The
+ * library also needs heap_sort.c (introsort fallback, itself built with
+ * -DROSETTA_NO_MAIN), sortnet.c, arena.c and task_pool.c.
+ */
+
+#ifndef ROSETTA_QUICKSORT_H
+#define ROSETTA_QUICKSORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Lomuto-partition quicksort (reference)
+ */
+void quicksort_inplace(int arr[], int size);
+
+/**
+ * Functional quicksort; returns a newly allocated sorted copy
+ */
+int* quicksort_functional(int arr[], int size);
+
+/**
+ * Three-way (Dutch national flag) quicksort for inputs with many duplicates
+ */
+void quicksort_three_way(int arr[], int size);
+
+/**
+ * Introsort: O(n log n) worst case, sorting-network leaves
+ */
+void quicksort_intro(int arr[], int size);
+
+/**
+ * Block-partition quicksort (pdqsort-style branchless partitioning)
+ */
+void quicksort_block(int arr[], int size);
+
+/**
+ * Introsort core on arr[low..high] with a given depth budget
+ */
+void introsort_loop(int arr[], int low, int high, int depth_limit);
+
+// Partition kernels, also used by the selection algorithms in 022
+
+/**
+ * Branchless block partition of arr[low+1..high] around the pivot at
+ * arr[low]; the pivot ends in the returned slot, smaller keys before it.
+ * *already_partitioned reports that no key had to move.
+ */
+int block_partition(int arr[], int low, int high, bool* already_partitioned);
+
+/**
+ * Partition arr[low+1..high] around the pivot at arr[low] with keys equal
+ * to it going left; returns the pivot's slot. Used when the key before the
+ * range equals the pivot, so everything up to the result is final.
+ */
+int partition_equal_left(int arr[], int low, int high);
+
+/**
+ * Ninther (large ranges) or median-of-three pivot index for arr[low..high]
+ */
+int choose_pivot(int arr[], int low, int high);
+
+/**
+ * Insertion sort of arr[low..high]
+ */
+void insertion_sort_range(int arr[], int low, int high);
+
+/**
+ * Work-stealing parallel introsort (threads <= 0: one per CPU).
+ * Returns 0 on success, -1 if n exceeds INT_MAX.
+ */
+int quicksort_parallel(int* arr, size_t n, int threads);
+
+#endif  // ROSETTA_QUICKSORT_H
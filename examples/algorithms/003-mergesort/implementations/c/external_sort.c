@@ -0,0 +1,672 @@
+/**
+ * External (Out-of-Core) Sort of Binary Key Files
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#define _GNU_SOURCE
+
+#include "external_sort.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "async_io.h"
+#include "sort_generic.h"
+
+SORT_DEFINE(ext_i32, int32_t, int32_t, SORT_KEY_SELF, uint32_t, sort_bits_i32)
+SORT_DEFINE(ext_i64, int64_t, int64_t, SORT_KEY_SELF, uint64_t, sort_bits_i64)
+
+// Offsets and lengths of every transfer are multiples of this (O_DIRECT)
+#define EXT_ALIGN 4096
+
+// Merge block per run buffer, and the largest single request. Blocks
+// shrink towards EXT_BLOCK_MIN while that lets one pass merge every run.
+#define EXT_BLOCK_MAX (1u << 20)
+#define EXT_BLOCK_MIN (256u << 10)
+#define EXT_SLICE (8u << 20)
+
+#define EXT_MIN_MEMORY (64u << 10)
+
+// Merge key of an exhausted run: no int32 key reaches it, and an int64
+// key equal to it is the same value (see merge_keys())
+#define EXT_EXHAUSTED INT64_MAX
+
+// Request tags: bit 63 write, bits 32..62 buffer index, low 32 bits the
+// bytes the caller needs (a read may stop at end of file past them)
+#define EXT_TAG_WRITE (UINT64_C(1) << 63)
+
+typedef struct {
+    uint64_t offset;
+    uint64_t bytes;
+} ext_run;
+
+typedef struct {
+    async_io *io;
+    int *pending;  // Requests in flight per buffer index
+    external_sort_stats *stats;
+} ext_ctx;
+
+static uint64_t align_up(uint64_t value) {
+    return (value + EXT_ALIGN - 1) & ~(uint64_t)(EXT_ALIGN - 1);
+}
+
+static size_t align_down(size_t value) {
+    return value & ~(size_t)(EXT_ALIGN - 1);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int64_t load_key(const char *p, int key_bytes) {
+    if (key_bytes == 4) {
+        int32_t key;
+        memcpy(&key, p, sizeof(key));
+        return key;
+    }
+    int64_t key;
+    memcpy(&key, p, sizeof(key));
+    return key;
+}
+
+static void store_key(char *p, int64_t key, int key_bytes) {
+    if (key_bytes == 4) {
+        int32_t narrow = (int32_t)key;
+        memcpy(p, &narrow, sizeof(narrow));
+    } else {
+        memcpy(p, &key, sizeof(key));
+    }
+}
+
+/**
+ * Queue reads / writes of `bytes` at offset in EXT_SLICE requests, each
+ * padded to EXT_ALIGN, under buffer index `index`
+ */
+static int ext_submit(ext_ctx *c, int write, int fd, char *buf, uint64_t bytes, uint64_t offset,
+                      unsigned index) {
+    for (uint64_t done = 0; done < bytes; done += EXT_SLICE) {
+        uint64_t need = bytes - done < EXT_SLICE ? bytes - done : EXT_SLICE;
+        uint64_t tag = (uint64_t)index << 32 | need | (write ? EXT_TAG_WRITE : 0);
+        size_t len = (size_t)align_up(need);
+        int rc = write ? async_io_write(c->io, fd, buf + done, len, offset + done, tag)
+                       : async_io_read(c->io, fd, buf + done, len, offset + done, tag);
+        if (rc != 0) {
+            errno = EIO;
+            return -1;
+        }
+        c->pending[index]++;
+    }
+    return 0;
+}
+
+/**
+ * Reap one completion and check it moved what its tag asked for
+ */
+static int ext_wait_one(ext_ctx *c) {
+    uint64_t tag;
+    int64_t result;
+    if (async_io_wait(c->io, &tag, &result) != 0) {
+        errno = EIO;
+        return -1;
+    }
+    unsigned index = (unsigned)(tag >> 32) & 0x7fffffffu;
+    uint64_t need = tag & 0xffffffffu;
+    c->pending[index]--;
+
+    if (tag & EXT_TAG_WRITE) {
+        if (result != (int64_t)align_up(need)) {
+            errno = result < 0 ? (int)-result : EIO;
+            return -1;
+        }
+        c->stats->bytes_written += need;
+    } else {
+        if (result < (int64_t)need) {
+            errno = result < 0 ? (int)-result : EIO;
+            return -1;
+        }
+        c->stats->bytes_read += need;
+    }
+    return 0;
+}
+
+static int ext_wait(ext_ctx *c, unsigned index) {
+    while (c->pending[index] > 0) {
+        if (ext_wait_one(c) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int ext_drain(ext_ctx *c) {
+    while (async_io_in_flight(c->io) > 0) {
+        if (ext_wait_one(c) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void sort_chunk(char *buf, uint64_t bytes, int key_bytes) {
+    if (key_bytes == 4) {
+        size_t n = (size_t)(bytes / 4);
+        if (ext_i32_radix_sort((int32_t *)buf, n) != 0) {
+            ext_i32_quicksort((int32_t *)buf, n);  // No memory for the radix buffer
+        }
+    } else {
+        size_t n = (size_t)(bytes / 8);
+        if (ext_i64_radix_sort((int64_t *)buf, n) != 0) {
+            ext_i64_quicksort((int64_t *)buf, n);
+        }
+    }
+}
+
+/**
+ * Pass 1: sorted runs of `chunk` bytes at offsets i * chunk of out_fd.
+ * Buffers rotate: while chunk i sorts in buf[i % 3], chunk i+1 is read
+ * into the next buffer and chunk i-1 written from the previous one.
+ */
+static int form_runs(ext_ctx *c, int in_fd, uint64_t file_bytes, int out_fd, size_t chunk,
+                     int key_bytes, char *buf[3], ext_run *runs) {
+    uint64_t count = (file_bytes + chunk - 1) / chunk;
+
+    if (ext_submit(c, 0, in_fd, buf[0], file_bytes < chunk ? file_bytes : chunk, 0, 0) != 0) {
+        return -1;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        unsigned b = (unsigned)(i % 3);
+        if (i + 1 < count) {
+            unsigned next = (unsigned)((i + 1) % 3);
+            uint64_t offset = (i + 1) * chunk;
+            uint64_t bytes = file_bytes - offset < chunk ? file_bytes - offset : chunk;
+            // Its previous occupant (chunk i-2) must be written out first
+            if (ext_wait(c, next) != 0 || ext_submit(c, 0, in_fd, buf[next], bytes, offset, next) != 0) {
+                return -1;
+            }
+        }
+        if (ext_wait(c, b) != 0) {
+            return -1;
+        }
+
+        runs[i].offset = i * chunk;
+        runs[i].bytes = file_bytes - runs[i].offset < chunk ? file_bytes - runs[i].offset : chunk;
+        sort_chunk(buf[b], runs[i].bytes, key_bytes);
+        if (ext_submit(c, 1, out_fd, buf[b], runs[i].bytes, runs[i].offset, b) != 0) {
+            return -1;
+        }
+    }
+    return ext_drain(c);
+}
+
+/**
+ * A run being merged: its keys stream through two alternating blocks
+ */
+typedef struct {
+    uint64_t next;  // File offset of the next block to request
+    uint64_t end;
+    char *buf[2];
+    size_t valid[2];  // Bytes requested into each block; 0: none
+    int cur;
+    size_t pos;
+} ext_reader;
+
+typedef struct {
+    ext_ctx *c;
+    int in_fd;
+    int out_fd;
+    int key_bytes;
+    size_t block;
+    int fan_in;
+    ext_reader *readers;
+    char *out_buf[2];
+    int out_cur;
+    size_t out_pos;
+    uint64_t out_offset;
+    int *tree;          // tree[0]: winner; tree[1..k): loser of each match
+    int64_t *tree_key;  // Current key of each tree[] entry
+} ext_merge;
+
+static int reader_request(ext_merge *m, int r, int b) {
+    ext_reader *rd = &m->readers[r];
+    uint64_t bytes = rd->end - rd->next < m->block ? rd->end - rd->next : m->block;
+    rd->valid[b] = (size_t)bytes;
+    if (bytes == 0) {
+        return 0;
+    }
+    rd->next += bytes;
+    return ext_submit(m->c, 0, m->in_fd, rd->buf[b], bytes, rd->next - bytes, (unsigned)(2 * r + b));
+}
+
+/**
+ * Run r consumed its current block: refill it in the background and
+ * switch to the other. 1 if that one holds keys, 0 if the run is
+ * exhausted, -1 on error.
+ */
+static int reader_next_block(ext_merge *m, int r) {
+    ext_reader *rd = &m->readers[r];
+    int old = rd->cur;
+    rd->cur ^= 1;
+    rd->pos = 0;
+    if (reader_request(m, r, old) != 0) {
+        return -1;
+    }
+    if (rd->valid[rd->cur] == 0) {
+        return 0;
+    }
+    return ext_wait(m->c, (unsigned)(2 * r + rd->cur)) == 0 ? 1 : -1;
+}
+
+static int writer_flush(ext_merge *m) {
+    unsigned tag = (unsigned)(2 * m->fan_in + m->out_cur);
+    if (m->out_pos == 0) {
+        return 0;
+    }
+    if (ext_submit(m->c, 1, m->out_fd, m->out_buf[m->out_cur], m->out_pos, m->out_offset, tag) != 0) {
+        return -1;
+    }
+    m->out_offset = align_up(m->out_offset + m->out_pos);
+    m->out_pos = 0;
+    m->out_cur ^= 1;
+    return ext_wait(m->c, (unsigned)(2 * m->fan_in + m->out_cur));
+}
+
+/**
+ * Loser-tree merge of `total` keys from readers[0..k) (every one holding
+ * its first key). Exhausted runs enter the tree as EXT_EXHAUSTED: the loop
+ * stops after `total` keys, so a sentinel only ever wins against
+ * remaining keys equal to it, and then outputs the same value. Called
+ * with a constant key_bytes so each width gets its own branch-free replay.
+ */
+static inline int merge_keys(ext_merge *m, int k, uint64_t total, int key_bytes) {
+    int *tree = m->tree;
+    int64_t *tree_key = m->tree_key;
+
+    // Node of leaf i is (i + k) / 2. The first key up to reach an empty
+    // node parks there; the second plays it and the winner moves on.
+    for (int i = 0; i < k; i++) {
+        tree[i] = -1;
+    }
+    for (int r = 0; r < k; r++) {
+        int w = r;
+        int64_t wk = load_key(m->readers[r].buf[0], key_bytes);
+        for (int node = (r + k) / 2; node > 0; node /= 2) {
+            if (tree[node] < 0) {
+                tree[node] = w;
+                tree_key[node] = wk;
+                w = -1;
+                break;
+            }
+            if (tree_key[node] < wk) {
+                int t = tree[node];
+                int64_t tk = tree_key[node];
+                tree[node] = w;
+                tree_key[node] = wk;
+                w = t;
+                wk = tk;
+            }
+        }
+        if (w >= 0) {
+            tree[0] = w;
+            tree_key[0] = wk;
+        }
+    }
+
+    // The output cursor lives in locals: stores through it may alias *m
+    int w = tree[0];
+    int64_t wk = tree_key[0];
+    char *out = m->out_buf[m->out_cur] + m->out_pos;
+    char *out_end = m->out_buf[m->out_cur] + m->block;
+    for (uint64_t t = 0; t < total; t++) {
+        store_key(out, wk, key_bytes);
+        out += key_bytes;
+        if (out == out_end) {
+            m->out_pos = m->block;
+            if (writer_flush(m) != 0) {
+                return -1;
+            }
+            out = m->out_buf[m->out_cur];
+            out_end = out + m->block;
+        }
+
+        ext_reader *rd = &m->readers[w];
+        rd->pos += (size_t)key_bytes;
+        if (rd->pos >= rd->valid[rd->cur]) {
+            int more = rd->valid[rd->cur] == 0 ? 0 : reader_next_block(m, w);
+            if (more < 0) {
+                return -1;
+            }
+            if (!more) {
+                rd->valid[rd->cur] = 0;  // Stays exhausted if it wins again
+                rd->pos = 0;
+            }
+        }
+        wk = rd->valid[rd->cur] > 0 ? load_key(rd->buf[rd->cur] + rd->pos, key_bytes)
+                                    : EXT_EXHAUSTED;
+
+        // Masks rather than ?: so the compiler cannot turn the swap back
+        // into a branch, which mispredicts half the time on random keys
+        for (int node = (w + k) / 2; node > 0; node /= 2) {
+            int l = tree[node];
+            int64_t lk = tree_key[node];
+            int64_t mask = -(int64_t)(lk < wk);
+            int64_t key_diff = (lk ^ wk) & mask;
+            int index_diff = (l ^ w) & (int)mask;
+            tree[node] = l ^ index_diff;
+            tree_key[node] = lk ^ key_diff;
+            w ^= index_diff;
+            wk ^= key_diff;
+        }
+    }
+    m->out_pos = (size_t)(out - m->out_buf[m->out_cur]);
+    return 0;
+}
+
+/**
+ * Merge runs[0..k) into one run of out_fd starting at m->out_offset
+ */
+static int merge_group(ext_merge *m, const ext_run *runs, int k, ext_run *merged) {
+    uint64_t total = 0;
+    merged->offset = m->out_offset;
+
+    for (int r = 0; r < k; r++) {
+        ext_reader *rd = &m->readers[r];
+        rd->next = runs[r].offset;
+        rd->end = runs[r].offset + runs[r].bytes;
+        rd->cur = 0;
+        rd->pos = 0;
+        total += runs[r].bytes / (uint64_t)m->key_bytes;
+        if (reader_request(m, r, 0) != 0 || reader_request(m, r, 1) != 0) {
+            return -1;
+        }
+    }
+    for (int r = 0; r < k; r++) {
+        if (ext_wait(m->c, (unsigned)(2 * r)) != 0) {
+            return -1;
+        }
+    }
+
+    int rc = m->key_bytes == 4 ? merge_keys(m, k, total, 4) : merge_keys(m, k, total, 8);
+    if (rc != 0) {
+        return -1;
+    }
+    merged->bytes = total * (uint64_t)m->key_bytes;
+    if (writer_flush(m) != 0) {
+        return -1;
+    }
+    return ext_drain(m->c);
+}
+
+static int open_temp(const char *dir, int want_direct, int *direct) {
+    char path[4096];
+    int fd = -1;
+
+    if (want_direct) {
+        snprintf(path, sizeof(path), "%s/extsort-XXXXXX", dir);
+        fd = mkostemp(path, O_DIRECT);
+        if (fd < 0) {
+            *direct = 0;
+        }
+    }
+    if (fd < 0) {
+        snprintf(path, sizeof(path), "%s/extsort-XXXXXX", dir);
+        fd = mkstemp(path);
+    }
+    if (fd >= 0) {
+        unlink(path);  // Reclaimed when closed, even on a crash
+    }
+    return fd;
+}
+
+static int open_direct(const char *path, int flags, int want_direct, int *direct) {
+    if (want_direct) {
+        int fd = open(path, flags | O_DIRECT, 0644);
+        if (fd >= 0 || errno != EINVAL) {
+            return fd;
+        }
+        *direct = 0;  // Filesystem refuses O_DIRECT
+    }
+    return open(path, flags, 0644);
+}
+
+external_sort_config external_sort_default_config(void) {
+    external_sort_config config = {256u << 20, 4, 0, NULL};
+    return config;
+}
+
+/**
+ * Merge block size and fan-in for `runs` runs: two blocks per input run
+ * and two for the output fill the budget
+ */
+static int merge_geometry(size_t memory, uint64_t runs, size_t *block) {
+    size_t size = EXT_BLOCK_MAX;
+    while (size > EXT_BLOCK_MIN && memory / (2 * size) - 1 < runs) {
+        size /= 2;
+    }
+    if (size > align_down(memory / 8)) {
+        size = align_down(memory / 8);
+    }
+    *block = size;
+    uint64_t fan_in = memory / (2 * size) - 1;
+    return (int)(fan_in < runs ? fan_in : runs > 2 ? runs : 2);
+}
+
+static void *aligned_buffer(size_t bytes) {
+    return aligned_alloc(EXT_ALIGN, (size_t)align_up(bytes > 0 ? bytes : 1));
+}
+
+int external_sort(const char *input_path, const char *output_path,
+                  const external_sort_config *config, external_sort_stats *stats) {
+    int key_bytes = config->key_bytes;
+    size_t memory = config->memory_bytes;
+    const char *tmp_dir = config->tmp_dir;
+
+    memset(stats, 0, sizeof(*stats));
+    if ((key_bytes != 4 && key_bytes != 8) || memory < EXT_MIN_MEMORY) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (tmp_dir == NULL) {
+        tmp_dir = getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp";
+    }
+
+    double start = now_seconds();
+    struct stat st;
+    if (stat(input_path, &st) != 0) {
+        return -1;
+    }
+    uint64_t file_bytes = (uint64_t)st.st_size;
+    if (file_bytes % (uint64_t)key_bytes != 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    size_t chunk = align_down(memory / 4);  // Three rotating buffers + radix scratch
+    uint64_t num_runs = (file_bytes + chunk - 1) / chunk;
+    size_t block;
+    int fan_in = merge_geometry(memory, num_runs, &block);
+    unsigned run_depth = 3 * (unsigned)(chunk / EXT_SLICE + 1);
+    unsigned merge_depth = 2 * (unsigned)fan_in + 2;
+    unsigned depth = run_depth > merge_depth ? run_depth : merge_depth;
+
+    stats->fan_in = fan_in;
+    stats->direct_io = config->direct_io;
+
+    int in_fd = open_direct(input_path, O_RDONLY, config->direct_io, &stats->direct_io);
+    int out_fd = open_direct(output_path, O_WRONLY | O_CREAT, config->direct_io,
+                             &stats->direct_io);
+    int fds[2] = {-1, -1};  // Run files, alternating between merge passes
+    async_io *io = async_io_create(depth);
+    int *pending = calloc((size_t)(2 * fan_in + 2), sizeof(int));
+    char *buf[3] = {NULL, NULL, NULL};
+    ext_run *runs = NULL;
+    ext_merge m;
+    memset(&m, 0, sizeof(m));
+    int rc = -1;
+    int saved_errno = 0;
+
+    if (in_fd < 0 || out_fd < 0 || io == NULL || pending == NULL) {
+        saved_errno = errno != 0 ? errno : ENOMEM;
+        goto cleanup;
+    }
+
+    // Truncate only once the output is known not to be the input itself
+    struct stat out_st;
+    if (fstat(in_fd, &st) != 0 || fstat(out_fd, &out_st) != 0) {
+        saved_errno = errno;
+        goto cleanup;
+    }
+    if (st.st_dev == out_st.st_dev && st.st_ino == out_st.st_ino) {
+        saved_errno = EINVAL;
+        goto cleanup;
+    }
+    if (ftruncate(out_fd, 0) != 0) {
+        saved_errno = errno;
+        goto cleanup;
+    }
+
+    ext_ctx c = {io, pending, stats};
+    stats->io_backend = async_io_backend(io);
+    stats->keys = file_bytes / (uint64_t)key_bytes;
+    if (file_bytes == 0) {
+        rc = 0;
+        goto cleanup;
+    }
+
+    // Pass 1: run formation; a single chunk goes straight to the output
+    runs = malloc(num_runs * sizeof(ext_run));
+    for (int i = 0; i < 3; i++) {
+        buf[i] = aligned_buffer(chunk);
+    }
+    if (runs == NULL || buf[0] == NULL || buf[1] == NULL || buf[2] == NULL) {
+        saved_errno = ENOMEM;
+        goto cleanup;
+    }
+    int run_fd = out_fd;
+    if (num_runs > 1) {
+        fds[0] = open_temp(tmp_dir, config->direct_io, &stats->direct_io);
+        run_fd = fds[0];
+    }
+    if (run_fd < 0 || form_runs(&c, in_fd, file_bytes, run_fd, chunk, key_bytes, buf, runs) != 0) {
+        saved_errno = errno;
+        goto cleanup;
+    }
+    for (int i = 0; i < 3; i++) {
+        free(buf[i]);
+        buf[i] = NULL;
+    }
+    stats->runs = num_runs;
+    stats->passes = 1;
+    stats->run_seconds = now_seconds() - start;
+
+    // Merge passes of fan_in runs each, the last one into the output
+    double merge_start = now_seconds();
+    m.c = &c;
+    m.key_bytes = key_bytes;
+    m.block = block;
+    m.fan_in = fan_in;
+    m.readers = calloc((size_t)fan_in, sizeof(ext_reader));
+    m.tree_key = malloc((size_t)fan_in * sizeof(int64_t));
+    m.tree = malloc((size_t)fan_in * sizeof(int));
+    m.out_buf[0] = aligned_buffer(block);
+    m.out_buf[1] = aligned_buffer(block);
+    int buffers_ok = m.readers != NULL && m.tree != NULL && m.tree_key != NULL &&
+                     m.out_buf[0] != NULL && m.out_buf[1] != NULL;
+    for (int r = 0; buffers_ok && r < fan_in; r++) {
+        m.readers[r].buf[0] = aligned_buffer(block);
+        m.readers[r].buf[1] = aligned_buffer(block);
+        buffers_ok = m.readers[r].buf[0] != NULL && m.readers[r].buf[1] != NULL;
+    }
+    if (num_runs > 1 && !buffers_ok) {
+        saved_errno = ENOMEM;
+        goto cleanup;
+    }
+
+    int src = 0;
+    while (num_runs > 1) {
+        int last = num_runs <= (uint64_t)fan_in;
+        int dst = src ^ 1;
+        if (!last && fds[dst] < 0) {
+            fds[dst] = open_temp(tmp_dir, config->direct_io, &stats->direct_io);
+            if (fds[dst] < 0) {
+                saved_errno = errno;
+                goto cleanup;
+            }
+        }
+        m.in_fd = fds[src];
+        m.out_fd = last ? out_fd : fds[dst];
+        m.out_offset = 0;
+        m.out_cur = 0;
+        m.out_pos = 0;
+
+        uint64_t merged = 0;
+        for (uint64_t g = 0; g < num_runs; g += (uint64_t)fan_in) {
+            int k = num_runs - g < (uint64_t)fan_in ? (int)(num_runs - g) : fan_in;
+            ext_run out_run;
+            if (merge_group(&m, runs + g, k, &out_run) != 0) {
+                saved_errno = errno;
+                goto cleanup;
+            }
+            runs[merged++] = out_run;  // g >= merged: never overwrites an unread run
+        }
+        if (ftruncate(fds[src], 0) != 0) {  // Free the consumed runs' space
+            saved_errno = errno;
+            goto cleanup;
+        }
+        num_runs = merged;
+        src = dst;
+        stats->passes++;
+    }
+    stats->merge_seconds = now_seconds() - merge_start;
+
+    // Padded final blocks: cut the output back to exactly the input size
+    if (ftruncate(out_fd, (off_t)file_bytes) != 0) {
+        saved_errno = errno;
+        goto cleanup;
+    }
+    rc = 0;
+
+cleanup:
+    async_io_destroy(io);  // Drains requests that still reference buffers
+    if (m.readers != NULL) {
+        for (int r = 0; r < fan_in; r++) {
+            free(m.readers[r].buf[0]);
+            free(m.readers[r].buf[1]);
+        }
+    }
+    free(m.readers);
+    free(m.tree_key);
+    free(m.tree);
+    free(m.out_buf[0]);
+    free(m.out_buf[1]);
+    for (int i = 0; i < 3; i++) {
+        free(buf[i]);
+    }
+    free(runs);
+    free(pending);
+    for (int i = 0; i < 2; i++) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+    if (in_fd >= 0) {
+        close(in_fd);
+    }
+    if (out_fd >= 0) {
+        close(out_fd);
+    }
+    stats->total_seconds = now_seconds() - start;
+    if (rc != 0) {
+        errno = saved_errno != 0 ? saved_errno : EIO;
+    }
+    return rc;
+}
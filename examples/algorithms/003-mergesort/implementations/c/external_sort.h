@@ -0,0 +1,65 @@
+/**
+ * External (Out-of-Core) Sort of Binary Key Files
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Sorts a file of native-endian int32 or int64 keys that may exceed RAM,
+ * in a fixed memory budget:
+ *
+ * 1. Run formation: budget/4-byte chunks are read, radix-sorted
+ *    (sort_generic.h) and written as runs, three buffers in rotation so
+ *    reading chunk i+1 and writing chunk i-1 overlap sorting chunk i.
+ * 2. Merge passes: up to fan_in runs at a time are merged through a
+ *    loser tree, each run read through two alternating blocks and the
+ *    output written through two more, so refills and writes are in
+ *    flight while the merge consumes the other block. The last pass
+ *    writes the output file.
+ *
+ * All transfers go through async_io (io_uring where available) at
+ * 4 KiB-aligned offsets and lengths, so run files, input and output can
+ * use O_DIRECT and bypass the page cache; where the filesystem refuses
+ * O_DIRECT the file is opened buffered instead.
+ */
+
+#ifndef ROSETTA_EXTERNAL_SORT_H
+#define ROSETTA_EXTERNAL_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    size_t memory_bytes;  // Buffer budget (at least 64 KiB)
+    int key_bytes;        // 4 (int32) or 8 (int64)
+    int direct_io;        // Request O_DIRECT
+    const char *tmp_dir;  // Run files; NULL: $TMPDIR or /tmp
+} external_sort_config;
+
+typedef struct {
+    uint64_t keys;
+    uint64_t runs;            // Sorted runs after run formation
+    int passes;               // Passes over the data, run formation included
+    int fan_in;               // Runs merged at once
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    double run_seconds;       // Run formation
+    double merge_seconds;
+    double total_seconds;
+    const char *io_backend;   // "io_uring" or "sync"
+    int direct_io;            // O_DIRECT granted on every file
+} external_sort_stats;
+
+/**
+ * 256 MiB budget, int32 keys, buffered I/O, default temp directory
+ */
+external_sort_config external_sort_default_config(void);
+
+/**
+ * Sort input_path into output_path (distinct files). Returns 0, or -1
+ * with errno set (EINVAL: bad config, a size that is not a whole
+ * number of keys, or output_path naming the input file itself).
+ */
+int external_sort(const char *input_path, const char *output_path,
+                  const external_sort_config *config, external_sort_stats *stats);
+
+#endif  // ROSETTA_EXTERNAL_SORT_H
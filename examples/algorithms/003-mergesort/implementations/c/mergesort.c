@@ -12,6 +12,29 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <limits.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "bench.h"
+#include "external_sort.h"
+#include "int_io.h"
+#include "mergesort.h"
+#include "sortnet.h"
+#include "task_pool.h"
+#include "topology.h"
+
+// Leaf run length for mergesort_bottomup(): sorted by the SIMD
+// sorting-network kernel
+#define MERGESORT_RUN SORTNET_MAX
+
+// mergesort_parallel() sorts at most this many elements sequentially
+#define MERGESORT_PARALLEL_THRESHOLD 32768
+
+// mergesort_adaptive(): natural runs shorter than this are extended by
+// insertion sort, and this many consecutive wins switch a merge to galloping
+#define ADAPTIVE_MIN_RUN 32
+#define ADAPTIVE_MIN_GALLOP 7
 
 /**
  * Merge two sorted subarrays arr[left..mid] and arr[mid+1..right]
@@ -98,6 +121,530 @@ void mergesort(int arr[], int size) {
     }
 }
 
+/**
+ * Insertion sort arr[left..right)
+ */
+static void insertion_sort_run(int arr[], size_t left, size_t right) {
+    for (size_t i = left + 1; i < right; i++) {
+        int key = arr[i];
+        size_t j = i;
+        while (j > left && arr[j - 1] > key) {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = key;
+    }
+}
+
+/**
+ * Network-sorted leaf runs followed by ping-pong merge passes between
+ * src and dst (both n long). Returns whichever buffer holds the result.
+ */
+static int *bottomup_passes(int src[], int dst[], size_t n) {
+    for (size_t left = 0; left < n; left += MERGESORT_RUN) {
+        size_t right = left + MERGESORT_RUN < n ? left + MERGESORT_RUN : n;
+        sortnet_sort(src + left, right - left);
+    }
+
+    for (size_t width = MERGESORT_RUN; width < n; width *= 2) {
+        for (size_t left = 0; left < n; left += 2 * width) {
+            size_t mid = left + width < n ? left + width : n;
+            size_t right = left + 2 * width < n ? left + 2 * width : n;
+            // An unpaired tail run merges with nothing, i.e. moves across
+            sortnet_merge(src + left, mid - left, src + mid, right - mid, dst + left);
+        }
+
+        int *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    return src;
+}
+
+/**
+ * Bottom-up merge sort with a single n-sized auxiliary buffer.
+ *
+ * Runs of MERGESORT_RUN elements are sorted in place by the sorting-network
+ * kernel, then each pass merges pairs of runs from one buffer into the
+ * other with the vectorized sortnet_merge() and the two buffers swap
+ * roles, so there is no per-merge allocation and no copy-back between
+ * levels. At most one final copy is needed when the pass count is odd.
+ * Equal ints are interchangeable, so the result is what a stable sort
+ * gives. Returns 0 on success, -1 if the auxiliary buffer cannot be
+ * allocated (arr is then unchanged).
+ */
+int mergesort_bottomup(int arr[], int size) {
+    if (size <= 1) {
+        return 0;
+    }
+
+    size_t n = (size_t)size;
+    if (n <= MERGESORT_RUN) {
+        sortnet_sort(arr, n);
+        return 0;
+    }
+
+    int *aux = malloc(n * sizeof(int));
+    if (aux == NULL) {
+        return -1;
+    }
+
+    int *sorted = bottomup_passes(arr, aux, n);
+    if (sorted != arr) {
+        memcpy(arr, sorted, n * sizeof(int));
+    }
+    free(aux);
+    return 0;
+}
+
+/**
+ * Merge-path co-rank: the number of elements taken from a among the first
+ * k outputs of the stable merge of a[0..na) and b[0..nb)
+ */
+static size_t co_rank(size_t k, const int a[], size_t na, const int b[], size_t nb) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        // a[i] is emitted before b[k - i - 1] when a[i] <= b[k - i - 1]
+        if (a[i] <= b[k - i - 1]) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Shared state of one mergesort_parallel() call. The array is cut into
+ * `chunks` equal spans, which are both the initial sorted runs and the
+ * per-worker output spans of every merge round.
+ */
+typedef struct {
+    int *arr;
+    int *aux;
+    size_t n;
+    size_t chunks;
+    const int *src;  // Current merge round: runs of `width` chunks in src
+    int *dst;
+    size_t width;
+} parallel_merge_ctx;
+
+static size_t chunk_bound(const parallel_merge_ctx *m, size_t chunk) {
+    return chunk >= m->chunks ? m->n : m->n * chunk / m->chunks;
+}
+
+static void chunk_sort_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                            unsigned depth) {
+    parallel_merge_ctx *m = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    size_t lo = chunk_bound(m, begin);
+    size_t hi = chunk_bound(m, begin + 1);
+    int *sorted = bottomup_passes(m->arr + lo, m->aux + lo, hi - lo);
+    if (sorted != m->arr + lo) {
+        memcpy(m->arr + lo, sorted, (hi - lo) * sizeof(int));
+    }
+}
+
+/**
+ * Produce output span `begin` of the current round: for every run pair
+ * overlapping it, co-rank both span ends and merge just that slice
+ */
+static void merge_round_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                             unsigned depth) {
+    parallel_merge_ctx *m = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    size_t out_lo = chunk_bound(m, begin);
+    size_t out_hi = chunk_bound(m, begin + 1);
+    size_t pair = begin - begin % (2 * m->width);
+
+    for (; pair < m->chunks && chunk_bound(m, pair) < out_hi; pair += 2 * m->width) {
+        size_t lo = chunk_bound(m, pair);
+        size_t mid = chunk_bound(m, pair + m->width);
+        size_t hi = chunk_bound(m, pair + 2 * m->width);
+        const int *a = m->src + lo;
+        const int *b = m->src + mid;
+        size_t na = mid - lo;
+        size_t nb = hi - mid;
+
+        size_t k0 = (out_lo > lo ? out_lo : lo) - lo;
+        size_t k1 = (out_hi < hi ? out_hi : hi) - lo;
+        size_t i0 = co_rank(k0, a, na, b, nb);
+        size_t i1 = co_rank(k1, a, na, b, nb);
+        sortnet_merge(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0),
+                      m->dst + lo + k0);
+    }
+}
+
+static void copy_back_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                           unsigned depth) {
+    parallel_merge_ctx *m = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    size_t lo = chunk_bound(m, begin);
+    size_t hi = chunk_bound(m, begin + 1);
+    memcpy(m->arr + lo, m->aux + lo, (hi - lo) * sizeof(int));
+}
+
+/**
+ * Stable parallel merge sort.
+ *
+ * Each of `threads` workers (<= 0: one per online CPU) bottom-up sorts
+ * one equal chunk, then ceil(log2(threads)) rounds merge pairs of runs
+ * between arr and one auxiliary buffer. Within a round every worker
+ * writes an equal slice of the output, located by merge-path co-ranking,
+ * so the last merges are split as evenly as the first. The buffer is the
+ * shared pool's scratch (task_pool_scratch()), interleaved over the NUMA
+ * nodes on huge pages as any worker may merge any slice, so repeated
+ * sorts reuse both threads and memory. Small inputs and threads == 1 use
+ * mergesort_bottomup(). Returns 0 on success, -1 if memory or threads are
+ * unavailable (arr is then unchanged).
+ */
+int mergesort_parallel(int arr[], int size, int threads) {
+    if (threads <= 0) {
+        threads = task_pool_cpu_count();
+    }
+    if (threads == 1 || size <= MERGESORT_PARALLEL_THRESHOLD) {
+        return mergesort_bottomup(arr, size);
+    }
+
+    parallel_merge_ctx m = {arr, NULL, (size_t)size, (size_t)threads, NULL, NULL, 0};
+    task_pool *pool = task_pool_acquire(threads);
+    m.aux = pool != NULL ? task_pool_scratch(pool, m.n * sizeof(int)) : NULL;
+    if (m.aux == NULL) {
+        task_pool_release(pool);
+        return -1;
+    }
+
+    task_pool_parallel_for(pool, chunk_sort_task, &m, m.chunks);
+
+    m.src = arr;
+    m.dst = m.aux;
+    for (m.width = 1; m.width < m.chunks; m.width *= 2) {
+        task_pool_parallel_for(pool, merge_round_task, &m, m.chunks);
+        int *next_dst = (int *)m.src;
+        m.src = m.dst;
+        m.dst = next_dst;
+    }
+
+    if (m.src != arr) {
+        task_pool_parallel_for(pool, copy_back_task, &m, m.chunks);
+    }
+
+    task_pool_release(pool);
+    return 0;
+}
+
+/**
+ * Number of leading elements of a[0..n) that are <= key, by exponential
+ * then binary search (O(log k) for an answer k)
+ */
+static size_t gallop_right(int key, const int a[], size_t n) {
+    size_t lo = 0;
+    size_t hi = 1;
+    while (hi <= n && a[hi - 1] <= key) {
+        lo = hi;
+        hi = 2 * hi + 1;
+    }
+    if (hi > n) {
+        hi = n;
+    }
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (a[mid] <= key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Number of leading elements of a[0..n) that are < key
+ */
+static size_t gallop_left(int key, const int a[], size_t n) {
+    size_t lo = 0;
+    size_t hi = 1;
+    while (hi <= n && a[hi - 1] < key) {
+        lo = hi;
+        hi = 2 * hi + 1;
+    }
+    if (hi > n) {
+        hi = n;
+    }
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (a[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Merge arr[lo..mid) and arr[mid..hi) front to back, with the (shorter)
+ * left run copied to tmp. After ADAPTIVE_MIN_GALLOP consecutive wins by
+ * one side, whole blocks are located by galloping and moved at once.
+ */
+static void merge_lo(int arr[], size_t lo, size_t mid, size_t hi, int tmp[]) {
+    size_t na = mid - lo;
+    memcpy(tmp, arr + lo, na * sizeof(int));
+
+    size_t i = 0;
+    size_t j = mid;
+    size_t k = lo;
+
+    while (i < na && j < hi) {
+        size_t a_wins = 0;
+        size_t b_wins = 0;
+        while (i < na && j < hi && a_wins < ADAPTIVE_MIN_GALLOP && b_wins < ADAPTIVE_MIN_GALLOP) {
+            if (arr[j] < tmp[i]) {
+                arr[k++] = arr[j++];
+                b_wins++;
+                a_wins = 0;
+            } else {
+                arr[k++] = tmp[i++];
+                a_wins++;
+                b_wins = 0;
+            }
+        }
+
+        while (i < na && j < hi) {
+            size_t run_a = gallop_right(arr[j], tmp + i, na - i);
+            memcpy(arr + k, tmp + i, run_a * sizeof(int));
+            i += run_a;
+            k += run_a;
+            if (i == na) {
+                break;
+            }
+
+            size_t run_b = gallop_left(tmp[i], arr + j, hi - j);
+            memmove(arr + k, arr + j, run_b * sizeof(int));
+            j += run_b;
+            k += run_b;
+
+            if (run_a < ADAPTIVE_MIN_GALLOP && run_b < ADAPTIVE_MIN_GALLOP) {
+                break;
+            }
+        }
+    }
+
+    // Whatever is left of the right run is already in place
+    memcpy(arr + k, tmp + i, (na - i) * sizeof(int));
+}
+
+/**
+ * Mirror of merge_lo(): the (shorter) right run goes to tmp and the merge
+ * runs back to front
+ */
+static void merge_hi(int arr[], size_t lo, size_t mid, size_t hi, int tmp[]) {
+    size_t nb = hi - mid;
+    memcpy(tmp, arr + mid, nb * sizeof(int));
+
+    size_t i = mid;
+    size_t j = nb;
+    size_t k = hi;
+
+    while (i > lo && j > 0) {
+        size_t a_wins = 0;
+        size_t b_wins = 0;
+        while (i > lo && j > 0 && a_wins < ADAPTIVE_MIN_GALLOP && b_wins < ADAPTIVE_MIN_GALLOP) {
+            if (tmp[j - 1] < arr[i - 1]) {
+                arr[--k] = arr[--i];
+                a_wins++;
+                b_wins = 0;
+            } else {
+                arr[--k] = tmp[--j];
+                b_wins++;
+                a_wins = 0;
+            }
+        }
+
+        while (i > lo && j > 0) {
+            size_t run_a = (i - lo) - gallop_right(tmp[j - 1], arr + lo, i - lo);
+            k -= run_a;
+            i -= run_a;
+            memmove(arr + k, arr + i, run_a * sizeof(int));
+            if (i == lo) {
+                break;
+            }
+
+            size_t run_b = j - gallop_left(arr[i - 1], tmp, j);
+            k -= run_b;
+            j -= run_b;
+            memcpy(arr + k, tmp + j, run_b * sizeof(int));
+
+            if (run_a < ADAPTIVE_MIN_GALLOP && run_b < ADAPTIVE_MIN_GALLOP) {
+                break;
+            }
+        }
+    }
+
+    // Whatever is left of the left run is already in place
+    memcpy(arr + lo, tmp, j * sizeof(int));
+}
+
+/**
+ * Merge adjacent sorted runs arr[lo..mid) and arr[mid..hi). Elements
+ * already in their final place at either end are skipped by galloping,
+ * so runs that do not overlap cost O(log n).
+ */
+static void merge_runs(int arr[], size_t lo, size_t mid, size_t hi, int tmp[]) {
+    lo += gallop_right(arr[mid], arr + lo, mid - lo);
+    if (lo == mid) {
+        return;
+    }
+    hi = mid + gallop_left(arr[mid - 1], arr + mid, hi - mid);
+
+    if (mid - lo <= hi - mid) {
+        merge_lo(arr, lo, mid, hi, tmp);
+    } else {
+        merge_hi(arr, lo, mid, hi, tmp);
+    }
+}
+
+/**
+ * Length of the natural run starting at arr[lo]; strictly descending runs
+ * are reversed in place (strictness keeps the sort stable)
+ */
+static size_t natural_run(int arr[], size_t lo, size_t n) {
+    size_t hi = lo + 1;
+    if (hi == n) {
+        return 1;
+    }
+
+    if (arr[hi] < arr[lo]) {
+        while (hi + 1 < n && arr[hi + 1] < arr[hi]) {
+            hi++;
+        }
+        for (size_t a = lo, b = hi; a < b; a++, b--) {
+            int temp = arr[a];
+            arr[a] = arr[b];
+            arr[b] = temp;
+        }
+    } else {
+        while (hi + 1 < n && arr[hi + 1] >= arr[hi]) {
+            hi++;
+        }
+    }
+    return hi - lo + 1;
+}
+
+/**
+ * Powersort node power of the boundary between runs [s1, s1 + n1) and
+ * [s1 + n1, s1 + n1 + n2): the depth at which the boundary would sit in a
+ * perfectly balanced merge tree over [0, n)
+ */
+static int node_power(size_t s1, size_t n1, size_t n2, size_t n) {
+    size_t a = 2 * s1 + n1;  // 2 * midpoint of the left run
+    size_t b = a + n1 + n2;  // 2 * midpoint of the right run
+    int power = 0;
+
+    for (;;) {
+        power++;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+typedef struct {
+    size_t start;
+    size_t length;
+    int power;  // Power of the boundary with the next run on the stack
+} natural_run_entry;
+
+/**
+ * Adaptive natural merge sort with the powersort merge policy
+ * (Munro & Wild, ESA 2018).
+ *
+ * Existing ascending and descending runs are used as they are (short ones
+ * are extended to ADAPTIVE_MIN_RUN by insertion sort), and adjacent runs
+ * are merged in the order given by their node powers, which is within
+ * O(n) of the optimal merge cost. Merges gallop. Sorted input takes one
+ * linear scan, and k runs cost O(n log k). Stable. Returns 0 on success,
+ * -1 if the n/2 merge buffer cannot be allocated (arr is then unchanged).
+ */
+int mergesort_adaptive(int arr[], int size) {
+    if (size <= 1) {
+        return 0;
+    }
+
+    size_t n = (size_t)size;
+    int *tmp = malloc((n / 2 + 1) * sizeof(int));
+    if (tmp == NULL) {
+        return -1;
+    }
+
+    // Powers strictly increase up the stack, so its height is <= log2(n) + 1
+    natural_run_entry stack[sizeof(size_t) * 8 + 1];
+    int height = 0;
+
+    for (size_t lo = 0; lo < n;) {
+        size_t length = natural_run(arr, lo, n);
+        if (length < ADAPTIVE_MIN_RUN) {
+            size_t forced = n - lo < ADAPTIVE_MIN_RUN ? n - lo : ADAPTIVE_MIN_RUN;
+            insertion_sort_run(arr, lo, lo + forced);
+            length = forced;
+        }
+
+        if (height > 0) {
+            natural_run_entry *top = &stack[height - 1];
+            int power = node_power(top->start, top->length, length, n);
+
+            while (height > 1 && stack[height - 2].power > power) {
+                natural_run_entry *left = &stack[height - 2];
+                natural_run_entry *right = &stack[height - 1];
+                merge_runs(arr, left->start, right->start, right->start + right->length, tmp);
+                left->length += right->length;
+                height--;
+            }
+            stack[height - 1].power = power;
+        }
+
+        stack[height].start = lo;
+        stack[height].length = length;
+        stack[height].power = 0;
+        height++;
+        lo += length;
+    }
+
+    while (height > 1) {
+        natural_run_entry *left = &stack[height - 2];
+        natural_run_entry *right = &stack[height - 1];
+        merge_runs(arr, left->start, right->start, right->start + right->length, tmp);
+        left->length += right->length;
+        height--;
+    }
+
+    free(tmp);
+    return 0;
+}
+
+#ifndef ROSETTA_NO_MAIN
+
 /**
  * Check if array is sorted
  */
@@ -124,6 +671,81 @@ void print_array(const int arr[], int size) {
     printf("]\n");
 }
 
+/**
+ * Scratch file path for external_sort() tests and benchmarks
+ */
+static void scratch_path(char *path, size_t len, const char *name) {
+    const char *dir = getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp";
+    snprintf(path, len, "%s/%s", dir, name);
+}
+
+static int write_file(const char *path, const void *data, size_t bytes) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return -1;
+    }
+    int ok = fwrite(data, 1, bytes, f) == bytes;
+    return fclose(f) == 0 && ok ? 0 : -1;
+}
+
+static int read_file(const char *path, void *data, size_t bytes) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return -1;
+    }
+    int ok = fread(data, 1, bytes, f) == bytes && fgetc(f) == EOF;
+    fclose(f);
+    return ok ? 0 : -1;
+}
+
+static int compare_i32(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_i64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * external_sort() of n keys of key_bytes under a memory budget, checked
+ * against qsort(); returns the stats of the run
+ */
+static external_sort_stats check_external(const void *keys, size_t n, int key_bytes,
+                                          size_t memory, int direct_io) {
+    char in_path[1024];
+    char out_path[1024];
+    scratch_path(in_path, sizeof(in_path), "mergesort-test-in.bin");
+    scratch_path(out_path, sizeof(out_path), "mergesort-test-out.bin");
+
+    size_t bytes = n * (size_t)key_bytes;
+    char *expected = malloc(bytes + 1);
+    char *actual = malloc(bytes + 1);
+    assert(expected != NULL && actual != NULL);
+    memcpy(expected, keys, bytes);
+    qsort(expected, n, (size_t)key_bytes, key_bytes == 4 ? compare_i32 : compare_i64);
+    assert(write_file(in_path, keys, bytes) == 0);
+
+    external_sort_config config = external_sort_default_config();
+    config.memory_bytes = memory;
+    config.key_bytes = key_bytes;
+    config.direct_io = direct_io;
+    external_sort_stats stats;
+    assert(external_sort(in_path, out_path, &config, &stats) == 0);
+    assert(read_file(out_path, actual, bytes) == 0);
+    assert(memcmp(expected, actual, bytes) == 0);
+    assert(stats.keys == n);
+
+    remove(in_path);
+    remove(out_path);
+    free(expected);
+    free(actual);
+    return stats;
+}
+
 /**
  * Run test suite
  */
@@ -174,9 +796,492 @@ void run_tests(void) {
     assert(is_sorted(arr7, size7));
     assert(arr7[0] == 1 && arr7[1] == 1);
 
+    // Test 8: Bottom-up variant matches the reference mergesort(),
+    // including sizes straddling the leaf run length and odd pass counts
+    static const int cross_sizes[] = {0, 1, 2, 31, 32, 33, 64, 65, 100, 1000, 4097};
+    for (size_t t = 0; t < sizeof(cross_sizes) / sizeof(cross_sizes[0]); t++) {
+        int size = cross_sizes[t];
+        int *expected = malloc((size + 1) * sizeof(int));
+        int *actual = malloc((size + 1) * sizeof(int));
+        assert(expected != NULL && actual != NULL);
+
+        bench_fill_random(expected, size, 7 + t, 50);
+        memcpy(actual, expected, size * sizeof(int));
+        mergesort(expected, size);
+        assert(mergesort_bottomup(actual, size) == 0);
+        assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+
+        free(expected);
+        free(actual);
+    }
+
+    // Test 9: Parallel variant matches the reference at awkward thread
+    // counts, with heavy duplication to exercise the co-rank tie rule
+    static const int par_sizes[] = {40000, 100003};
+    static const int par_threads[] = {2, 3, 4, 7, 8};
+    for (size_t t = 0; t < sizeof(par_sizes) / sizeof(par_sizes[0]); t++) {
+        int size = par_sizes[t];
+        int *expected = malloc(size * sizeof(int));
+        int *actual = malloc(size * sizeof(int));
+        assert(expected != NULL && actual != NULL);
+
+        for (size_t p = 0; p < sizeof(par_threads) / sizeof(par_threads[0]); p++) {
+            bench_fill_random(expected, size, 11 + p, p % 2 ? 100 : 0);
+            memcpy(actual, expected, size * sizeof(int));
+            assert(mergesort_bottomup(expected, size) == 0);
+            assert(mergesort_parallel(actual, size, par_threads[p]) == 0);
+            assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+        }
+
+        free(expected);
+        free(actual);
+    }
+
+    // The shared pool and its scratch outlive a call: the next one of the
+    // same size gets both back, a concurrent one a pool of its own
+    task_pool *shared = task_pool_acquire(3);
+    assert(shared != NULL && task_pool_scratch(shared, 1 << 20) != NULL);
+    void *scratch = task_pool_scratch(shared, 4096);
+    task_pool *second = task_pool_acquire(3);
+    assert(second != NULL && second != shared);
+    task_pool_release(second);
+    task_pool_release(shared);
+    assert(task_pool_acquire(3) == shared && task_pool_scratch(shared, 1 << 20) == scratch);
+    task_pool_release(shared);
+
+    // Test 10: Adaptive variant matches the reference on presorted shapes
+    static const int adaptive_sizes[] = {0, 1, 2, 31, 33, 100, 1000, 50000};
+    for (size_t t = 0; t < sizeof(adaptive_sizes) / sizeof(adaptive_sizes[0]); t++) {
+        int size = adaptive_sizes[t];
+        int *expected = malloc((size + 1) * sizeof(int));
+        int *actual = malloc((size + 1) * sizeof(int));
+        assert(expected != NULL && actual != NULL);
+
+        for (int shape = 0; shape < 6; shape++) {
+            switch (shape) {
+            case 0: bench_fill_random(expected, size, 3 + t, 10); break;
+            case 1: bench_fill_sorted_fraction(expected, size, 3 + t, 1.0); break;
+            case 2: bench_fill_reversed_blocks(expected, size, size); break;
+            case 3: bench_fill_sorted_fraction(expected, size, 3 + t, 0.9); break;
+            case 4: bench_fill_runs(expected, size, 3 + t, 7); break;
+            default: bench_fill_reversed_blocks(expected, size, 100); break;
+            }
+            memcpy(actual, expected, size * sizeof(int));
+            mergesort(expected, size);
+            assert(mergesort_adaptive(actual, size) == 0);
+            assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+        }
+
+        free(expected);
+        free(actual);
+    }
+
+    // Test 11: External sort against qsort(): a 64 KiB budget forces
+    // many runs and several merge passes (fan-in 3), buffered and O_DIRECT
+    {
+        const size_t n = 300000;
+        int32_t *keys32 = malloc(n * sizeof(int32_t));
+        int64_t *keys64 = malloc(n * sizeof(int64_t));
+        assert(keys32 != NULL && keys64 != NULL);
+        bench_fill_random((int *)keys32, (int)n, 19, 0);
+        for (size_t i = 0; i < n; i++) {
+            keys64[i] = (int64_t)keys32[i] * 4096 + (int64_t)(i % 3);
+        }
+        keys64[0] = INT64_MIN;
+        keys64[1] = INT64_MAX;
+        keys64[2] = INT64_MIN;
+
+        for (int direct = 0; direct < 2; direct++) {
+            external_sort_stats stats = check_external(keys32, n, 4, 64 << 10, direct);
+            assert(stats.runs > 3 && stats.passes > 2 && stats.fan_in == 3);
+            stats = check_external(keys64, n, 8, 1 << 20, direct);
+            assert(stats.runs > 1);
+        }
+
+        // One chunk: sorted in memory straight into the output; small
+        // remainder run; no keys at all
+        external_sort_stats stats = check_external(keys32, 1000, 4, 64 << 10, 0);
+        assert(stats.runs == 1 && stats.passes == 1);
+        check_external(keys32, 16384 + 7, 4, 256 << 10, 1);
+        stats = check_external(keys32, 0, 4, 64 << 10, 0);
+        assert(stats.runs == 0);
+
+        // A size that is not a whole number of keys is rejected
+        char in_path[1024];
+        char out_path[1024];
+        scratch_path(in_path, sizeof(in_path), "mergesort-test-in.bin");
+        scratch_path(out_path, sizeof(out_path), "mergesort-test-out.bin");
+        assert(write_file(in_path, keys32, 10) == 0);
+        external_sort_config config = external_sort_default_config();
+        assert(external_sort(in_path, out_path, &config, &stats) == -1);
+
+        // Sorting a file onto itself is refused before the output is
+        // truncated, so the input survives
+        int keys4[4] = {4, 3, 2, 1};
+        assert(write_file(in_path, keys4, sizeof(keys4)) == 0);
+        assert(external_sort(in_path, in_path, &config, &stats) == -1 && errno == EINVAL);
+        struct stat st;
+        assert(stat(in_path, &st) == 0 && (size_t)st.st_size == sizeof(keys4));
+        remove(in_path);
+        remove(out_path);
+
+        free(keys32);
+        free(keys64);
+    }
+
+    // Test 12: int_io text and binary round trips, including values
+    // whose text straddles the 1 MiB read() blocks, and parse errors
+    {
+        const size_t n = 400000;
+        int *values = malloc(n * sizeof(int));
+        assert(values != NULL);
+        bench_fill_random(values, (int)n, 23, 0);
+        for (size_t i = 0; i < n; i += 7) {
+            values[i] = -values[i];
+        }
+        values[0] = INT_MIN;
+        values[1] = INT_MAX;
+        values[2] = 0;
+
+        char path[1024];
+        scratch_path(path, sizeof(path), "mergesort-test-io.txt");
+        for (int format = INT_IO_TEXT; format <= INT_IO_BINARY; format++) {
+            int *back = NULL;
+            size_t count = 0;
+            assert(int_io_write(path, (int_io_format)format, values, n) == 0);
+            assert(int_io_read(path, (int_io_format)format, &back, &count) == 0);
+            assert(count == n && memcmp(back, values, n * sizeof(int)) == 0);
+            free(back);
+        }
+        assert(int_io_checksum(values, n) != int_io_checksum(values + 1, n - 1));
+
+        static const char *const good = " 12\t-7\r\n+3\n\n-2147483648 2147483647";
+        static const int good_values[] = {12, -7, 3, INT_MIN, INT_MAX};
+        int *back = NULL;
+        size_t count = 0;
+        assert(write_file(path, good, strlen(good)) == 0);
+        assert(int_io_read(path, INT_IO_TEXT, &back, &count) == 0);
+        assert(count == 5 && memcmp(back, good_values, sizeof(good_values)) == 0);
+        free(back);
+
+        static const char *const bad[] = {
+            "1 2x 3", "2147483648", "-2147483649", "- 4", "99999999999999999999",
+        };
+        for (size_t b = 0; b < sizeof(bad) / sizeof(bad[0]); b++) {
+            assert(write_file(path, bad[b], strlen(bad[b])) == 0);
+            assert(int_io_read(path, INT_IO_TEXT, &back, &count) == -1);
+        }
+        assert(write_file(path, values, 6) == 0);
+        assert(int_io_read(path, INT_IO_BINARY, &back, &count) == -1);
+
+        remove(path);
+        free(values);
+    }
+
     printf("✓ All tests passed\n");
 }
 
+/**
+ * Benchmark context: pristine input plus a scratch copy restored before each run
+ */
+typedef struct {
+    const int *input;
+    int *work;
+    int size;
+    int threads;  // mergesort_parallel() only
+} sort_bench_ctx;
+
+static void restore_input(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    memcpy(c->work, c->input, c->size * sizeof(int));
+}
+
+static void bench_mergesort(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    mergesort(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_mergesort_bottomup(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    mergesort_bottomup(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_mergesort_adaptive(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    mergesort_adaptive(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_mergesort_parallel(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    mergesort_parallel(c->work, c->size, c->threads);
+    bench_escape(c->work);
+}
+
+/**
+ * Run benchmark suite on deterministic random input
+ */
+int run_benchmarks(void) {
+    printf("Running Merge Sort benchmarks...\n");
+
+    static const int sizes[] = {1000, 10000, 100000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/003-mergesort");
+    for (int s = 0; s < num_sizes; s++) {
+        int size = sizes[s];
+        int *input = malloc(size * sizeof(int));
+        int *work = malloc(size * sizeof(int));
+
+        if (input == NULL || work == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(input);
+            free(work);
+            return 1;
+        }
+
+        bench_fill_random(input, size, 42, size);
+        sort_bench_ctx ctx = {input, work, size, 0};
+
+        snprintf(name, sizeof(name), "mergesort/n=%d", size);
+        bench_measure(name, bench_mergesort, restore_input, &ctx);
+        snprintf(name, sizeof(name), "mergesort_bottomup/n=%d", size);
+        bench_measure(name, bench_mergesort_bottomup, restore_input, &ctx);
+        snprintf(name, sizeof(name), "mergesort_parallel/n=%d", size);
+        bench_measure(name, bench_mergesort_parallel, restore_input, &ctx);
+        snprintf(name, sizeof(name), "mergesort_adaptive/n=%d", size);
+        bench_measure(name, bench_mergesort_adaptive, restore_input, &ctx);
+
+        free(input);
+        free(work);
+    }
+
+    // Presorted inputs: where run detection and galloping pay off
+    const int size = 100000;
+    int *input = malloc(size * sizeof(int));
+    int *work = malloc(size * sizeof(int));
+    if (input == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(input);
+        free(work);
+        return 1;
+    }
+
+    static const char *const shapes[] = {
+        "sorted", "sorted_99pct", "sorted_90pct", "runs_4", "runs_64", "reversed_blocks_1000",
+    };
+    sort_bench_ctx ctx = {input, work, size, 0};
+    for (int shape = 0; shape < 6; shape++) {
+        switch (shape) {
+        case 0: bench_fill_sorted_fraction(input, size, 42, 1.0); break;
+        case 1: bench_fill_sorted_fraction(input, size, 42, 0.99); break;
+        case 2: bench_fill_sorted_fraction(input, size, 42, 0.9); break;
+        case 3: bench_fill_runs(input, size, 42, 4); break;
+        case 4: bench_fill_runs(input, size, 42, 64); break;
+        default: bench_fill_reversed_blocks(input, size, 1000); break;
+        }
+
+        snprintf(name, sizeof(name), "mergesort/%s", shapes[shape]);
+        bench_measure(name, bench_mergesort, restore_input, &ctx);
+        snprintf(name, sizeof(name), "mergesort_bottomup/%s", shapes[shape]);
+        bench_measure(name, bench_mergesort_bottomup, restore_input, &ctx);
+        snprintf(name, sizeof(name), "mergesort_adaptive/%s", shapes[shape]);
+        bench_measure(name, bench_mergesort_adaptive, restore_input, &ctx);
+    }
+
+    free(input);
+    free(work);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * Thread sweep of mergesort_parallel() (1, 2, 4, ... max_threads) against
+ * the sequential mergesort_bottomup() and reference mergesort() at one
+ * size; multi-threaded points also run with workers pinned in NUMA node
+ * blocks (see quicksort's scaling table)
+ */
+int run_scaling(int max_threads, int size) {
+    printf("Merge Sort scaling (n=%d, up to %d threads):\n", size, max_threads);
+    topology_report(stdout);
+
+    size_t bytes = (size_t)size * sizeof(int);
+    int *input = malloc(bytes);
+    int *work = topology_alloc(bytes, TOPOLOGY_BLOCKED | TOPOLOGY_HUGE_PAGES);
+    if (input == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(input);
+        topology_free(work, bytes);
+        return 1;
+    }
+
+    bench_fill_random(input, size, 42, 0);
+    sort_bench_ctx ctx = {input, work, size, 1};
+    bench_config config = bench_default_config();
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/003-mergesort");
+
+    snprintf(name, sizeof(name), "mergesort/n=%d", size);
+    bench_run(name, bench_mergesort, restore_input, &ctx, &config, &result);
+    bench_report(&result);
+    double reference_ns = result.median_ns;
+
+    snprintf(name, sizeof(name), "mergesort_bottomup/n=%d", size);
+    bench_run(name, bench_mergesort_bottomup, restore_input, &ctx, &config, &result);
+    bench_report(&result);
+    double sequential_ns = result.median_ns;
+
+    task_pool_set_default_affinity(TASK_POOL_AFFINITY_NONE);
+    for (int threads = 1;; threads *= 2) {
+        if (threads > max_threads) {
+            threads = max_threads;
+        }
+        ctx.threads = threads;
+
+        snprintf(name, sizeof(name), "mergesort_parallel/n=%d/t=%d", size, threads);
+        bench_run(name, bench_mergesort_parallel, restore_input, &ctx, &config, &result);
+        bench_record(&result);
+
+        double unpinned_ns = result.median_ns;
+        double speedup = sequential_ns / unpinned_ns;
+        printf("  threads=%-3d median %12.1f ns  speedup %5.2fx (vs mergesort %5.2fx)"
+               "  efficiency %5.1f%%",
+               threads, unpinned_ns, speedup, reference_ns / unpinned_ns,
+               100.0 * speedup / threads);
+
+        if (threads > 1) {
+            task_pool_set_default_affinity(TASK_POOL_AFFINITY_PINNED);
+            snprintf(name, sizeof(name), "mergesort_parallel/n=%d/t=%d/pinned", size, threads);
+            bench_run(name, bench_mergesort_parallel, restore_input, &ctx, &config, &result);
+            bench_record(&result);
+            printf("  pinned %12.1f ns (%5.2fx)", result.median_ns, unpinned_ns / result.median_ns);
+            task_pool_set_default_affinity(TASK_POOL_AFFINITY_NONE);
+        }
+        printf("\n");
+
+        if (threads == max_threads) {
+            break;
+        }
+    }
+    task_pool_set_default_affinity(TASK_POOL_AFFINITY_AUTO);
+
+    free(input);
+    topology_free(work, bytes);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * External sort of a generated random file of size_mb MiB under a
+ * budget_mb MiB buffer budget; reports throughput and the pass structure,
+ * then streams the output back to check it is sorted
+ */
+int run_external(int size_mb, int budget_mb, int key_bytes, int direct_io) {
+    char in_path[1024];
+    char out_path[1024];
+    scratch_path(in_path, sizeof(in_path), "mergesort-external-in.bin");
+    scratch_path(out_path, sizeof(out_path), "mergesort-external-out.bin");
+    printf("External sort: %d MiB of int%d keys, %d MiB budget, %s I/O (%s)\n", size_mb,
+           key_bytes * 8, budget_mb, direct_io ? "O_DIRECT" : "buffered", in_path);
+
+    // Generate the input one 1 MiB block at a time
+    const size_t block = 1 << 20;
+    int *keys = malloc(block);
+    FILE *f = fopen(in_path, "wb");
+    if (keys == NULL || f == NULL) {
+        fprintf(stderr, "Error: Cannot create %s\n", in_path);
+        free(keys);
+        if (f != NULL) {
+            fclose(f);
+        }
+        return 1;
+    }
+    int written = 1;
+    for (int b = 0; b < size_mb && written; b++) {
+        bench_fill_random(keys, (int)(block / sizeof(int)), 42 + (unsigned)b, 0);
+        written = fwrite(keys, 1, block, f) == block;
+    }
+    if (fclose(f) != 0 || !written) {
+        fprintf(stderr, "Error: Cannot write %s\n", in_path);
+        free(keys);
+        remove(in_path);
+        return 1;
+    }
+
+    bench_begin("algorithms/003-mergesort");
+    external_sort_config config = external_sort_default_config();
+    config.memory_bytes = (size_t)budget_mb << 20;
+    config.key_bytes = key_bytes;
+    config.direct_io = direct_io;
+    external_sort_stats stats;
+    int status = external_sort(in_path, out_path, &config, &stats);
+    remove(in_path);
+    if (status != 0) {
+        perror("external_sort");
+        free(keys);
+        remove(out_path);
+        bench_end();
+        return 1;
+    }
+
+    double gib = (double)size_mb / 1024.0;
+    printf("  %s backend, O_DIRECT %s, %llu runs, fan-in %d, %d passes\n", stats.io_backend,
+           stats.direct_io ? "granted" : "off", (unsigned long long)stats.runs, stats.fan_in,
+           stats.passes);
+    printf("  run formation %7.3f s   merge %7.3f s   total %7.3f s   %6.3f GiB/s sorted\n",
+           stats.run_seconds, stats.merge_seconds, stats.total_seconds,
+           gib / stats.total_seconds);
+    printf("  I/O: %.2f GiB read, %.2f GiB written, %.3f GiB/s combined\n",
+           (double)stats.bytes_read / (1 << 30), (double)stats.bytes_written / (1 << 30),
+           (double)(stats.bytes_read + stats.bytes_written) / (1 << 30) / stats.total_seconds);
+
+    // Stream the output back: sorted, and nothing lost
+    int sorted = 1;
+    uint64_t count = 0;
+    int64_t previous = INT64_MIN;
+    f = fopen(out_path, "rb");
+    size_t got;
+    while (f != NULL && sorted && (got = fread(keys, 1, block, f)) > 0) {
+        for (size_t i = 0; i + (size_t)key_bytes <= got; i += (size_t)key_bytes) {
+            int64_t key = 0;
+            if (key_bytes == 4) {
+                int32_t narrow;
+                memcpy(&narrow, (char *)keys + i, sizeof(narrow));
+                key = narrow;
+            } else {
+                memcpy(&key, (char *)keys + i, sizeof(key));
+            }
+            sorted &= key >= previous;
+            previous = key;
+            count++;
+        }
+    }
+    if (f != NULL) {
+        fclose(f);
+    }
+    remove(out_path);
+    free(keys);
+
+    if (!sorted || count != stats.keys) {
+        fprintf(stderr, "Error: Output is not a sorted permutation\n");
+        bench_end();
+        return 1;
+    }
+    printf("  verified: %llu keys in order\n", (unsigned long long)count);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * mergesort() for int_io_run_sort()
+ */
+static int sort_stream(int arr[], int size) {
+    mergesort(arr, size);
+    return 0;
+}
+
 /**
  * Main entry point
  */
@@ -187,10 +1292,52 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // If "benchmark" argument, run benchmarks
+    if (argc == 2 && strcmp(argv[1], "benchmark") == 0) {
+        return run_benchmarks();
+    }
+
+    // "scaling [max_threads] [size]": parallel thread sweep
+    if (argc >= 2 && argc <= 4 && strcmp(argv[1], "scaling") == 0) {
+        int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+        int size = argc > 3 ? atoi(argv[3]) : 1000000;
+        if (max_threads < 1 || size < 1) {
+            fprintf(stderr, "Error: Invalid scaling arguments\n");
+            return 1;
+        }
+        return run_scaling(max_threads, size);
+    }
+
+    // "external [size_mb] [budget_mb] [key_bytes] [direct]": out-of-core sort
+    if (argc >= 2 && argc <= 6 && strcmp(argv[1], "external") == 0) {
+        int size_mb = argc > 2 ? atoi(argv[2]) : 1024;
+        int budget_mb = argc > 3 ? atoi(argv[3]) : 64;
+        int key_bytes = argc > 4 ? atoi(argv[4]) : 4;
+        int direct_io = argc > 5 ? atoi(argv[5]) : 0;
+        if (size_mb < 1 || budget_mb < 1 || (key_bytes != 4 && key_bytes != 8)) {
+            fprintf(stderr, "Error: Invalid external arguments\n");
+            return 1;
+        }
+        return run_external(size_mb, budget_mb, key_bytes, direct_io);
+    }
+
+    // "sort [options]": bulk input / output through int_io.h
+    if (argc >= 2 && strcmp(argv[1], "sort") == 0) {
+        int_io_options options;
+        if (int_io_parse_args(argc, argv, 2, 0, &options) != 0) {
+            return 1;
+        }
+        return int_io_run_sort(&options, "mergesort", sort_stream);
+    }
+
     // Otherwise, parse array from command line
     if (argc < 2) {
         printf("Usage: %s <num1> <num2> <num3> ...\n", argv[0]);
         printf("       %s test\n", argv[0]);
+        printf("       %s benchmark\n", argv[0]);
+        printf("       %s scaling [max_threads] [size]\n", argv[0]);
+        printf("       %s external [size_mb] [budget_mb] [key_bytes] [direct]\n", argv[0]);
+        printf("       %s sort " INT_IO_USAGE "\n", argv[0]);
         printf("\nExample: %s 64 34 25 12 22 11 90 88\n", argv[0]);
         return 1;
     }
@@ -219,3 +1366,5 @@ int main(int argc, char *argv[]) {
     free(arr);
     return 0;
 }
+
+#endif  // ROSETTA_NO_MAIN
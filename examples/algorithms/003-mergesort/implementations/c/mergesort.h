@@ -0,0 +1,44 @@
+/**
+ * Merge Sort Algorithms - Public Interface
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Other implementations link mergesort.c compiled with -DROSETTA_NO_MAIN,
+ * which drops the test/benchmark driver and keeps only the sorts.
+ */
+
+#ifndef ROSETTA_MERGESORT_H
+#define ROSETTA_MERGESORT_H
+
+/**
+ * Merge two sorted subarrays arr[left..mid] and arr[mid+1..right]
+ */
+void merge(int arr[], int left, int mid, int right);
+
+/**
+ * Top-down merge sort (reference)
+ */
+void mergesort_recursive(int arr[], int left, int right);
+void mergesort(int arr[], int size);
+
+/**
+ * Bottom-up merge sort over sorting-network runs with one auxiliary
+ * buffer. Returns 0, or -1 if the buffer cannot be allocated.
+ */
+int mergesort_bottomup(int arr[], int size);
+
+/**
+ * Stable parallel merge sort (threads <= 0: one per CPU). Returns 0, or
+ * -1 if memory or threads are unavailable (arr is then unchanged).
+ */
+int mergesort_parallel(int arr[], int size, int threads);
+
+/**
+ * Natural merge sort with the powersort merge policy: O(n) on sorted or
+ * reversed input, O(n log k) for k runs. Returns 0, or -1 if the merge
+ * buffer cannot be allocated (arr is then unchanged).
+ */
+int mergesort_adaptive(int arr[], int size);
+
+#endif  // ROSETTA_MERGESORT_H
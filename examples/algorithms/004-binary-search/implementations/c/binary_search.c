@@ -6,13 +6,49 @@
  *
  * Time Complexity: O(log n)
  * Space Complexity: O(1)
+ *
+ * Large arrays make every probe of the textbook loop a cache miss and a
+ * mispredicted branch. lower_bound_branchless() removes the branches;
+ * eytzinger_index and stree_index re-lay the keys so each level of the
+ * descent touches one predictable cache line.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
 #include <assert.h>
 #include <string.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "bench.h"
+#include "binary_search.h"
+#include "int_io.h"
+
+#define CACHE_LINE 64
+// ints per cache line: the Eytzinger descent prefetches node 16k, the
+// first of k's descendants four levels down
+#define LINE_INTS (CACHE_LINE / (int)sizeof(int))
+// lower_bound_branchless() stops prefetching once the window fits in L1,
+// where the extra loads only lengthen each step
+#define BRANCHLESS_PREFETCH_MIN 4096
+// binary_search_batch() keeps this many searches in flight: enough
+// misses to cover DRAM latency, few enough for the pointers to stay in L1
+#define BATCH_GROUP 16
+// ...and gallops through ascending targets when there are at least
+// 1 / BATCH_GALLOP_GAP of them per key; sparser ones gallop too far
+#define BATCH_GALLOP_GAP 1
+// interpolation_search() scans windows of at most this many keys, and
+// bisects after this many interpolation rounds
+#define INTERP_SCAN_MAX 32
+#define INTERP_MAX_ROUNDS 4
+// Radix table of the learned index: at most 2^this entries (1 MiB)
+#define LEARNED_RADIX_MAX_BITS 18
+
 /**
  * Binary search implementation
  * Returns index of target in sorted array, or -1 if not found
@@ -59,6 +95,573 @@ int binary_search_recursive(const int arr[], int size, int target) {
     return binary_search_recursive_helper(arr, 0, size - 1, target);
 }
 
+/**
+ * Branchless lower bound: halve the window with a masked add instead of
+ * a branch (a multiply or ?: compiles to imul or jumps), and while the
+ * window is large prefetch both possible next probes so a miss overlaps
+ * the current one
+ */
+int lower_bound_branchless(const int arr[], int size, int target) {
+    if (size <= 0) {
+        return 0;
+    }
+    const int *base = arr;
+    int len = size;
+    while (len > BRANCHLESS_PREFETCH_MIN) {
+        int half = len / 2;
+        len -= half;
+        __builtin_prefetch(&base[len / 2]);
+        __builtin_prefetch(&base[half + len / 2]);
+        base += half & -(base[half - 1] < target);
+    }
+    while (len > 1) {
+        int half = len / 2;
+        len -= half;
+        base += half & -(base[half - 1] < target);
+    }
+    return (int)(base - arr) + (*base < target);
+}
+
+int binary_search_branchless(const int arr[], int size, int target) {
+    int i = lower_bound_branchless(arr, size, target);
+    return i < size && arr[i] == target ? i : -1;
+}
+
+/**
+ * Branchless lower bound over arr[0..n) without prefetching (short
+ * windows of the sorted-targets path)
+ */
+static size_t lower_bound_window(const int arr[], size_t n, int target) {
+    if (n == 0) {
+        return 0;
+    }
+    const int *base = arr;
+    while (n > 1) {
+        size_t half = n / 2;
+        n -= half;
+        base += half & -(size_t)(base[half - 1] < target);
+    }
+    return (size_t)(base - arr) + (*base < target);
+}
+
+static int hit_or_miss(const int arr[], size_t n, size_t i, int target) {
+    return i < n && arr[i] == target ? (int)i : -1;
+}
+
+/**
+ * Up to BATCH_GROUP branchless searches of arr[from..n) in lockstep.
+ * Every search takes the same sequence of window lengths, so one step is
+ * a loop over the group; prefetching each search's next probe right
+ * after its step leaves the whole group's misses in flight together.
+ * Returns the lower bound of the last target.
+ */
+static size_t search_group(const int arr[], size_t n, size_t from, const int targets[],
+                           size_t count, int out[]) {
+    const int *base[BATCH_GROUP];
+    for (size_t g = 0; g < count; g++) {
+        base[g] = arr + from;
+    }
+    size_t len = n - from;
+    while (len > 1) {
+        size_t half = len / 2;
+        len -= half;
+        for (size_t g = 0; g < count; g++) {
+            base[g] += half & -(size_t)(base[g][half - 1] < targets[g]);
+            __builtin_prefetch(&base[g][len / 2]);  // Next probe (or its neighbour)
+        }
+    }
+    size_t i = from;
+    for (size_t g = 0; g < count; g++) {
+        i = from == n ? n : (size_t)(base[g] - arr) + (*base[g] < targets[g]);
+        out[g] = hit_or_miss(arr, n, i, targets[g]);
+    }
+    return i;
+}
+
+/**
+ * Dense ascending targets (a few keys apart): each answer is at or after
+ * the previous one, so gallop from there (1, 2, 4, ... keys ahead) and
+ * finish the bracketed window branchlessly
+ */
+static void search_gallop(const int arr[], size_t n, const int targets[], size_t m, int out[]) {
+    size_t lo = 0;
+    for (size_t j = 0; j < m; j++) {
+        int target = targets[j];
+        size_t step = 1;
+        while (lo + step <= n && arr[lo + step - 1] < target) {
+            step *= 2;
+        }
+        size_t from = lo + step / 2;  // arr[from - 1] < target
+        size_t to = lo + step < n ? lo + step : n;
+        lo = from + lower_bound_window(arr + from, to - from, target);
+        out[j] = hit_or_miss(arr, n, lo, target);
+    }
+}
+
+void binary_search_batch(const int *arr, size_t n, const int *targets, size_t m, int *out) {
+    if (n == 0) {
+        for (size_t j = 0; j < m; j++) {
+            out[j] = -1;
+        }
+        return;
+    }
+
+    size_t sorted = 1;
+    while (sorted < m && targets[sorted - 1] <= targets[sorted]) {
+        sorted++;
+    }
+    sorted = m > 0 && sorted >= m;
+    if (sorted && n / m <= BATCH_GALLOP_GAP) {
+        search_gallop(arr, n, targets, m, out);
+        return;
+    }
+
+    // Ascending targets narrow every group's window to start at the
+    // previous group's last answer
+    size_t from = 0;
+    for (size_t i = 0; i < m; i += BATCH_GROUP) {
+        size_t count = m - i < BATCH_GROUP ? m - i : BATCH_GROUP;
+        size_t last = search_group(arr, n, from, targets + i, count, out + i);
+        from = sorted ? last : 0;
+    }
+}
+
+/**
+ * Round an allocation of `count` ints up to whole cache lines
+ */
+static int *alloc_lines(size_t count) {
+    size_t bytes = (count * sizeof(int) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    return aligned_alloc(CACHE_LINE, bytes);
+}
+
+/**
+ * In-order walk of the implicit tree, handing out sorted keys
+ */
+static void eytzinger_fill(eytzinger_index *index, const int arr[], size_t k, int *next) {
+    if (k > (size_t)index->size) {
+        return;
+    }
+    eytzinger_fill(index, arr, 2 * k, next);
+    index->keys[k] = arr[*next];
+    index->ranks[k] = *next;
+    (*next)++;
+    eytzinger_fill(index, arr, 2 * k + 1, next);
+}
+
+int eytzinger_build(eytzinger_index *index, const int arr[], int size) {
+    index->size = size < 0 ? 0 : size;
+    index->keys = alloc_lines((size_t)index->size + 1);
+    index->ranks = malloc(((size_t)index->size + 1) * sizeof(int));
+    if (index->keys == NULL || index->ranks == NULL) {
+        eytzinger_free(index);
+        return -1;
+    }
+    int next = 0;
+    index->keys[0] = INT_MIN;  // Never compared
+    index->ranks[0] = index->size;
+    eytzinger_fill(index, arr, 1, &next);
+    return 0;
+}
+
+void eytzinger_free(eytzinger_index *index) {
+    free(index->keys);
+    free(index->ranks);
+    index->keys = NULL;
+    index->ranks = NULL;
+    index->size = 0;
+}
+
+/**
+ * Node of the first key >= target (0 if none). The descent goes right on
+ * every key < target; the answer is the last node where it went left,
+ * found by stripping the trailing right turns (ones) and that left turn.
+ */
+static size_t eytzinger_node(const eytzinger_index *index, int target) {
+    const int *keys = index->keys;
+    size_t n = (size_t)index->size;
+    size_t k = 1;
+    while (k <= n) {
+        // Integer arithmetic: the prefetch address may lie past the array
+        __builtin_prefetch((const void *)((uintptr_t)keys + LINE_INTS * k * sizeof(int)));
+        k = 2 * k + (keys[k] < target);
+    }
+    return k >> (__builtin_ctzll(~(unsigned long long)k) + 1);
+}
+
+int eytzinger_lower_bound(const eytzinger_index *index, int target) {
+    return index->ranks[eytzinger_node(index, target)];
+}
+
+int eytzinger_search(const eytzinger_index *index, int target) {
+    size_t k = eytzinger_node(index, target);
+    return k != 0 && index->keys[k] == target ? index->ranks[k] : -1;
+}
+
+/**
+ * Keys of one S-tree node below target
+ */
+static inline int stree_node_rank(const int node[], int target) {
+#if defined(__AVX512F__)
+    __m512i keys = _mm512_load_si512((const void *)node);
+    return __builtin_popcount(_mm512_cmplt_epi32_mask(keys, _mm512_set1_epi32(target)));
+#elif defined(__AVX2__)
+    __m256i x = _mm256_set1_epi32(target);
+    __m256i lo = _mm256_cmpgt_epi32(x, _mm256_load_si256((const __m256i *)node));
+    __m256i hi = _mm256_cmpgt_epi32(x, _mm256_load_si256((const __m256i *)(node + 8)));
+    unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lo)) |
+                    (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8;
+    return __builtin_popcount(mask);
+#else
+    int count = 0;
+    for (int i = 0; i < STREE_NODE_KEYS; i++) {
+        count += node[i] < target;
+    }
+    return count;
+#endif
+}
+
+static void stree_fill(stree_index *index, const int arr[], size_t k, int *next) {
+    if (k >= (size_t)index->nodes) {
+        return;
+    }
+    for (int i = 0; i < STREE_NODE_KEYS; i++) {
+        stree_fill(index, arr, k * (STREE_NODE_KEYS + 1) + 1 + i, next);
+        size_t slot = k * STREE_NODE_KEYS + i;
+        int has_key = *next < index->size;
+        index->keys[slot] = has_key ? arr[*next] : INT_MAX;
+        index->ranks[slot] = has_key ? *next : index->size;
+        *next += has_key;
+    }
+    stree_fill(index, arr, k * (STREE_NODE_KEYS + 1) + 1 + STREE_NODE_KEYS, next);
+}
+
+int stree_build(stree_index *index, const int arr[], int size) {
+    index->size = size < 0 ? 0 : size;
+    index->nodes = (index->size + STREE_NODE_KEYS - 1) / STREE_NODE_KEYS;
+    size_t slots = (size_t)index->nodes * STREE_NODE_KEYS;
+    index->keys = alloc_lines(slots == 0 ? 1 : slots);
+    index->ranks = malloc((slots == 0 ? 1 : slots) * sizeof(int));
+    if (index->keys == NULL || index->ranks == NULL) {
+        stree_free(index);
+        return -1;
+    }
+    int next = 0;
+    stree_fill(index, arr, 0, &next);
+    return 0;
+}
+
+void stree_free(stree_index *index) {
+    free(index->keys);
+    free(index->ranks);
+    index->keys = NULL;
+    index->ranks = NULL;
+    index->nodes = 0;
+    index->size = 0;
+}
+
+/**
+ * Slot of the first key >= target, or SIZE_MAX if none: each level keeps
+ * the node's first key >= target as the best candidate so far
+ */
+static size_t stree_slot(const stree_index *index, int target) {
+    size_t best = SIZE_MAX;
+    size_t nodes = (size_t)index->nodes;
+    size_t k = 0;
+    while (k < nodes) {
+        int i = stree_node_rank(index->keys + k * STREE_NODE_KEYS, target);
+        best = i < STREE_NODE_KEYS ? k * STREE_NODE_KEYS + i : best;
+        k = k * (STREE_NODE_KEYS + 1) + 1 + i;
+    }
+    return best;
+}
+
+int stree_lower_bound(const stree_index *index, int target) {
+    size_t slot = stree_slot(index, target);
+    return slot == SIZE_MAX ? index->size : index->ranks[slot];
+}
+
+int stree_search(const stree_index *index, int target) {
+    size_t slot = stree_slot(index, target);
+    if (slot == SIZE_MAX || index->keys[slot] != target || index->ranks[slot] == index->size) {
+        return -1;
+    }
+    return index->ranks[slot];
+}
+
+/**
+ * Interpolated position of target in arr[0..size), for arr[0] < target
+ * <= arr[size - 1]
+ */
+static int interpolate(const int arr[], int size, int target) {
+    double span = (double)arr[size - 1] - (double)arr[0];
+    int p = (int)(((double)target - (double)arr[0]) / span * (size - 1));
+    return p < 0 ? 0 : p >= size ? size - 1 : p;
+}
+
+int interpolation_search(const int arr[], int size, int target) {
+    if (size <= 0) {
+        return -1;
+    }
+    if (target <= arr[0] || target > arr[size - 1]) {
+        return arr[0] == target ? 0 : -1;
+    }
+
+    // Narrow arr[lo] < target <= arr[hi] by re-interpolating inside it.
+    // A probe alone only moves one end, so a second probe one expected
+    // error (sqrt of the window, for uniform keys) past it brackets the
+    // target from the other side.
+    int lo = 0;
+    int hi = size - 1;
+    for (int round = 0; hi - lo > INTERP_SCAN_MAX && round < INTERP_MAX_ROUNDS; round++) {
+        int guard = (int)sqrt((double)(hi - lo));
+        int p = lo + interpolate(arr + lo, hi - lo + 1, target);
+        p = p <= lo ? lo + 1 : p >= hi ? hi - 1 : p;
+        if (arr[p] < target) {
+            lo = p;
+            int q = p + guard;
+            if (q < hi && arr[q] >= target) {
+                hi = q;
+            }
+        } else {
+            hi = p;
+            int q = p - guard;
+            if (q > lo && arr[q] < target) {
+                lo = q;
+            }
+        }
+    }
+
+    // Short window: scan sequentially; skewed keys: bisect what is left
+    int p = lo + 1;
+    if (hi - lo <= INTERP_SCAN_MAX) {
+        while (arr[p] < target) {
+            p++;  // arr[hi] >= target stops the scan
+        }
+    } else {
+        p += lower_bound_branchless(arr + p, hi - lo, target);
+    }
+    return arr[p] == target ? p : -1;
+}
+
+/**
+ * Close the current segment of the shrinking cone: any slope in
+ * [slope_low, slope_high] keeps every covered key within epsilon
+ */
+static int push_segment(learned_index *index, int *capacity, learned_segment segment,
+                        double slope_low, double slope_high) {
+    if (index->num_segments == *capacity) {
+        int grown = *capacity * 2;
+        learned_segment *segments = realloc(index->segments, grown * sizeof(learned_segment));
+        if (segments == NULL) {
+            return -1;
+        }
+        index->segments = segments;
+        *capacity = grown;
+    }
+    if (slope_low == -HUGE_VAL) {
+        segment.slope = 0.0;  // Single key
+    } else {
+        segment.slope = (slope_low + slope_high) / 2.0;
+    }
+    index->segments[index->num_segments++] = segment;
+    return 0;
+}
+
+/**
+ * Fit segments over (key, first index) of every distinct key: a segment
+ * grows while some line through its first point stays within epsilon of
+ * all its points (the cone of admissible slopes is non-empty)
+ */
+static int fit_segments(learned_index *index) {
+    const int *arr = index->arr;
+    int capacity = 64;
+    index->segments = malloc(capacity * sizeof(learned_segment));
+    if (index->segments == NULL) {
+        return -1;
+    }
+
+    learned_segment current = {arr[0], 0, 0.0};
+    double slope_low = -HUGE_VAL;
+    double slope_high = HUGE_VAL;
+    for (int i = 1; i < index->size; i++) {
+        if (arr[i] == arr[i - 1]) {
+            continue;  // Lookups land on first occurrences
+        }
+        double dx = (double)arr[i] - (double)current.key;
+        double low = (i - index->epsilon - current.pos) / dx;
+        double high = (i + index->epsilon - current.pos) / dx;
+        if (low > slope_high || high < slope_low) {
+            if (push_segment(index, &capacity, current, slope_low, slope_high) != 0) {
+                return -1;
+            }
+            current = (learned_segment){arr[i], i, 0.0};
+            slope_low = -HUGE_VAL;
+            slope_high = HUGE_VAL;
+        } else {
+            slope_low = low > slope_low ? low : slope_low;
+            slope_high = high < slope_high ? high : slope_high;
+        }
+    }
+    return push_segment(index, &capacity, current, slope_low, slope_high);
+}
+
+/**
+ * Radix table over the segments' first keys: radix[v] is the first segment
+ * whose key prefix (top radix_bits of key - min_key) is >= v
+ */
+static int build_radix(learned_index *index) {
+    uint32_t span = (uint32_t)index->arr[index->size - 1] - (uint32_t)index->min_key;
+    int span_bits = span == 0 ? 1 : 32 - __builtin_clz(span);
+    int bits = 1;
+    while ((1 << bits) < index->num_segments && bits < LEARNED_RADIX_MAX_BITS) {
+        bits++;
+    }
+    bits = bits > span_bits ? span_bits : bits;
+    index->radix_bits = bits;
+    index->radix_shift = span_bits - bits;
+    index->radix = malloc((((size_t)1 << bits) + 1) * sizeof(uint32_t));
+    if (index->radix == NULL) {
+        return -1;
+    }
+
+    uint32_t v = 0;
+    for (int s = 0; s < index->num_segments; s++) {
+        uint32_t prefix =
+            ((uint32_t)index->segments[s].key - (uint32_t)index->min_key) >> index->radix_shift;
+        while (v <= prefix) {
+            index->radix[v++] = (uint32_t)s;
+        }
+    }
+    while (v <= (1u << bits)) {
+        index->radix[v++] = (uint32_t)index->num_segments;
+    }
+    return 0;
+}
+
+int learned_index_build(learned_index *index, const int arr[], int size, int epsilon) {
+    memset(index, 0, sizeof(*index));
+    if (size < 0 || epsilon < 1) {
+        return -1;
+    }
+    index->arr = arr;
+    index->size = size;
+    index->epsilon = epsilon;
+    if (size == 0) {
+        return 0;
+    }
+    index->min_key = arr[0];
+    if (fit_segments(index) != 0 || build_radix(index) != 0) {
+        learned_index_free(index);
+        return -1;
+    }
+    return 0;
+}
+
+void learned_index_free(learned_index *index) {
+    free(index->segments);
+    free(index->radix);
+    memset(index, 0, sizeof(*index));
+}
+
+size_t learned_index_bytes(const learned_index *index) {
+    size_t radix = index->radix == NULL ? 0 : (((size_t)1 << index->radix_bits) + 1);
+    return (size_t)index->num_segments * sizeof(learned_segment) + radix * sizeof(uint32_t);
+}
+
+int learned_index_lower_bound(const learned_index *index, int target) {
+    const int *arr = index->arr;
+    int n = index->size;
+    if (n == 0 || target <= arr[0]) {
+        return 0;
+    }
+    if (target > arr[n - 1]) {
+        return n;
+    }
+
+    // Last segment starting at or before target: it lies between the
+    // segment before target's prefix and the last one with that prefix
+    uint32_t prefix = ((uint32_t)target - (uint32_t)index->min_key) >> index->radix_shift;
+    size_t lo = index->radix[prefix];
+    lo = lo > 0 ? lo - 1 : 0;
+    size_t len = index->radix[prefix + 1] - lo;
+    const learned_segment *segments = index->segments;
+    while (len > 1) {
+        size_t half = len / 2;
+        len -= half;
+        lo += half & -(size_t)(segments[lo + half].key <= target);
+    }
+    const learned_segment *segment = &segments[lo];
+
+    // Search the +-epsilon window around the prediction; a window whose
+    // answer sits on its edge may have cut the real one off (runs of
+    // duplicates), so check and widen to the whole array if so
+    double predicted = segment->pos + segment->slope * ((double)target - (double)segment->key);
+    int guess = predicted < 0 ? 0 : predicted > n ? n : (int)predicted;
+    int from = guess - index->epsilon - 1 < 0 ? 0 : guess - index->epsilon - 1;
+    int to = guess + index->epsilon + 2 > n ? n : guess + index->epsilon + 2;
+    int i = from + (int)lower_bound_window(arr + from, (size_t)(to - from), target);
+    if ((i == from && from > 0 && arr[from - 1] >= target) || (i == to && to < n)) {
+        i = lower_bound_branchless(arr, n, target);
+    }
+    return i;
+}
+
+int learned_index_search(const learned_index *index, int target) {
+    int i = learned_index_lower_bound(index, target);
+    return i < index->size && index->arr[i] == target ? i : -1;
+}
+
+#ifndef ROSETTA_NO_MAIN
+
+/**
+ * qsort comparator for the batch tests
+ */
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Uniform double in [0, 1) (xorshift64*)
+ */
+static double next_unit(uint64_t *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return (double)((*state * 0x2545F4914F6CDD1DULL) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * Sorted key sets for the interpolation and learned-index runs: uniform,
+ * lognormal (sigma 1.5), 64 tight clusters, 16 distinct keys, and
+ * INT_MIN/INT_MAX mixed with uniform keys
+ */
+static void fill_keys(int arr[], int size, int shape, uint64_t seed) {
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+    double centers[64];
+    for (int c = 0; c < 64; c++) {
+        centers[c] = next_unit(&state) * (INT_MAX - 65536.0);
+    }
+    for (int i = 0; i < size; i++) {
+        double u = next_unit(&state);
+        if (shape == 1) {
+            double z = sqrt(-2.0 * log(1.0 - u)) * cos(6.283185307179586 * next_unit(&state));
+            double key = exp(1.5 * z) * 1e6;
+            arr[i] = key < INT_MAX ? (int)key : INT_MAX;
+        } else if (shape == 2) {
+            arr[i] = (int)(centers[(int)(u * 64)] + next_unit(&state) * 65536.0);
+        } else if (shape == 3) {
+            arr[i] = (int)(u * 16);
+        } else if (shape == 4 && i % 3 != 2) {
+            arr[i] = i % 3 == 0 ? INT_MIN : INT_MAX;
+        } else {
+            arr[i] = (int)(u * INT_MAX);
+        }
+    }
+    qsort(arr, size, sizeof(int), compare_ints);
+}
+
 /**
  * Run test suite
  */
@@ -104,9 +707,607 @@ void run_tests(void) {
     assert(binary_search(arr4, 1000, 1998) == 999);
     assert(binary_search(arr4, 1000, 501) == -1);
 
+    // Test case 5: branchless, Eytzinger and S-tree searches agree with a
+    // linear scan, with duplicates, INT_MIN/INT_MAX keys, targets between
+    // keys and beyond both ends, and partial S-tree nodes
+    static const int sizes[] = {0, 1, 2, 3, 15, 16, 17, 31, 100, 272, 273, 1000, 4913, 5000};
+    for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+        int size = sizes[t];
+        for (int shape = 0; shape < 3; shape++) {
+            int *arr = malloc((size + 1) * sizeof(int));
+            assert(arr != NULL);
+            for (int i = 0; i < size; i++) {
+                arr[i] = shape == 0 ? 3 * i - size : shape == 1 ? i / 4 : 0;
+            }
+            if (shape == 2 && size > 1) {
+                arr[0] = INT_MIN;
+                arr[size - 1] = INT_MAX;
+            }
+
+            eytzinger_index eytzinger;
+            stree_index stree;
+            assert(eytzinger_build(&eytzinger, arr, size) == 0);
+            assert(stree_build(&stree, arr, size) == 0);
+
+            int probes[3 * 5003 + 4];
+            int num_probes = 0;
+            probes[num_probes++] = INT_MIN;
+            probes[num_probes++] = INT_MAX;
+            for (int i = 0; i < size; i++) {
+                probes[num_probes++] = arr[i];
+                probes[num_probes++] = arr[i] - (arr[i] > INT_MIN);
+                probes[num_probes++] = arr[i] + (arr[i] < INT_MAX);
+            }
+            for (int p = 0; p < num_probes; p++) {
+                int target = probes[p];
+                int expected = 0;
+                while (expected < size && arr[expected] < target) {
+                    expected++;
+                }
+                int hit = expected < size && arr[expected] == target ? expected : -1;
+
+                assert(lower_bound_branchless(arr, size, target) == expected);
+                assert(binary_search_branchless(arr, size, target) == hit);
+                assert(eytzinger_lower_bound(&eytzinger, target) == expected);
+                assert(eytzinger_search(&eytzinger, target) == hit);
+                assert(stree_lower_bound(&stree, target) == expected);
+                assert(stree_search(&stree, target) == hit);
+            }
+
+            eytzinger_free(&eytzinger);
+            stree_free(&stree);
+            free(arr);
+        }
+    }
+
+    // Test case 6: binary_search_batch() matches one search per target, in
+    // lockstep groups (random order, partial last group) and on the
+    // ascending fast path (with repeats and misses past both ends)
+    static const int batch_sizes[] = {0, 1, 2, 17, 1000, 100003};
+    static const int batch_counts[] = {0, 1, 15, 16, 17, 1000};
+    for (size_t t = 0; t < sizeof(batch_sizes) / sizeof(batch_sizes[0]); t++) {
+        int size = batch_sizes[t];
+        int *arr = malloc((size + 1) * sizeof(int));
+        assert(arr != NULL);
+        for (int i = 0; i < size; i++) {
+            arr[i] = 3 * (i / 2);  // Pairs of duplicates with gaps
+        }
+        for (size_t c = 0; c < sizeof(batch_counts) / sizeof(batch_counts[0]); c++) {
+            int count = batch_counts[c];
+            int targets[1000];
+            int out[1000];
+            for (int order = 0; order < 2; order++) {
+                bench_fill_random(targets, count, 7 + t + c, 3 * size / 2 + 8);
+                for (int i = 0; i < count; i++) {
+                    targets[i] -= 4;
+                }
+                if (order == 1) {
+                    qsort(targets, count, sizeof(int), compare_ints);
+                }
+                binary_search_batch(arr, size, targets, count, out);
+                for (int i = 0; i < count; i++) {
+                    assert(out[i] == binary_search_branchless(arr, size, targets[i]));
+                }
+            }
+        }
+        free(arr);
+    }
+
+    // Test case 7: interpolation_search() and the learned index agree
+    // with the branchless search on every key set, epsilon and edge probe
+    static const int key_sizes[] = {0, 1, 2, 1000, 100003};
+    static const int epsilons[] = {1, 4, 32};
+    for (size_t t = 0; t < sizeof(key_sizes) / sizeof(key_sizes[0]); t++) {
+        int size = key_sizes[t];
+        int *arr = malloc((size + 1) * sizeof(int));
+        int *probes = malloc((3 * size + 1000) * sizeof(int));
+        assert(arr != NULL && probes != NULL);
+        for (int shape = 0; shape < 5; shape++) {
+            fill_keys(arr, size, shape, 3 + t);
+            int num_probes = 0;
+            probes[num_probes++] = INT_MIN;
+            probes[num_probes++] = INT_MAX;
+            for (int i = 0; i < size; i++) {
+                probes[num_probes++] = arr[i];
+                probes[num_probes++] = arr[i] - (arr[i] > INT_MIN);
+                probes[num_probes++] = arr[i] + (arr[i] < INT_MAX);
+            }
+            bench_fill_random(probes + num_probes, 998, 11 + t, INT_MAX);
+            num_probes += 998;
+
+            for (size_t e = 0; e < sizeof(epsilons) / sizeof(epsilons[0]); e++) {
+                learned_index learned;
+                assert(learned_index_build(&learned, arr, size, epsilons[e]) == 0);
+                assert(learned.num_segments <= size);
+                for (int p = 0; p < num_probes; p++) {
+                    int target = probes[p];
+                    assert(learned_index_lower_bound(&learned, target) ==
+                           lower_bound_branchless(arr, size, target));
+                    assert(learned_index_search(&learned, target) ==
+                           binary_search_branchless(arr, size, target));
+                    if (e == 0) {
+                        assert(interpolation_search(arr, size, target) ==
+                               binary_search_branchless(arr, size, target));
+                    }
+                }
+                learned_index_free(&learned);
+            }
+        }
+        free(arr);
+        free(probes);
+    }
+
+    learned_index invalid;
+    assert(learned_index_build(&invalid, arr1, size1, 0) == -1);
+
     printf("✓ All tests passed\n");
 }
 
+#define BENCH_LOOKUPS 1024
+
+/**
+ * Benchmark context: sorted array (or a layout of it) plus a pool of
+ * lookup targets. Each iteration takes the next BENCH_LOOKUPS targets, so
+ * a pool larger than the cache keeps search paths from staying cached.
+ */
+typedef struct {
+    const int *arr;
+    int size;
+    const int *targets;
+    int pool;    // Multiple of BENCH_LOOKUPS
+    int cursor;  // Start of the next batch
+    int (*search)(const int arr[], int size, int target);
+    const eytzinger_index *eytzinger;
+    const stree_index *stree;
+    int *out;  // BENCH_LOOKUPS results of binary_search_batch()
+    const learned_index *learned;
+} search_bench_ctx;
+
+static const int *next_batch(search_bench_ctx *c) {
+    const int *batch = c->targets + c->cursor;
+    c->cursor = (c->cursor + BENCH_LOOKUPS) % c->pool;
+    return batch;
+}
+
+static void bench_lookups(void *ctx) {
+    search_bench_ctx *c = ctx;
+    const int *targets = next_batch(c);
+    int found = 0;
+
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        found += c->search(c->arr, c->size, targets[i]) >= 0;
+    }
+    BENCH_DO_NOT_OPTIMIZE(found);
+}
+
+static void bench_eytzinger_lookups(void *ctx) {
+    search_bench_ctx *c = ctx;
+    const int *targets = next_batch(c);
+    int found = 0;
+
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        found += eytzinger_search(c->eytzinger, targets[i]) >= 0;
+    }
+    BENCH_DO_NOT_OPTIMIZE(found);
+}
+
+static void bench_batch_lookups(void *ctx) {
+    search_bench_ctx *c = ctx;
+    const int *targets = next_batch(c);
+    binary_search_batch(c->arr, (size_t)c->size, targets, BENCH_LOOKUPS, c->out);
+    bench_escape(c->out);
+}
+
+static void bench_learned_lookups(void *ctx) {
+    search_bench_ctx *c = ctx;
+    const int *targets = next_batch(c);
+    int found = 0;
+
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        found += learned_index_search(c->learned, targets[i]) >= 0;
+    }
+    BENCH_DO_NOT_OPTIMIZE(found);
+}
+
+static void bench_stree_lookups(void *ctx) {
+    search_bench_ctx *c = ctx;
+    const int *targets = next_batch(c);
+    int found = 0;
+
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        found += stree_search(c->stree, targets[i]) >= 0;
+    }
+    BENCH_DO_NOT_OPTIMIZE(found);
+}
+
+#define SEARCH_VARIANTS 5
+
+static const char *const variant_names[SEARCH_VARIANTS] = {
+    "binary_search", "binary_search_recursive", "binary_search_branchless", "eytzinger_search",
+    "stree_search"};
+
+/**
+ * Sorted keys 0, 2, 4, ... and `pool` random targets, about half hits
+ */
+static int *make_search_input(int size, int targets[], int pool) {
+    int *arr = malloc((size_t)size * sizeof(int));
+    if (arr == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < size; i++) {
+        arr[i] = i * 2;
+    }
+    bench_fill_random(targets, pool, 42, size <= INT_MAX / 2 ? size * 2 : INT_MAX);
+    return arr;
+}
+
+/**
+ * Measure one variant; the layouts are built here and freed afterwards so
+ * at most one copy of a large array exists at a time. Returns 0, or -1 if
+ * a layout could not be allocated.
+ */
+static int run_variant(int variant, search_bench_ctx *ctx, const bench_config *config,
+                       bench_result *result, const char *name) {
+    static int (*const plain[3])(const int[], int, int) = {
+        binary_search, binary_search_recursive, binary_search_branchless};
+    eytzinger_index eytzinger = {0};
+    stree_index stree = {0};
+    bench_fn fn = bench_lookups;
+
+    if (variant < 3) {
+        ctx->search = plain[variant];
+    } else if (variant == 3) {
+        if (eytzinger_build(&eytzinger, ctx->arr, ctx->size) != 0) {
+            return -1;
+        }
+        ctx->eytzinger = &eytzinger;
+        fn = bench_eytzinger_lookups;
+    } else {
+        if (stree_build(&stree, ctx->arr, ctx->size) != 0) {
+            return -1;
+        }
+        ctx->stree = &stree;
+        fn = bench_stree_lookups;
+    }
+
+    if (config != NULL) {
+        bench_run(name, fn, NULL, ctx, config, result);
+        bench_record(result);
+    } else {
+        bench_measure(name, fn, NULL, ctx);
+    }
+
+    eytzinger_free(&eytzinger);
+    stree_free(&stree);
+    ctx->eytzinger = NULL;
+    ctx->stree = NULL;
+    return 0;
+}
+
+/**
+ * Run benchmark suite: 1024 random lookups (about half hits) per sample
+ */
+int run_benchmarks(void) {
+    printf("Running Binary Search benchmarks...\n");
+
+    static const int sizes[] = {1000, 100000, 10000000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    int targets[BENCH_LOOKUPS];
+    int sorted[BENCH_LOOKUPS];
+    int out[BENCH_LOOKUPS];
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/004-binary-search");
+    for (int s = 0; s < num_sizes; s++) {
+        int size = sizes[s];
+        int *arr = make_search_input(size, targets, BENCH_LOOKUPS);
+
+        if (arr == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            return 1;
+        }
+
+        search_bench_ctx ctx = {arr, size, targets, BENCH_LOOKUPS, 0, NULL, NULL, NULL, out, NULL};
+        for (int v = 0; v < SEARCH_VARIANTS; v++) {
+            snprintf(name, sizeof(name), "%s/n=%d", variant_names[v], size);
+            if (run_variant(v, &ctx, NULL, NULL, name) != 0) {
+                fprintf(stderr, "Error: Memory allocation failed\n");
+                free(arr);
+                return 1;
+            }
+        }
+
+        snprintf(name, sizeof(name), "binary_search_batch/n=%d", size);
+        bench_measure(name, bench_batch_lookups, NULL, &ctx);
+        memcpy(sorted, targets, sizeof(sorted));
+        qsort(sorted, BENCH_LOOKUPS, sizeof(int), compare_ints);
+        ctx.targets = sorted;
+        snprintf(name, sizeof(name), "binary_search_batch/sorted/n=%d", size);
+        bench_measure(name, bench_batch_lookups, NULL, &ctx);
+
+        free(arr);
+    }
+
+    return bench_end() == 0 ? 0 : 1;
+}
+
+// Targets cycled through by the layout sweep (4 MiB, beyond L2)
+#define SWEEP_TARGET_POOL (1 << 20)
+
+/**
+ * Every variant on arrays from 1 KiB (L1) up to max_bytes (DRAM),
+ * growing 4x per step (1 GiB and 4 GiB are both points)
+ */
+int run_layout_sweep(uint64_t max_bytes) {
+    printf("Binary Search layout sweep (1 KiB .. %llu MiB):\n",
+           (unsigned long long)(max_bytes >> 20));
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    bench_result result;
+    int *targets = malloc(SWEEP_TARGET_POOL * sizeof(int));
+    char name[BENCH_NAME_LEN];
+
+    if (targets == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        return 1;
+    }
+
+    bench_begin("algorithms/004-binary-search");
+    for (uint64_t bytes = 1024; bytes <= max_bytes && bytes / sizeof(int) <= INT_MAX;
+         bytes *= 4) {
+        int size = (int)(bytes / sizeof(int));
+        int *arr = make_search_input(size, targets, SWEEP_TARGET_POOL);
+
+        if (arr == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed at n=%d\n", size);
+            break;
+        }
+
+        search_bench_ctx ctx = {arr, size, targets, SWEEP_TARGET_POOL, 0, NULL, NULL, NULL, NULL, NULL};
+        double baseline_ns = 0;
+        for (int v = 0; v < SEARCH_VARIANTS; v++) {
+            snprintf(name, sizeof(name), "%s/n=%d", variant_names[v], size);
+            if (run_variant(v, &ctx, &config, &result, name) != 0) {
+                printf("  %8llu KiB  %-26s skipped (out of memory)\n",
+                       (unsigned long long)(bytes >> 10), variant_names[v]);
+                continue;
+            }
+            double per_lookup = result.median_ns / BENCH_LOOKUPS;
+            if (v == 0) {
+                baseline_ns = per_lookup;
+            }
+            printf("  %8llu KiB  %-26s %8.1f ns/lookup  speedup %5.2fx\n",
+                   (unsigned long long)(bytes >> 10), variant_names[v], per_lookup,
+                   baseline_ns / per_lookup);
+        }
+
+        free(arr);
+    }
+
+    free(targets);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * Lookups per second of binary_search_batch() against one search per
+ * target, from 1 KiB (L1) up to max_bytes (DRAM), growing 4x per step
+ */
+int run_batch_sweep(uint64_t max_bytes) {
+    static const char *const names[4] = {"binary_search", "binary_search_branchless",
+                                         "binary_search_batch", "binary_search_batch/sorted"};
+    printf("Binary Search batch sweep (1 KiB .. %llu MiB):\n",
+           (unsigned long long)(max_bytes >> 20));
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    bench_result result;
+    int *targets = malloc(SWEEP_TARGET_POOL * sizeof(int));
+    int *sorted = malloc(SWEEP_TARGET_POOL * sizeof(int));
+    int out[BENCH_LOOKUPS];
+    char name[BENCH_NAME_LEN];
+
+    if (targets == NULL || sorted == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(targets);
+        free(sorted);
+        return 1;
+    }
+
+    bench_begin("algorithms/004-binary-search");
+    for (uint64_t bytes = 1024; bytes <= max_bytes && bytes / sizeof(int) <= INT_MAX;
+         bytes *= 4) {
+        int size = (int)(bytes / sizeof(int));
+        int *arr = make_search_input(size, targets, SWEEP_TARGET_POOL);
+
+        if (arr == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed at n=%d\n", size);
+            break;
+        }
+        // Each batch of the sorted pool is one ascending run
+        memcpy(sorted, targets, SWEEP_TARGET_POOL * sizeof(int));
+        for (int b = 0; b < SWEEP_TARGET_POOL; b += BENCH_LOOKUPS) {
+            qsort(sorted + b, BENCH_LOOKUPS, sizeof(int), compare_ints);
+        }
+
+        search_bench_ctx ctx = {arr, size, targets, SWEEP_TARGET_POOL, 0, NULL, NULL, NULL, out, NULL};
+        double baseline_ns = 0;
+        for (int v = 0; v < 4; v++) {
+            snprintf(name, sizeof(name), "%s/n=%d", names[v], size);
+            ctx.cursor = 0;
+            ctx.targets = v == 3 ? sorted : targets;
+            ctx.search = v == 0 ? binary_search : binary_search_branchless;
+            bench_run(name, v < 2 ? bench_lookups : bench_batch_lookups, NULL, &ctx, &config,
+                      &result);
+            bench_record(&result);
+            if (v == 0) {
+                baseline_ns = result.median_ns;
+            }
+            printf("  %8llu KiB  %-27s %8.2f M lookups/s  speedup %5.2fx\n",
+                   (unsigned long long)(bytes >> 10), names[v],
+                   BENCH_LOOKUPS * 1e3 / result.median_ns, baseline_ns / result.median_ns);
+        }
+
+        free(arr);
+    }
+
+    free(targets);
+    free(sorted);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+#define LEARNED_EPSILON 32
+
+/**
+ * Interpolation search and the learned index against bisection on
+ * uniform, lognormal and clustered keys; half the targets are keys of
+ * the array, half uniform over its key range
+ */
+int run_learned_sweep(int size) {
+    static const char *const key_sets[3] = {"uniform", "lognormal", "clustered"};
+    static const char *const names[4] = {"binary_search", "binary_search_branchless",
+                                         "interpolation_search", "learned_index_search"};
+    printf("Learned index sweep (n=%d, epsilon %d):\n", size, LEARNED_EPSILON);
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    bench_result result;
+    int *arr = malloc((size_t)size * sizeof(int));
+    int *targets = malloc(SWEEP_TARGET_POOL * sizeof(int));
+    char name[BENCH_NAME_LEN];
+
+    if (arr == NULL || targets == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(arr);
+        free(targets);
+        return 1;
+    }
+
+    bench_begin("algorithms/004-binary-search");
+    for (int k = 0; k < 3; k++) {
+        fill_keys(arr, size, k, 42);
+        bench_fill_random(targets, SWEEP_TARGET_POOL, 43, INT_MAX);
+        for (int i = 0; i < SWEEP_TARGET_POOL; i++) {
+            int pick = (int)((double)targets[i] / INT_MAX * size);
+            double span = (double)arr[size - 1] - (double)arr[0];
+            targets[i] = i % 2 ? arr[pick] : (int)(arr[0] + (double)targets[i] / INT_MAX * span);
+        }
+
+        learned_index learned;
+        uint64_t start = bench_now_ns();
+        if (learned_index_build(&learned, arr, size, LEARNED_EPSILON) != 0) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(arr);
+            free(targets);
+            return 1;
+        }
+        double build_ms = (bench_now_ns() - start) / 1e6;
+        size_t bytes = learned_index_bytes(&learned);
+        printf("  %-9s index: %d segments, %zu bytes (%.3f%% of the array), built in %.1f ms\n",
+               key_sets[k], learned.num_segments, bytes,
+               100.0 * bytes / ((double)size * sizeof(int)), build_ms);
+
+        search_bench_ctx ctx = {arr, size, targets, SWEEP_TARGET_POOL, 0, NULL,
+                                NULL, NULL, NULL, &learned};
+        double baseline_ns = 0;
+        for (int v = 0; v < 4; v++) {
+            snprintf(name, sizeof(name), "%s/%s/n=%d", names[v], key_sets[k], size);
+            static int (*const plain[3])(const int[], int, int) = {
+                binary_search, binary_search_branchless, interpolation_search};
+            ctx.cursor = 0;
+            ctx.search = v < 3 ? plain[v] : NULL;
+            bench_run(name, v < 3 ? bench_lookups : bench_learned_lookups, NULL, &ctx, &config,
+                      &result);
+            bench_record(&result);
+            double per_lookup = result.median_ns / BENCH_LOOKUPS;
+            if (v == 0) {
+                baseline_ns = per_lookup;
+            }
+            printf("  %-9s %-26s %8.1f ns/lookup  speedup %5.2fx\n", key_sets[k], names[v],
+                   per_lookup, baseline_ns / per_lookup);
+        }
+
+        learned_index_free(&learned);
+    }
+
+    free(arr);
+    free(targets);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * "search" mode: sorted keys from --in, targets from --queries, and the
+ * index of each target (or -1) written in the output format. Searches run
+ * through binary_search_batch(); --time splits off the I/O.
+ */
+int run_search_stream(const int_io_options *options) {
+    if (options->queries == NULL) {
+        fprintf(stderr, "Error: search needs --queries PATH\n");
+        return 1;
+    }
+
+    int *keys = NULL;
+    int *targets = NULL;
+    size_t n = 0;
+    size_t m = 0;
+    uint64_t t0 = bench_now_ns();
+    if (int_io_read(options->input, options->input_format, &keys, &n) != 0) {
+        perror(options->input != NULL ? options->input : "stdin");
+        return 1;
+    }
+    if (int_io_read(options->queries, options->input_format, &targets, &m) != 0) {
+        perror(options->queries);
+        free(keys);
+        return 1;
+    }
+    for (size_t i = 1; i < n; i++) {
+        if (keys[i] < keys[i - 1]) {
+            fprintf(stderr, "Error: Keys are not sorted (index %zu)\n", i);
+            free(keys);
+            free(targets);
+            return 1;
+        }
+    }
+
+    int *found = malloc((m + 1) * sizeof(int));
+    if (found == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(keys);
+        free(targets);
+        free(found);
+        return 1;
+    }
+    uint64_t t1 = bench_now_ns();
+    binary_search_batch(keys, n, targets, m, found);
+    uint64_t t2 = bench_now_ns();
+
+    int status = int_io_write(options->output, options->output_format, found, m);
+    if (status != 0) {
+        perror(options->output != NULL ? options->output : "stdout");
+    }
+    uint64_t t3 = bench_now_ns();
+    if (options->report_time && status == 0) {
+        fprintf(stderr,
+                "binary_search: n=%zu queries=%zu  read %.3f ms  search %.3f ms  write %.3f ms\n",
+                n, m, (double)(t1 - t0) / 1e6, (double)(t2 - t1) / 1e6,
+                (double)(t3 - t2) / 1e6);
+    }
+
+    free(keys);
+    free(targets);
+    free(found);
+    return status == 0 ? 0 : 1;
+}
+
 /**
  * Main entry point
  */
@@ -117,10 +1318,60 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // If "benchmark" argument, run benchmarks
+    if (argc == 2 && strcmp(argv[1], "benchmark") == 0) {
+        return run_benchmarks();
+    }
+
+    // "layouts [max_bytes]": every search variant from L1- to DRAM-sized
+    // arrays; the layouts need about 2x the array on top of it
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "layouts") == 0) {
+        uint64_t max_bytes = argc == 3 ? strtoull(argv[2], NULL, 10) : 1ULL << 30;
+        if (max_bytes < 1024) {
+            fprintf(stderr, "Error: Invalid sweep size\n");
+            return 1;
+        }
+        return run_layout_sweep(max_bytes);
+    }
+
+    // "batch [max_bytes]": lookups/s of binary_search_batch() vs one at a time
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "batch") == 0) {
+        uint64_t max_bytes = argc == 3 ? strtoull(argv[2], NULL, 10) : 1ULL << 30;
+        if (max_bytes < 1024) {
+            fprintf(stderr, "Error: Invalid sweep size\n");
+            return 1;
+        }
+        return run_batch_sweep(max_bytes);
+    }
+
+    // "learned [size]": interpolation / learned index on three key sets
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "learned") == 0) {
+        int size = argc == 3 ? atoi(argv[2]) : 10000000;
+        if (size < 2) {
+            fprintf(stderr, "Error: Invalid sweep size\n");
+            return 1;
+        }
+        return run_learned_sweep(size);
+    }
+
+    // "search [options] --queries PATH": bulk input / output through int_io.h
+    if (argc >= 2 && strcmp(argv[1], "search") == 0) {
+        int_io_options options;
+        if (int_io_parse_args(argc, argv, 2, 1, &options) != 0) {
+            return 1;
+        }
+        return run_search_stream(&options);
+    }
+
     // Otherwise, expect array elements and target
     if (argc < 3) {
         printf("Usage: %s <target> <element1> <element2> ...\n", argv[0]);
         printf("       %s test\n", argv[0]);
+        printf("       %s benchmark\n", argv[0]);
+        printf("       %s layouts [max_bytes]\n", argv[0]);
+        printf("       %s batch [max_bytes]\n", argv[0]);
+        printf("       %s learned [size]\n", argv[0]);
+        printf("       %s search --queries PATH " INT_IO_USAGE "\n", argv[0]);
         printf("\nExample: %s 7 1 3 5 7 9 11 13\n", argv[0]);
         return 1;
     }
@@ -151,3 +1402,5 @@ int main(int argc, char *argv[]) {
     free(arr);
     return 0;
 }
+
+#endif  // ROSETTA_NO_MAIN
@@ -0,0 +1,138 @@
+/**
+ * Binary Search Algorithms - Public Interface
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Other implementations link binary_search.c compiled with
+ * -DROSETTA_NO_MAIN, which drops the test/benchmark driver.
+ */
+
+#ifndef ROSETTA_BINARY_SEARCH_H
+#define ROSETTA_BINARY_SEARCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Binary search (reference): index of target in sorted arr, or -1
+ */
+int binary_search(const int arr[], int size, int target);
+int binary_search_recursive(const int arr[], int size, int target);
+
+/**
+ * Index of the first key >= target in sorted arr (size if none), with a
+ * fixed number of conditional-move steps and no data-dependent branches
+ */
+int lower_bound_branchless(const int arr[], int size, int target);
+
+/**
+ * Index of the first occurrence of target in sorted arr, or -1
+ */
+int binary_search_branchless(const int arr[], int size, int target);
+
+/**
+ * out[i] = binary_search_branchless(arr, n, targets[i]) for i in [0, m).
+ * Unsorted targets are searched in groups advanced in lockstep, so one
+ * search's cache miss overlaps the others'; ascending targets take a
+ * fast path that gallops forward from the previous result.
+ */
+void binary_search_batch(const int *arr, size_t n, const int *targets, size_t m, int *out);
+
+/**
+ * Sorted keys in Eytzinger (BFS) order: node k has children 2k and 2k+1,
+ * so the top levels share cache lines and the descent can prefetch four
+ * levels ahead. ranks[k] maps node k back to its index in the source
+ * array. About 2x the memory of the array.
+ */
+typedef struct {
+    int *keys;   // keys[1..size], 64-byte aligned
+    int *ranks;  // ranks[0] = size ("no key >= target")
+    int size;
+} eytzinger_index;
+
+/**
+ * Build the layout of sorted arr. Returns 0, or -1 on allocation failure.
+ */
+int eytzinger_build(eytzinger_index *index, const int arr[], int size);
+void eytzinger_free(eytzinger_index *index);
+
+/**
+ * Same results as lower_bound_branchless() / binary_search_branchless()
+ * on the source array
+ */
+int eytzinger_lower_bound(const eytzinger_index *index, int target);
+int eytzinger_search(const eytzinger_index *index, int target);
+
+/**
+ * Static B-tree ("S-tree"): nodes of STREE_NODE_KEYS sorted keys, one
+ * cache line each, searched with one SIMD compare + popcount per level.
+ * Node k has children k * (STREE_NODE_KEYS + 1) + 1 + i. Short nodes are
+ * padded with INT_MAX (rank size).
+ */
+#define STREE_NODE_KEYS 16
+
+typedef struct {
+    int *keys;   // nodes * STREE_NODE_KEYS keys, 64-byte aligned
+    int *ranks;  // Source index of every key slot
+    int nodes;
+    int size;
+} stree_index;
+
+int stree_build(stree_index *index, const int arr[], int size);
+void stree_free(stree_index *index);
+int stree_lower_bound(const stree_index *index, int target);
+int stree_search(const stree_index *index, int target);
+
+/**
+ * Interpolation search for near-uniform keys: a few interpolated probes
+ * narrow the window, a short one is scanned linearly, and skewed keys that
+ * leave a wide window fall back to the branchless search. Index of the
+ * first occurrence of target, or -1.
+ */
+int interpolation_search(const int arr[], int size, int target);
+
+/**
+ * Piecewise-linear learned index (PGM / RadixSpline style) over a sorted
+ * array: each segment predicts a key's position within +-epsilon, a radix
+ * table on the top key bits finds the segment, and the branchless search
+ * finishes inside the predicted window. Built in one O(n) pass; the array
+ * is referenced, not copied.
+ */
+typedef struct {
+    int key;       // First key the segment covers
+    int pos;       // Index of that key in the array
+    double slope;  // Positions per key unit
+} learned_segment;
+
+typedef struct {
+    const int *arr;
+    int size;
+    int epsilon;
+    learned_segment *segments;
+    int num_segments;
+    uint32_t *radix;  // (1 << radix_bits) + 1 entries: first segment per key prefix
+    int radix_bits;
+    int radix_shift;
+    int min_key;
+} learned_index;
+
+/**
+ * Build over sorted arr with maximum position error epsilon (>= 1).
+ * Returns 0, or -1 on allocation failure or invalid arguments.
+ */
+int learned_index_build(learned_index *index, const int arr[], int size, int epsilon);
+void learned_index_free(learned_index *index);
+
+/**
+ * Same results as lower_bound_branchless() / binary_search_branchless()
+ */
+int learned_index_lower_bound(const learned_index *index, int target);
+int learned_index_search(const learned_index *index, int target);
+
+/**
+ * Memory used by the index itself (segments + radix table)
+ */
+size_t learned_index_bytes(const learned_index *index);
+
+#endif  // ROSETTA_BINARY_SEARCH_H
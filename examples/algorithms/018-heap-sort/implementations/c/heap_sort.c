@@ -5,18 +5,37 @@
  * Sister project: decy (https://github.com/paiml/decy)
  *
  * Time Complexity: O(n log n)
- * Space Complexity: O(1) - in-place sorting
+ * Space Complexity: O(1) - in-place sorting (heap_sort_dary: O(n))
+ *
+ * heap_sort_bottom_up() and heap_sort_dary() replace the recursive
+ * two-comparison heapify() with Floyd's bottom-up sift: walk the hole
+ * left by the root down to a leaf through the larger children (one
+ * comparison per level for a binary heap), then sift the displaced last
+ * element up from there, which rarely takes more than a level or two.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <string.h>
 #include <assert.h>
 
+#include "bench.h"
+#include "heap_sort.h"
+#include "int_io.h"
+#include "priority_queue.h"
+
+// 4-ary heap: four int children fill a 16-byte group, sixteen grandchildren a line
+#define HEAP_ARITY 4
+#define HEAP_LINE_BYTES 64
+// Ints before the root: puts node 1 (first child) at offset 48 of a line
+// and node 5 (first grandchild) at offset 0
+#define HEAP_LAYOUT_PAD 11
+
 /**
  * Swap two elements in array
  */
-void swap(int arr[], int i, int j) {
+static void swap(int arr[], int i, int j) {
     int temp = arr[i];
     arr[i] = arr[j];
     arr[j] = temp;
@@ -83,6 +102,149 @@ void heap_sort(int arr[], int size) {
     }
 }
 
+/**
+ * Floyd's sift of binary max-heap arr[0..n): fill the hole at `hole` with
+ * `value`. The hole descends to a leaf via the larger child (picked
+ * without a branch), then `value` climbs back up to where it belongs.
+ */
+static inline void sift_bottom_up(int arr[], size_t n, size_t hole, int value) {
+    size_t top = hole;
+    size_t child;
+
+    while ((child = 2 * hole + 2) < n) {
+        child -= arr[child - 1] > arr[child];
+        arr[hole] = arr[child];
+        hole = child;
+    }
+    if (child == n) {
+        // Lone left child at the bottom
+        arr[hole] = arr[n - 1];
+        hole = n - 1;
+    }
+
+    while (hole > top) {
+        size_t parent = (hole - 1) / 2;
+        if (arr[parent] >= value) {
+            break;
+        }
+        arr[hole] = arr[parent];
+        hole = parent;
+    }
+    arr[hole] = value;
+}
+
+/**
+ * Iterative heap sort with Floyd's bottom-up sift-down; in place, and
+ * the fastest variant while the array fits in L2
+ */
+void heap_sort_bottom_up(int arr[], int size) {
+    if (size <= 1) {
+        return;
+    }
+
+    size_t n = (size_t)size;
+    for (size_t i = n / 2; i-- > 0;) {
+        sift_bottom_up(arr, n, i, arr[i]);
+    }
+
+    // The root moves to the end; the element it displaces refills the heap
+    for (size_t end = n - 1; end > 0; end--) {
+        int value = arr[end];
+        arr[end] = arr[0];
+        sift_bottom_up(arr, end, 0, value);
+    }
+}
+
+/**
+ * Position of the largest of the `count` siblings heap[first..)
+ */
+static inline size_t largest_sibling(const int heap[], size_t first, size_t count) {
+    size_t largest = first;
+    for (size_t k = 1; k < count; k++) {
+        if (heap[first + k] > heap[largest]) {
+            largest = first + k;
+        }
+    }
+    return largest;
+}
+
+/**
+ * Floyd's sift of the 4-ary max-heap heap[0..n), laid out by
+ * heap_sort_dary(). On the way down, the (single) cache line holding all
+ * grandchildren is prefetched while the children are compared, and the
+ * children are compared as a two-round tournament rather than a chain.
+ */
+static inline void sift_dary(int heap[], size_t n, size_t hole, int value) {
+    size_t top = hole;
+    size_t child;
+
+    while ((child = HEAP_ARITY * hole + 1) + HEAP_ARITY <= n) {
+        size_t grandchild = HEAP_ARITY * child + 1;
+        if (grandchild < n) {
+            __builtin_prefetch(&heap[grandchild]);
+        }
+        size_t left = child + (heap[child + 1] > heap[child]);
+        size_t right = child + 2 + (heap[child + 3] > heap[child + 2]);
+        size_t largest = heap[right] > heap[left] ? right : left;
+        heap[hole] = heap[largest];
+        hole = largest;
+    }
+    if (child < n) {
+        size_t largest = largest_sibling(heap, child, n - child);
+        heap[hole] = heap[largest];
+        hole = largest;
+    }
+
+    while (hole > top) {
+        size_t parent = (hole - 1) / HEAP_ARITY;
+        if (heap[parent] >= value) {
+            break;
+        }
+        heap[hole] = heap[parent];
+        hole = parent;
+    }
+    heap[hole] = value;
+}
+
+/**
+ * Heap sort over a 4-ary heap in a cache-line-aligned scratch copy. The
+ * root sits HEAP_LAYOUT_PAD ints into a 64-byte line, which puts each
+ * node's four children in one 16-byte group and all sixteen grandchildren
+ * in one line: a level of the descent costs one line, and half as many
+ * levels as the binary heap. Each maximum is written straight to its
+ * final place in arr. Wins once the array outgrows L2; returns 0, or -1
+ * (arr unchanged) if the copy cannot be allocated.
+ */
+int heap_sort_dary(int arr[], int size) {
+    if (size <= 1) {
+        return 0;
+    }
+
+    size_t n = (size_t)size;
+    size_t bytes = (HEAP_LAYOUT_PAD + n) * sizeof(int);
+    int *buffer = aligned_alloc(HEAP_LINE_BYTES, (bytes + HEAP_LINE_BYTES - 1) / HEAP_LINE_BYTES *
+                                                     HEAP_LINE_BYTES);
+    if (buffer == NULL) {
+        return -1;
+    }
+    int *heap = buffer + HEAP_LAYOUT_PAD;
+    memcpy(heap, arr, n * sizeof(int));
+
+    for (size_t i = (n - 2) / HEAP_ARITY + 1; i-- > 0;) {
+        sift_dary(heap, n, i, heap[i]);
+    }
+    for (size_t end = n - 1; end > 0; end--) {
+        arr[end] = heap[0];
+        sift_dary(heap, end, 0, heap[end]);
+    }
+    arr[0] = heap[0];
+
+    free(buffer);
+    return 0;
+}
+
+#ifndef ROSETTA_NO_MAIN
+
 /**
  * Check if array is sorted
  */
@@ -95,6 +257,15 @@ int is_sorted(const int arr[], int size) {
     return 1;
 }
 
+/**
+ * qsort comparator (reference ordering for the variant tests)
+ */
+int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
 /**
  * Print array
  */
@@ -159,9 +330,476 @@ void run_tests(void) {
     assert(is_sorted(arr7, size7));
     assert(arr7[0] == 1 && arr7[1] == 1);
 
+    // Test 8: Bottom-up and 4-ary variants match qsort at sizes around
+    // partial child groups (5, 6, 21, 22), on sorted, reversed, few-unique
+    // and INT_MIN/INT_MAX input
+    static const int cross_sizes[] = {0, 1, 2, 3, 4, 5, 6, 17, 21, 22, 1000, 65537};
+    for (size_t t = 0; t < sizeof(cross_sizes) / sizeof(cross_sizes[0]); t++) {
+        int size = cross_sizes[t];
+        int *input = malloc((size + 1) * sizeof(int));
+        int *expected = malloc((size + 1) * sizeof(int));
+        int *actual = malloc((size + 1) * sizeof(int));
+        assert(input != NULL && expected != NULL && actual != NULL);
+
+        for (int shape = 0; shape < 5; shape++) {
+            bench_fill_random(input, size, 11 + t, shape == 2 ? 300 : 0);
+            for (int i = 0; i < size; i++) {
+                if (shape == 0) {
+                    input[i] = (int)((unsigned)input[i] * 2u);  // full int32 range
+                } else if (shape == 1) {
+                    input[i] = i;
+                } else if (shape == 3) {
+                    input[i] = size - i;
+                } else if (shape == 4) {
+                    input[i] = i % 3 == 0 ? INT_MIN : (i % 3 == 1 ? INT_MAX : -1);
+                }
+            }
+            memcpy(expected, input, size * sizeof(int));
+            qsort(expected, size, sizeof(int), compare_ints);
+
+            memcpy(actual, input, size * sizeof(int));
+            heap_sort_bottom_up(actual, size);
+            assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+
+            memcpy(actual, input, size * sizeof(int));
+            assert(heap_sort_dary(actual, size) == 0);
+            assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+        }
+
+        free(input);
+        free(expected);
+        free(actual);
+    }
+
+    // Test 9: Priority queue pops in key order after pushes with handles,
+    // decrease-key and handle recycling
+    {
+        enum { QUEUED = 2000 };
+        static int current[QUEUED];
+        static pq_handle handles[QUEUED];
+        pq_int q;
+        assert(pq_int_init(&q, 1) == 0);
+        assert(pq_int_pop(&q, NULL, NULL) == -1 && pq_int_peek(&q, NULL, NULL) == -1);
+
+        bench_fill_random(current, QUEUED, 9, 1000000);
+        for (int i = 0; i < QUEUED; i++) {
+            assert(pq_int_push(&q, current[i], &handles[i]) == 0);
+            assert(handles[i] == (pq_handle)i);
+        }
+        for (int i = 0; i < QUEUED; i += 3) {
+            current[i] -= 500000;
+            assert(pq_int_decrease_key(&q, handles[i], current[i]) == 0);
+        }
+        assert(pq_int_decrease_key(&q, handles[1], current[1] + 1) == -1);
+        assert(pq_int_decrease_key(&q, QUEUED, 0) == -1);
+        assert(pq_int_size(&q) == QUEUED);
+
+        int previous = INT_MIN;
+        int key;
+        pq_handle handle;
+        for (int i = 0; i < QUEUED; i++) {
+            assert(pq_int_pop(&q, &key, &handle) == 0);
+            assert(key >= previous && key == current[handle]);
+            assert(pq_int_decrease_key(&q, handle, INT_MIN) == -1);
+            previous = key;
+        }
+        assert(pq_int_size(&q) == 0);
+
+        // Freed handles are reused before the queue grows
+        size_t capacity = q.capacity;
+        for (int i = 0; i < QUEUED; i++) {
+            assert(pq_int_push(&q, i, &handle) == 0 && handle < capacity);
+        }
+        assert(q.capacity == capacity);
+        pq_int_free(&q);
+    }
+
+    // Test 10: Bulk heapify gives the handle of keys[i] as i (uint64, float)
+    {
+        static const uint64_t keys[] = {UINT64_MAX, 7, 3, 3, 0, 1ull << 40, 9, 2};
+        size_t n = sizeof(keys) / sizeof(keys[0]);
+        pq_u64 q;
+        assert(pq_u64_init(&q, 0) == 0);
+        assert(pq_u64_heapify(&q, keys, n) == 0);
+        uint64_t previous = 0;
+        uint64_t key;
+        pq_handle handle;
+        for (size_t i = 0; i < n; i++) {
+            assert(pq_u64_pop(&q, &key, &handle) == 0);
+            assert(key >= previous && key == keys[handle]);
+            previous = key;
+        }
+        pq_u64_free(&q);
+
+        static const float fkeys[] = {2.5f, -1.0f, 0.0f, -1e30f, 1e30f};
+        pq_float fq;
+        assert(pq_float_init(&fq, 2) == 0);
+        assert(pq_float_heapify(&fq, fkeys, 5) == 0);
+        float fkey;
+        assert(pq_float_pop(&fq, &fkey, &handle) == 0 && fkey == -1e30f && handle == 3);
+        assert(pq_float_decrease_key(&fq, 4, -2e30f) == 0);
+        assert(pq_float_pop(&fq, &fkey, &handle) == 0 && handle == 4);
+        pq_float_free(&fq);
+    }
+
+    // Test 11: Streaming top-k matches the tail of a full sort, for k of
+    // 0, 1, a few, and at or beyond n
+    {
+        enum { STREAM = 5000 };
+        static int stream[STREAM];
+        static int sorted[STREAM];
+        static int selected[STREAM + 8];
+        static float fstream[STREAM];
+        static float fselected[STREAM + 8];
+        bench_fill_random(stream, STREAM, 21, 1 << 20);
+        for (int i = 0; i < STREAM; i++) {
+            stream[i] -= 1 << 19;
+            fstream[i] = (float)stream[i];
+        }
+        memcpy(sorted, stream, sizeof(stream));
+        qsort(sorted, STREAM, sizeof(int), compare_ints);
+
+        static const size_t ks[] = {0, 1, 5, 1000, STREAM, STREAM + 3};
+        for (size_t t = 0; t < sizeof(ks) / sizeof(ks[0]); t++) {
+            size_t expected = ks[t] < STREAM ? ks[t] : STREAM;
+            assert(pq_int_top_k(stream, STREAM, ks[t], selected) == (long)expected);
+            assert(pq_float_top_k(fstream, STREAM, ks[t], fselected) == (long)expected);
+            for (size_t i = 0; i < expected; i++) {
+                assert(selected[i] == sorted[STREAM - 1 - i]);
+                assert(fselected[i] == (float)selected[i]);
+            }
+        }
+    }
+
     printf("✓ All tests passed\n");
 }
 
+/**
+ * Benchmark context: pristine input plus a scratch copy restored before each run
+ */
+typedef struct {
+    const int *input;
+    int *work;
+    int size;
+} sort_bench_ctx;
+
+static void restore_input(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    memcpy(c->work, c->input, c->size * sizeof(int));
+}
+
+static void bench_heap_sort(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    heap_sort(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_heap_sort_bottom_up(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    heap_sort_bottom_up(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_heap_sort_dary(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    if (heap_sort_dary(c->work, c->size) != 0) {
+        heap_sort_bottom_up(c->work, c->size);
+    }
+    bench_escape(c->work);
+}
+
+// Variants compared by both benchmark modes
+#define HEAP_VARIANTS 3
+static const char *const variant_names[HEAP_VARIANTS] = {
+    "heap_sort", "heap_sort_bottom_up", "heap_sort_dary"};
+static const bench_fn variant_fns[HEAP_VARIANTS] = {
+    bench_heap_sort, bench_heap_sort_bottom_up, bench_heap_sort_dary};
+
+/**
+ * Priority-queue benchmark bodies per key type. Keys come from a
+ * xorshift64 stream through `draw`, so top-k runs over streams far larger
+ * than memory while holding only k keys.
+ */
+static inline uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+#define DRAW_INT(x) ((int)((x) >> 33))
+#define DRAW_U64(x) (x)
+#define DRAW_FLOAT(x) ((float)((x) >> 40) * (1.0f / 16777216.0f))
+
+#define PQ_BENCH_DEFINE(name, type, draw)                                                      \
+    typedef struct {                                                                           \
+        const type *input; /* size keys to heapify before each hold run */                     \
+        size_t size;                                                                           \
+        size_t stream;     /* top-k stream length */                                           \
+        size_t k;                                                                              \
+        type *out;         /* k slots */                                                       \
+        name queue;                                                                            \
+    } name##_bench_ctx;                                                                        \
+                                                                                               \
+    static void name##_restore_queue(void *ctx) {                                              \
+        name##_bench_ctx *c = ctx;                                                             \
+        name##_heapify(&c->queue, c->input, c->size);                                          \
+    }                                                                                          \
+                                                                                               \
+    static void name##_empty_queue(void *ctx) {                                                \
+        name##_bench_ctx *c = ctx;                                                             \
+        name##_heapify(&c->queue, c->input, 0);                                                \
+    }                                                                                          \
+                                                                                               \
+    /* Hold model: size x (pop the minimum, push a fresh key) at constant size */              \
+    static void bench_##name##_hold(void *ctx) {                                               \
+        name##_bench_ctx *c = ctx;                                                             \
+        uint64_t state = 0x9E3779B97F4A7C15ull;                                                \
+        type key;                                                                              \
+        for (size_t i = 0; i < c->size; i++) {                                                 \
+            name##_pop(&c->queue, &key, NULL);                                                 \
+            name##_push(&c->queue, draw(next_random(&state)), NULL);                           \
+        }                                                                                      \
+        bench_escape(c->queue.keys);                                                           \
+    }                                                                                          \
+                                                                                               \
+    /* Fill then drain: size pushes into an empty queue, then size pops */                     \
+    static void bench_##name##_fill_drain(void *ctx) {                                         \
+        name##_bench_ctx *c = ctx;                                                             \
+        uint64_t state = 0x9E3779B97F4A7C15ull;                                                \
+        type key = 0;                                                                          \
+        for (size_t i = 0; i < c->size; i++) {                                                 \
+            name##_push(&c->queue, draw(next_random(&state)), NULL);                           \
+        }                                                                                      \
+        for (size_t i = 0; i < c->size; i++) {                                                 \
+            name##_pop(&c->queue, &key, NULL);                                                 \
+        }                                                                                      \
+        BENCH_DO_NOT_OPTIMIZE(key);                                                            \
+    }                                                                                          \
+                                                                                               \
+    static void bench_##name##_topk(void *ctx) {                                               \
+        name##_bench_ctx *c = ctx;                                                             \
+        uint64_t state = 0x9E3779B97F4A7C15ull;                                                \
+        name##_topk t;                                                                         \
+        if (name##_topk_init(&t, c->k) != 0) {                                                 \
+            return;                                                                            \
+        }                                                                                      \
+        for (size_t i = 0; i < c->stream; i++) {                                               \
+            name##_topk_offer(&t, draw(next_random(&state)));                                  \
+        }                                                                                      \
+        name##_topk_finish(&t, c->out);                                                        \
+        name##_topk_free(&t);                                                                  \
+        bench_escape(c->out);                                                                  \
+    }                                                                                          \
+                                                                                               \
+    /* Run one body; config NULL: bench_measure(), else print ns per operation */              \
+    static int name##_bench_one(const char *bench_name, bench_fn fn, bench_fn setup,           \
+                                name##_bench_ctx *c, const bench_config *config, double ops) { \
+        if (config == NULL) {                                                                  \
+            return bench_measure(bench_name, fn, setup, c);                                    \
+        }                                                                                      \
+        bench_result result;                                                                   \
+        if (bench_run(bench_name, fn, setup, c, config, &result) != 0) {                       \
+            return -1;                                                                         \
+        }                                                                                      \
+        bench_record(&result);                                                                 \
+        printf("  %-40s median %10.3f ms  %7.2f ns/op  %8.1f Mops/s\n", bench_name,            \
+               result.median_ns / 1e6, result.median_ns / ops, ops * 1e3 / result.median_ns);  \
+        return 0;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    /* Push/pop mixes at each queue size, then top-k over a `stream`-key stream */             \
+    static int name##_bench_queue(const char *label, const size_t sizes[], int num_sizes,      \
+                                  size_t stream, const size_t ks[], int num_ks,                \
+                                  const bench_config *config) {                                \
+        char bench_name[BENCH_NAME_LEN];                                                       \
+        for (int s = 0; s < num_sizes; s++) {                                                  \
+            name##_bench_ctx c = {0};                                                          \
+            type *input = malloc(sizes[s] * sizeof(type));                                     \
+            if (input == NULL || name##_init(&c.queue, sizes[s]) != 0) {                       \
+                fprintf(stderr, "Error: Memory allocation failed\n");                          \
+                free(input);                                                                   \
+                return 1;                                                                      \
+            }                                                                                  \
+            uint64_t state = 42;                                                               \
+            for (size_t i = 0; i < sizes[s]; i++) {                                            \
+                input[i] = draw(next_random(&state));                                          \
+            }                                                                                  \
+            c.input = input;                                                                   \
+            c.size = sizes[s];                                                                 \
+                                                                                               \
+            snprintf(bench_name, sizeof(bench_name), "pq_%s/hold/n=%zu", label, sizes[s]);     \
+            name##_bench_one(bench_name, bench_##name##_hold, name##_restore_queue, &c, config,\
+                             2.0 * sizes[s]);                                                  \
+            snprintf(bench_name, sizeof(bench_name), "pq_%s/fill_drain/n=%zu", label,          \
+                     sizes[s]);                                                                \
+            name##_bench_one(bench_name, bench_##name##_fill_drain, name##_empty_queue, &c,    \
+                             config, 2.0 * sizes[s]);                                          \
+                                                                                               \
+            name##_free(&c.queue);                                                             \
+            free(input);                                                                       \
+        }                                                                                      \
+                                                                                               \
+        for (int t = 0; t < num_ks; t++) {                                                     \
+            name##_bench_ctx c = {0};                                                          \
+            c.out = malloc(ks[t] * sizeof(type));                                              \
+            if (c.out == NULL) {                                                               \
+                fprintf(stderr, "Error: Memory allocation failed\n");                          \
+                return 1;                                                                      \
+            }                                                                                  \
+            c.stream = stream;                                                                 \
+            c.k = ks[t];                                                                       \
+            snprintf(bench_name, sizeof(bench_name), "pq_%s/top_k/k=%zu/n=%zu", label, ks[t],  \
+                     stream);                                                                  \
+            name##_bench_one(bench_name, bench_##name##_topk, NULL, &c, config,                \
+                             (double)stream);                                                  \
+            free(c.out);                                                                       \
+        }                                                                                      \
+        return 0;                                                                              \
+    }
+
+PQ_BENCH_DEFINE(pq_int, int, DRAW_INT)
+PQ_BENCH_DEFINE(pq_u64, uint64_t, DRAW_U64)
+PQ_BENCH_DEFINE(pq_float, float, DRAW_FLOAT)
+
+/**
+ * Run benchmark suite on deterministic random input
+ */
+int run_benchmarks(void) {
+    printf("Running Heap Sort benchmarks...\n");
+
+    static const int sizes[] = {1000, 10000, 100000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/018-heap-sort");
+    for (int s = 0; s < num_sizes; s++) {
+        int size = sizes[s];
+        int *input = malloc(size * sizeof(int));
+        int *work = malloc(size * sizeof(int));
+
+        if (input == NULL || work == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(input);
+            free(work);
+            return 1;
+        }
+
+        bench_fill_random(input, size, 42, size);
+        sort_bench_ctx ctx = {input, work, size};
+
+        for (int v = 0; v < HEAP_VARIANTS; v++) {
+            snprintf(name, sizeof(name), "%s/n=%d", variant_names[v], size);
+            bench_measure(name, variant_fns[v], restore_input, &ctx);
+        }
+
+        free(input);
+        free(work);
+    }
+
+    // Priority queue push/pop mixes and top-k of a 1M-key stream
+    static const size_t queue_sizes[] = {1000, 100000};
+    static const size_t ks[] = {100};
+    if (pq_int_bench_queue("int", queue_sizes, 2, 1000000, ks, 1, NULL) != 0) {
+        return 1;
+    }
+
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * Push/pop throughput at queue sizes from L1- to DRAM-resident, and top-k
+ * (k = 10, 1000, 100000) over a generated stream of `stream` keys, for
+ * each key type. Pushes and pops both count as operations; for top-k an
+ * operation is one stream key.
+ */
+int run_queue_sweep(size_t stream) {
+    static const size_t sizes[] = {1000, 100000, 1000000};
+    static const size_t ks[] = {10, 1000, 100000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    int num_ks = sizeof(ks) / sizeof(ks[0]);
+
+    printf("Priority queue throughput (top-k stream of %zu keys):\n", stream);
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+
+    bench_begin("algorithms/018-heap-sort");
+    if (pq_int_bench_queue("int", sizes, num_sizes, stream, ks, num_ks, &config) != 0 ||
+        pq_u64_bench_queue("u64", sizes, num_sizes, stream, ks, num_ks, &config) != 0 ||
+        pq_float_bench_queue("float", sizes, num_sizes, stream, ks, num_ks, &config) != 0) {
+        return 1;
+    }
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * Variants against heap_sort() at sizes whose 4-byte keys sit in L1
+ * (32 KB), L2 (800 KB), L3 (16 MB) and DRAM (128 MB), stopping at
+ * max_size. The large sizes take seconds per sort, so samples are capped.
+ */
+int run_cache_sweep(int max_size) {
+    static const int sizes[] = {8000, 200000, 4000000, 32000000};
+    static const char *const levels[] = {"L1", "L2", "L3", "DRAM"};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("Heap Sort cache sweep (up to n=%d):\n", max_size);
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 3) {
+        config.samples = 3;
+    }
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/018-heap-sort");
+    for (int s = 0; s < num_sizes && sizes[s] <= max_size; s++) {
+        int size = sizes[s];
+        int *input = malloc(size * sizeof(int));
+        int *work = malloc(size * sizeof(int));
+
+        if (input == NULL || work == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(input);
+            free(work);
+            return 1;
+        }
+
+        bench_fill_random(input, size, 42, size);
+        sort_bench_ctx ctx = {input, work, size};
+
+        double baseline_ns = 0;
+        for (int v = 0; v < HEAP_VARIANTS; v++) {
+            snprintf(name, sizeof(name), "%s/%s/n=%d", variant_names[v], levels[s], size);
+            bench_run(name, variant_fns[v], restore_input, &ctx, &config, &result);
+            bench_record(&result);
+            if (v == 0) {
+                baseline_ns = result.median_ns;
+            }
+            printf("  %-4s n=%-9d %-20s median %10.3f ms  speedup %5.2fx\n", levels[s], size,
+                   variant_names[v], result.median_ns / 1e6, baseline_ns / result.median_ns);
+        }
+
+        free(input);
+        free(work);
+    }
+
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * heap_sort() for int_io_run_sort()
+ */
+static int sort_stream(int arr[], int size) {
+    heap_sort(arr, size);
+    return 0;
+}
+
 /**
  * Main entry point
  */
@@ -172,10 +810,48 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // If "benchmark" argument, run benchmarks
+    if (argc == 2 && strcmp(argv[1], "benchmark") == 0) {
+        return run_benchmarks();
+    }
+
+    // "cache [max_size]": variants at L1/L2/L3/DRAM-sized inputs
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "cache") == 0) {
+        int max_size = argc == 3 ? atoi(argv[2]) : 32000000;
+        if (max_size < 1) {
+            fprintf(stderr, "Error: Invalid cache sweep size\n");
+            return 1;
+        }
+        return run_cache_sweep(max_size);
+    }
+
+    // "queue [stream_length]": priority queue and top-k throughput
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "queue") == 0) {
+        long long stream = argc == 3 ? atoll(argv[2]) : 100000000;
+        if (stream < 1) {
+            fprintf(stderr, "Error: Invalid stream length\n");
+            return 1;
+        }
+        return run_queue_sweep((size_t)stream);
+    }
+
+    // "sort [options]": bulk input / output through int_io.h
+    if (argc >= 2 && strcmp(argv[1], "sort") == 0) {
+        int_io_options options;
+        if (int_io_parse_args(argc, argv, 2, 0, &options) != 0) {
+            return 1;
+        }
+        return int_io_run_sort(&options, "heap_sort", sort_stream);
+    }
+
     // Otherwise, parse array from command line
     if (argc < 2) {
         printf("Usage: %s <num1> <num2> <num3> ...\n", argv[0]);
         printf("       %s test\n", argv[0]);
+        printf("       %s benchmark\n", argv[0]);
+        printf("       %s cache [max_size]\n", argv[0]);
+        printf("       %s queue [stream_length]\n", argv[0]);
+        printf("       %s sort " INT_IO_USAGE "\n", argv[0]);
         printf("\nExample: %s 4 2 7 1 9 3 6 5\n", argv[0]);
         return 1;
     }
@@ -204,3 +880,5 @@ int main(int argc, char *argv[]) {
     free(arr);
     return 0;
 }
+
+#endif  // ROSETTA_NO_MAIN
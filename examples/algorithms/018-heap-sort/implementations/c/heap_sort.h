@@ -0,0 +1,41 @@
+/**
+ * Heap Sort Algorithm - Public Interface
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Other implementations link heap_sort.c compiled with -DROSETTA_NO_MAIN,
+ * which drops the test/benchmark driver and keeps only the primitives.
+ */
+
+#ifndef ROSETTA_HEAP_SORT_H
+#define ROSETTA_HEAP_SORT_H
+
+/**
+ * Heapify a subtree rooted at index i
+ */
+void heapify(int arr[], int heap_size, int i);
+
+/**
+ * Build a max heap from unsorted array
+ */
+void build_max_heap(int arr[], int size);
+
+/**
+ * Heap sort main function
+ */
+void heap_sort(int arr[], int size);
+
+/**
+ * Iterative heap sort with Floyd's bottom-up sift-down, in place
+ */
+void heap_sort_bottom_up(int arr[], int size);
+
+/**
+ * Bottom-up heap sort over a cache-line-aligned 4-ary heap (O(n) scratch).
+ * Returns 0, or -1 with arr unchanged if the scratch copy cannot be
+ * allocated.
+ */
+int heap_sort_dary(int arr[], int size);
+
+#endif  // ROSETTA_HEAP_SORT_H
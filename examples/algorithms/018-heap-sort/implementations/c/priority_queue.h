@@ -0,0 +1,309 @@
+/**
+ * Priority Queues and Streaming Top-k over Binary Heaps
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Header-only and generated per key type, so the comparator is inlined
+ * into every sift: PQ_DEFINE(name, type, less) emits
+ *
+ *   name                  queue: push, pop, peek, decrease-key, heapify
+ *   name##_topk           streaming selector of the k greatest keys
+ *   name##_top_k()        top-k of an array through the selector
+ *
+ * The queue is a min-queue under `less` (pass a "greater" comparator for
+ * a max-queue). pq_int, pq_u64 and pq_float are instantiated below; float
+ * queues must not be given NaNs.
+ *
+ * Every queued key carries a handle, returned by push, that stays valid
+ * until that key is popped; decrease-key takes it. Handles are recycled
+ * without extra memory: ids[] is a permutation of 0..capacity-1 whose
+ * first size entries are the handles of heap slots 0..size-1 and whose
+ * tail is the free list, and pos[] is its inverse, so a handle is queued
+ * exactly when pos[handle] < size.
+ *
+ * Pops use the same bottom-up (Floyd) sift as heap_sort_bottom_up(): the
+ * hole at the root descends to a leaf through the smaller children, one
+ * comparison per level, then the displaced last key climbs back up.
+ *
+ * The selector keeps the k greatest keys seen so far in a k-slot min-heap
+ * whose root is the admission threshold; a stream of n keys costs O(k)
+ * memory and O(n + m log k) time, where m (the number of keys that beat
+ * the threshold) is small for unordered streams.
+ */
+
+#ifndef ROSETTA_PRIORITY_QUEUE_H
+#define ROSETTA_PRIORITY_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef size_t pq_handle;
+
+#define PQ_LESS(a, b) ((a) < (b))
+
+#define PQ_DEFINE(name, type, less)                                                            \
+    typedef struct {                                                                           \
+        type *keys;        /* Heap-ordered keys, keys[0] is the minimum */                     \
+        pq_handle *ids;    /* ids[i]: handle of slot i; free handles past size */              \
+        size_t *pos;       /* pos[h]: slot of handle h (inverse of ids) */                     \
+        size_t size;                                                                           \
+        size_t capacity;                                                                       \
+    } name;                                                                                    \
+                                                                                               \
+    /* Grow to hold at least `capacity` keys; new handles join the free list */                \
+    static inline int name##_reserve(name *q, size_t capacity) {                               \
+        if (capacity <= q->capacity) {                                                         \
+            return 0;                                                                          \
+        }                                                                                      \
+        type *keys = realloc(q->keys, capacity * sizeof(type));                                \
+        if (keys == NULL) {                                                                    \
+            return -1;                                                                         \
+        }                                                                                      \
+        q->keys = keys;                                                                        \
+        pq_handle *ids = realloc(q->ids, capacity * sizeof(pq_handle));                        \
+        if (ids == NULL) {                                                                     \
+            return -1;                                                                         \
+        }                                                                                      \
+        q->ids = ids;                                                                          \
+        size_t *pos = realloc(q->pos, capacity * sizeof(size_t));                              \
+        if (pos == NULL) {                                                                     \
+            return -1;                                                                         \
+        }                                                                                      \
+        q->pos = pos;                                                                          \
+        for (size_t h = q->capacity; h < capacity; h++) {                                      \
+            q->ids[h] = h;                                                                     \
+            q->pos[h] = h;                                                                     \
+        }                                                                                      \
+        q->capacity = capacity;                                                                \
+        return 0;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    /* Empty queue with room for `capacity` keys; returns 0, or -1 */                          \
+    static inline int name##_init(name *q, size_t capacity) {                                  \
+        q->keys = NULL;                                                                        \
+        q->ids = NULL;                                                                         \
+        q->pos = NULL;                                                                         \
+        q->size = 0;                                                                           \
+        q->capacity = 0;                                                                       \
+        return name##_reserve(q, capacity > 0 ? capacity : 1);                                 \
+    }                                                                                          \
+                                                                                               \
+    static inline void name##_free(name *q) {                                                  \
+        free(q->keys);                                                                         \
+        free(q->ids);                                                                          \
+        free(q->pos);                                                                          \
+        q->keys = NULL;                                                                        \
+        q->ids = NULL;                                                                         \
+        q->pos = NULL;                                                                         \
+        q->size = 0;                                                                           \
+        q->capacity = 0;                                                                       \
+    }                                                                                          \
+                                                                                               \
+    static inline size_t name##_size(const name *q) {                                          \
+        return q->size;                                                                        \
+    }                                                                                          \
+                                                                                               \
+    /* Put (key, id) into slot i */                                                            \
+    static inline void name##_place(name *q, size_t i, type key, pq_handle id) {               \
+        q->keys[i] = key;                                                                      \
+        q->ids[i] = id;                                                                        \
+        q->pos[id] = i;                                                                        \
+    }                                                                                          \
+                                                                                               \
+    /* Move the hole at slot i up past every parent greater than key, then fill it */          \
+    static inline void name##_sift_up(name *q, size_t i, size_t top, type key, pq_handle id) { \
+        while (i > top) {                                                                      \
+            size_t parent = (i - 1) / 2;                                                       \
+            if (!less(key, q->keys[parent])) {                                                 \
+                break;                                                                         \
+            }                                                                                  \
+            name##_place(q, i, q->keys[parent], q->ids[parent]);                               \
+            i = parent;                                                                        \
+        }                                                                                      \
+        name##_place(q, i, key, id);                                                           \
+    }                                                                                          \
+                                                                                               \
+    /* Floyd's sift: fill the hole at slot i of the first n slots with (key, id) */            \
+    static inline void name##_sift_bottom_up(name *q, size_t n, size_t i, type key,            \
+                                             pq_handle id) {                                   \
+        size_t top = i;                                                                        \
+        size_t child;                                                                          \
+        while ((child = 2 * i + 2) < n) {                                                      \
+            child -= less(q->keys[child - 1], q->keys[child]);                                 \
+            name##_place(q, i, q->keys[child], q->ids[child]);                                 \
+            i = child;                                                                         \
+        }                                                                                      \
+        if (child == n) {                                                                      \
+            name##_place(q, i, q->keys[n - 1], q->ids[n - 1]);                                 \
+            i = n - 1;                                                                         \
+        }                                                                                      \
+        name##_sift_up(q, i, top, key, id);                                                    \
+    }                                                                                          \
+                                                                                               \
+    /* Queue key, growing as needed; *handle (if non-NULL) receives its handle */              \
+    static inline int name##_push(name *q, type key, pq_handle *handle) {                      \
+        if (q->size == q->capacity && name##_reserve(q, 2 * q->capacity) != 0) {               \
+            return -1;                                                                         \
+        }                                                                                      \
+        pq_handle id = q->ids[q->size];                                                        \
+        if (handle != NULL) {                                                                  \
+            *handle = id;                                                                      \
+        }                                                                                      \
+        name##_sift_up(q, q->size++, 0, key, id);                                              \
+        return 0;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    /* Minimum key and its handle (either may be NULL); -1 if empty */                         \
+    static inline int name##_peek(const name *q, type *key, pq_handle *handle) {               \
+        if (q->size == 0) {                                                                    \
+            return -1;                                                                         \
+        }                                                                                      \
+        if (key != NULL) {                                                                     \
+            *key = q->keys[0];                                                                 \
+        }                                                                                      \
+        if (handle != NULL) {                                                                  \
+            *handle = q->ids[0];                                                               \
+        }                                                                                      \
+        return 0;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    /* Remove the minimum, reporting it like peek(); its handle is freed */                    \
+    static inline int name##_pop(name *q, type *key, pq_handle *handle) {                      \
+        if (name##_peek(q, key, handle) != 0) {                                                \
+            return -1;                                                                         \
+        }                                                                                      \
+        pq_handle freed = q->ids[0];                                                           \
+        size_t last = --q->size;                                                               \
+        if (last > 0) {                                                                        \
+            name##_sift_bottom_up(q, last, 0, q->keys[last], q->ids[last]);                    \
+        }                                                                                      \
+        q->ids[last] = freed;                                                                  \
+        q->pos[freed] = last;                                                                  \
+        return 0;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    /* Lower a queued key; -1 if the handle is not queued or key is larger */                  \
+    static inline int name##_decrease_key(name *q, pq_handle handle, type key) {               \
+        if (handle >= q->capacity || q->pos[handle] >= q->size) {                              \
+            return -1;                                                                         \
+        }                                                                                      \
+        size_t i = q->pos[handle];                                                             \
+        if (less(q->keys[i], key)) {                                                           \
+            return -1;                                                                         \
+        }                                                                                      \
+        name##_sift_up(q, i, 0, key, handle);                                                  \
+        return 0;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    /* Replace the contents with keys[0..n) in O(n); keys[i] gets handle i */                  \
+    static inline int name##_heapify(name *q, const type keys[], size_t n) {                   \
+        if (name##_reserve(q, n) != 0) {                                                       \
+            return -1;                                                                         \
+        }                                                                                      \
+        for (size_t h = 0; h < q->capacity; h++) {                                             \
+            q->ids[h] = h;                                                                     \
+            q->pos[h] = h;                                                                     \
+        }                                                                                      \
+        for (size_t i = 0; i < n; i++) {                                                       \
+            q->keys[i] = keys[i];                                                              \
+        }                                                                                      \
+        q->size = n;                                                                           \
+        for (size_t i = n / 2; i-- > 0;) {                                                     \
+            name##_sift_bottom_up(q, n, i, q->keys[i], q->ids[i]);                             \
+        }                                                                                      \
+        return 0;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    typedef struct {                                                                           \
+        type *keys;  /* Min-heap of the best keys so far; keys[0] is the threshold */          \
+        size_t size;                                                                           \
+        size_t k;                                                                              \
+    } name##_topk;                                                                             \
+                                                                                               \
+    static inline int name##_topk_init(name##_topk *t, size_t k) {                             \
+        t->keys = malloc((k > 0 ? k : 1) * sizeof(type));                                      \
+        t->size = 0;                                                                           \
+        t->k = k;                                                                              \
+        return t->keys != NULL ? 0 : -1;                                                       \
+    }                                                                                          \
+                                                                                               \
+    static inline void name##_topk_free(name##_topk *t) {                                      \
+        free(t->keys);                                                                         \
+        t->keys = NULL;                                                                        \
+        t->size = 0;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    /* Floyd's sift over the selector's heap keys[0..n), hole at slot i */                     \
+    static inline void name##_topk_sift(type keys[], size_t n, size_t i, type key) {           \
+        size_t top = i;                                                                        \
+        size_t child;                                                                          \
+        while ((child = 2 * i + 2) < n) {                                                      \
+            child -= less(keys[child - 1], keys[child]);                                       \
+            keys[i] = keys[child];                                                             \
+            i = child;                                                                         \
+        }                                                                                      \
+        if (child == n) {                                                                      \
+            keys[i] = keys[n - 1];                                                             \
+            i = n - 1;                                                                         \
+        }                                                                                      \
+        while (i > top) {                                                                      \
+            size_t parent = (i - 1) / 2;                                                       \
+            if (!less(key, keys[parent])) {                                                    \
+                break;                                                                         \
+            }                                                                                  \
+            keys[i] = keys[parent];                                                            \
+            i = parent;                                                                        \
+        }                                                                                      \
+        keys[i] = key;                                                                         \
+    }                                                                                          \
+                                                                                               \
+    /* Offer one stream key; the common rejection is one comparison */                         \
+    static inline void name##_topk_offer(name##_topk *t, type key) {                           \
+        if (t->size == t->k) {                                                                 \
+            if (t->k > 0 && less(t->keys[0], key)) {                                           \
+                name##_topk_sift(t->keys, t->k, 0, key);                                       \
+            }                                                                                  \
+            return;                                                                            \
+        }                                                                                      \
+        size_t i = t->size++;                                                                  \
+        while (i > 0 && less(key, t->keys[(i - 1) / 2])) {                                     \
+            t->keys[i] = t->keys[(i - 1) / 2];                                                 \
+            i = (i - 1) / 2;                                                                   \
+        }                                                                                      \
+        t->keys[i] = key;                                                                      \
+    }                                                                                          \
+                                                                                               \
+    /* Write the selected keys to out, greatest first; returns their count */                  \
+    static inline size_t name##_topk_finish(name##_topk *t, type out[]) {                      \
+        size_t count = t->size;                                                                \
+        for (size_t end = count; end > 0; end--) {                                             \
+            out[end - 1] = t->keys[0];                                                         \
+            if (end > 1) {                                                                     \
+                name##_topk_sift(t->keys, end - 1, 0, t->keys[end - 1]);                       \
+            }                                                                                  \
+        }                                                                                      \
+        t->size = 0;                                                                           \
+        return count;                                                                          \
+    }                                                                                          \
+                                                                                               \
+    /* The min(n, k) greatest of arr[0..n), greatest first; -1 if out of memory */             \
+    static inline long name##_top_k(const type arr[], size_t n, size_t k, type out[]) {        \
+        name##_topk t;                                                                         \
+        if (name##_topk_init(&t, k) != 0) {                                                    \
+            return -1;                                                                         \
+        }                                                                                      \
+        for (size_t i = 0; i < n; i++) {                                                       \
+            name##_topk_offer(&t, arr[i]);                                                     \
+        }                                                                                      \
+        long count = (long)name##_topk_finish(&t, out);                                        \
+        name##_topk_free(&t);                                                                  \
+        return count;                                                                          \
+    }
+
+PQ_DEFINE(pq_int, int, PQ_LESS)
+PQ_DEFINE(pq_u64, uint64_t, PQ_LESS)
+PQ_DEFINE(pq_float, float, PQ_LESS)
+
+#endif  // ROSETTA_PRIORITY_QUEUE_H
@@ -7,27 +7,64 @@
  * Time Complexity: O(d * (n + k)) where d is digits, k is radix (base)
  * Space Complexity: O(n + k)
  *
- * Note: This implementation works with non-negative integers only
+ * Note: radix_sort() works with non-negative integers only; the binary
+ * radix variants (radix_sort_lsd256/radix_sort_lsd2048/radix_sort_parallel
+ * and the in-place radix_sort_american_flag) take any int32
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "bench.h"
+#include "int_io.h"
+#include "memory_profile.h"
+#include "quicksort.h"
+#include "radix_sort.h"
+#include "reduce.h"
+#include "sort_generic.h"
+#include "task_pool.h"
+#include "topology.h"
+
 #define RADIX 10  // Base-10 radix sort
 
+// Binary LSD variants: most digit passes any supported width needs
+#define LSD_MAX_PASSES 4
+#define LSD_MAX_BUCKETS 2048
+
+// XOR with this maps int32 order onto uint32 order (negatives first)
+#define LSD_SIGN_FLIP 0x80000000u
+
+// Parallel variant: byte digits, below this size the sequential sort wins
+#define RADIX_PARALLEL_THRESHOLD 65536
+#define RADIX_PARALLEL_BUCKETS 256
+#define RADIX_PARALLEL_PASSES 4
+
+// Write-combining lines: one cache line of ints per bucket per chunk
+#define WC_LINE_BYTES 64
+#define WC_LINE_INTS (WC_LINE_BYTES / (int)sizeof(int))
+
+// Write-combine a pass only when it fills at least this many buckets;
+// fewer output streams stay cache- and TLB-resident on their own
+#define RADIX_WC_MIN_BUCKETS 64
+
+// Outputs at least this many ints (8 MiB) bypass the cache on scatter
+#define RADIX_STREAM_MIN (1u << 21)
+
+// American flag sort: buckets at or below this size finish with introsort
+#define FLAG_SORT_INTRO_THRESHOLD 128
+
 /**
- * Find maximum element in array
+ * Find maximum element in array (SIMD reduction from common/c/reduce.c)
  */
 int find_max(const int arr[], int size) {
-    int max = arr[0];
-    for (int i = 1; i < size; i++) {
-        if (arr[i] > max) {
-            max = arr[i];
-        }
-    }
-    return max;
+    return reduce_max(arr, (size_t)size);
 }
 
 /**
@@ -83,6 +120,481 @@ void radix_sort(int arr[], int size) {
     }
 }
 
+/**
+ * Binary LSD radix sort engine over digit_bits-wide digits of the
+ * sign-flipped key.
+ *
+ * - One read pass builds the histograms of every digit at once
+ * - Passes where all keys share the digit are skipped (e.g. the high
+ *   digits of small keys), so the pass count adapts to the key range
+ * - Scatter passes ping-pong between arr and one auxiliary buffer, with a
+ *   single copy at the end only if an odd number of passes ran
+ *
+ * Returns 0 on success, -1 if the auxiliary buffer cannot be allocated
+ * (arr is then unchanged).
+ */
+static inline int lsd_radix_sort(int arr[], int size, int digit_bits) {
+    if (size <= 1) {
+        return 0;
+    }
+
+    size_t n = (size_t)size;
+    int passes = (32 + digit_bits - 1) / digit_bits;
+    uint32_t mask = (1u << digit_bits) - 1;
+    uint32_t hist[LSD_MAX_PASSES][LSD_MAX_BUCKETS];
+    memset(hist, 0, sizeof(hist));
+
+    // Fused histogram pass
+    for (size_t i = 0; i < n; i++) {
+        uint32_t key = (uint32_t)arr[i] ^ LSD_SIGN_FLIP;
+        for (int p = 0; p < passes; p++) {
+            hist[p][(key >> (p * digit_bits)) & mask]++;
+        }
+    }
+
+    uint32_t first_key = (uint32_t)arr[0] ^ LSD_SIGN_FLIP;
+    int *aux = NULL;
+    int *src = arr;
+    int *dst = NULL;
+
+    for (int p = 0; p < passes; p++) {
+        int shift = p * digit_bits;
+        uint32_t *count = hist[p];
+
+        // Every key has this digit: the pass would be the identity
+        if (count[(first_key >> shift) & mask] == n) {
+            continue;
+        }
+
+        if (aux == NULL) {
+            aux = malloc(n * sizeof(int));
+            if (aux == NULL) {
+                return -1;
+            }
+            dst = aux;
+        }
+
+        // Exclusive prefix sum turns counts into output offsets
+        uint32_t offset = 0;
+        for (uint32_t d = 0; d <= mask; d++) {
+            uint32_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            int value = src[i];
+            uint32_t digit = (((uint32_t)value ^ LSD_SIGN_FLIP) >> shift) & mask;
+            dst[count[digit]++] = value;
+        }
+
+        int *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(int));
+    }
+    free(aux);
+    return 0;
+}
+
+/**
+ * LSD radix sort, radix 256: four byte passes, any int32 keys
+ */
+int radix_sort_lsd256(int arr[], int size) {
+    return lsd_radix_sort(arr, size, 8);
+}
+
+/**
+ * LSD radix sort, radix 2048: three 11-bit passes (11 + 11 + 10 bits),
+ * any int32 keys. Fewer passes over memory than radix 256, at the price
+ * of a 2048-entry histogram per pass (still L1/L2 resident).
+ */
+int radix_sort_lsd2048(int arr[], int size) {
+    return lsd_radix_sort(arr, size, 11);
+}
+
+/**
+ * Shared state of radix_sort_parallel(). The input is split into `chunks`
+ * equal contiguous ranges, one task each; counts[c] is chunk c's digit
+ * histogram for the current pass, turned into its output offsets.
+ */
+typedef struct {
+    int *arr;
+    int *aux;
+    size_t n;
+    size_t chunks;
+    const int *src;
+    int *dst;
+    int shift;
+    int combine;  // Current pass goes through write-combining lines
+    int stream;
+    uint32_t (*fused)[RADIX_PARALLEL_PASSES][RADIX_PARALLEL_BUCKETS];
+    uint32_t (*counts)[RADIX_PARALLEL_BUCKETS];
+    int *lines;  // chunks * BUCKETS write-combining lines, line aligned
+} parallel_radix_ctx;
+
+static size_t radix_chunk_bound(const parallel_radix_ctx *r, size_t c) {
+    return r->n / r->chunks * c + r->n % r->chunks * c / r->chunks;
+}
+
+static uint32_t byte_digit(int value, int shift) {
+    return (((uint32_t)value ^ LSD_SIGN_FLIP) >> shift) & (RADIX_PARALLEL_BUCKETS - 1);
+}
+
+/**
+ * Index of dst within its cache line; lines are defined by address, so
+ * this works for any int-aligned output buffer
+ */
+static size_t line_slot(const int *dst) {
+    return ((uintptr_t)dst / sizeof(int)) & (WC_LINE_INTS - 1);
+}
+
+/**
+ * Write one complete, line-aligned cache line
+ */
+static void store_line(int *dst, const int *line, int stream) {
+#if defined(__SSE2__)
+    if (stream) {
+        __m128i *out = (__m128i *)dst;
+        const __m128i *in = (const __m128i *)line;
+        for (int k = 0; k < WC_LINE_BYTES / 16; k++) {
+            _mm_stream_si128(out + k, _mm_load_si128(in + k));
+        }
+        return;
+    }
+#else
+    (void)stream;
+#endif
+    memcpy(dst, line, WC_LINE_BYTES);
+}
+
+/**
+ * Every digit histogram of one chunk in one read; also this chunk's
+ * counts for the first pass
+ */
+static void fused_histogram_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                                 unsigned depth) {
+    parallel_radix_ctx *r = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    uint32_t (*hist)[RADIX_PARALLEL_BUCKETS] = r->fused[begin];
+    memset(hist, 0, sizeof(r->fused[begin]));
+    for (size_t i = radix_chunk_bound(r, begin); i < radix_chunk_bound(r, begin + 1); i++) {
+        uint32_t key = (uint32_t)r->arr[i] ^ LSD_SIGN_FLIP;
+        hist[0][key & 0xFF]++;
+        hist[1][(key >> 8) & 0xFF]++;
+        hist[2][(key >> 16) & 0xFF]++;
+        hist[3][key >> 24]++;
+    }
+    memcpy(r->counts[begin], hist[0], sizeof(r->counts[begin]));
+}
+
+/**
+ * One chunk's histogram of the current digit (chunk contents change
+ * after every scatter, so later passes recount). Four interleaved
+ * sub-histograms keep runs of equal digits from serializing on one
+ * counter.
+ */
+static void digit_histogram_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                                 unsigned depth) {
+    parallel_radix_ctx *r = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    const int *src = r->src;
+    int shift = r->shift;
+    size_t i = radix_chunk_bound(r, begin);
+    size_t hi = radix_chunk_bound(r, begin + 1);
+    uint32_t sub[4][RADIX_PARALLEL_BUCKETS];
+    memset(sub, 0, sizeof(sub));
+
+    for (; i + 4 <= hi; i += 4) {
+        sub[0][byte_digit(src[i], shift)]++;
+        sub[1][byte_digit(src[i + 1], shift)]++;
+        sub[2][byte_digit(src[i + 2], shift)]++;
+        sub[3][byte_digit(src[i + 3], shift)]++;
+    }
+    for (; i < hi; i++) {
+        sub[0][byte_digit(src[i], shift)]++;
+    }
+
+    uint32_t *count = r->counts[begin];
+    for (int d = 0; d < RADIX_PARALLEL_BUCKETS; d++) {
+        count[d] = sub[0][d] + sub[1][d] + sub[2][d] + sub[3][d];
+    }
+}
+
+/**
+ * Scatter one chunk to its precomputed offsets through per-bucket
+ * write-combining lines: a line is written out only once full (and only
+ * the part inside this chunk's bucket range when that range starts or
+ * ends mid-line), so dst sees whole-line, optionally streaming, stores
+ * instead of 256 interleaved single-int streams. Passes with few
+ * non-empty buckets scatter directly.
+ */
+static void scatter_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                         unsigned depth) {
+    parallel_radix_ctx *r = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    // Locals: stores into the int lines could otherwise alias r's int fields
+    const int *src = r->src;
+    int *dst = r->dst;
+    int shift = r->shift;
+    int stream = r->stream;
+    size_t hi = radix_chunk_bound(r, begin + 1);
+    int *lines = r->lines + begin * RADIX_PARALLEL_BUCKETS * WC_LINE_INTS;
+    uint32_t *pos = r->counts[begin];
+
+    if (!r->combine) {
+        for (size_t i = radix_chunk_bound(r, begin); i < hi; i++) {
+            int value = src[i];
+            dst[pos[byte_digit(value, shift)]++] = value;
+        }
+        return;
+    }
+
+    uint32_t first[RADIX_PARALLEL_BUCKETS];
+    memcpy(first, pos, sizeof(first));
+
+    for (size_t i = radix_chunk_bound(r, begin); i < hi; i++) {
+        int value = src[i];
+        uint32_t d = byte_digit(value, shift);
+        int *line = lines + d * WC_LINE_INTS;
+        uint32_t p = pos[d]++;
+        size_t slot = line_slot(dst + p);
+
+        line[slot] = value;
+        if (slot == WC_LINE_INTS - 1) {
+            uint32_t filled = p + 1 - first[d];
+            if (filled >= WC_LINE_INTS) {
+                store_line(dst + p + 1 - WC_LINE_INTS, line, stream);
+            } else {
+                memcpy(dst + first[d], line + WC_LINE_INTS - filled, filled * sizeof(int));
+            }
+        }
+    }
+
+    // Partial last lines
+    for (int d = 0; d < RADIX_PARALLEL_BUCKETS; d++) {
+        size_t slot = line_slot(dst + pos[d]);
+        size_t filled = pos[d] - first[d];
+        if (slot > 0 && filled > 0) {
+            size_t tail = slot < filled ? slot : filled;
+            memcpy(dst + pos[d] - tail, lines + d * WC_LINE_INTS + slot - tail,
+                   tail * sizeof(int));
+        }
+    }
+
+#if defined(__SSE2__)
+    if (stream) {
+        _mm_sfence();
+    }
+#endif
+}
+
+static void radix_copy_back_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                                 unsigned depth) {
+    parallel_radix_ctx *r = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    size_t lo = radix_chunk_bound(r, begin);
+    size_t hi = radix_chunk_bound(r, begin + 1);
+    memcpy(r->arr + lo, r->src + lo, (hi - lo) * sizeof(int));
+}
+
+/**
+ * Multi-threaded LSD radix sort, radix 256, any int32 keys.
+ *
+ * Each of `threads` tasks (<= 0: one per online CPU) owns one contiguous
+ * chunk. Per pass, every chunk counts its digits, a prefix sum across
+ * digits and then chunks gives each (chunk, digit) pair its own output
+ * range, and the chunks scatter in parallel without synchronization.
+ * That keeps equal digits in input order, so every pass is stable.
+ * Passes whose digit is shared by all keys are skipped, as in
+ * lsd_radix_sort(). Small inputs and threads == 1 use radix_sort_lsd256().
+ * Returns 0 on success, -1 if memory or threads are unavailable (arr is
+ * then unchanged).
+ */
+int radix_sort_parallel(int arr[], int size, int threads) {
+    if (threads <= 0) {
+        threads = task_pool_cpu_count();
+    }
+    if (threads == 1 || size <= RADIX_PARALLEL_THRESHOLD) {
+        return radix_sort_lsd256(arr, size);
+    }
+
+    parallel_radix_ctx r = {0};
+    r.arr = arr;
+    r.n = (size_t)size;
+    r.chunks = (size_t)threads;
+    r.stream = r.n >= RADIX_STREAM_MIN;
+
+    size_t aux_bytes = (r.n * sizeof(int) + WC_LINE_BYTES - 1) / WC_LINE_BYTES * WC_LINE_BYTES;
+    size_t line_bytes = r.chunks * RADIX_PARALLEL_BUCKETS * WC_LINE_BYTES;
+    // Any chunk scatters anywhere: the pool's scratch is interleaved over the nodes
+    task_pool *pool = task_pool_acquire(threads);
+    r.aux = pool != NULL ? task_pool_scratch(pool, aux_bytes) : NULL;
+    r.lines = aligned_alloc(WC_LINE_BYTES, line_bytes);
+    r.fused = malloc(r.chunks * sizeof(*r.fused));
+    r.counts = malloc(r.chunks * sizeof(*r.counts));
+    if (r.aux == NULL || r.lines == NULL || r.fused == NULL || r.counts == NULL) {
+        task_pool_release(pool);
+        free(r.lines);
+        free(r.fused);
+        free(r.counts);
+        return -1;
+    }
+
+    task_pool_parallel_for(pool, fused_histogram_task, &r, r.chunks);
+
+    r.src = arr;
+    r.dst = r.aux;
+    for (int p = 0; p < RADIX_PARALLEL_PASSES; p++) {
+        uint32_t total[RADIX_PARALLEL_BUCKETS] = {0};
+        for (size_t c = 0; c < r.chunks; c++) {
+            for (int d = 0; d < RADIX_PARALLEL_BUCKETS; d++) {
+                total[d] += r.fused[c][p][d];
+            }
+        }
+
+        r.shift = p * 8;
+        if (total[byte_digit(r.src[0], r.shift)] == r.n) {
+            continue;
+        }
+
+        int used = 0;
+        for (int d = 0; d < RADIX_PARALLEL_BUCKETS; d++) {
+            used += total[d] != 0;
+        }
+        r.combine = used >= RADIX_WC_MIN_BUCKETS;
+
+        // counts already hold pass 0 from the fused histogram
+        if (p > 0) {
+            task_pool_parallel_for(pool, digit_histogram_task, &r, r.chunks);
+        }
+
+        // Offsets: digit-major, then chunk order within a digit
+        uint32_t offset = 0;
+        for (int d = 0; d < RADIX_PARALLEL_BUCKETS; d++) {
+            for (size_t c = 0; c < r.chunks; c++) {
+                uint32_t count = r.counts[c][d];
+                r.counts[c][d] = offset;
+                offset += count;
+            }
+        }
+
+        task_pool_parallel_for(pool, scatter_task, &r, r.chunks);
+        int *next_dst = (int *)r.src;
+        r.src = r.dst;
+        r.dst = next_dst;
+    }
+
+    if (r.src != arr) {
+        task_pool_parallel_for(pool, radix_copy_back_task, &r, r.chunks);
+    }
+
+    task_pool_release(pool);
+    free(r.lines);
+    free(r.fused);
+    free(r.counts);
+    return 0;
+}
+
+/**
+ * American flag sort of arr[0..n) on the byte at `shift` and below.
+ *
+ * Counts the digit, then permutes in place: each bucket's write head
+ * takes the next key whose digit belongs there, following the cycle of
+ * displaced keys until one for the current bucket turns up. Every key
+ * moves at most once per level, and the only extra memory is two
+ * 256-entry arrays per level (at most four levels, on the stack).
+ */
+static void american_flag_sort_range(int arr[], size_t n, int shift) {
+    for (;;) {
+        if (n <= FLAG_SORT_INTRO_THRESHOLD) {
+            quicksort_intro(arr, (int)n);
+            return;
+        }
+
+        size_t count[RADIX_PARALLEL_BUCKETS] = {0};
+        for (size_t i = 0; i < n; i++) {
+            count[byte_digit(arr[i], shift)]++;
+        }
+
+        // One bucket holds everything: go straight to the next digit
+        if (count[byte_digit(arr[0], shift)] == n) {
+            if (shift == 0) {
+                return;
+            }
+            shift -= 8;
+            continue;
+        }
+
+        size_t head[RADIX_PARALLEL_BUCKETS];
+        size_t tail[RADIX_PARALLEL_BUCKETS];
+        size_t offset = 0;
+        for (int d = 0; d < RADIX_PARALLEL_BUCKETS; d++) {
+            head[d] = offset;
+            offset += count[d];
+            tail[d] = offset;
+        }
+
+        for (uint32_t d = 0; d < RADIX_PARALLEL_BUCKETS; d++) {
+            while (head[d] < tail[d]) {
+                int value = arr[head[d]];
+                uint32_t digit = byte_digit(value, shift);
+                while (digit != d) {
+                    int displaced = arr[head[digit]];
+                    arr[head[digit]++] = value;
+                    value = displaced;
+                    digit = byte_digit(value, shift);
+                }
+                arr[head[d]++] = value;
+            }
+        }
+
+        // Low byte done: every bucket holds a single value
+        if (shift == 0) {
+            return;
+        }
+
+        size_t start = 0;
+        for (int d = 0; d < RADIX_PARALLEL_BUCKETS; d++) {
+            if (count[d] > 1) {
+                american_flag_sort_range(arr + start, count[d], shift - 8);
+            }
+            start += count[d];
+        }
+        return;
+    }
+}
+
+/**
+ * In-place MSD radix sort (American flag sort), radix 256, any int32 keys.
+ * Peak memory is the input plus O(1): no output buffer, unlike the LSD
+ * variants, at the price of unstable, less sequential permutation passes.
+ * Buckets of FLAG_SORT_INTRO_THRESHOLD or fewer keys use introsort from
+ * 002-quicksort.
+ */
+void radix_sort_american_flag(int arr[], int size) {
+    if (size > 1) {
+        american_flag_sort_range(arr, (size_t)size, 24);
+    }
+}
+
+#ifndef ROSETTA_NO_MAIN
+
 /**
  * Check if array is sorted
  */
@@ -109,6 +621,214 @@ void print_array(const int arr[], int size) {
     printf("]\n");
 }
 
+/**
+ * qsort comparator
+ */
+int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Key distributions of the parallel sweep
+#define RADIX_DISTRIBUTIONS 3
+static const char *const distribution_names[RADIX_DISTRIBUTIONS] = {
+    "uniform", "skewed", "few-unique"};
+
+/**
+ * Deterministic signed keys:
+ * 0 uniform     full int32 range
+ * 1 skewed      log-uniform magnitudes, both signs (most keys are small,
+ *               so the high bytes land in a few buckets)
+ * 2 few-unique  16 distinct values
+ */
+void fill_distribution(int arr[], int size, uint64_t seed, int shape) {
+    bench_fill_random(arr, size, seed, 0);
+    for (int i = 0; i < size; i++) {
+        unsigned r = (unsigned)arr[i];
+        if (shape == 0) {
+            arr[i] = (int)(r * 2u);
+        } else if (shape == 1) {
+            int magnitude = (int)(r >> (r % 31));
+            arr[i] = (r & 1) ? -magnitude : magnitude;
+        } else {
+            arr[i] = (int)((r % 16) * 0x10101010u);
+        }
+    }
+}
+
+/**
+ * Records of the generic-sort tests and benchmark: 16 and 64 bytes with
+ * 32- and 64-bit keys, and 32 bytes with a float key. payload[0] holds
+ * the input position, so tests can check the permutation and stability.
+ */
+typedef struct {
+    uint32_t key;
+    uint32_t payload[3];
+} rec16;
+
+typedef struct {
+    uint64_t key;
+    uint64_t payload[7];
+} rec64;
+
+typedef struct {
+    float key;
+    uint32_t payload[7];
+} recf32;
+
+#define REC_KEY(r) ((r)->key)
+
+SORT_DEFINE(rec16_sort, rec16, uint32_t, REC_KEY, uint32_t, sort_bits_u32)
+SORT_DEFINE(rec64_sort, rec64, uint64_t, REC_KEY, uint64_t, sort_bits_u64)
+SORT_DEFINE(recf32_sort, recf32, float, REC_KEY, uint32_t, sort_bits_f32)
+
+#define REC_ENGINES 5
+static const char *const rec_engine_names[REC_ENGINES] = {"quicksort", "mergesort", "heapsort",
+                                                          "radix_sort", "sort_indexed"};
+
+static uint64_t rec_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * Per record type: fill (random or 16 distinct keys), run engine e, and
+ * check the output is a sorted, stable-where-promised permutation
+ */
+#define REC_DEFINE_HELPERS(name, type, key_type, make_key)                                     \
+    static void name##_fill(type *r, size_t n, uint64_t seed, int few_unique) {                \
+        uint64_t state = seed * 2654435761u + 1;                                               \
+        for (size_t i = 0; i < n; i++) {                                                       \
+            uint64_t x = rec_random(&state);                                                   \
+            memset(&r[i], 0, sizeof(type));                                                    \
+            r[i].key = make_key(few_unique ? x % 16 * 0x1234567 : x);                          \
+            for (size_t j = 0; j < sizeof(r[i].payload) / sizeof(r[i].payload[0]); j++) {      \
+                r[i].payload[j] = i * (j + 1);                                                 \
+            }                                                                                  \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    static int name##_engine(int engine, type *r, size_t n) {                                  \
+        switch (engine) {                                                                      \
+        case 0:                                                                                \
+            name##_sort_quicksort(r, n);                                                       \
+            return 0;                                                                          \
+        case 1:                                                                                \
+            return name##_sort_mergesort(r, n);                                                \
+        case 2:                                                                                \
+            name##_sort_heapsort(r, n);                                                        \
+            return 0;                                                                          \
+        case 3:                                                                                \
+            return name##_sort_radix_sort(r, n);                                               \
+        default:                                                                               \
+            return name##_sort_sort_indexed(r, n);                                             \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    static int name##_check(const type *r, const type *input, size_t n, int stable) {          \
+        unsigned char *seen = calloc(n + 1, 1);                                                \
+        int ok = seen != NULL && name##_sort_is_sorted(r, n);                                  \
+        for (size_t i = 0; ok && i < n; i++) {                                                 \
+            size_t from = (size_t)r[i].payload[0];                                             \
+            ok = from < n && !seen[from] && memcmp(&r[i], &input[from], sizeof(type)) == 0;    \
+            if (ok && stable && i > 0 && !(r[i - 1].key < r[i].key)) {                         \
+                ok = r[i - 1].payload[0] < r[i].payload[0];                                    \
+            }                                                                                  \
+            if (ok) {                                                                          \
+                seen[from] = 1;                                                                \
+            }                                                                                  \
+        }                                                                                      \
+        free(seen);                                                                            \
+        return ok;                                                                             \
+    }                                                                                          \
+                                                                                               \
+    static int name##_compare(const void *a, const void *b) {                                  \
+        key_type x = ((const type *)a)->key;                                                   \
+        key_type y = ((const type *)b)->key;                                                   \
+        return (x > y) - (x < y);                                                              \
+    }
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+#define REC_KEY_U32(x) ((uint32_t)(x))
+#define REC_KEY_U64(x) ((uint64_t)(x))
+#define REC_KEY_F32(x) ((float)(int32_t)(uint32_t)(x) / 1024.0f)
+
+REC_DEFINE_HELPERS(rec16, rec16, uint32_t, REC_KEY_U32)
+REC_DEFINE_HELPERS(rec64, rec64, uint64_t, REC_KEY_U64)
+REC_DEFINE_HELPERS(recf32, recf32, float, REC_KEY_F32)
+
+/**
+ * Every generic engine on every record type, sizes and key shapes
+ */
+static void test_generic_records(void) {
+    static const size_t sizes[] = {0, 1, 2, SORT_INSERTION_MAX + 1, SORT_RUN + 1, 1000, 100003};
+    size_t max = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+    rec64 *input = malloc(max * sizeof(rec64));
+    rec64 *work = malloc(max * sizeof(rec64));
+    assert(input != NULL && work != NULL);
+
+    for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+        size_t n = sizes[t];
+        for (int few = 0; few < 2; few++) {
+            for (int e = 0; e < REC_ENGINES; e++) {
+                int stable = e == 1 || e >= 3;
+
+                rec16_fill((rec16 *)input, n, t, few);
+                memcpy(work, input, n * sizeof(rec16));
+                assert(rec16_engine(e, (rec16 *)work, n) == 0);
+                assert(rec16_check((rec16 *)work, (rec16 *)input, n, stable));
+
+                rec64_fill(input, n, t, few);
+                memcpy(work, input, n * sizeof(rec64));
+                assert(rec64_engine(e, work, n) == 0);
+                assert(rec64_check(work, input, n, stable));
+
+                recf32_fill((recf32 *)input, n, t, few);
+                memcpy(work, input, n * sizeof(recf32));
+                assert(recf32_engine(e, (recf32 *)work, n) == 0);
+                assert(recf32_check((recf32 *)work, (recf32 *)input, n, stable));
+            }
+        }
+    }
+
+    // Bare uint64 / float keys (the instantiations in sort_generic.h),
+    // including negative floats and both zeros for the radix bit map
+    uint64_t *keys = (uint64_t *)input;
+    uint64_t *expected = (uint64_t *)work;
+    uint64_t state = 99;
+    for (size_t i = 0; i < 50000; i++) {
+        keys[i] = expected[i] = rec_random(&state) >> (i % 64);
+    }
+    qsort(expected, 50000, sizeof(uint64_t), compare_u64);
+    assert(sort_u64_radix_sort(keys, 50000) == 0);
+    assert(memcmp(keys, expected, 50000 * sizeof(uint64_t)) == 0);
+
+    float *floats = (float *)input;
+    float *sorted = (float *)work;
+    for (size_t i = 0; i < 50000; i++) {
+        floats[i] = i % 1000 == 0 ? (i % 2000 ? -0.0f : 0.0f) : REC_KEY_F32(rec_random(&state));
+        sorted[i] = floats[i];
+    }
+    sort_float_quicksort(sorted, 50000);
+    assert(sort_float_is_sorted(sorted, 50000));
+    assert(sort_float_sort_indexed(floats, 50000) == 0);
+    assert(sort_float_is_sorted(floats, 50000));
+    for (size_t i = 0; i < 50000; i++) {
+        assert(floats[i] == sorted[i]);
+    }
+
+    free(input);
+    free(work);
+}
+
 /**
  * Run test suite
  */
@@ -166,9 +886,458 @@ void run_tests(void) {
     assert(is_sorted(arr8, size8));
     assert(arr8[0] == 0 && arr8[1] == 0 && arr8[2] == 0);
 
+    // Test 9: Binary radix variants on signed keys match qsort, including
+    // INT_MIN/INT_MAX, narrow ranges (skipped passes) and sizes near 0
+    static const int cross_sizes[] = {0, 1, 2, 17, 1000, 65537};
+    int (*variants[])(int[], int) = {radix_sort_lsd256, radix_sort_lsd2048};
+    for (size_t t = 0; t < sizeof(cross_sizes) / sizeof(cross_sizes[0]); t++) {
+        int size = cross_sizes[t];
+        int *expected = malloc((size + 1) * sizeof(int));
+        int *actual = malloc((size + 1) * sizeof(int));
+        assert(expected != NULL && actual != NULL);
+
+        for (int shape = 0; shape < 4; shape++) {
+            bench_fill_random(expected, size, 5 + t, shape == 2 ? 300 : 0);
+            for (int i = 0; i < size; i++) {
+                if (shape == 0) {
+                    expected[i] = (int)((unsigned)expected[i] * 2u);  // full int32 range
+                } else if (shape == 1) {
+                    expected[i] -= 1 << 30;
+                } else if (shape == 3) {
+                    expected[i] = i % 3 == 0 ? -2147483647 - 1 : (i % 3 == 1 ? 2147483647 : -1);
+                }
+            }
+            for (int v = 0; v < 2; v++) {
+                memcpy(actual, expected, size * sizeof(int));
+                assert(variants[v](actual, size) == 0);
+                assert(is_sorted(actual, size));
+            }
+            qsort(expected, size, sizeof(int), compare_ints);
+            assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+        }
+
+        free(expected);
+        free(actual);
+    }
+
+    // Test 10: Parallel variant matches the sequential one for odd thread
+    // counts, chunk sizes not a multiple of a cache line, and the
+    // distributions used by the scaling sweep
+    static const int parallel_sizes[] = {70001, 100003};
+    static const int parallel_threads[] = {2, 3, 4, 7};
+    for (size_t t = 0; t < sizeof(parallel_sizes) / sizeof(parallel_sizes[0]); t++) {
+        int size = parallel_sizes[t];
+        int *input = malloc(size * sizeof(int));
+        int *expected = malloc(size * sizeof(int));
+        int *actual = malloc(size * sizeof(int));
+        assert(input != NULL && expected != NULL && actual != NULL);
+
+        for (int shape = 0; shape < RADIX_DISTRIBUTIONS; shape++) {
+            fill_distribution(input, size, 11 + t, shape);
+            memcpy(expected, input, size * sizeof(int));
+            qsort(expected, size, sizeof(int), compare_ints);
+
+            for (size_t k = 0; k < sizeof(parallel_threads) / sizeof(parallel_threads[0]); k++) {
+                memcpy(actual, input, size * sizeof(int));
+                assert(radix_sort_parallel(actual, size, parallel_threads[k]) == 0);
+                assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+            }
+        }
+
+        free(input);
+        free(expected);
+        free(actual);
+    }
+
+    // Streaming stores, into an array that does not start on a cache line
+    {
+        int size = (int)RADIX_STREAM_MIN + 13;
+        int *expected = malloc(size * sizeof(int));
+        int *buffer = malloc((size + 1) * sizeof(int));
+        assert(expected != NULL && buffer != NULL);
+
+        int *actual = buffer + 1;
+        fill_distribution(actual, size, 17, 0);
+        memcpy(expected, actual, size * sizeof(int));
+        qsort(expected, size, sizeof(int), compare_ints);
+        assert(radix_sort_parallel(actual, size, 3) == 0);
+        assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+
+        free(expected);
+        free(buffer);
+    }
+
+    // Test 11: In-place American flag sort matches qsort across bucket
+    // sizes around the introsort cutoff and all scaling distributions
+    static const int flag_sizes[] = {0, 1, 2, FLAG_SORT_INTRO_THRESHOLD,
+                                     FLAG_SORT_INTRO_THRESHOLD + 1, 5000, 100003};
+    for (size_t t = 0; t < sizeof(flag_sizes) / sizeof(flag_sizes[0]); t++) {
+        int size = flag_sizes[t];
+        int *expected = malloc((size + 1) * sizeof(int));
+        int *actual = malloc((size + 1) * sizeof(int));
+        assert(expected != NULL && actual != NULL);
+
+        for (int shape = 0; shape < RADIX_DISTRIBUTIONS; shape++) {
+            fill_distribution(expected, size, 23 + t, shape);
+            memcpy(actual, expected, size * sizeof(int));
+            radix_sort_american_flag(actual, size);
+            qsort(expected, size, sizeof(int), compare_ints);
+            assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+        }
+
+        free(expected);
+        free(actual);
+    }
+
+    int extremes[300];
+    for (int i = 0; i < 300; i++) {
+        extremes[i] = i % 3 == 0 ? -2147483647 - 1 : (i % 3 == 1 ? 2147483647 : 300 - i);
+    }
+    radix_sort_american_flag(extremes, 300);
+    assert(is_sorted(extremes, 300));
+    assert(extremes[0] == -2147483647 - 1 && extremes[299] == 2147483647);
+
+    // Test 12: Same order as the decimal reference on non-negative keys
+    int arr10[] = {170, 45, 75, 90, 802, 24, 2, 66, 0, 802};
+    int ref10[] = {170, 45, 75, 90, 802, 24, 2, 66, 0, 802};
+    radix_sort(ref10, 10);
+    radix_sort_lsd2048(arr10, 10);
+    assert(memcmp(arr10, ref10, sizeof(ref10)) == 0);
+
+    // Test 13: Generic record engines (sort_generic.h) against the input
+    test_generic_records();
+
     printf("✓ All tests passed\n");
 }
 
+/**
+ * Benchmark context: pristine input plus a scratch copy restored before each run
+ */
+typedef struct {
+    const int *input;
+    int *work;
+    int size;
+    int threads;
+} sort_bench_ctx;
+
+static void restore_input(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    memcpy(c->work, c->input, c->size * sizeof(int));
+}
+
+static void bench_radix_sort(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    radix_sort(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_radix_sort_lsd256(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    radix_sort_lsd256(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_radix_sort_lsd2048(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    radix_sort_lsd2048(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_radix_sort_parallel(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    radix_sort_parallel(c->work, c->size, c->threads);
+    bench_escape(c->work);
+}
+
+static void bench_radix_sort_american_flag(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    radix_sort_american_flag(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_qsort(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    qsort(c->work, c->size, sizeof(int), compare_ints);
+    bench_escape(c->work);
+}
+
+/**
+ * Run benchmark suite on deterministic random input
+ */
+int run_benchmarks(void) {
+    printf("Running Radix Sort benchmarks...\n");
+
+    static const int sizes[] = {1000, 10000, 100000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/019-radix-sort");
+    for (int s = 0; s < num_sizes; s++) {
+        int size = sizes[s];
+        int *input = malloc(size * sizeof(int));
+        int *work = malloc(size * sizeof(int));
+
+        if (input == NULL || work == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(input);
+            free(work);
+            return 1;
+        }
+
+        bench_fill_random(input, size, 42, size);
+        sort_bench_ctx ctx = {input, work, size, 1};
+
+        snprintf(name, sizeof(name), "radix_sort/n=%d", size);
+        bench_measure(name, bench_radix_sort, restore_input, &ctx);
+        snprintf(name, sizeof(name), "radix_sort_lsd256/n=%d", size);
+        bench_measure(name, bench_radix_sort_lsd256, restore_input, &ctx);
+        snprintf(name, sizeof(name), "radix_sort_lsd2048/n=%d", size);
+        bench_measure(name, bench_radix_sort_lsd2048, restore_input, &ctx);
+        snprintf(name, sizeof(name), "radix_sort_american_flag/n=%d", size);
+        bench_measure(name, bench_radix_sort_american_flag, restore_input, &ctx);
+        snprintf(name, sizeof(name), "qsort/n=%d", size);
+        bench_measure(name, bench_qsort, restore_input, &ctx);
+
+        free(input);
+        free(work);
+    }
+
+    // Production shape: tens of millions of signed full-range int32 keys
+    const int batch = 10000000;
+    int *input = malloc(batch * sizeof(int));
+    int *work = malloc(batch * sizeof(int));
+    if (input == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(input);
+        free(work);
+        return 1;
+    }
+
+    bench_fill_random(input, batch, 42, 0);
+    for (int i = 0; i < batch; i++) {
+        input[i] = (int)((unsigned)input[i] * 2u);
+    }
+    sort_bench_ctx ctx = {input, work, batch, 1};
+    snprintf(name, sizeof(name), "radix_sort_lsd256/signed/n=%d", batch);
+    bench_measure(name, bench_radix_sort_lsd256, restore_input, &ctx);
+    snprintf(name, sizeof(name), "radix_sort_lsd2048/signed/n=%d", batch);
+    bench_measure(name, bench_radix_sort_lsd2048, restore_input, &ctx);
+    snprintf(name, sizeof(name), "radix_sort_american_flag/signed/n=%d", batch);
+    bench_measure(name, bench_radix_sort_american_flag, restore_input, &ctx);
+
+    // Peak RSS of one sort each (input and scratch copy already resident)
+    static const struct {
+        const char *name;
+        bench_fn fn;
+    } profiled[] = {
+        {"radix_sort_lsd256", bench_radix_sort_lsd256},
+        {"radix_sort_lsd2048", bench_radix_sort_lsd2048},
+        {"radix_sort_american_flag", bench_radix_sort_american_flag},
+    };
+    printf("Peak memory (n=%d, %.2f MB of keys):\n", batch,
+           batch * sizeof(int) / 1048576.0);
+    for (size_t i = 0; i < sizeof(profiled) / sizeof(profiled[0]); i++) {
+        memory_profile mp;
+        restore_input(&ctx);
+        memory_profile_begin(&mp);
+        profiled[i].fn(&ctx);
+        memory_profile_end(&mp);
+        memory_profile_report(profiled[i].name, &mp);
+    }
+
+    free(input);
+    free(work);
+
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * Thread sweep of radix_sort_parallel() (1, 2, 4, ... max_threads) for
+ * each key distribution, against the sequential radix_sort_lsd256(), with
+ * and without pinned workers; same layout as the quicksort and mergesort
+ * scaling tables
+ */
+int run_scaling(int max_threads, int size) {
+    printf("Radix Sort scaling (n=%d, up to %d threads):\n", size, max_threads);
+
+    topology_report(stdout);
+
+    size_t bytes = (size_t)size * sizeof(int);
+    int *input = malloc(bytes);
+    int *work = topology_alloc(bytes, TOPOLOGY_BLOCKED | TOPOLOGY_HUGE_PAGES);
+    if (input == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(input);
+        topology_free(work, bytes);
+        return 1;
+    }
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/019-radix-sort");
+    task_pool_set_default_affinity(TASK_POOL_AFFINITY_NONE);
+    for (int shape = 0; shape < RADIX_DISTRIBUTIONS; shape++) {
+        const char *dist = distribution_names[shape];
+        fill_distribution(input, size, 42, shape);
+        sort_bench_ctx ctx = {input, work, size, 1};
+
+        snprintf(name, sizeof(name), "radix_sort_lsd256/%s/n=%d", dist, size);
+        bench_run(name, bench_radix_sort_lsd256, restore_input, &ctx, &config, &result);
+        bench_report(&result);
+        double sequential_ns = result.median_ns;
+
+        for (int threads = 1;; threads *= 2) {
+            if (threads > max_threads) {
+                threads = max_threads;
+            }
+            ctx.threads = threads;
+
+            snprintf(name, sizeof(name), "radix_sort_parallel/%s/n=%d/t=%d", dist, size,
+                     threads);
+            bench_run(name, bench_radix_sort_parallel, restore_input, &ctx, &config, &result);
+            bench_record(&result);
+
+            double unpinned_ns = result.median_ns;
+            double speedup = sequential_ns / unpinned_ns;
+            printf("  %-10s threads=%-3d median %10.3f ms  speedup %5.2fx  efficiency %5.1f%%",
+                   dist, threads, unpinned_ns / 1e6, speedup, 100.0 * speedup / threads);
+
+            if (threads > 1) {
+                task_pool_set_default_affinity(TASK_POOL_AFFINITY_PINNED);
+                snprintf(name, sizeof(name), "radix_sort_parallel/%s/n=%d/t=%d/pinned", dist,
+                         size, threads);
+                bench_run(name, bench_radix_sort_parallel, restore_input, &ctx, &config, &result);
+                bench_record(&result);
+                printf("  pinned %10.3f ms (%5.2fx)", result.median_ns / 1e6,
+                       unpinned_ns / result.median_ns);
+                task_pool_set_default_affinity(TASK_POOL_AFFINITY_NONE);
+            }
+            printf("\n");
+
+            if (threads == max_threads) {
+                break;
+            }
+        }
+    }
+    task_pool_set_default_affinity(TASK_POOL_AFFINITY_AUTO);
+
+    free(input);
+    topology_free(work, bytes);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * Generic record sort benchmark context; engine -1 is qsort()
+ */
+typedef struct {
+    const void *input;
+    void *work;
+    size_t n;
+    size_t record_bytes;
+    int type;  // 0 rec16, 1 rec64, 2 recf32
+    int engine;
+} rec_bench_ctx;
+
+static void restore_records(void *ctx) {
+    rec_bench_ctx *c = ctx;
+    memcpy(c->work, c->input, c->n * c->record_bytes);
+}
+
+static void bench_records(void *ctx) {
+    rec_bench_ctx *c = ctx;
+    static int (*const compare[3])(const void *, const void *) = {rec16_compare, rec64_compare,
+                                                                  recf32_compare};
+    if (c->engine < 0) {
+        qsort(c->work, c->n, c->record_bytes, compare[c->type]);
+    } else if (c->type == 0) {
+        rec16_engine(c->engine, c->work, c->n);
+    } else if (c->type == 1) {
+        rec64_engine(c->engine, c->work, c->n);
+    } else {
+        recf32_engine(c->engine, c->work, c->n);
+    }
+    bench_escape(c->work);
+}
+
+/**
+ * Every generic engine on 16-byte/u32-key, 64-byte/u64-key and
+ * 32-byte/float-key records, against qsort() with a comparator callback
+ */
+int run_records(int size) {
+    static const char *const type_names[3] = {"rec16/u32", "rec64/u64", "rec32/f32"};
+    static const size_t record_bytes[3] = {sizeof(rec16), sizeof(rec64), sizeof(recf32)};
+    size_t n = (size_t)size;
+    void *input = malloc(n * sizeof(rec64));
+    void *work = malloc(n * sizeof(rec64));
+
+    if (input == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(input);
+        free(work);
+        return 1;
+    }
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+
+    printf("Generic record sorts (n=%d):\n", size);
+    bench_begin("algorithms/019-radix-sort");
+    for (int type = 0; type < 3; type++) {
+        if (type == 0) {
+            rec16_fill(input, n, 42, 0);
+        } else if (type == 1) {
+            rec64_fill(input, n, 42, 0);
+        } else {
+            recf32_fill(input, n, 42, 0);
+        }
+
+        double qsort_ns = 0;
+        for (int engine = -1; engine < REC_ENGINES; engine++) {
+            const char *engine_name = engine < 0 ? "qsort" : rec_engine_names[engine];
+            rec_bench_ctx ctx = {input, work, n, record_bytes[type], type, engine};
+            snprintf(name, sizeof(name), "generic/%s/%s/n=%d", type_names[type], engine_name,
+                     size);
+            bench_run(name, bench_records, restore_records, &ctx, &config, &result);
+            bench_record(&result);
+            if (engine < 0) {
+                qsort_ns = result.median_ns;
+            }
+            printf("  %-10s %-13s %9.3f ms  %7.1f M records/s  %6.2fx qsort\n", type_names[type],
+                   engine_name, result.median_ns / 1e6, n * 1e3 / result.median_ns,
+                   qsort_ns / result.median_ns);
+        }
+    }
+
+    free(input);
+    free(work);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * radix_sort() for int_io_run_sort()
+ */
+static int sort_stream(int arr[], int size) {
+    for (int i = 0; i < size; i++) {
+        if (arr[i] < 0) {
+            fprintf(stderr, "Error: radix_sort takes non-negative values only\n");
+            return -1;
+        }
+    }
+    radix_sort(arr, size);
+    return 0;
+}
+
 /**
  * Main entry point
  */
@@ -179,10 +1348,49 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // If "benchmark" argument, run benchmarks
+    if (argc == 2 && strcmp(argv[1], "benchmark") == 0) {
+        return run_benchmarks();
+    }
+
+    // "scaling [max_threads] [size]": parallel thread sweep
+    if (argc >= 2 && argc <= 4 && strcmp(argv[1], "scaling") == 0) {
+        int max_threads = argc > 2 ? atoi(argv[2]) : task_pool_cpu_count();
+        int size = argc > 3 ? atoi(argv[3]) : 10000000;
+        if (max_threads < 1 || size < 1) {
+            fprintf(stderr, "Error: Invalid scaling arguments\n");
+            return 1;
+        }
+        return run_scaling(max_threads, size);
+    }
+
+    // "records [size]": generic engines on wide records
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "records") == 0) {
+        int size = argc == 3 ? atoi(argv[2]) : 2000000;
+        if (size < 1) {
+            fprintf(stderr, "Error: Invalid record count\n");
+            return 1;
+        }
+        return run_records(size);
+    }
+
+    // "sort [options]": bulk input / output through int_io.h
+    if (argc >= 2 && strcmp(argv[1], "sort") == 0) {
+        int_io_options options;
+        if (int_io_parse_args(argc, argv, 2, 0, &options) != 0) {
+            return 1;
+        }
+        return int_io_run_sort(&options, "radix_sort", sort_stream);
+    }
+
     // Otherwise, parse array from command line
     if (argc < 2) {
         printf("Usage: %s <num1> <num2> <num3> ...\n", argv[0]);
         printf("       %s test\n", argv[0]);
+        printf("       %s benchmark\n", argv[0]);
+        printf("       %s scaling [max_threads] [size]\n", argv[0]);
+        printf("       %s records [size]\n", argv[0]);
+        printf("       %s sort " INT_IO_USAGE "\n", argv[0]);
         printf("\nExample: %s 170 45 75 90 802 24 2 66\n", argv[0]);
         printf("\nNote: Only works with non-negative integers\n");
         return 1;
@@ -217,3 +1425,5 @@ int main(int argc, char *argv[]) {
     free(arr);
     return 0;
 }
+
+#endif  // ROSETTA_NO_MAIN
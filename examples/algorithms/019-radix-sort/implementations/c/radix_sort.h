@@ -0,0 +1,49 @@
+/**
+ * Radix Sort Algorithms - Public Interface
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Other implementations link radix_sort.c compiled with -DROSETTA_NO_MAIN,
+ * which drops the test/benchmark driver and keeps only the sorts. The
+ * library also needs task_pool.c, reduce.c and the 002-quicksort library (introsort
+ * for American flag sort buckets) with its dependencies.
+ */
+
+#ifndef ROSETTA_RADIX_SORT_H
+#define ROSETTA_RADIX_SORT_H
+
+/**
+ * Find maximum element in array
+ */
+int find_max(const int arr[], int size);
+
+/**
+ * Decimal LSD radix sort for non-negative integers (reference)
+ */
+void radix_sort(int arr[], int size);
+
+/**
+ * LSD radix sort, radix 256, any int32 keys.
+ * Returns 0 on success, -1 if the auxiliary buffer cannot be allocated.
+ */
+int radix_sort_lsd256(int arr[], int size);
+
+/**
+ * LSD radix sort, radix 2048 (three passes), any int32 keys.
+ * Returns 0 on success, -1 if the auxiliary buffer cannot be allocated.
+ */
+int radix_sort_lsd2048(int arr[], int size);
+
+/**
+ * Multi-threaded LSD radix sort (threads <= 0: one per CPU).
+ * Returns 0 on success, -1 if memory or threads are unavailable.
+ */
+int radix_sort_parallel(int arr[], int size, int threads);
+
+/**
+ * In-place MSD radix sort (American flag sort), O(1) extra memory
+ */
+void radix_sort_american_flag(int arr[], int size);
+
+#endif  // ROSETTA_RADIX_SORT_H
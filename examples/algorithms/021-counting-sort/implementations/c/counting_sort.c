@@ -4,78 +4,452 @@
  * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
  * Sister project: decy (https://github.com/paiml/decy)
  *
- * Time Complexity: O(n + k) where k is range
- * Space Complexity: O(k)
+ * Time Complexity: O(n + k) where k is range (max - min + 1)
+ * Space Complexity: O(k), no output buffer
+ *
+ * Ranges too wide for an L2-sized histogram are handed to LSD radix sort
+ * from 019-radix-sort, so counting_sort() is O(n) in time and bounded in
+ * memory for any int32 input.
  */
 
+#define _GNU_SOURCE
+
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdalign.h>
 #include <assert.h>
 #include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "counting_sort.h"
+#include "int_io.h"
+#include "radix_sort.h"
+#include "reduce.h"
+#include "sort_auto.h"
+#include "task_pool.h"
+#include "topology.h"
+
+// Default limits: count when the range is at most this multiple of n...
+#define COUNTING_SORT_RANGE_FACTOR 4
+// ...and its histogram fits this budget (a typical per-core L2)
+#define COUNTING_SORT_MAX_COUNT_BYTES (1u << 20)
+
+// Stores issued per key when rewriting the array from its counts
+#define COUNTING_FILL_STORES 4
+
+// Parallel variants: below this many keys one thread wins
+#define COUNTING_PARALLEL_THRESHOLD 65536
+
+#define CACHE_LINE 64
+#define COUNTERS_PER_LINE (CACHE_LINE / (int)sizeof(uint32_t))
+
+// Ranges up to this many keys are counted into interleaved sub-histograms
+#define COUNTING_SUB_HISTOGRAM_MAX 1024
+#define COUNTING_SUB_HISTOGRAMS 4
+
+counting_sort_limits counting_sort_default_limits(void) {
+    counting_sort_limits limits = {COUNTING_SORT_RANGE_FACTOR, COUNTING_SORT_MAX_COUNT_BYTES};
+    return limits;
+}
 
 /**
- * Find maximum element in array
+ * Minimum and maximum in one pass (SIMD reduction from common/c/reduce.c)
  */
-int find_max(const int arr[], int size) {
-    int max = arr[0];
-    for (int i = 1; i < size; i++) {
-        if (arr[i] > max) {
-            max = arr[i];
+void find_min_max(const int arr[], int size, int *min_out, int *max_out) {
+    reduce_minmax(arr, (size_t)size, min_out, max_out);
+}
+
+/**
+ * Whether keys spanning `range` values are cheaper to count than to
+ * radix sort under `limits`
+ */
+static int range_fits(uint64_t range, int size, const counting_sort_limits *limits) {
+    return range <= (uint64_t)limits->range_factor * (uint64_t)size &&
+           range <= limits->max_count_bytes / sizeof(uint32_t);
+}
+
+/**
+ * Add the keys of arr[0..n) that lie in [base, base + range) to the
+ * zeroed counters row[0..range); returns how many there were. Small
+ * ranges (few distinct, often repeated keys) interleave four histograms
+ * so that runs of one key do not serialize on a single counter.
+ */
+static size_t count_range(const int arr[], size_t n, uint32_t base, uint64_t range,
+                          uint32_t row[]) {
+    size_t counted = 0;
+    size_t i = 0;
+    if (range <= COUNTING_SUB_HISTOGRAM_MAX) {
+        uint32_t sub[COUNTING_SUB_HISTOGRAMS - 1][COUNTING_SUB_HISTOGRAM_MAX];
+        memset(sub, 0, sizeof(sub));
+        for (; i + COUNTING_SUB_HISTOGRAMS <= n; i += COUNTING_SUB_HISTOGRAMS) {
+            uint32_t k0 = (uint32_t)arr[i] - base;
+            uint32_t k1 = (uint32_t)arr[i + 1] - base;
+            uint32_t k2 = (uint32_t)arr[i + 2] - base;
+            uint32_t k3 = (uint32_t)arr[i + 3] - base;
+            if (k0 < range) {
+                row[k0]++;
+            }
+            if (k1 < range) {
+                sub[0][k1]++;
+            }
+            if (k2 < range) {
+                sub[1][k2]++;
+            }
+            if (k3 < range) {
+                sub[2][k3]++;
+            }
+        }
+        for (uint64_t k = 0; k < range; k++) {
+            row[k] += sub[0][k] + sub[1][k] + sub[2][k];
+            counted += row[k];
         }
     }
-    return max;
+    for (; i < n; i++) {
+        uint32_t k = (uint32_t)arr[i] - base;
+        if (k < range) {
+            row[k]++;
+            counted++;
+        }
+    }
+    return counted;
 }
 
 /**
- * Counting sort implementation
- * Sorts array of non-negative integers
+ * Write keys min + first .. min + last - 1, each count[k] times, to
+ * out[0..total) (total = sum of those counts). While there is room,
+ * every key gets COUNTING_FILL_STORES unconditional stores and the cursor
+ * advances by its count, so the usual short runs cost no data-dependent
+ * branch.
  */
-void counting_sort(int arr[], int size) {
+static void fill_from_counts(int out[], size_t total, const uint32_t count[], uint64_t first,
+                             uint64_t last, int min) {
+    int *end = out + total;
+    uint64_t k = first;
+    for (; k < last && end - out >= COUNTING_FILL_STORES; k++) {
+        int value = (int)((int64_t)min + (int64_t)k);
+        uint32_t c = count[k];
+        for (int j = 0; j < COUNTING_FILL_STORES; j++) {
+            out[j] = value;
+        }
+        for (uint32_t j = COUNTING_FILL_STORES; j < c; j++) {
+            out[j] = value;
+        }
+        out += c;
+    }
+    for (; k < last; k++) {
+        int value = (int)((int64_t)min + (int64_t)k);
+        for (uint32_t c = count[k]; c > 0; c--) {
+            *out++ = value;
+        }
+    }
+}
+
+/**
+ * Counting sort of any int32 keys, choosing the method from the key
+ * range. Counting uses max - min + 1 counters offset by min and rewrites
+ * the array straight from the counts (equal ints are interchangeable, so
+ * no stable output pass is needed). Returns the method used.
+ */
+counting_sort_method counting_sort_with_limits(int arr[], int size,
+                                               const counting_sort_limits *limits) {
     if (size <= 1) {
-        return;
+        return COUNTING_SORT_TRIVIAL;
     }
 
-    // Find maximum element to determine range
-    int max = find_max(arr, size);
+    int min;
+    int max;
+    find_min_max(arr, size, &min, &max);
+    if (min == max) {
+        return COUNTING_SORT_TRIVIAL;
+    }
 
-    // Create count array and initialize to 0
-    int *count = calloc(max + 1, sizeof(int));
+    uint64_t range = (uint64_t)((int64_t)max - min) + 1;
+    if (!range_fits(range, size, limits)) {
+        // LSD needs an n-int buffer; fall back to the in-place MSD sort
+        if (radix_sort_lsd2048(arr, size) != 0) {
+            radix_sort_american_flag(arr, size);
+        }
+        return COUNTING_SORT_RADIX;
+    }
+
+    uint32_t *count = calloc(range, sizeof(uint32_t));
     if (count == NULL) {
         fprintf(stderr, "Error: Memory allocation failed\n");
-        return;
+        return COUNTING_SORT_FAILED;
     }
 
-    // Store count of each element
-    for (int i = 0; i < size; i++) {
-        count[arr[i]]++;
+    // Store count of each element, offset by the minimum
+    count_range(arr, (size_t)size, (uint32_t)min, range, count);
+
+    fill_from_counts(arr, (size_t)size, count, 0, range, min);
+
+    free(count);
+    return COUNTING_SORT_COUNTS;
+}
+
+/**
+ * Counting sort implementation with the default limits
+ */
+void counting_sort(int arr[], int size) {
+    counting_sort_limits limits = counting_sort_default_limits();
+    counting_sort_with_limits(arr, size, &limits);
+}
+
+/**
+ * Per-task results, one cache line each so neighbouring tasks never
+ * write the same line
+ */
+typedef struct {
+    alignas(CACHE_LINE) int min;
+    int max;
+    size_t total;   // Keys in this slice of the key range
+    size_t offset;  // Where the slice starts in the sorted output
+} counting_slot;
+
+/**
+ * Shared state of the parallel counting kernels. Input chunks and slices
+ * of the key range [min, min + range) are both split `tasks` ways. Task c
+ * counts its chunk into private row c (rows are padded to whole cache
+ * lines, so no two tasks share one); task s then sums column slice s of
+ * all rows.
+ */
+typedef struct {
+    const int *src;
+    int *out;
+    size_t n;
+    size_t tasks;
+    int min;
+    uint64_t range;
+    size_t stride;       // Row length in counters, a cache-line multiple
+    uint32_t *rows;      // tasks * stride private counters
+    uint32_t *counts;    // range totals
+    counting_slot *slots;
+} parallel_count_ctx;
+
+static size_t split_bound(size_t total, size_t parts, size_t i) {
+    return total / parts * i + total % parts * i / parts;
+}
+
+static void min_max_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                         unsigned depth) {
+    parallel_count_ctx *p = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    size_t lo = split_bound(p->n, p->tasks, begin);
+    size_t hi = split_bound(p->n, p->tasks, begin + 1);
+    find_min_max(p->src + lo, (int)(hi - lo), &p->slots[begin].min, &p->slots[begin].max);
+}
+
+/**
+ * Count one chunk into its private row; keys outside [min, min + range)
+ * are skipped. The owning task zeroes its row, so its pages are first
+ * touched by the thread that uses them.
+ */
+static void private_histogram_task(task_pool *pool, void *ctx, size_t begin, size_t end,
+                                   unsigned depth) {
+    parallel_count_ctx *p = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    uint32_t *row = p->rows + begin * p->stride;
+    memset(row, 0, p->range * sizeof(uint32_t));
+
+    size_t lo = split_bound(p->n, p->tasks, begin);
+    size_t hi = split_bound(p->n, p->tasks, begin + 1);
+    count_range(p->src + lo, hi - lo, (uint32_t)p->min, p->range, row);
+}
+
+/**
+ * Sum one slice of the key range across all private rows
+ */
+static void reduce_task(task_pool *pool, void *ctx, size_t begin, size_t end, unsigned depth) {
+    parallel_count_ctx *p = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
+
+    size_t lo = split_bound(p->range, p->tasks, begin);
+    size_t hi = split_bound(p->range, p->tasks, begin + 1);
+    size_t total = 0;
+    for (size_t k = lo; k < hi; k++) {
+        uint32_t sum = 0;
+        for (size_t t = 0; t < p->tasks; t++) {
+            sum += p->rows[t * p->stride + k];
+        }
+        p->counts[k] = sum;
+        total += sum;
     }
+    p->slots[begin].total = total;
+}
+
+/**
+ * Rewrite one slice of the key range into its place in the output
+ */
+static void fill_task(task_pool *pool, void *ctx, size_t begin, size_t end, unsigned depth) {
+    parallel_count_ctx *p = ctx;
+    (void)pool;
+    (void)end;
+    (void)depth;
 
-    // Modify count array to store cumulative counts
-    for (int i = 1; i <= max; i++) {
-        count[i] += count[i - 1];
+    fill_from_counts(p->out + p->slots[begin].offset, p->slots[begin].total, p->counts,
+                     split_bound(p->range, p->tasks, begin),
+                     split_bound(p->range, p->tasks, begin + 1), p->min);
+}
+
+/**
+ * Allocate the private rows and per-task slots for `p->tasks` tasks over
+ * p->range keys; returns 0 on success
+ */
+static int alloc_private_rows(parallel_count_ctx *p) {
+    p->stride = (p->range + COUNTERS_PER_LINE - 1) / COUNTERS_PER_LINE * COUNTERS_PER_LINE;
+    p->rows = aligned_alloc(CACHE_LINE, p->tasks * p->stride * sizeof(uint32_t));
+    p->slots = aligned_alloc(CACHE_LINE, p->tasks * sizeof(counting_slot));
+    if (p->rows == NULL || p->slots == NULL) {
+        free(p->rows);
+        free(p->slots);
+        return -1;
     }
+    return 0;
+}
 
-    // Build output array
-    int *output = malloc(size * sizeof(int));
-    if (output == NULL) {
-        fprintf(stderr, "Error: Memory allocation failed\n");
-        free(count);
-        return;
+/**
+ * Frequency table of arr over [min_value, max_value]: counts[v - min_value]
+ * receives the number of keys equal to v; keys outside the domain are
+ * ignored. Inputs above COUNTING_PARALLEL_THRESHOLD are counted by
+ * `threads` tasks (<= 0: one per online CPU) into private histograms that
+ * are then reduced in parallel. Returns the number of keys counted, or -1
+ * if min_value > max_value or memory or threads are unavailable.
+ */
+int count_values(const int arr[], int size, int min_value, int max_value, uint32_t counts[],
+                 int threads) {
+    if (min_value > max_value) {
+        return -1;
+    }
+    if (threads <= 0) {
+        threads = task_pool_cpu_count();
     }
 
-    // Place elements in sorted order (iterate backwards for stability)
-    for (int i = size - 1; i >= 0; i--) {
-        output[count[arr[i]] - 1] = arr[i];
-        count[arr[i]]--;
+    uint64_t range = (uint64_t)((int64_t)max_value - min_value) + 1;
+    if (threads == 1 || size <= COUNTING_PARALLEL_THRESHOLD) {
+        memset(counts, 0, range * sizeof(uint32_t));
+        return (int)count_range(arr, (size_t)size, (uint32_t)min_value, range, counts);
     }
 
-    // Copy sorted elements back to original array
-    memcpy(arr, output, size * sizeof(int));
+    parallel_count_ctx p = {0};
+    p.src = arr;
+    p.n = (size_t)size;
+    p.tasks = (size_t)threads;
+    p.min = min_value;
+    p.range = range;
+    p.counts = counts;
 
-    free(count);
-    free(output);
+    task_pool *pool = alloc_private_rows(&p) == 0 ? task_pool_acquire(threads) : NULL;
+    if (pool == NULL) {
+        free(p.rows);
+        free(p.slots);
+        return -1;
+    }
+
+    task_pool_parallel_for(pool, private_histogram_task, &p, p.tasks);
+    task_pool_parallel_for(pool, reduce_task, &p, p.tasks);
+
+    size_t counted = 0;
+    for (size_t s = 0; s < p.tasks; s++) {
+        counted += p.slots[s].total;
+    }
+
+    task_pool_release(pool);
+    free(p.rows);
+    free(p.slots);
+    return (int)counted;
+}
+
+/**
+ * Multi-threaded counting sort of any int32 keys: parallel min/max,
+ * private per-task histograms, a parallel reduction over slices of the
+ * key range, a prefix sum over the slices, and a parallel fill of each
+ * slice's part of the output. Ranges beyond the default limits use
+ * radix_sort_parallel(). threads <= 0 means one per online CPU; small
+ * inputs and threads == 1 use counting_sort(). Returns 0 on success, -1
+ * if memory or threads are unavailable (arr is then unchanged).
+ */
+int counting_sort_parallel(int arr[], int size, int threads) {
+    if (threads <= 0) {
+        threads = task_pool_cpu_count();
+    }
+    if (threads == 1 || size <= COUNTING_PARALLEL_THRESHOLD) {
+        counting_sort_limits limits = counting_sort_default_limits();
+        return counting_sort_with_limits(arr, size, &limits) == COUNTING_SORT_FAILED ? -1 : 0;
+    }
+
+    parallel_count_ctx p = {0};
+    p.src = arr;
+    p.out = arr;
+    p.n = (size_t)size;
+    p.tasks = (size_t)threads;
+
+    p.slots = aligned_alloc(CACHE_LINE, p.tasks * sizeof(counting_slot));
+    task_pool *pool = p.slots != NULL ? task_pool_acquire(threads) : NULL;
+    if (pool == NULL) {
+        free(p.slots);
+        return -1;
+    }
+
+    task_pool_parallel_for(pool, min_max_task, &p, p.tasks);
+    int min = p.slots[0].min;
+    int max = p.slots[0].max;
+    for (size_t t = 1; t < p.tasks; t++) {
+        min = p.slots[t].min < min ? p.slots[t].min : min;
+        max = p.slots[t].max > max ? p.slots[t].max : max;
+    }
+    free(p.slots);
+    p.slots = NULL;
+
+    p.min = min;
+    p.range = (uint64_t)((int64_t)max - min) + 1;
+    counting_sort_limits limits = counting_sort_default_limits();
+    if (min == max) {
+        task_pool_release(pool);
+        return 0;
+    }
+    if (!range_fits(p.range, size, &limits)) {
+        task_pool_release(pool);
+        return radix_sort_parallel(arr, size, threads);
+    }
+
+    p.counts = malloc(p.range * sizeof(uint32_t));
+    if (p.counts == NULL || alloc_private_rows(&p) != 0) {
+        free(p.counts);
+        task_pool_release(pool);
+        return -1;
+    }
+
+    task_pool_parallel_for(pool, private_histogram_task, &p, p.tasks);
+    task_pool_parallel_for(pool, reduce_task, &p, p.tasks);
+
+    size_t offset = 0;
+    for (size_t s = 0; s < p.tasks; s++) {
+        p.slots[s].offset = offset;
+        offset += p.slots[s].total;
+    }
+
+    task_pool_parallel_for(pool, fill_task, &p, p.tasks);
+
+    task_pool_release(pool);
+    free(p.rows);
+    free(p.slots);
+    free(p.counts);
+    return 0;
 }
 
+#ifndef ROSETTA_NO_MAIN
+
 /**
  * Check if array is sorted
  */
@@ -102,11 +476,93 @@ void print_array(const int arr[], int size) {
     printf("]\n");
 }
 
+/**
+ * qsort comparator
+ */
+int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Input shapes of the sort_auto() sweep
+#define AUTO_SHAPES 7
+static const char *const auto_shape_names[AUTO_SHAPES] = {
+    "random", "sorted", "reversed", "sorted_99pct", "runs", "few_unique", "small_range"};
+
+/**
+ * Deterministic sort_auto() inputs; every shape but small_range spans
+ * far more values than counting sort takes, so the other rules decide
+ */
+void fill_auto_shape(int arr[], int size, uint64_t seed, int shape) {
+    int scale = (int)(2147483647 / size) < 1024 ? (int)(2147483647 / size) : 1024;
+    switch (shape) {
+    case 0:
+        bench_fill_random(arr, size, seed, 0);
+        return;
+    case 1:
+    case 2:
+        for (int i = 0; i < size; i++) {
+            arr[i] = (shape == 1 ? i : size - 1 - i) * scale;
+        }
+        return;
+    case 3:
+        bench_fill_sorted_fraction(arr, size, seed, 0.99);
+        break;
+    case 4:
+        bench_fill_runs(arr, size, seed, 16);
+        break;
+    case 5: {
+        int table[16];
+        bench_fill_random(table, 16, seed + 1, 0);
+        bench_fill_random(arr, size, seed, 16);
+        for (int i = 0; i < size; i++) {
+            arr[i] = table[arr[i]];
+        }
+        return;
+    }
+    default:
+        bench_fill_random(arr, size, seed, 1024);
+        return;
+    }
+    for (int i = 0; i < size; i++) {
+        arr[i] *= scale;
+    }
+}
+
+// Key distributions of the parallel sweep
+#define COUNTING_DISTRIBUTIONS 3
+static const char *const distribution_names[COUNTING_DISTRIBUTIONS] = {
+    "status", "ids", "wide"};
+
+/**
+ * Deterministic keys:
+ * 0 status  HTTP-like status codes in [100, 600), heavily skewed to a
+ *           handful of values
+ * 1 ids     uniform bucket ids in [0, 65536)
+ * 2 wide    signed full int32 range (radix path)
+ */
+void fill_distribution(int arr[], int size, uint64_t seed, int shape) {
+    static const int common_codes[] = {200, 200, 200, 200, 200, 304, 404, 500};
+    bench_fill_random(arr, size, seed, 0);
+    for (int i = 0; i < size; i++) {
+        unsigned r = (unsigned)arr[i];
+        if (shape == 0) {
+            arr[i] = r % 16 != 0 ? common_codes[r % 8] : 100 + (int)(r / 16 % 500);
+        } else if (shape == 1) {
+            arr[i] = (int)(r % 65536);
+        } else {
+            arr[i] = (int)(r * 2u);
+        }
+    }
+}
+
 /**
  * Run test suite
  */
 void run_tests(void) {
     printf("Running Counting Sort tests...\n");
+    counting_sort_limits limits = counting_sort_default_limits();
 
     // Test 1: Basic array
     int arr1[] = {4, 2, 2, 8, 3, 3, 1};
@@ -153,9 +609,522 @@ void run_tests(void) {
     assert(is_sorted(arr7, size7));
     assert(arr7[0] == 1 && arr7[4] == 200);
 
+    // Test 8: Negative keys and a range far from zero (min offset)
+    int arr8[] = {-3, 7, -3, 0, -10, 12, 7};
+    int size8 = sizeof(arr8) / sizeof(arr8[0]);
+    assert(counting_sort_with_limits(arr8, size8, &limits) == COUNTING_SORT_COUNTS);
+    assert(is_sorted(arr8, size8));
+    assert(arr8[0] == -10 && arr8[1] == -3 && arr8[6] == 12);
+
+    int arr9[] = {1000000005, 1000000000, 1000000003, 1000000000};
+    assert(counting_sort_with_limits(arr9, 4, &limits) == COUNTING_SORT_COUNTS);
+    assert(arr9[0] == 1000000000 && arr9[1] == 1000000000 && arr9[3] == 1000000005);
+
+    // Test 9: Wide ranges switch to radix sort, including INT_MIN..INT_MAX
+    int arr10[] = {2147483647, -2147483647 - 1, 0, -1, 1, 2147483647};
+    int size10 = sizeof(arr10) / sizeof(arr10[0]);
+    assert(counting_sort_with_limits(arr10, size10, &limits) == COUNTING_SORT_RADIX);
+    assert(is_sorted(arr10, size10));
+    assert(arr10[0] == -2147483647 - 1 && arr10[5] == 2147483647);
+
+    int arr11[] = {7, 7, 7};
+    assert(counting_sort_with_limits(arr11, 3, &limits) == COUNTING_SORT_TRIVIAL);
+
+    // Test 10: Both methods agree with qsort on either side of the limits
+    int size12 = 5000;
+    int *input = malloc(size12 * sizeof(int));
+    int *expected = malloc(size12 * sizeof(int));
+    int *actual = malloc(size12 * sizeof(int));
+    assert(input != NULL && expected != NULL && actual != NULL);
+
+    static const int ranges[] = {16, 5000, 20000, 20001, 1 << 20};
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+        bench_fill_random(input, size12, 3 + r, ranges[r]);
+        // Pin both ends so max - min + 1 is exactly ranges[r]
+        input[0] = 0;
+        input[1] = ranges[r] - 1;
+        for (int i = 0; i < size12; i++) {
+            input[i] -= ranges[r] / 2;
+        }
+        memcpy(expected, input, size12 * sizeof(int));
+        qsort(expected, size12, sizeof(int), compare_ints);
+
+        memcpy(actual, input, size12 * sizeof(int));
+        counting_sort_method method = counting_sort_with_limits(actual, size12, &limits);
+        assert(memcmp(expected, actual, size12 * sizeof(int)) == 0);
+        // Ranges up to 4 * n are counted
+        assert(method == (r < 3 ? COUNTING_SORT_COUNTS : COUNTING_SORT_RADIX));
+
+        // A budget one counter short of the range forces radix sort
+        counting_sort_limits tight = {COUNTING_SORT_RANGE_FACTOR,
+                                      (ranges[r] - 1) * sizeof(uint32_t)};
+        memcpy(actual, input, size12 * sizeof(int));
+        assert(counting_sort_with_limits(actual, size12, &tight) == COUNTING_SORT_RADIX);
+        assert(memcmp(expected, actual, size12 * sizeof(int)) == 0);
+    }
+
+    free(input);
+    free(expected);
+    free(actual);
+
+    // Test 11: Parallel sort matches qsort for odd thread counts on every
+    // scaling distribution (the wide one takes the radix path)
+    static const int parallel_sizes[] = {70001, 100003};
+    static const int parallel_threads[] = {2, 3, 4, 7};
+    for (size_t t = 0; t < sizeof(parallel_sizes) / sizeof(parallel_sizes[0]); t++) {
+        int size = parallel_sizes[t];
+        input = malloc(size * sizeof(int));
+        expected = malloc(size * sizeof(int));
+        actual = malloc(size * sizeof(int));
+        assert(input != NULL && expected != NULL && actual != NULL);
+
+        for (int shape = 0; shape < COUNTING_DISTRIBUTIONS; shape++) {
+            fill_distribution(input, size, 31 + t, shape);
+            memcpy(expected, input, size * sizeof(int));
+            qsort(expected, size, sizeof(int), compare_ints);
+
+            for (size_t k = 0; k < sizeof(parallel_threads) / sizeof(parallel_threads[0]); k++) {
+                memcpy(actual, input, size * sizeof(int));
+                assert(counting_sort_parallel(actual, size, parallel_threads[k]) == 0);
+                assert(memcmp(expected, actual, size * sizeof(int)) == 0);
+            }
+        }
+
+        free(input);
+        free(expected);
+        free(actual);
+    }
+
+    // Test 12: count_values() matches a direct count, sequential and
+    // parallel, and ignores keys outside the domain
+    int size13 = 100003;
+    int *keys = malloc(size13 * sizeof(int));
+    uint32_t *counts = malloc(400 * sizeof(uint32_t));
+    uint32_t reference[400] = {0};
+    assert(keys != NULL && counts != NULL);
+
+    fill_distribution(keys, size13, 41, 0);  // status codes 100..599
+    int in_domain = 0;
+    for (int i = 0; i < size13; i++) {
+        if (keys[i] >= 150 && keys[i] < 550) {
+            reference[keys[i] - 150]++;
+            in_domain++;
+        }
+    }
+    for (int threads = 1; threads <= 4; threads++) {
+        assert(count_values(keys, size13, 150, 549, counts, threads) == in_domain);
+        assert(memcmp(counts, reference, sizeof(reference)) == 0);
+    }
+    assert(count_values(keys, 1000, 150, 549, counts, 1) > 0);
+    assert(count_values(keys, size13, 1, 0, counts, 1) == -1);
+
+    int extremes[] = {-2147483647 - 1, 2147483647, 0};
+    uint32_t edge[2];
+    assert(count_values(extremes, 3, 2147483646, 2147483647, edge, 1) == 1);
+    assert(edge[0] == 0 && edge[1] == 1);
+
+    free(keys);
+    free(counts);
+
+    // Test 13: sort_auto() matches qsort on every shape, across the
+    // small-n, counting and sampled rules
+    static const int auto_sizes[] = {0, 1, 2, 7, 100, 2047, 2048, 5000, 100003};
+    int max_auto = 100003;
+    int *auto_input = malloc(max_auto * sizeof(int));
+    int *auto_expected = malloc(max_auto * sizeof(int));
+    int *auto_actual = malloc(max_auto * sizeof(int));
+    assert(auto_input != NULL && auto_expected != NULL && auto_actual != NULL);
+
+    for (size_t s = 0; s < sizeof(auto_sizes) / sizeof(auto_sizes[0]); s++) {
+        int n = auto_sizes[s];
+        for (int shape = 0; shape < AUTO_SHAPES && n > 0; shape++) {
+            fill_auto_shape(auto_input, n, 43 + shape, shape);
+            memcpy(auto_expected, auto_input, n * sizeof(int));
+            qsort(auto_expected, n, sizeof(int), compare_ints);
+            for (int e = 0; e < SORT_AUTO_ENGINE_COUNT; e++) {
+                memcpy(auto_actual, auto_input, n * sizeof(int));
+                sort_auto_run((sort_auto_engine)e, auto_actual, n, 2);
+                if (e != SORT_AUTO_TRIVIAL || n < 2) {
+                    assert(memcmp(auto_actual, auto_expected, n * sizeof(int)) == 0);
+                }
+            }
+            memcpy(auto_actual, auto_input, n * sizeof(int));
+            sort_auto(auto_actual, n);
+            assert(memcmp(auto_actual, auto_expected, n * sizeof(int)) == 0);
+        }
+    }
+
+    // Test 14: engine choices under the default profile
+    sort_auto_profile profile = sort_auto_default_profile();
+    profile.threads = 1;
+    int big = 100003;
+    const struct {
+        int size;
+        int shape;
+        sort_auto_engine engine;
+    } choices[] = {
+        {1, 0, SORT_AUTO_TRIVIAL},           {100, 0, SORT_AUTO_INTROSORT},
+        {big, 6, SORT_AUTO_COUNTING},        {big, 0, SORT_AUTO_RADIX},
+        {big, 1, SORT_AUTO_MERGESORT_ADAPTIVE}, {big, 2, SORT_AUTO_MERGESORT_ADAPTIVE},
+        {big, 3, SORT_AUTO_MERGESORT_ADAPTIVE}, {big, 4, SORT_AUTO_RADIX},
+        {big, 5, SORT_AUTO_RADIX},
+    };
+    for (size_t c = 0; c < sizeof(choices) / sizeof(choices[0]); c++) {
+        fill_auto_shape(auto_input, choices[c].size, 44, choices[c].shape);
+        assert(sort_auto_with_profile(auto_input, choices[c].size, &profile) ==
+               choices[c].engine);
+        assert(is_sorted(auto_input, choices[c].size));
+    }
+    profile.duplicate_min = 0.5;
+    fill_auto_shape(auto_input, big, 44, 5);
+    assert(sort_auto_with_profile(auto_input, big, &profile) == SORT_AUTO_INTROSORT);
+    profile.radix_min_n = SIZE_MAX;
+    fill_auto_shape(auto_input, big, 44, 0);
+    assert(sort_auto_with_profile(auto_input, big, &profile) == SORT_AUTO_INTROSORT);
+
+    free(auto_input);
+    free(auto_expected);
+    free(auto_actual);
+
+    // Test 15: profiles round-trip through a file; malformed files are
+    // rejected and leave the profile untouched
+    char profile_path[] = "/tmp/sort_auto_profile_XXXXXX";
+    int profile_fd = mkstemp(profile_path);
+    assert(profile_fd >= 0);
+    close(profile_fd);
+
+    sort_auto_profile saved = sort_auto_default_profile();
+    saved.radix_min_n = 1234;
+    saved.parallel_min_n = SIZE_MAX;
+    saved.counting_range_factor = 2.5;
+    saved.presorted_max = 0.125;
+    saved.threads = 3;
+    assert(sort_auto_save_profile(profile_path, &saved) == 0);
+    sort_auto_profile loaded = sort_auto_default_profile();
+    assert(sort_auto_load_profile(profile_path, &loaded) == 0);
+    assert(loaded.radix_min_n == 1234 && loaded.parallel_min_n == SIZE_MAX);
+    assert(loaded.counting_range_factor == 2.5 && loaded.presorted_max == 0.125);
+    assert(loaded.counting_max_bytes == saved.counting_max_bytes && loaded.threads == 3);
+
+    static const char *const malformed[] = {"radix_min_n\n", "radix_min_n 12x\n",
+                                            "no_such_key 1\n", "threads -1\n",
+                                            "radix_min_n 1 2\n"};
+    for (size_t m = 0; m < sizeof(malformed) / sizeof(malformed[0]); m++) {
+        FILE *f = fopen(profile_path, "w");
+        assert(f != NULL);
+        fprintf(f, "# comment\n\nradix_min_n 99\n%s", malformed[m]);
+        fclose(f);
+        sort_auto_profile untouched = saved;
+        assert(sort_auto_load_profile(profile_path, &untouched) == -1 && errno == EINVAL);
+        assert(untouched.radix_min_n == 1234);
+    }
+    unlink(profile_path);
+    assert(sort_auto_load_profile(profile_path, &loaded) == -1);
+
     printf("✓ All tests passed\n");
 }
 
+/**
+ * Benchmark context: pristine input plus a scratch copy restored before each run
+ */
+typedef struct {
+    const int *input;
+    int *work;
+    int size;
+    int threads;
+} sort_bench_ctx;
+
+static void restore_input(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    memcpy(c->work, c->input, c->size * sizeof(int));
+}
+
+static void bench_counting_sort(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    counting_sort(c->work, c->size);
+    bench_escape(c->work);
+}
+
+static void bench_counting_sort_parallel(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    counting_sort_parallel(c->work, c->size, c->threads);
+    bench_escape(c->work);
+}
+
+/**
+ * Frequency table only, over the status-code domain
+ */
+static void bench_count_values(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    uint32_t counts[500];
+    count_values(c->input, c->size, 100, 599, counts, c->threads);
+    bench_escape(counts);
+}
+
+/**
+ * Run benchmark suite on deterministic random input
+ */
+int run_benchmarks(void) {
+    printf("Running Counting Sort benchmarks...\n");
+
+    static const int sizes[] = {1000, 10000, 100000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/021-counting-sort");
+    for (int s = 0; s < num_sizes; s++) {
+        int size = sizes[s];
+        int *input = malloc(size * sizeof(int));
+        int *work = malloc(size * sizeof(int));
+
+        if (input == NULL || work == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(input);
+            free(work);
+            return 1;
+        }
+
+        bench_fill_random(input, size, 42, size);
+        sort_bench_ctx ctx = {input, work, size, 1};
+
+        snprintf(name, sizeof(name), "counting_sort/n=%d", size);
+        bench_measure(name, bench_counting_sort, restore_input, &ctx);
+
+        // Same spread far from zero: counted with a min offset
+        for (int i = 0; i < size; i++) {
+            input[i] += 1000000000;
+        }
+        snprintf(name, sizeof(name), "counting_sort/offset/n=%d", size);
+        bench_measure(name, bench_counting_sort, restore_input, &ctx);
+
+        // Signed full int32 range: handed to radix sort
+        bench_fill_random(input, size, 42, 0);
+        for (int i = 0; i < size; i++) {
+            input[i] = (int)((unsigned)input[i] * 2u);
+        }
+        snprintf(name, sizeof(name), "counting_sort/wide/n=%d", size);
+        bench_measure(name, bench_counting_sort, restore_input, &ctx);
+
+        fill_distribution(input, size, 42, 0);
+        snprintf(name, sizeof(name), "count_values/status/n=%d", size);
+        bench_measure(name, bench_count_values, NULL, &ctx);
+
+        free(input);
+        free(work);
+    }
+
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * Thread sweep of counting_sort_parallel() and count_values() (1, 2, 4,
+ * ... max_threads) for each key distribution, against the sequential
+ * counting_sort(), with and without pinned workers for the sort; same
+ * layout as the other scaling tables
+ */
+int run_scaling(int max_threads, int size) {
+    printf("Counting Sort scaling (n=%d, up to %d threads):\n", size, max_threads);
+
+    topology_report(stdout);
+
+    size_t bytes = (size_t)size * sizeof(int);
+    int *input = malloc(bytes);
+    int *work = topology_alloc(bytes, TOPOLOGY_BLOCKED | TOPOLOGY_HUGE_PAGES);
+    if (input == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(input);
+        topology_free(work, bytes);
+        return 1;
+    }
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/021-counting-sort");
+    task_pool_set_default_affinity(TASK_POOL_AFFINITY_NONE);
+    for (int shape = 0; shape < COUNTING_DISTRIBUTIONS; shape++) {
+        const char *dist = distribution_names[shape];
+        fill_distribution(input, size, 42, shape);
+        sort_bench_ctx ctx = {input, work, size, 1};
+
+        snprintf(name, sizeof(name), "counting_sort/%s/n=%d", dist, size);
+        bench_run(name, bench_counting_sort, restore_input, &ctx, &config, &result);
+        bench_report(&result);
+        double sequential_ns = result.median_ns;
+
+        for (int threads = 1;; threads *= 2) {
+            if (threads > max_threads) {
+                threads = max_threads;
+            }
+            ctx.threads = threads;
+
+            snprintf(name, sizeof(name), "counting_sort_parallel/%s/n=%d/t=%d", dist, size,
+                     threads);
+            bench_run(name, bench_counting_sort_parallel, restore_input, &ctx, &config, &result);
+            bench_record(&result);
+
+            double unpinned_ns = result.median_ns;
+            double speedup = sequential_ns / unpinned_ns;
+            printf("  %-7s threads=%-3d median %10.3f ms  speedup %5.2fx  efficiency %5.1f%%",
+                   dist, threads, unpinned_ns / 1e6, speedup, 100.0 * speedup / threads);
+
+            if (threads > 1) {
+                task_pool_set_default_affinity(TASK_POOL_AFFINITY_PINNED);
+                snprintf(name, sizeof(name), "counting_sort_parallel/%s/n=%d/t=%d/pinned", dist,
+                         size, threads);
+                bench_run(name, bench_counting_sort_parallel, restore_input, &ctx, &config,
+                          &result);
+                bench_record(&result);
+                printf("  pinned %10.3f ms (%5.2fx)", result.median_ns / 1e6,
+                       unpinned_ns / result.median_ns);
+                task_pool_set_default_affinity(TASK_POOL_AFFINITY_NONE);
+            }
+            printf("\n");
+
+            if (shape == 0) {
+                snprintf(name, sizeof(name), "count_values/%s/n=%d/t=%d", dist, size, threads);
+                bench_run(name, bench_count_values, NULL, &ctx, &config, &result);
+                bench_record(&result);
+                printf("  %-7s threads=%-3d count_values %10.3f ms\n", dist, threads,
+                       result.median_ns / 1e6);
+            }
+
+            if (threads == max_threads) {
+                break;
+            }
+        }
+    }
+
+    task_pool_set_default_affinity(TASK_POOL_AFFINITY_AUTO);
+
+    free(input);
+    topology_free(work, bytes);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+static void bench_sort_auto(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    sort_auto(c->work, c->size);
+    bench_escape(c->work);
+}
+
+typedef struct {
+    sort_bench_ctx base;
+    sort_auto_engine engine;
+} engine_bench_ctx;
+
+static void bench_engine(void *ctx) {
+    engine_bench_ctx *c = ctx;
+    sort_auto_run(c->engine, c->base.work, c->base.size, c->base.threads);
+    bench_escape(c->base.work);
+}
+
+/**
+ * sort_auto() against every single engine over a mix of input shapes:
+ * per shape the engine it picked and the fastest one, then the totals
+ * for the whole mix (what one fixed choice would have cost)
+ */
+int run_auto(int size) {
+    printf("sort_auto() over mixed inputs (n=%d):\n", size);
+
+    int *input = malloc(size * sizeof(int));
+    int *work = malloc(size * sizeof(int));
+    if (input == NULL || work == NULL) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        free(input);
+        free(work);
+        return 1;
+    }
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+    double engine_total[SORT_AUTO_ENGINE_COUNT] = {0};
+    double auto_total = 0.0;
+
+    bench_begin("algorithms/021-counting-sort");
+    for (int shape = 0; shape < AUTO_SHAPES; shape++) {
+        const char *shape_name = auto_shape_names[shape];
+        fill_auto_shape(input, size, 42, shape);
+
+        // Dry run on a copy to learn the choice
+        memcpy(work, input, size * sizeof(int));
+        sort_auto_engine chosen = sort_auto(work, size);
+
+        engine_bench_ctx ctx = {{input, work, size, 0}, SORT_AUTO_COUNTING};
+        snprintf(name, sizeof(name), "sort_auto/%s/n=%d", shape_name, size);
+        bench_run(name, bench_sort_auto, restore_input, &ctx.base, &config, &result);
+        bench_record(&result);
+        double auto_ns = result.median_ns;
+        auto_total += auto_ns;
+
+        sort_auto_engine fastest = SORT_AUTO_COUNTING;
+        double fastest_ns = 0.0;
+        for (int e = SORT_AUTO_COUNTING; e < SORT_AUTO_ENGINE_COUNT; e++) {
+            ctx.engine = (sort_auto_engine)e;
+            snprintf(name, sizeof(name), "%s/%s/n=%d", sort_auto_engine_name(ctx.engine),
+                     shape_name, size);
+            bench_run(name, bench_engine, restore_input, &ctx, &config, &result);
+            bench_record(&result);
+            engine_total[e] += result.median_ns;
+            if (e == SORT_AUTO_COUNTING || result.median_ns < fastest_ns) {
+                fastest = ctx.engine;
+                fastest_ns = result.median_ns;
+            }
+        }
+        printf("  %-12s sort_auto %9.3f ms (%-18s)  fastest %9.3f ms (%s)\n", shape_name,
+               auto_ns / 1e6, sort_auto_engine_name(chosen), fastest_ns / 1e6,
+               sort_auto_engine_name(fastest));
+    }
+
+    printf("  mixed total: sort_auto %.3f ms\n", auto_total / 1e6);
+    for (int e = SORT_AUTO_COUNTING; e < SORT_AUTO_ENGINE_COUNT; e++) {
+        printf("  mixed total: %-18s %9.3f ms  (%5.2fx sort_auto)\n",
+               sort_auto_engine_name((sort_auto_engine)e), engine_total[e] / 1e6,
+               engine_total[e] / auto_total);
+    }
+
+    free(input);
+    free(work);
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * Measure this machine's thresholds and write them to path
+ */
+int run_calibrate(int size, const char *path) {
+    printf("Calibrating sort_auto() (up to n=%d):\n", size);
+    sort_auto_profile profile = sort_auto_default_profile();
+    if (sort_auto_calibrate(&profile, size, stdout) != 0) {
+        fprintf(stderr, "Error: Memory allocation failed\n");
+        return 1;
+    }
+    if (sort_auto_save_profile(path, &profile) != 0) {
+        perror(path);
+        return 1;
+    }
+    printf("Wrote %s (use with ROSETTA_SORT_PROFILE=%s)\n", path, path);
+    return 0;
+}
+
+/**
+ * counting_sort() for int_io_run_sort(); -1 when the counters cannot be
+ * allocated, so the CLI fails instead of writing the input unsorted
+ */
+static int sort_stream(int arr[], int size) {
+    counting_sort_limits limits = counting_sort_default_limits();
+    return counting_sort_with_limits(arr, size, &limits) == COUNTING_SORT_FAILED ? -1 : 0;
+}
+
 /**
  * Main entry point
  */
@@ -166,12 +1135,61 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // If "benchmark" argument, run benchmarks
+    if (argc == 2 && strcmp(argv[1], "benchmark") == 0) {
+        return run_benchmarks();
+    }
+
+    // "scaling [max_threads] [size]": parallel thread sweep
+    if (argc >= 2 && argc <= 4 && strcmp(argv[1], "scaling") == 0) {
+        int max_threads = argc > 2 ? atoi(argv[2]) : task_pool_cpu_count();
+        int size = argc > 3 ? atoi(argv[3]) : 10000000;
+        if (max_threads < 1 || size < 1) {
+            fprintf(stderr, "Error: Invalid scaling arguments\n");
+            return 1;
+        }
+        return run_scaling(max_threads, size);
+    }
+
+    // "auto [size]": sort_auto() against each engine over mixed shapes
+    if (argc >= 2 && argc <= 3 && strcmp(argv[1], "auto") == 0) {
+        int size = argc > 2 ? atoi(argv[2]) : 1000000;
+        if (size < 1) {
+            fprintf(stderr, "Error: Invalid size\n");
+            return 1;
+        }
+        return run_auto(size);
+    }
+
+    // "calibrate [size] [profile]": per-machine sort_auto() thresholds
+    if (argc >= 2 && argc <= 4 && strcmp(argv[1], "calibrate") == 0) {
+        int size = argc > 2 ? atoi(argv[2]) : 1000000;
+        if (size < 1) {
+            fprintf(stderr, "Error: Invalid size\n");
+            return 1;
+        }
+        return run_calibrate(size, argc > 3 ? argv[3] : "sort_auto.profile");
+    }
+
+    // "sort [options]": bulk input / output through int_io.h
+    if (argc >= 2 && strcmp(argv[1], "sort") == 0) {
+        int_io_options options;
+        if (int_io_parse_args(argc, argv, 2, 0, &options) != 0) {
+            return 1;
+        }
+        return int_io_run_sort(&options, "counting_sort", sort_stream);
+    }
+
     // Otherwise, parse array from command line
     if (argc < 2) {
         printf("Usage: %s <num1> <num2> <num3> ...\n", argv[0]);
         printf("       %s test\n", argv[0]);
+        printf("       %s benchmark\n", argv[0]);
+        printf("       %s scaling [max_threads] [size]\n", argv[0]);
+        printf("       %s auto [size]\n", argv[0]);
+        printf("       %s calibrate [size] [profile]\n", argv[0]);
+        printf("       %s sort " INT_IO_USAGE "\n", argv[0]);
         printf("\nExample: %s 4 2 2 8 3 3 1\n", argv[0]);
-        printf("\nNote: Only works with non-negative integers\n");
         return 1;
     }
 
@@ -186,11 +1204,6 @@ int main(int argc, char *argv[]) {
     // Parse array elements
     for (int i = 0; i < size; i++) {
         arr[i] = atoi(argv[i + 1]);
-        if (arr[i] < 0) {
-            fprintf(stderr, "Error: Counting sort only works with non-negative integers\n");
-            free(arr);
-            return 1;
-        }
     }
 
     printf("Before: ");
@@ -204,3 +1217,5 @@ int main(int argc, char *argv[]) {
     free(arr);
     return 0;
 }
+
+#endif  // ROSETTA_NO_MAIN
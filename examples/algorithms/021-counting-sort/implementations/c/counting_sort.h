@@ -0,0 +1,62 @@
+/**
+ * Counting Sort Algorithms - Public Interface
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Other implementations link counting_sort.c compiled with
+ * -DROSETTA_NO_MAIN, which drops the test/benchmark driver.
+ */
+
+#ifndef ROSETTA_COUNTING_SORT_H
+#define ROSETTA_COUNTING_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * When counting_sort() counts instead of radix sorting: the key range
+ * max - min + 1 must be at most range_factor * n, and its uint32 counters
+ * at most max_count_bytes
+ */
+typedef struct {
+    size_t range_factor;
+    size_t max_count_bytes;
+} counting_sort_limits;
+
+typedef enum {
+    COUNTING_SORT_FAILED = -1,  // Out of memory; arr unchanged
+    COUNTING_SORT_TRIVIAL,      // Fewer than two distinct keys
+    COUNTING_SORT_COUNTS,       // Histogram over [min, max]
+    COUNTING_SORT_RADIX         // Range too wide: radix sort
+} counting_sort_method;
+
+counting_sort_limits counting_sort_default_limits(void);
+
+/**
+ * Minimum and maximum in one pass (SIMD reduction from common/c/reduce.c)
+ */
+void find_min_max(const int arr[], int size, int *min_out, int *max_out);
+
+/**
+ * Counting sort of any int32 keys, radix sorting ranges outside limits.
+ * Returns the method used.
+ */
+counting_sort_method counting_sort_with_limits(int arr[], int size,
+                                               const counting_sort_limits *limits);
+void counting_sort(int arr[], int size);
+
+/**
+ * Frequency table of arr over [min_value, max_value] (threads <= 0: one
+ * per CPU). Returns the number of keys counted, or -1.
+ */
+int count_values(const int arr[], int size, int min_value, int max_value, uint32_t counts[],
+                 int threads);
+
+/**
+ * Multi-threaded counting sort (threads <= 0: one per CPU). Returns 0, or
+ * -1 if memory or threads are unavailable (arr is then unchanged).
+ */
+int counting_sort_parallel(int arr[], int size, int threads);
+
+#endif  // ROSETTA_COUNTING_SORT_H
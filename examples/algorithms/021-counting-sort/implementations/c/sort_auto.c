@@ -0,0 +1,657 @@
+/**
+ * Adaptive Sort Dispatcher
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#define _GNU_SOURCE
+
+#include "sort_auto.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "counting_sort.h"
+#include "mergesort.h"
+#include "quicksort.h"
+#include "radix_sort.h"
+#include "reduce.h"
+#include "task_pool.h"
+
+// Presortedness sample: this many runs of this many adjacent pairs
+#define SORT_AUTO_DESCENT_BLOCKS 32
+#define SORT_AUTO_DESCENT_PAIRS 32
+
+// Keys of the strided sample whose pairwise order gives the inversion ratio
+#define SORT_AUTO_INVERSION_KEYS 64
+
+// Slots of the open-addressing table counting distinct sampled keys
+#define SORT_AUTO_HASH_SLOTS 512
+#define SORT_AUTO_HASH_SHIFT 23  // 32 - log2(SORT_AUTO_HASH_SLOTS)
+
+// Widest range (per key) the counting engine counts rather than radix sorts
+#define SORT_AUTO_COUNTING_MAX_FACTOR 64
+
+// Calibration: best of this many timings per point
+#define CALIBRATE_REPS 3
+
+// Calibration: keys sorted per timing of small sizes (in batches)
+#define CALIBRATE_BATCH_KEYS (1u << 18)
+
+// Calibration: a parallel engine must be this much faster to count
+#define CALIBRATE_PARALLEL_GAIN 0.9
+
+static const char *const ENGINE_NAMES[SORT_AUTO_ENGINE_COUNT] = {
+    "trivial", "counting",           "counting_parallel", "introsort",
+    "introsort_parallel", "mergesort_adaptive", "radix",  "radix_parallel",
+};
+
+const char *sort_auto_engine_name(sort_auto_engine engine) {
+    return engine >= 0 && engine < SORT_AUTO_ENGINE_COUNT ? ENGINE_NAMES[engine] : "unknown";
+}
+
+sort_auto_profile sort_auto_default_profile(void) {
+    sort_auto_profile profile;
+    profile.radix_min_n = 1024;
+    profile.parallel_min_n = SIZE_MAX;
+    profile.counting_range_factor = 4.0;
+    profile.counting_max_bytes = 16u << 20;
+    profile.presorted_max = 0.05;
+    profile.duplicate_min = 0.96;
+    profile.threads = 0;
+    return profile;
+}
+
+/*
+ * Profile files
+ */
+
+typedef enum { FIELD_SIZE, FIELD_DOUBLE, FIELD_INT } field_type;
+
+typedef struct {
+    const char *key;
+    field_type type;
+    size_t offset;
+} profile_field;
+
+static const profile_field PROFILE_FIELDS[] = {
+    {"radix_min_n", FIELD_SIZE, offsetof(sort_auto_profile, radix_min_n)},
+    {"parallel_min_n", FIELD_SIZE, offsetof(sort_auto_profile, parallel_min_n)},
+    {"counting_range_factor", FIELD_DOUBLE, offsetof(sort_auto_profile, counting_range_factor)},
+    {"counting_max_bytes", FIELD_SIZE, offsetof(sort_auto_profile, counting_max_bytes)},
+    {"presorted_max", FIELD_DOUBLE, offsetof(sort_auto_profile, presorted_max)},
+    {"duplicate_min", FIELD_DOUBLE, offsetof(sort_auto_profile, duplicate_min)},
+    {"threads", FIELD_INT, offsetof(sort_auto_profile, threads)},
+};
+
+#define PROFILE_FIELD_COUNT (sizeof(PROFILE_FIELDS) / sizeof(PROFILE_FIELDS[0]))
+
+/**
+ * Store value into the field of profile named key; 0 or -1
+ */
+static int set_field(sort_auto_profile *profile, const char *key, const char *value) {
+    for (size_t f = 0; f < PROFILE_FIELD_COUNT; f++) {
+        if (strcmp(key, PROFILE_FIELDS[f].key) != 0) {
+            continue;
+        }
+        char *slot = (char *)profile + PROFILE_FIELDS[f].offset;
+        char *end = NULL;
+        errno = 0;
+        if (PROFILE_FIELDS[f].type == FIELD_DOUBLE) {
+            double v = strtod(value, &end);
+            if (*end != '\0' || errno != 0) {
+                return -1;
+            }
+            memcpy(slot, &v, sizeof(v));
+        } else {
+            if (value[0] == '-') {
+                return -1;
+            }
+            unsigned long long v = strtoull(value, &end, 10);
+            if (*end != '\0' || errno != 0 || end == value) {
+                return -1;
+            }
+            if (PROFILE_FIELDS[f].type == FIELD_SIZE) {
+                size_t s = v > SIZE_MAX ? SIZE_MAX : (size_t)v;
+                memcpy(slot, &s, sizeof(s));
+            } else {
+                if (v > 4096) {
+                    return -1;
+                }
+                int t = (int)v;
+                memcpy(slot, &t, sizeof(t));
+            }
+        }
+        return 0;
+    }
+    return -1;
+}
+
+int sort_auto_load_profile(const char *path, sort_auto_profile *profile) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+
+    sort_auto_profile loaded = *profile;
+    char line[256];
+    int status = 0;
+    while (status == 0 && fgets(line, sizeof(line), f) != NULL) {
+        char key[64];
+        char value[64];
+        char extra;
+        char *p = line + strspn(line, " \t");
+        if (*p == '#' || *p == '\n' || *p == '\0') {
+            continue;
+        }
+        if (sscanf(p, "%63s %63s %c", key, value, &extra) != 2 ||
+            set_field(&loaded, key, value) != 0) {
+            status = -1;
+        }
+    }
+    if (status == 0 && ferror(f)) {
+        status = -1;
+    } else if (status != 0) {
+        errno = EINVAL;
+    }
+    int saved_errno = errno;
+    fclose(f);
+    errno = saved_errno;
+
+    if (status == 0) {
+        *profile = loaded;
+    }
+    return status;
+}
+
+int sort_auto_save_profile(const char *path, const sort_auto_profile *profile) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        return -1;
+    }
+
+    int ok = fprintf(f, "# sort_auto profile (021-counting-sort: ./counting_sort calibrate)\n") > 0;
+    for (size_t i = 0; i < PROFILE_FIELD_COUNT && ok; i++) {
+        const char *slot = (const char *)profile + PROFILE_FIELDS[i].offset;
+        if (PROFILE_FIELDS[i].type == FIELD_DOUBLE) {
+            double v;
+            memcpy(&v, slot, sizeof(v));
+            ok = fprintf(f, "%s %.6g\n", PROFILE_FIELDS[i].key, v) > 0;
+        } else if (PROFILE_FIELDS[i].type == FIELD_SIZE) {
+            size_t v;
+            memcpy(&v, slot, sizeof(v));
+            ok = fprintf(f, "%s %zu\n", PROFILE_FIELDS[i].key, v) > 0;
+        } else {
+            int v;
+            memcpy(&v, slot, sizeof(v));
+            ok = fprintf(f, "%s %d\n", PROFILE_FIELDS[i].key, v) > 0;
+        }
+    }
+    ok &= fclose(f) == 0;
+    return ok ? 0 : -1;
+}
+
+/*
+ * Features and dispatch
+ */
+
+static int fits_counting(const sort_auto_features *features, const sort_auto_profile *profile) {
+    uint64_t range = (uint64_t)((int64_t)features->max - (int64_t)features->min) + 1;
+    return (double)range <= profile->counting_range_factor * (double)features->n &&
+           range <= profile->counting_max_bytes / sizeof(uint32_t);
+}
+
+/**
+ * Fraction of descending pairs among SORT_AUTO_DESCENT_BLOCKS runs of
+ * SORT_AUTO_DESCENT_PAIRS adjacent pairs spread evenly over arr: many
+ * pairs for the estimate, few cache lines for the cost
+ */
+static double sample_descents(const int arr[], size_t n) {
+    size_t pairs = n - 1;
+    size_t block = pairs / SORT_AUTO_DESCENT_BLOCKS;
+    if (block < SORT_AUTO_DESCENT_PAIRS) {
+        size_t descents = 0;
+        for (size_t i = 0; i < pairs; i++) {
+            descents += arr[i + 1] < arr[i];
+        }
+        return (double)descents / (double)pairs;
+    }
+
+    size_t descents = 0;
+    for (size_t b = 0; b < SORT_AUTO_DESCENT_BLOCKS; b++) {
+        const int *p = arr + b * block;
+        for (size_t i = 0; i < SORT_AUTO_DESCENT_PAIRS; i++) {
+            descents += p[i + 1] < p[i];
+        }
+    }
+    return (double)descents / (double)(SORT_AUTO_DESCENT_BLOCKS * SORT_AUTO_DESCENT_PAIRS);
+}
+
+/**
+ * Fraction of inverted pairs among SORT_AUTO_INVERSION_KEYS strided
+ * keys. Descents alone cannot tell a few keys out of place (cheap to
+ * merge) from a few long runs that interleave in value (a full merge
+ * per level); the sampled inversions can.
+ */
+static double sample_inversions(const int arr[], size_t n) {
+    int keys[SORT_AUTO_INVERSION_KEYS];
+    size_t taken = n < SORT_AUTO_INVERSION_KEYS ? n : SORT_AUTO_INVERSION_KEYS;
+    size_t stride = n / taken;
+    for (size_t k = 0; k < taken; k++) {
+        keys[k] = arr[k * stride];
+    }
+
+    unsigned inversions = 0;
+    for (size_t i = 0; i + 1 < taken; i++) {
+        for (size_t j = i + 1; j < taken; j++) {
+            inversions += keys[j] < keys[i];
+        }
+    }
+    return (double)inversions / (double)(taken * (taken - 1) / 2);
+}
+
+/**
+ * 1 - distinct / sampled over up to SORT_AUTO_SAMPLE strided keys,
+ * counted in a small open-addressing table
+ */
+static double sample_duplicates(const int arr[], size_t n) {
+    int slots[SORT_AUTO_HASH_SLOTS];
+    unsigned char used[SORT_AUTO_HASH_SLOTS];
+    memset(used, 0, sizeof(used));
+
+    size_t taken = n < SORT_AUTO_SAMPLE ? n : SORT_AUTO_SAMPLE;
+    size_t stride = n / taken;
+    size_t distinct = 0;
+    for (size_t k = 0; k < taken; k++) {
+        int key = arr[k * stride];
+        uint32_t h = ((uint32_t)key * 0x9E3779B1u) >> SORT_AUTO_HASH_SHIFT;
+        while (used[h] && slots[h] != key) {
+            h = (h + 1) & (SORT_AUTO_HASH_SLOTS - 1);
+        }
+        if (!used[h]) {
+            used[h] = 1;
+            slots[h] = key;
+            distinct++;
+        }
+    }
+    return 1.0 - (double)distinct / (double)taken;
+}
+
+void sort_auto_sample(const int arr[], int size, const sort_auto_profile *profile,
+                      sort_auto_features *features) {
+    size_t n = size > 0 ? (size_t)size : 0;
+    features->n = n;
+    features->min = 0;
+    features->max = 0;
+    features->descents = 0.5;
+    features->inversions = 0.5;
+    features->duplicates = 0.0;
+    features->threads = 1;
+    if (n < 2) {
+        return;
+    }
+
+    reduce_minmax(arr, n, &features->min, &features->max);
+    if (n >= profile->parallel_min_n) {
+        features->threads = profile->threads > 0 ? profile->threads : task_pool_cpu_count();
+    }
+    // The sampled ratios only matter past the counting and small-n rules
+    if (fits_counting(features, profile) || n < profile->radix_min_n) {
+        return;
+    }
+    features->descents = sample_descents(arr, n);
+    if (features->descents <= profile->presorted_max ||
+        features->descents >= 1.0 - profile->presorted_max) {
+        features->inversions = sample_inversions(arr, n);
+    }
+    features->duplicates = sample_duplicates(arr, n);
+}
+
+sort_auto_engine sort_auto_choose(const sort_auto_features *features,
+                                  const sort_auto_profile *profile) {
+    if (features->n < 2) {
+        return SORT_AUTO_TRIVIAL;
+    }
+    int parallel = features->threads > 1 && features->n >= profile->parallel_min_n;
+
+    if (fits_counting(features, profile)) {
+        return parallel ? SORT_AUTO_COUNTING_PARALLEL : SORT_AUTO_COUNTING;
+    }
+    if (features->n < profile->radix_min_n) {
+        return SORT_AUTO_INTROSORT;
+    }
+    double low = profile->presorted_max;
+    double high = 1.0 - profile->presorted_max;
+    if ((features->descents <= low && features->inversions <= low) ||
+        (features->descents >= high && features->inversions >= high)) {
+        return SORT_AUTO_MERGESORT_ADAPTIVE;
+    }
+    if (features->duplicates >= profile->duplicate_min) {
+        return parallel ? SORT_AUTO_INTROSORT_PARALLEL : SORT_AUTO_INTROSORT;
+    }
+    return parallel ? SORT_AUTO_RADIX_PARALLEL : SORT_AUTO_RADIX;
+}
+
+void sort_auto_run(sort_auto_engine engine, int arr[], int size, int threads) {
+    if (size < 2) {
+        return;
+    }
+    switch (engine) {
+    case SORT_AUTO_TRIVIAL:
+        break;
+    case SORT_AUTO_COUNTING_PARALLEL:
+        if (counting_sort_parallel(arr, size, threads) == 0) {
+            break;
+        }
+        // Fall through
+    case SORT_AUTO_COUNTING: {
+        // The dispatch already judged the range: count anything up to
+        // SORT_AUTO_COUNTING_MAX_FACTOR counters per key, radix sort beyond
+        counting_sort_limits limits = {SORT_AUTO_COUNTING_MAX_FACTOR,
+                                       SORT_AUTO_COUNTING_MAX_FACTOR * (size_t)size *
+                                           sizeof(uint32_t)};
+        if (counting_sort_with_limits(arr, size, &limits) == COUNTING_SORT_FAILED) {
+            quicksort_block(arr, size);
+        }
+        break;
+    }
+    case SORT_AUTO_INTROSORT_PARALLEL:
+        if (quicksort_parallel(arr, (size_t)size, threads) == 0) {
+            break;
+        }
+        // Fall through
+    case SORT_AUTO_INTROSORT:
+        quicksort_block(arr, size);
+        break;
+    case SORT_AUTO_MERGESORT_ADAPTIVE:
+        if (mergesort_adaptive(arr, size) != 0) {
+            quicksort_block(arr, size);
+        }
+        break;
+    case SORT_AUTO_RADIX_PARALLEL:
+        if (radix_sort_parallel(arr, size, threads) == 0) {
+            break;
+        }
+        // Fall through
+    case SORT_AUTO_RADIX:
+    default:
+        if (radix_sort_lsd2048(arr, size) != 0) {
+            radix_sort_american_flag(arr, size);
+        }
+        break;
+    }
+}
+
+sort_auto_engine sort_auto_with_profile(int arr[], int size, const sort_auto_profile *profile) {
+    sort_auto_features features;
+    sort_auto_sample(arr, size, profile, &features);
+    sort_auto_engine engine = sort_auto_choose(&features, profile);
+    sort_auto_run(engine, arr, size, features.threads);
+    return engine;
+}
+
+static sort_auto_profile global_profile;
+static pthread_once_t global_profile_once = PTHREAD_ONCE_INIT;
+
+static void load_global_profile(void) {
+    global_profile = sort_auto_default_profile();
+    const char *path = getenv("ROSETTA_SORT_PROFILE");
+    if (path != NULL && path[0] != '\0' && sort_auto_load_profile(path, &global_profile) != 0) {
+        perror(path);  // Keep the defaults
+    }
+}
+
+sort_auto_engine sort_auto(int arr[], int size) {
+    pthread_once(&global_profile_once, load_global_profile);
+    return sort_auto_with_profile(arr, size, &global_profile);
+}
+
+/*
+ * Calibration
+ */
+
+/**
+ * Best-of-CALIBRATE_REPS nanoseconds for engine to sort src[0..n * batch)
+ * as `batch` separate arrays of n keys, through the scratch copy work
+ */
+static double time_engine(sort_auto_engine engine, const int src[], int work[], size_t n,
+                          size_t batch, int threads) {
+    double best = 0.0;
+    for (int rep = 0; rep < CALIBRATE_REPS; rep++) {
+        memcpy(work, src, n * batch * sizeof(int));
+        uint64_t start = bench_now_ns();
+        for (size_t b = 0; b < batch; b++) {
+            sort_auto_run(engine, work + b * n, (int)n, threads);
+        }
+        double elapsed = (double)(bench_now_ns() - start);
+        bench_escape(work);
+        if (rep == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+/**
+ * Faster of radix sort and introsort on src[0..n)
+ */
+static double time_general(const int src[], int work[], size_t n) {
+    double radix = time_engine(SORT_AUTO_RADIX, src, work, n, 1, 1);
+    double intro = time_engine(SORT_AUTO_INTROSORT, src, work, n, 1, 1);
+    return radix < intro ? radix : intro;
+}
+
+/**
+ * Keys of bench_fill_* (in [0, n)) spread over a range wider than the
+ * counting rule accepts, order preserved
+ */
+static void widen_keys(int arr[], size_t n) {
+    int scale = (int)(INT32_MAX / (int64_t)(n > 0 ? n : 1));
+    scale = scale > 1024 ? 1024 : scale;
+    for (size_t i = 0; i < n; i++) {
+        arr[i] *= scale;
+    }
+}
+
+static size_t calibrate_radix_min_n(int src[], int work[], FILE *log) {
+    bench_fill_random(src, CALIBRATE_BATCH_KEYS, 2801, 0);
+    size_t crossover = 0;  // Smallest size radix wins from, through the largest
+    for (size_t n = 64; n <= 65536; n *= 2) {
+        size_t batch = CALIBRATE_BATCH_KEYS / n;
+        double radix = time_engine(SORT_AUTO_RADIX, src, work, n, batch, 1) / (double)batch;
+        double intro = time_engine(SORT_AUTO_INTROSORT, src, work, n, batch, 1) / (double)batch;
+        if (log != NULL) {
+            fprintf(log, "  radix_min_n    n=%-8zu radix %9.0f ns  introsort %9.0f ns\n", n, radix,
+                    intro);
+        }
+        if (radix < intro) {
+            crossover = crossover == 0 ? n : crossover;
+        } else {
+            crossover = 0;
+        }
+    }
+    return crossover == 0 ? 131072 : crossover;
+}
+
+static size_t calibrate_parallel_min_n(int src[], int work[], size_t max_n, int threads,
+                                       FILE *log) {
+    if (threads <= 1) {
+        if (log != NULL) {
+            fprintf(log, "  parallel_min_n one thread available: parallel engines disabled\n");
+        }
+        return SIZE_MAX;
+    }
+    bench_fill_random(src, max_n, 2802, 0);
+    size_t crossover = 0;
+    for (size_t n = 16384; n <= max_n; n *= 2) {
+        double serial = time_engine(SORT_AUTO_RADIX, src, work, n, 1, 1);
+        double parallel = time_engine(SORT_AUTO_RADIX_PARALLEL, src, work, n, 1, threads);
+        if (log != NULL) {
+            fprintf(log, "  parallel_min_n n=%-8zu radix %9.0f ns  radix_parallel(%d) %9.0f ns\n",
+                    n, serial, threads, parallel);
+        }
+        if (parallel < serial * CALIBRATE_PARALLEL_GAIN) {
+            crossover = crossover == 0 ? n : crossover;
+        } else {
+            crossover = 0;
+        }
+    }
+    return crossover == 0 ? SIZE_MAX : crossover;
+}
+
+/**
+ * Largest histogram (bytes) counting still beats the general engines
+ * with at n keys, trying ranges upward from 2^10
+ */
+static size_t calibrate_counting_bytes(int src[], int work[], size_t n, FILE *log) {
+    size_t best = 0;
+    for (uint64_t range = 1024; range <= 64 * (uint64_t)n && range <= INT32_MAX; range *= 4) {
+        bench_fill_random(src, n, 2803, (int)range);
+        double counting = time_engine(SORT_AUTO_COUNTING, src, work, n, 1, 1);
+        double general = time_general(src, work, n);
+        if (log != NULL) {
+            fprintf(log,
+                    "  counting_bytes range=%-10" PRIu64 " counting %9.0f ns  general %9.0f ns\n",
+                    range, counting, general);
+        }
+        if (counting >= general) {
+            break;
+        }
+        best = (size_t)range * sizeof(uint32_t);
+    }
+    return best;
+}
+
+/**
+ * Largest range / n ratio counting still beats the general engines at
+ */
+static double calibrate_counting_factor(int src[], int work[], size_t n, size_t max_bytes,
+                                        FILE *log) {
+    double best = 0.0;
+    for (size_t factor = 1; factor <= 64; factor *= 2) {
+        uint64_t range = (uint64_t)factor * n;
+        if (range * sizeof(uint32_t) > max_bytes || range > INT32_MAX) {
+            break;
+        }
+        bench_fill_random(src, n, 2804, (int)range);
+        double counting = time_engine(SORT_AUTO_COUNTING, src, work, n, 1, 1);
+        double general = time_general(src, work, n);
+        if (log != NULL) {
+            fprintf(log, "  range_factor   %-2zu x %-7zu counting %9.0f ns  general %9.0f ns\n",
+                    factor, n, counting, general);
+        }
+        if (counting >= general) {
+            break;
+        }
+        best = (double)factor;
+    }
+    return best;
+}
+
+/**
+ * Sampled disorder (the larger of the descent and inversion ratios) up
+ * to which adaptive mergesort beats the general engines, over inputs
+ * with a growing fraction of keys out of place
+ */
+static double calibrate_presorted(int src[], int work[], size_t n, const sort_auto_profile *profile,
+                                  FILE *log) {
+    static const double DISORDER[] = {0.0, 0.001, 0.003, 0.01, 0.03, 0.1, 0.3};
+    double last_win = -1.0;
+    for (size_t d = 0; d < sizeof(DISORDER) / sizeof(DISORDER[0]); d++) {
+        bench_fill_sorted_fraction(src, n, 2805 + d, 1.0 - DISORDER[d]);
+        widen_keys(src, n);
+        sort_auto_features features;
+        sort_auto_profile sampling = *profile;
+        sampling.radix_min_n = 0;  // Force the sampled ratios
+        sampling.counting_max_bytes = 0;
+        sampling.presorted_max = 1.0;
+        sort_auto_sample(src, (int)n, &sampling, &features);
+        double disorder =
+            features.descents > features.inversions ? features.descents : features.inversions;
+
+        double adaptive = time_engine(SORT_AUTO_MERGESORT_ADAPTIVE, src, work, n, 1, 1);
+        double general = time_general(src, work, n);
+        if (log != NULL) {
+            fprintf(log,
+                    "  presorted_max  %5.1f%% moved (sampled %.3f) mergesort_adaptive %9.0f ns  "
+                    "general %9.0f ns\n",
+                    DISORDER[d] * 100.0, disorder, adaptive, general);
+        }
+        if (adaptive >= general) {
+            // Halfway between the last winning and first losing estimate
+            return last_win < 0.0 ? 0.0 : (last_win + disorder) / 2.0;
+        }
+        last_win = disorder > last_win ? disorder : last_win;
+    }
+    return last_win;
+}
+
+/**
+ * Sampled duplicate ratio from which introsort beats radix sort, over
+ * inputs drawing from fewer and fewer distinct (wide-range) keys
+ */
+static double calibrate_duplicates(int src[], int work[], size_t n,
+                                   const sort_auto_profile *profile, FILE *log) {
+    static const int DISTINCT[] = {2, 16, 256, 4096, 65536};
+    int table[65536];
+    double last_win = 2.0;  // Never
+    for (size_t d = 0; d < sizeof(DISTINCT) / sizeof(DISTINCT[0]); d++) {
+        bench_fill_random(table, (size_t)DISTINCT[d], 2806 + d, 0);
+        bench_fill_random(src, n, 2807 + d, DISTINCT[d]);
+        for (size_t i = 0; i < n; i++) {
+            src[i] = table[src[i]];
+        }
+        sort_auto_features features;
+        sort_auto_profile sampling = *profile;
+        sampling.radix_min_n = 0;
+        sampling.counting_max_bytes = 0;
+        sort_auto_sample(src, (int)n, &sampling, &features);
+
+        double intro = time_engine(SORT_AUTO_INTROSORT, src, work, n, 1, 1);
+        double radix = time_engine(SORT_AUTO_RADIX, src, work, n, 1, 1);
+        if (log != NULL) {
+            fprintf(log,
+                    "  duplicate_min  %-5d distinct (sampled %.3f) introsort %9.0f ns  "
+                    "radix %9.0f ns\n",
+                    DISTINCT[d], features.duplicates, intro, radix);
+        }
+        if (intro >= radix) {
+            return last_win > 1.0 ? 2.0 : (last_win + features.duplicates) / 2.0;
+        }
+        last_win = features.duplicates;
+    }
+    return last_win;
+}
+
+int sort_auto_calibrate(sort_auto_profile *profile, int max_size, FILE *log) {
+    size_t max_n = max_size > 65536 ? (size_t)max_size : 65536;
+    size_t cap = max_n > CALIBRATE_BATCH_KEYS ? max_n : CALIBRATE_BATCH_KEYS;
+    int *src = malloc(cap * sizeof(int));
+    int *work = malloc(cap * sizeof(int));
+    if (src == NULL || work == NULL) {
+        free(src);
+        free(work);
+        return -1;
+    }
+    int threads = profile->threads > 0 ? profile->threads : task_pool_cpu_count();
+
+    profile->radix_min_n = calibrate_radix_min_n(src, work, log);
+    profile->parallel_min_n = calibrate_parallel_min_n(src, work, max_n, threads, log);
+    profile->counting_max_bytes = calibrate_counting_bytes(src, work, max_n, log);
+    profile->counting_range_factor = calibrate_counting_factor(
+        src, work, max_n / 64 >= 1024 ? max_n / 64 : 1024, profile->counting_max_bytes, log);
+    // Presorted keys are widened by up to 1024x, so stay within int range
+    size_t presorted_n = max_n < (1u << 21) ? max_n : (1u << 21);
+    profile->presorted_max = calibrate_presorted(src, work, presorted_n, profile, log);
+    profile->duplicate_min = calibrate_duplicates(src, work, max_n, profile, log);
+
+    free(src);
+    free(work);
+    return 0;
+}
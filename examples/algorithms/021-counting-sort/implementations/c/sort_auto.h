@@ -0,0 +1,130 @@
+/**
+ * Adaptive Sort Dispatcher
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * sort_auto() looks at the input before choosing a sort:
+ *
+ * - n, and min/max over the whole array (SIMD reduce_minmax(), about
+ *   n/16 cycles), giving the key range
+ * - presortedness: the fraction of descents among 1024 adjacent pairs,
+ *   read as 32 evenly spaced blocks (0: ascending, 1: descending), and
+ *   of inverted pairs among 64 strided keys (which separates a few keys
+ *   out of place from a few interleaved runs)
+ * - duplicate ratio: 1 - distinct / SORT_AUTO_SAMPLE over a strided
+ *   sample of keys
+ * - worker threads available
+ *
+ * and dispatches, in order: counting sort when the range is small
+ * against n; introsort (pdqsort-style quicksort_block()) for small n;
+ * adaptive mergesort for nearly sorted or reversed input; introsort for
+ * heavily duplicated keys; LSD radix sort otherwise. Counting, introsort
+ * and radix switch to their parallel variants from parallel_min_n keys
+ * when more than one thread is available.
+ *
+ * The thresholds live in a sort_auto_profile. sort_auto_calibrate()
+ * measures the crossovers on this machine and sort_auto_save_profile()
+ * writes them as "key value" lines; sort_auto() reads the file named by
+ * $ROSETTA_SORT_PROFILE once, and uses the built-in defaults without it.
+ */
+
+#ifndef ROSETTA_SORT_AUTO_H
+#define ROSETTA_SORT_AUTO_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+// Keys sort_auto_sample() draws for the duplicate ratio
+#define SORT_AUTO_SAMPLE 256
+
+typedef enum {
+    SORT_AUTO_TRIVIAL = 0,  // Fewer than two keys
+    SORT_AUTO_COUNTING,
+    SORT_AUTO_COUNTING_PARALLEL,
+    SORT_AUTO_INTROSORT,
+    SORT_AUTO_INTROSORT_PARALLEL,
+    SORT_AUTO_MERGESORT_ADAPTIVE,
+    SORT_AUTO_RADIX,
+    SORT_AUTO_RADIX_PARALLEL,
+    SORT_AUTO_ENGINE_COUNT
+} sort_auto_engine;
+
+typedef struct {
+    size_t radix_min_n;            // Introsort below this many keys
+    size_t parallel_min_n;         // Parallel engines from here (SIZE_MAX: never)
+    double counting_range_factor;  // Count when max - min + 1 <= factor * n...
+    size_t counting_max_bytes;     // ...and its uint32 histogram fits this
+    double presorted_max;          // Adaptive mergesort up to this disorder (or order) ratio
+    double duplicate_min;          // Introsort from this duplicate ratio (> 1: never)
+    int threads;                   // 0: one per online CPU
+} sort_auto_profile;
+
+typedef struct {
+    size_t n;
+    int min;
+    int max;
+    double descents;    // Sampled descending adjacent pairs / pairs sampled
+    double inversions;  // Inverted pairs / pairs of the strided key sample
+    double duplicates;  // 1 - sampled distinct keys / sample size
+    int threads;
+} sort_auto_features;
+
+/**
+ * Thresholds measured on a 1-CPU AVX-512 VM (see sort_auto_calibrate()):
+ * radix from 1024 keys, counting up to 4 counters per key and 16 MiB,
+ * adaptive mergesort up to 5% disorder, introsort from 96% duplicates,
+ * no parallel engines
+ */
+sort_auto_profile sort_auto_default_profile(void);
+
+/**
+ * Read / write a profile file. Loading starts from *profile, so keys
+ * missing from the file keep their values. Returns 0, or -1 with errno
+ * set (EINVAL: a line that is not "key value" or names an unknown key).
+ */
+int sort_auto_load_profile(const char *path, sort_auto_profile *profile);
+int sort_auto_save_profile(const char *path, const sort_auto_profile *profile);
+
+/**
+ * Measure the features of arr[0..size) that the dispatch looks at
+ */
+void sort_auto_sample(const int arr[], int size, const sort_auto_profile *profile,
+                      sort_auto_features *features);
+
+/**
+ * The engine sort_auto_with_profile() picks for these features
+ */
+sort_auto_engine sort_auto_choose(const sort_auto_features *features,
+                                  const sort_auto_profile *profile);
+
+/**
+ * Sort arr with one engine (threads <= 0: one per CPU). Engines that run
+ * out of memory fall back to one that needs none, so this always sorts;
+ * the counting engines radix sort ranges over 64 counters per key.
+ */
+void sort_auto_run(sort_auto_engine engine, int arr[], int size, int threads);
+
+/**
+ * Sample, choose and sort; returns the engine used
+ */
+sort_auto_engine sort_auto_with_profile(int arr[], int size, const sort_auto_profile *profile);
+
+/**
+ * sort_auto_with_profile() with $ROSETTA_SORT_PROFILE or the defaults
+ */
+sort_auto_engine sort_auto(int arr[], int size);
+
+/**
+ * Measure every threshold of profile on this machine with inputs of up
+ * to max_size keys (at least 65536), logging each crossover to log (NULL:
+ * quiet). profile->threads is kept. Returns 0, or -1 if memory runs out.
+ */
+int sort_auto_calibrate(sort_auto_profile *profile, int max_size, FILE *log);
+
+/**
+ * Display name ("counting", "radix_parallel", ...)
+ */
+const char *sort_auto_engine_name(sort_auto_engine engine);
+
+#endif  // ROSETTA_SORT_AUTO_H
@@ -6,17 +6,42 @@
  *
  * Time Complexity: O(n²)
  * Space Complexity: O(1)
+ *
+ * When only some order statistics are needed, select_kth(), partial_sort()
+ * and percentiles() avoid both the quadratic scan and a full sort. They
+ * run on the quicksort partition kernels (002) and the binary heap (018).
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <math.h>
 #include <string.h>
 
+#include "bench.h"
+#include "heap_sort.h"
+#include "int_io.h"
+#include "quicksort.h"
+#include "reduce.h"
+#include "selection_sort.h"
+
+// selection_sort() scans shorter suffixes without the reduce dispatch
+#define SELECTION_SIMD_MIN 32
+// Ranges at or below this size are finished by insertion sort
+#define SELECT_LEAF 16
+// Above this range size the pivot comes from a Floyd-Rivest sample
+#define SELECT_SAMPLE_MIN 600
+// partial_sort() heap-selects while k is at most size / this...
+#define PARTIAL_HEAP_RATIO 1024
+// ...and gives up once more than size / this keys beat the heap root
+#define PARTIAL_HEAP_ADMIT_RATIO 16
+
 /**
  * Swap two integers
  */
-void swap(int *a, int *b) {
+static void swap(int *a, int *b) {
     int temp = *a;
     *a = *b;
     *b = temp;
@@ -30,10 +55,15 @@ void selection_sort(int arr[], int size) {
     for (int i = 0; i < size - 1; i++) {
         int min_idx = i;
 
-        // Find minimum element in unsorted portion
-        for (int j = i + 1; j < size; j++) {
-            if (arr[j] < arr[min_idx]) {
-                min_idx = j;
+        // Find minimum element in unsorted portion; long ones with the
+        // vectorized argmin
+        if (size - i >= SELECTION_SIMD_MIN) {
+            min_idx += (int)reduce_argmin(arr + i, (size_t)(size - i));
+        } else {
+            for (int j = i + 1; j < size; j++) {
+                if (arr[j] < arr[min_idx]) {
+                    min_idx = j;
+                }
             }
         }
 
@@ -44,6 +74,197 @@ void selection_sort(int arr[], int size) {
     }
 }
 
+/**
+ * Partitioning rounds allowed before select_range() gives up on its
+ * pivots and sorts the remaining range outright
+ */
+static int select_depth_limit(int size) {
+    return 2 * (int)log2((double)size) + 4;
+}
+
+/**
+ * Introselect on arr[low..high] for index k (low <= k <= high).
+ *
+ * Each round partitions around a pivot with the branchless block
+ * partition from quicksort_block(), which leaves the pivot in its final
+ * slot, and keeps the side holding k. Large ranges take the pivot Floyd-
+ * Rivest style: recursively select k's counterpart in a window of about
+ * n^(2/3) keys around k, offset towards the nearer end, so the side left
+ * over is usually tiny after two rounds (about n + min(k, n - k)
+ * comparisons). Smaller ranges use the quicksort ninther. As in
+ * block_sort_loop(), when the key before the range (`leftmost` false)
+ * equals the pivot, the keys equal to it are split off in one pass, so
+ * duplicates cannot stall the loop. After `depth` rounds without
+ * convergence the range is heap sorted, bounding the worst case at
+ * O(n log n).
+ */
+static void select_range(int arr[], int low, int high, int k, int depth, bool leftmost) {
+    while (high - low + 1 > SELECT_LEAF) {
+        if (depth-- == 0) {
+            heap_sort(arr + low, high - low + 1);
+            return;
+        }
+
+        int pivot_index;
+        if (high - low + 1 > SELECT_SAMPLE_MIN) {
+            double n = high - low + 1;
+            double i = k - low + 1;
+            double z = log(n);
+            double s = 0.5 * exp(2.0 * z / 3.0);
+            double sd = 0.5 * sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1.0 : 1.0);
+            int window_low = (int)fmax(low, k - i * s / n + sd);
+            int window_high = (int)fmin(high, k + (n - i) * s / n + sd);
+            select_range(arr, window_low, window_high, k, depth, true);
+            pivot_index = k;
+        } else {
+            pivot_index = choose_pivot(arr, low, high);
+        }
+        swap(&arr[low], &arr[pivot_index]);
+
+        if (!leftmost && arr[low - 1] >= arr[low]) {
+            int equal_end = partition_equal_left(arr, low, high);
+            if (k <= equal_end) {
+                return;
+            }
+            low = equal_end + 1;
+            continue;
+        }
+
+        bool already_partitioned;
+        int mid = block_partition(arr, low, high, &already_partitioned);
+        if (k == mid) {
+            return;
+        }
+        if (k < mid) {
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+            leftmost = false;
+        }
+    }
+
+    insertion_sort_range(arr, low, high);
+}
+
+int select_kth(int arr[], int size, int k) {
+    if (k < 0 || k >= size) {
+        return -1;
+    }
+    select_range(arr, 0, size - 1, k, select_depth_limit(size), true);
+    return 0;
+}
+
+/**
+ * Smallest k keys by heap selection: a max-heap of the first k keys
+ * admits each later key smaller than its root, then is heap sorted.
+ * About n + k log k log(n/k) comparisons on unordered input, most keys
+ * costing one. Input that keeps lowering the root (e.g. descending) would
+ * cost n log k, so after size / PARTIAL_HEAP_ADMIT_RATIO admissions this
+ * returns -1 with arr still a permutation of its input.
+ */
+static int heap_select(int arr[], int size, int k) {
+    int budget = size / PARTIAL_HEAP_ADMIT_RATIO;
+    build_max_heap(arr, k);
+    int threshold = arr[0];
+    for (int i = k; i < size; i++) {
+        if (arr[i] < threshold) {
+            if (budget-- == 0) {
+                return -1;
+            }
+            swap(&arr[0], &arr[i]);
+            heapify(arr, k, 0);
+            threshold = arr[0];
+        }
+    }
+    heap_sort(arr, k);
+    return 0;
+}
+
+void partial_sort(int arr[], int size, int k) {
+    if (k <= 0 || size <= 1) {
+        return;
+    }
+    if (k >= size) {
+        quicksort_intro(arr, size);
+        return;
+    }
+    if (k <= size / PARTIAL_HEAP_RATIO && heap_select(arr, size, k) == 0) {
+        return;
+    }
+
+    // arr[k - 1] lands in place with the k - 1 smaller keys before it
+    select_range(arr, 0, size - 1, k - 1, select_depth_limit(size), true);
+    quicksort_intro(arr, k - 1);
+}
+
+static int compare_ranks(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Place every rank in ranks[0..count) (sorted, distinct, all within
+ * [low, high]): select the middle one, then the smaller ranks left of it
+ * and the larger ones right of it. O(n log count).
+ */
+static void select_ranks(int arr[], int low, int high, const int ranks[], int count,
+                         int depth, bool leftmost) {
+    while (count > 0) {
+        int mid = count / 2;
+        int rank = ranks[mid];
+        select_range(arr, low, high, rank, depth, leftmost);
+        select_ranks(arr, low, rank - 1, ranks, mid, depth, leftmost);
+        low = rank + 1;
+        leftmost = false;
+        ranks += mid + 1;
+        count -= mid + 1;
+    }
+}
+
+int percentiles(int arr[], int size, const double qs[], int m, double out[]) {
+    if (size < 1 || m < 0) {
+        return -1;
+    }
+    for (int i = 0; i < m; i++) {
+        if (!(qs[i] >= 0.0 && qs[i] <= 100.0)) {
+            return -1;
+        }
+    }
+
+    // The lower and upper order statistic of every percentile
+    int *ranks = malloc((2 * (size_t)m + 1) * sizeof(int));
+    if (ranks == NULL) {
+        return -1;
+    }
+    int count = 0;
+    for (int i = 0; i < m; i++) {
+        double index = (qs[i] / 100.0) * (double)(size - 1);
+        ranks[count++] = (int)floor(index);
+        ranks[count++] = (int)ceil(index);
+    }
+    qsort(ranks, count, sizeof(int), compare_ranks);
+    int distinct = 0;
+    for (int i = 0; i < count; i++) {
+        if (distinct == 0 || ranks[i] != ranks[distinct - 1]) {
+            ranks[distinct++] = ranks[i];
+        }
+    }
+    select_ranks(arr, 0, size - 1, ranks, distinct, select_depth_limit(size), true);
+    free(ranks);
+
+    for (int i = 0; i < m; i++) {
+        double index = (qs[i] / 100.0) * (double)(size - 1);
+        int lower = (int)floor(index);
+        int upper = (int)ceil(index);
+        double weight = index - (double)lower;
+        out[i] = lower == upper ? arr[lower] : arr[lower] * (1.0 - weight) + arr[upper] * weight;
+    }
+    return 0;
+}
+
+#ifndef ROSETTA_NO_MAIN
+
 /**
  * Check if array is sorted
  */
@@ -56,6 +277,32 @@ int is_sorted(const int arr[], int size) {
     return 1;
 }
 
+/**
+ * qsort comparator (reference ordering for the selection tests)
+ */
+int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Fill arr with one of the selection test shapes: random, sorted,
+ * reversed, few unique keys, organ pipe
+ */
+static void fill_shape(int arr[], int size, int shape, uint64_t seed) {
+    bench_fill_random(arr, size, seed, shape == 3 ? 7 : 0);
+    for (int i = 0; i < size; i++) {
+        if (shape == 1) {
+            arr[i] = i;
+        } else if (shape == 2) {
+            arr[i] = size - i;
+        } else if (shape == 4) {
+            arr[i] = i < size / 2 ? i : size - i;
+        }
+    }
+}
+
 /**
  * Print array
  */
@@ -119,9 +366,382 @@ void run_tests(void) {
     selection_sort(arr7, size7);
     assert(is_sorted(arr7, size7));
 
+    // Test 8: select_kth() places the k-th smallest with smaller keys
+    // before and larger after, on both sides of the Floyd-Rivest sample
+    // threshold and for adversarial shapes
+    static const int select_sizes[] = {1, 2, 17, 600, 601, 5000, 100003};
+    for (size_t t = 0; t < sizeof(select_sizes) / sizeof(select_sizes[0]); t++) {
+        int size = select_sizes[t];
+        int *input = malloc(size * sizeof(int));
+        int *sorted = malloc(size * sizeof(int));
+        int *actual = malloc(size * sizeof(int));
+        assert(input != NULL && sorted != NULL && actual != NULL);
+
+        for (int shape = 0; shape < 5; shape++) {
+            fill_shape(input, size, shape, 8 + t);
+            memcpy(sorted, input, size * sizeof(int));
+            qsort(sorted, size, sizeof(int), compare_ints);
+
+            int ks[] = {0, 1, size / 4, size / 2, size - 1};
+            for (int j = 0; j < 5; j++) {
+                int k = ks[j] < size ? ks[j] : size - 1;
+                memcpy(actual, input, size * sizeof(int));
+                assert(select_kth(actual, size, k) == 0);
+                assert(actual[k] == sorted[k]);
+                for (int i = 0; i < size; i++) {
+                    assert(i < k ? actual[i] <= actual[k] : actual[i] >= actual[k]);
+                }
+            }
+        }
+        assert(select_kth(actual, size, -1) == -1 && select_kth(actual, size, size) == -1);
+
+        free(input);
+        free(sorted);
+        free(actual);
+    }
+
+    // Test 9: partial_sort() leaves the k smallest sorted in front (heap
+    // selection below size / PARTIAL_HEAP_RATIO, selection above) and keeps
+    // the array a permutation of its input
+    {
+        int size = 200011;
+        int *input = malloc(size * sizeof(int));
+        int *sorted = malloc(size * sizeof(int));
+        int *actual = malloc(size * sizeof(int));
+        assert(input != NULL && sorted != NULL && actual != NULL);
+
+        int ks[] = {0, 1, 5, size / PARTIAL_HEAP_RATIO, size / PARTIAL_HEAP_RATIO + 1,
+                    size / 2, size - 1, size, size + 5};
+        for (int shape = 0; shape < 5; shape++) {
+            fill_shape(input, size, shape, 9);
+            memcpy(sorted, input, size * sizeof(int));
+            qsort(sorted, size, sizeof(int), compare_ints);
+
+            for (size_t j = 0; j < sizeof(ks) / sizeof(ks[0]); j++) {
+                int k = ks[j] < size ? ks[j] : size;
+                memcpy(actual, input, size * sizeof(int));
+                partial_sort(actual, size, ks[j]);
+                assert(memcmp(actual, sorted, k * sizeof(int)) == 0);
+                qsort(actual, size, sizeof(int), compare_ints);
+                assert(memcmp(actual, sorted, size * sizeof(int)) == 0);
+            }
+        }
+
+        free(input);
+        free(sorted);
+        free(actual);
+    }
+
+    // Test 10: percentiles() matches linear interpolation over a full sort
+    {
+        static const double qs[] = {50.0, 0.0, 100.0, 95.0, 99.0, 25.0, 50.0, 33.3};
+        int m = sizeof(qs) / sizeof(qs[0]);
+        double out[sizeof(qs) / sizeof(qs[0])];
+        static const int sizes[] = {1, 2, 10, 1001, 65536};
+        for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+            int size = sizes[t];
+            int *sorted = malloc(size * sizeof(int));
+            int *actual = malloc(size * sizeof(int));
+            assert(sorted != NULL && actual != NULL);
+
+            fill_shape(actual, size, 0, 10 + t);
+            memcpy(sorted, actual, size * sizeof(int));
+            qsort(sorted, size, sizeof(int), compare_ints);
+            assert(percentiles(actual, size, qs, m, out) == 0);
+            for (int i = 0; i < m; i++) {
+                double index = qs[i] / 100.0 * (size - 1);
+                int lower = (int)floor(index);
+                int upper = (int)ceil(index);
+                double weight = index - lower;
+                double expected = sorted[lower] * (1.0 - weight) + sorted[upper] * weight;
+                assert(fabs(out[i] - expected) <= 1e-6 * (fabs(expected) + 1.0));
+            }
+
+            free(sorted);
+            free(actual);
+        }
+
+        int one[] = {5};
+        double bad = 100.5;
+        assert(percentiles(one, 0, qs, 1, out) == -1);
+        assert(percentiles(one, 1, &bad, 1, out) == -1);
+        assert(percentiles(one, 1, qs, 0, out) == 0);
+    }
+
+    // Test 11: every reduce kernel this CPU runs agrees with a plain scan,
+    // including ties (first index wins) and INT_MIN/INT_MAX keys, on both
+    // sides of the two-pass argmin cutoff
+    {
+        static const int sizes[] = {1, 2, 7, 8, 15, 16, 17, 31, 33, 64, 100, 1000, 65536,
+                                    65537, 200003};
+        int *arr = malloc(200003 * sizeof(int));
+        assert(arr != NULL);
+        for (int isa = 0; isa < REDUCE_ISA_COUNT; isa++) {
+            if (reduce_force((reduce_isa)isa) != 0) {
+                continue;
+            }
+            for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+                int size = sizes[t];
+                for (int shape = 0; shape < 7; shape++) {
+                    fill_shape(arr, size, shape < 5 ? shape : 3, 20 + t);
+                    if (shape == 5) {
+                        arr[size / 3] = INT_MIN;
+                        arr[size - 1] = INT_MIN;
+                        arr[size / 2] = INT_MAX;
+                        arr[size - 1 - size / 4] = INT_MAX;
+                    } else if (shape == 6) {
+                        for (int i = 0; i < size; i++) {
+                            arr[i] = i % 2 ? INT_MIN : INT_MAX;
+                        }
+                    }
+
+                    int min_idx = 0;
+                    int max_idx = 0;
+                    for (int i = 1; i < size; i++) {
+                        min_idx = arr[i] < arr[min_idx] ? i : min_idx;
+                        max_idx = arr[i] > arr[max_idx] ? i : max_idx;
+                    }
+                    int min;
+                    int max;
+                    reduce_minmax(arr, size, &min, &max);
+                    assert(reduce_min(arr, size) == arr[min_idx] && min == arr[min_idx]);
+                    assert(reduce_max(arr, size) == arr[max_idx] && max == arr[max_idx]);
+                    assert(reduce_argmin(arr, size) == (size_t)min_idx);
+                    assert(reduce_argmax(arr, size) == (size_t)max_idx);
+                }
+            }
+            assert(reduce_min(arr, 0) == INT_MAX && reduce_max(arr, 0) == INT_MIN);
+            assert(reduce_argmin(arr, 0) == 0 && reduce_argmax(arr, 0) == 0);
+        }
+        assert(reduce_force(REDUCE_ISA_COUNT) == -1);
+        reduce_force(reduce_detect());
+        free(arr);
+    }
+
     printf("✓ All tests passed\n");
 }
 
+/**
+ * Benchmark context: pristine input plus a scratch copy restored before each run
+ */
+typedef struct {
+    const int *input;
+    int *work;
+    int size;
+} sort_bench_ctx;
+
+static void restore_input(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    memcpy(c->work, c->input, c->size * sizeof(int));
+}
+
+static void bench_selection_sort(void *ctx) {
+    sort_bench_ctx *c = ctx;
+    selection_sort(c->work, c->size);
+    bench_escape(c->work);
+}
+
+/**
+ * Order-statistic benchmark context: the sort context plus k
+ */
+typedef struct {
+    sort_bench_ctx sort;
+    int k;
+} select_bench_ctx;
+
+static void restore_select_input(void *ctx) {
+    restore_input(&((select_bench_ctx *)ctx)->sort);
+}
+
+static void bench_full_sort(void *ctx) {
+    select_bench_ctx *c = ctx;
+    quicksort_intro(c->sort.work, c->sort.size);
+    bench_escape(c->sort.work);
+}
+
+static void bench_select_kth(void *ctx) {
+    select_bench_ctx *c = ctx;
+    select_kth(c->sort.work, c->sort.size, c->k);
+    bench_escape(c->sort.work);
+}
+
+static void bench_partial_sort(void *ctx) {
+    select_bench_ctx *c = ctx;
+    partial_sort(c->sort.work, c->sort.size, c->k);
+    bench_escape(c->sort.work);
+}
+
+static void bench_percentiles(void *ctx) {
+    static const double qs[] = {50.0, 95.0, 99.0};
+    select_bench_ctx *c = ctx;
+    double out[3];
+    percentiles(c->sort.work, c->sort.size, qs, 3, out);
+    bench_escape(out);
+}
+
+/**
+ * Run benchmark suite on deterministic random input
+ */
+int run_benchmarks(void) {
+    printf("Running Selection Sort benchmarks...\n");
+
+    static const int sizes[] = {100, 1000, 5000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/022-selection-sort");
+    for (int s = 0; s < num_sizes; s++) {
+        int size = sizes[s];
+        int *input = malloc(size * sizeof(int));
+        int *work = malloc(size * sizeof(int));
+
+        if (input == NULL || work == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(input);
+            free(work);
+            return 1;
+        }
+
+        bench_fill_random(input, size, 42, size);
+        sort_bench_ctx ctx = {input, work, size};
+
+        snprintf(name, sizeof(name), "selection_sort/n=%d", size);
+        bench_measure(name, bench_selection_sort, restore_input, &ctx);
+
+        free(input);
+        free(work);
+    }
+
+    // Order statistics of n keys against a full introsort: partial_sort()
+    // as k grows shows where selecting stops paying off
+    static const int select_sizes[] = {10000, 1000000};
+    for (int s = 0; s < 2; s++) {
+        int size = select_sizes[s];
+        int *input = malloc(size * sizeof(int));
+        int *work = malloc(size * sizeof(int));
+
+        if (input == NULL || work == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(input);
+            free(work);
+            return 1;
+        }
+
+        bench_fill_random(input, size, 42, 0);
+        select_bench_ctx ctx = {{input, work, size}, size / 2};
+
+        snprintf(name, sizeof(name), "quicksort_intro/n=%d", size);
+        bench_measure(name, bench_full_sort, restore_select_input, &ctx);
+        snprintf(name, sizeof(name), "select_kth/median/n=%d", size);
+        bench_measure(name, bench_select_kth, restore_select_input, &ctx);
+        snprintf(name, sizeof(name), "percentiles/p50,p95,p99/n=%d", size);
+        bench_measure(name, bench_percentiles, restore_select_input, &ctx);
+
+        for (int k = 10; k <= size; k *= 10) {
+            ctx.k = k;
+            snprintf(name, sizeof(name), "partial_sort/k=%d/n=%d", k, size);
+            bench_measure(name, bench_partial_sort, restore_select_input, &ctx);
+        }
+
+        free(input);
+        free(work);
+    }
+
+    return bench_end() == 0 ? 0 : 1;
+}
+
+typedef struct {
+    const int *arr;
+    size_t size;
+} reduce_bench_ctx;
+
+static void bench_reduce_min(void *ctx) {
+    reduce_bench_ctx *c = ctx;
+    BENCH_DO_NOT_OPTIMIZE(reduce_min(c->arr, c->size));
+}
+
+static void bench_reduce_argmin(void *ctx) {
+    reduce_bench_ctx *c = ctx;
+    BENCH_DO_NOT_OPTIMIZE(reduce_argmin(c->arr, c->size));
+}
+
+static void bench_reduce_minmax(void *ctx) {
+    reduce_bench_ctx *c = ctx;
+    int min;
+    int max;
+    reduce_minmax(c->arr, c->size, &min, &max);
+    BENCH_DO_NOT_OPTIMIZE(min);
+    BENCH_DO_NOT_OPTIMIZE(max);
+}
+
+/**
+ * Elements per cycle of each reduce path at L1/L2/L3/DRAM-sized inputs.
+ * Cycles come from the PMU under BENCH_PERF=1, else from the clock
+ * estimate of bench_cpu_ghz().
+ */
+int run_reduce_sweep(int max_size) {
+    static const int sizes[] = {4000, 60000, 4000000, 32000000};
+    static const char *const levels[] = {"L1", "L2", "L3", "DRAM"};
+    static const char *const op_names[] = {"min", "argmin", "minmax"};
+    static const bench_fn op_fns[] = {bench_reduce_min, bench_reduce_argmin,
+                                      bench_reduce_minmax};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    reduce_isa best = reduce_detect();
+
+    printf("Reduction sweep (up to n=%d, %s selected, clock estimate %.2f GHz):\n", max_size,
+           reduce_isa_name(best), bench_cpu_ghz());
+
+    bench_config config = bench_default_config();
+    config.warmup_samples = 1;
+    if (config.samples > 5) {
+        config.samples = 5;
+    }
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+
+    bench_begin("algorithms/022-selection-sort");
+    for (int s = 0; s < num_sizes && sizes[s] <= max_size; s++) {
+        int size = sizes[s];
+        int *input = malloc(size * sizeof(int));
+        if (input == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            return 1;
+        }
+        bench_fill_random(input, size, 42, 0);
+        reduce_bench_ctx ctx = {input, (size_t)size};
+
+        for (int isa = 0; isa < REDUCE_ISA_COUNT; isa++) {
+            if (reduce_force((reduce_isa)isa) != 0) {
+                continue;
+            }
+            for (int op = 0; op < 3; op++) {
+                snprintf(name, sizeof(name), "reduce_%s/%s/%s/n=%d", op_names[op],
+                         reduce_isa_name((reduce_isa)isa), levels[s], size);
+                bench_run(name, op_fns[op], NULL, &ctx, &config, &result);
+                bench_record(&result);
+                int measured;
+                double cycles = bench_cycles(&result, &measured);
+                printf("  %-4s n=%-9d %-7s %-7s median %10.1f us  %6.2f elem/cycle%s\n",
+                       levels[s], size, reduce_isa_name((reduce_isa)isa), op_names[op],
+                       result.median_ns / 1e3, size / cycles, measured ? " (PMU)" : "");
+            }
+        }
+        reduce_force(best);
+
+        free(input);
+    }
+
+    return bench_end() == 0 ? 0 : 1;
+}
+
+/**
+ * selection_sort() for int_io_run_sort()
+ */
+static int sort_stream(int arr[], int size) {
+    selection_sort(arr, size);
+    return 0;
+}
+
 /**
  * Main entry point
  */
@@ -132,10 +752,37 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // If "benchmark" argument, run benchmarks
+    if (argc == 2 && strcmp(argv[1], "benchmark") == 0) {
+        return run_benchmarks();
+    }
+
+    // "reduce [max_size]": min/argmin/minmax throughput of every SIMD path
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "reduce") == 0) {
+        int max_size = argc == 3 ? atoi(argv[2]) : 32000000;
+        if (max_size < 1) {
+            fprintf(stderr, "Error: Invalid reduction sweep size\n");
+            return 1;
+        }
+        return run_reduce_sweep(max_size);
+    }
+
+    // "sort [options]": bulk input / output through int_io.h
+    if (argc >= 2 && strcmp(argv[1], "sort") == 0) {
+        int_io_options options;
+        if (int_io_parse_args(argc, argv, 2, 0, &options) != 0) {
+            return 1;
+        }
+        return int_io_run_sort(&options, "selection_sort", sort_stream);
+    }
+
     // Otherwise, parse array from command line
     if (argc < 2) {
         printf("Usage: %s <num1> <num2> <num3> ...\n", argv[0]);
         printf("       %s test\n", argv[0]);
+        printf("       %s benchmark\n", argv[0]);
+        printf("       %s reduce [max_size]\n", argv[0]);
+        printf("       %s sort " INT_IO_USAGE "\n", argv[0]);
         printf("\nExample: %s 64 25 12 22 11\n", argv[0]);
         return 1;
     }
@@ -164,3 +811,5 @@ int main(int argc, char *argv[]) {
     free(arr);
     return 0;
 }
+
+#endif  // ROSETTA_NO_MAIN
@@ -0,0 +1,42 @@
+/**
+ * Selection Algorithms - Public Interface
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Other implementations link selection_sort.c compiled with
+ * -DROSETTA_NO_MAIN, which drops the test/benchmark driver. The library
+ * also needs quicksort.c and heap_sort.c (both built with
+ * -DROSETTA_NO_MAIN), reduce.c, sortnet.c, arena.c and task_pool.c.
+ */
+
+#ifndef ROSETTA_SELECTION_SORT_H
+#define ROSETTA_SELECTION_SORT_H
+
+/**
+ * Selection sort (reference, O(n^2))
+ */
+void selection_sort(int arr[], int size);
+
+/**
+ * Rearrange arr so arr[k] is its k-th smallest key (0-based), with no
+ * larger key before it and no smaller key after it. Expected O(n),
+ * worst case O(n log n). Returns 0, or -1 if k is not in [0, size).
+ */
+int select_kth(int arr[], int size, int k);
+
+/**
+ * Move the k smallest keys, sorted, to arr[0..k); the rest of arr is left
+ * in unspecified order. k >= size sorts the whole array.
+ */
+void partial_sort(int arr[], int size, int k);
+
+/**
+ * out[i] = qs[i]-th percentile of arr (qs in [0, 100]), linearly
+ * interpolated between order statistics as in harness/benchmarking/c and
+ * the Rust runner. Reorders arr. Returns 0, or -1 if size < 1, m < 0, a
+ * percentile is out of range or memory is unavailable.
+ */
+int percentiles(int arr[], int size, const double qs[], int m, double out[]);
+
+#endif  // ROSETTA_SELECTION_SORT_H
@@ -0,0 +1,75 @@
+/**
+ * Bump-Pointer Arena Allocator
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#include "arena.h"
+
+#include "topology.h"
+
+#include <stdlib.h>
+
+static size_t align_up(size_t value) {
+    return (value + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+int arena_init(arena *a, size_t capacity) {
+    a->offset = 0;
+    a->capacity = align_up(capacity > 0 ? capacity : 1);
+    a->mapped = a->capacity >= ARENA_HUGE_MIN;
+    a->base = a->mapped ? topology_alloc(a->capacity, TOPOLOGY_HUGE_PAGES)
+                        : aligned_alloc(ARENA_ALIGNMENT, a->capacity);
+
+    if (a->base == NULL) {
+        a->capacity = 0;
+        return -1;
+    }
+    return 0;
+}
+
+void arena_destroy(arena *a) {
+    if (a->mapped) {
+        topology_free(a->base, a->capacity);
+    } else {
+        free(a->base);
+    }
+    a->base = NULL;
+    a->capacity = 0;
+    a->offset = 0;
+    a->mapped = 0;
+}
+
+void *arena_alloc(arena *a, size_t size) {
+    size_t start = align_up(a->offset);
+
+    if (start > a->capacity || size > a->capacity - start) {
+        return NULL;
+    }
+
+    a->offset = start + size;
+    return a->base + start;
+}
+
+size_t arena_remaining(const arena *a) {
+    return a->capacity - a->offset;
+}
+
+size_t arena_mark(const arena *a) {
+    return a->offset;
+}
+
+void arena_release(arena *a, size_t mark) {
+    if (mark <= a->offset) {
+        a->offset = mark;
+    }
+}
+
+void arena_reset(arena *a) {
+    a->offset = 0;
+}
+
+size_t arena_capacity_for(size_t bytes, size_t count) {
+    return bytes + count * ARENA_ALIGNMENT;
+}
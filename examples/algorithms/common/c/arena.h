@@ -0,0 +1,76 @@
+/**
+ * Bump-Pointer Arena Allocator
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * One up-front allocation carved into scratch buffers by bumping an
+ * offset. Buffers are released in LIFO order via arena_mark()/
+ * arena_release() or all at once via arena_reset(), so sort kernels can
+ * take per-level scratch without a malloc/free round trip per call.
+ *
+ * All allocations are ARENA_ALIGNMENT-aligned (one cache line). Arenas
+ * of ARENA_HUGE_MIN bytes or more are mapped with huge pages
+ * (topology_alloc()), so a sort's scratch costs a few TLB entries rather
+ * than one per 4 KiB.
+ */
+
+#ifndef ROSETTA_ARENA_H
+#define ROSETTA_ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_ALIGNMENT 64
+
+// Capacity from which the backing buffer is mapped on huge pages
+#define ARENA_HUGE_MIN (2u << 20)
+
+typedef struct {
+    unsigned char *base;
+    size_t capacity;
+    size_t offset;
+    int mapped;  // base came from topology_alloc()
+} arena;
+
+/**
+ * Reserve capacity bytes. Returns 0 on success, -1 on allocation failure.
+ */
+int arena_init(arena *a, size_t capacity);
+
+/**
+ * Free the backing buffer
+ */
+void arena_destroy(arena *a);
+
+/**
+ * Bump-allocate size bytes; NULL if the arena is exhausted
+ */
+void *arena_alloc(arena *a, size_t size);
+
+/**
+ * Bytes still available (ignoring alignment padding)
+ */
+size_t arena_remaining(const arena *a);
+
+/**
+ * Current position, for a later arena_release()
+ */
+size_t arena_mark(const arena *a);
+
+/**
+ * Free everything allocated since mark
+ */
+void arena_release(arena *a, size_t mark);
+
+/**
+ * Free everything
+ */
+void arena_reset(arena *a);
+
+/**
+ * Capacity needed for `count` allocations totalling `bytes`, including
+ * worst-case alignment padding
+ */
+size_t arena_capacity_for(size_t bytes, size_t count);
+
+#endif  // ROSETTA_ARENA_H
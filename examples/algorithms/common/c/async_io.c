@@ -0,0 +1,322 @@
+/**
+ * Asynchronous Block I/O
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * The ring protocol follows io_uring(7): the submission ring's tail and
+ * the completion ring's head are ours, published with release stores;
+ * the kernel's side is read with acquire loads.
+ */
+
+#define _GNU_SOURCE
+
+#include "async_io.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+// IO_URING_OP_SUPPORTED arrives with IORING_OP_READ/WRITE and the probe (5.6 headers)
+#if defined(__linux__) && defined(__NR_io_uring_setup) && defined(IO_URING_OP_SUPPORTED) && \
+    !defined(ROSETTA_NO_IO_URING)
+#define ASYNC_IO_URING 1
+#endif
+
+typedef struct {
+    uint64_t tag;
+    int64_t result;
+} completion;
+
+struct async_io {
+    unsigned depth;
+    unsigned in_flight;
+
+    // Synchronous fallback: finished requests waiting for async_io_wait()
+    completion *done;
+    unsigned done_count;
+
+#ifdef ASYNC_IO_URING
+    int ring_fd;  // -1: synchronous fallback
+    void *sq_ring;
+    size_t sq_ring_bytes;
+    void *cq_ring;  // == sq_ring with IORING_FEAT_SINGLE_MMAP
+    size_t cq_ring_bytes;
+    struct io_uring_sqe *sqes;
+    size_t sqes_bytes;
+    unsigned *sq_tail;
+    unsigned sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+#endif
+};
+
+#ifdef ASYNC_IO_URING
+static int ring_enter(int fd, unsigned submit, unsigned wait) {
+    unsigned flags = wait > 0 ? IORING_ENTER_GETEVENTS : 0;
+    return (int)syscall(__NR_io_uring_enter, fd, submit, wait, flags, NULL, 0);
+}
+
+static void ring_unmap(async_io *io) {
+    if (io->sqes != NULL) {
+        munmap(io->sqes, io->sqes_bytes);
+    }
+    if (io->cq_ring != NULL && io->cq_ring != io->sq_ring) {
+        munmap(io->cq_ring, io->cq_ring_bytes);
+    }
+    if (io->sq_ring != NULL) {
+        munmap(io->sq_ring, io->sq_ring_bytes);
+    }
+    close(io->ring_fd);
+    io->ring_fd = -1;
+}
+
+static int op_supported(const struct io_uring_probe *probe, int op) {
+    return op <= probe->last_op && op < probe->ops_len &&
+           (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+/**
+ * Whether the ring runs IORING_OP_READ and IORING_OP_WRITE. Kernels 5.1
+ * to 5.5 create rings but fail those requests with -EINVAL; they also
+ * lack IORING_REGISTER_PROBE, so a failed probe counts as no.
+ */
+static int ring_supports_rw(int ring_fd) {
+    const unsigned ops = 256;
+    struct io_uring_probe *probe =
+        calloc(1, sizeof(*probe) + ops * sizeof(struct io_uring_probe_op));
+    if (probe == NULL) {
+        return 0;
+    }
+    int supported =
+        syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, ops) == 0 &&
+        op_supported(probe, IORING_OP_READ) && op_supported(probe, IORING_OP_WRITE);
+    free(probe);
+    return supported;
+}
+
+/**
+ * Create and map the ring; leaves ring_fd == -1 on any failure, or if
+ * the kernel cannot run the read and write opcodes
+ */
+static void ring_setup(async_io *io) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    io->ring_fd = (int)syscall(__NR_io_uring_setup, io->depth, &params);
+    if (io->ring_fd < 0) {
+        io->ring_fd = -1;
+        return;
+    }
+    if (!ring_supports_rw(io->ring_fd)) {
+        close(io->ring_fd);
+        io->ring_fd = -1;
+        return;
+    }
+
+    io->sq_ring_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    io->cq_ring_bytes = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    int single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && io->cq_ring_bytes > io->sq_ring_bytes) {
+        io->sq_ring_bytes = io->cq_ring_bytes;
+    }
+
+    io->sq_ring = mmap(NULL, io->sq_ring_bytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, io->ring_fd, IORING_OFF_SQ_RING);
+    if (io->sq_ring == MAP_FAILED) {
+        io->sq_ring = NULL;
+        ring_unmap(io);
+        return;
+    }
+    io->cq_ring = single ? io->sq_ring
+                         : mmap(NULL, io->cq_ring_bytes, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, io->ring_fd, IORING_OFF_CQ_RING);
+    if (io->cq_ring == MAP_FAILED) {
+        io->cq_ring = NULL;
+        ring_unmap(io);
+        return;
+    }
+    io->sqes_bytes = params.sq_entries * sizeof(struct io_uring_sqe);
+    io->sqes = mmap(NULL, io->sqes_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    io->ring_fd, IORING_OFF_SQES);
+    if (io->sqes == MAP_FAILED) {
+        io->sqes = NULL;
+        ring_unmap(io);
+        return;
+    }
+
+    unsigned char *sq = io->sq_ring;
+    unsigned char *cq = io->cq_ring;
+    io->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    io->sq_mask = *(unsigned *)(sq + params.sq_off.ring_mask);
+    io->sq_array = (unsigned *)(sq + params.sq_off.array);
+    io->cq_head = (unsigned *)(cq + params.cq_off.head);
+    io->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    io->cq_mask = *(unsigned *)(cq + params.cq_off.ring_mask);
+    io->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+}
+
+static int ring_submit(async_io *io, int opcode, int fd, const void *buf, size_t len,
+                       uint64_t offset, uint64_t tag) {
+    unsigned tail = *io->sq_tail;  // Only we write the tail
+    unsigned index = tail & io->sq_mask;
+    struct io_uring_sqe *sqe = &io->sqes[index];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = (unsigned char)opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)buf;
+    sqe->len = (unsigned)len;
+    sqe->off = offset;
+    sqe->user_data = tag;
+    io->sq_array[index] = index;
+    __atomic_store_n(io->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    int submitted;
+    do {
+        submitted = ring_enter(io->ring_fd, 1, 0);
+    } while (submitted < 0 && errno == EINTR);
+    return submitted == 1 ? 0 : -1;
+}
+#endif
+
+async_io *async_io_create(unsigned depth) {
+    async_io *io = calloc(1, sizeof(async_io));
+    if (io == NULL) {
+        return NULL;
+    }
+    io->depth = depth > 0 ? depth : 1;
+    io->done = malloc(io->depth * sizeof(completion));
+    if (io->done == NULL) {
+        free(io);
+        return NULL;
+    }
+#ifdef ASYNC_IO_URING
+    ring_setup(io);
+#endif
+    return io;
+}
+
+void async_io_destroy(async_io *io) {
+    if (io == NULL) {
+        return;
+    }
+#ifdef ASYNC_IO_URING
+    if (io->ring_fd >= 0) {
+        // Outstanding requests still reference caller buffers: drain them
+        uint64_t tag;
+        int64_t result;
+        while (async_io_wait(io, &tag, &result) == 0) {
+        }
+        ring_unmap(io);
+    }
+#endif
+    free(io->done);
+    free(io);
+}
+
+/**
+ * Full transfer with pread()/pwrite(), retrying short counts; bytes
+ * moved (short only at end of file) or -errno
+ */
+static int64_t sync_transfer(int write, int fd, void *buf, size_t len, uint64_t offset) {
+    size_t moved = 0;
+    while (moved < len) {
+        ssize_t n = write ? pwrite(fd, (char *)buf + moved, len - moved, (off_t)(offset + moved))
+                          : pread(fd, (char *)buf + moved, len - moved, (off_t)(offset + moved));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -errno;
+        }
+        if (n == 0) {
+            break;
+        }
+        moved += (size_t)n;
+    }
+    return (int64_t)moved;
+}
+
+static int submit(async_io *io, int write, int fd, void *buf, size_t len, uint64_t offset,
+                  uint64_t tag) {
+    if (io->in_flight == io->depth) {
+        return -1;
+    }
+#ifdef ASYNC_IO_URING
+    if (io->ring_fd >= 0) {
+        if (ring_submit(io, write ? IORING_OP_WRITE : IORING_OP_READ, fd, buf, len, offset, tag) !=
+            0) {
+            return -1;
+        }
+        io->in_flight++;
+        return 0;
+    }
+#endif
+    io->done[io->done_count].tag = tag;
+    io->done[io->done_count].result = sync_transfer(write, fd, buf, len, offset);
+    io->done_count++;
+    io->in_flight++;
+    return 0;
+}
+
+int async_io_read(async_io *io, int fd, void *buf, size_t len, uint64_t offset, uint64_t tag) {
+    return submit(io, 0, fd, buf, len, offset, tag);
+}
+
+int async_io_write(async_io *io, int fd, const void *buf, size_t len, uint64_t offset,
+                   uint64_t tag) {
+    return submit(io, 1, fd, (void *)buf, len, offset, tag);
+}
+
+int async_io_wait(async_io *io, uint64_t *tag, int64_t *result) {
+    if (io->in_flight == 0) {
+        return -1;
+    }
+#ifdef ASYNC_IO_URING
+    if (io->ring_fd >= 0) {
+        for (;;) {
+            unsigned head = *io->cq_head;  // Only we write the head
+            if (head != __atomic_load_n(io->cq_tail, __ATOMIC_ACQUIRE)) {
+                struct io_uring_cqe *cqe = &io->cqes[head & io->cq_mask];
+                *tag = cqe->user_data;
+                *result = cqe->res;
+                __atomic_store_n(io->cq_head, head + 1, __ATOMIC_RELEASE);
+                io->in_flight--;
+                return 0;
+            }
+            if (ring_enter(io->ring_fd, 0, 1) < 0 && errno != EINTR) {
+                return -1;
+            }
+        }
+    }
+#endif
+    io->done_count--;
+    *tag = io->done[io->done_count].tag;
+    *result = io->done[io->done_count].result;
+    io->in_flight--;
+    return 0;
+}
+
+unsigned async_io_in_flight(const async_io *io) {
+    return io->in_flight;
+}
+
+const char *async_io_backend(const async_io *io) {
+#ifdef ASYNC_IO_URING
+    if (io->ring_fd >= 0) {
+        return "io_uring";
+    }
+#endif
+    (void)io;
+    return "sync";
+}
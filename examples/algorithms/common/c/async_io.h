@@ -0,0 +1,58 @@
+/**
+ * Asynchronous Block I/O
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Positioned reads and writes that complete later, so a caller can keep
+ * computing (sorting, merging) while the next blocks move. On Linux the
+ * requests go through an io_uring driven by raw syscalls (no liburing);
+ * where the ring cannot be created or lacks IORING_OP_READ/WRITE (kernels
+ * before 5.6, seccomp, other OS) each request runs synchronously with
+ * pread()/pwrite() at submit time and its completion is queued, so
+ * callers see the same interface.
+ *
+ * Completions carry the caller's 64-bit tag and may arrive in any order.
+ * At most `depth` requests may be in flight.
+ */
+
+#ifndef ROSETTA_ASYNC_IO_H
+#define ROSETTA_ASYNC_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct async_io async_io;
+
+/**
+ * Start an I/O context for up to depth in-flight requests. Returns NULL
+ * on allocation failure; falls back to synchronous I/O without io_uring.
+ */
+async_io *async_io_create(unsigned depth);
+void async_io_destroy(async_io *io);
+
+/**
+ * Queue a read / write of len bytes at offset. Returns 0, or -1 if the
+ * request could not be queued (the queue is full or submission failed).
+ */
+int async_io_read(async_io *io, int fd, void *buf, size_t len, uint64_t offset, uint64_t tag);
+int async_io_write(async_io *io, int fd, const void *buf, size_t len, uint64_t offset,
+                   uint64_t tag);
+
+/**
+ * Block until any request completes: its tag, and bytes transferred or
+ * -errno in *result. Returns 0, or -1 if nothing is in flight.
+ */
+int async_io_wait(async_io *io, uint64_t *tag, int64_t *result);
+
+/**
+ * Requests submitted and not yet returned by async_io_wait()
+ */
+unsigned async_io_in_flight(const async_io *io);
+
+/**
+ * "io_uring" or "sync"
+ */
+const char *async_io_backend(const async_io *io);
+
+#endif  // ROSETTA_ASYNC_IO_H
@@ -0,0 +1,411 @@
+/**
+ * Bulk Integer Input / Output for the Algorithm CLIs
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#define _GNU_SOURCE
+
+#include "int_io.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Bytes per read() / fwrite() block
+#define INT_IO_BLOCK (1u << 20)
+
+// Longest text token: sign, ten digits and leading zeros to spare
+#define INT_IO_TOKEN_MAX 64
+
+static const char DIGIT_PAIRS[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static int is_stdio(const char *path) {
+    return path == NULL || strcmp(path, "-") == 0;
+}
+
+static int parse_format(const char *text, int allow_checksum, int_io_format *format) {
+    if (strcmp(text, "text") == 0) {
+        *format = INT_IO_TEXT;
+    } else if (strcmp(text, "binary") == 0) {
+        *format = INT_IO_BINARY;
+    } else if (allow_checksum && strcmp(text, "checksum") == 0) {
+        *format = INT_IO_CHECKSUM;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+int int_io_parse_args(int argc, char *argv[], int first, int queries_allowed,
+                      int_io_options *options) {
+    memset(options, 0, sizeof(*options));
+    options->input_format = INT_IO_TEXT;
+    options->output_format = INT_IO_TEXT;
+
+    for (int i = first; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--time") == 0) {
+            options->report_time = 1;
+            continue;
+        }
+        if (strcmp(arg, "--in") != 0 && strcmp(arg, "--out") != 0 &&
+            strcmp(arg, "--in-format") != 0 && strcmp(arg, "--out-format") != 0 &&
+            !(queries_allowed && strcmp(arg, "--queries") == 0)) {
+            fprintf(stderr, "Error: Unknown option %s\n", arg);
+            return -1;
+        }
+        if (i + 1 == argc) {
+            fprintf(stderr, "Error: Missing value for %s\n", arg);
+            return -1;
+        }
+
+        const char *value = argv[++i];
+        if (strcmp(arg, "--in") == 0) {
+            options->input = value;
+        } else if (strcmp(arg, "--out") == 0) {
+            options->output = value;
+        } else if (strcmp(arg, "--queries") == 0) {
+            options->queries = value;
+        } else if (parse_format(value, strcmp(arg, "--out-format") == 0,
+                                arg[2] == 'i' ? &options->input_format
+                                              : &options->output_format) != 0) {
+            fprintf(stderr, "Error: Unknown format %s for %s\n", value, arg);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * read() until len bytes or end of input; bytes read or -1
+ */
+static ssize_t read_full(int fd, char *buf, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = read(fd, buf + done, len - done);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        done += (size_t)n;
+    }
+    return (ssize_t)done;
+}
+
+/**
+ * Growable result array
+ */
+typedef struct {
+    int *data;
+    size_t count;
+    size_t capacity;
+} int_vec;
+
+static int vec_reserve(int_vec *v, size_t extra) {
+    if (v->count + extra <= v->capacity) {
+        return 0;
+    }
+    size_t capacity = v->capacity > 0 ? v->capacity : 1u << 16;
+    while (capacity < v->count + extra) {
+        capacity *= 2;
+    }
+    int *data = realloc(v->data, capacity * sizeof(int));
+    if (data == NULL) {
+        return -1;
+    }
+    v->data = data;
+    v->capacity = capacity;
+    return 0;
+}
+
+static int read_binary(int fd, int_vec *v) {
+    size_t bytes = 0;  // Includes a trailing partial value
+    for (;;) {
+        if (vec_reserve(v, INT_IO_BLOCK / sizeof(int) + 1) != 0) {
+            return -1;
+        }
+        char *base = (char *)v->data;
+        size_t room = v->capacity * sizeof(int) - bytes;
+        ssize_t n = read_full(fd, base + bytes, room < INT_IO_BLOCK ? room : INT_IO_BLOCK);
+        if (n < 0) {
+            return -1;
+        }
+        bytes += (size_t)n;
+        v->count = bytes / sizeof(int);
+        if (n == 0) {
+            break;
+        }
+    }
+    if (bytes % sizeof(int) != 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+static inline int is_space(unsigned char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/**
+ * Scan whitespace-separated decimal integers. The block always ends in a
+ * NUL sentinel, so the digit loop needs no bounds check; a token cut by
+ * the block end is moved to the front and completed by the next read().
+ */
+static int read_text(int fd, int_vec *v) {
+    char *buf = malloc(INT_IO_BLOCK + 1);
+    if (buf == NULL) {
+        return -1;
+    }
+    size_t kept = 0;  // Partial token carried over from the last block
+    int status = -1;
+
+    for (;;) {
+        ssize_t n = read_full(fd, buf + kept, INT_IO_BLOCK - kept);
+        if (n < 0) {
+            goto done;
+        }
+        int eof = (size_t)n < INT_IO_BLOCK - kept;
+        size_t len = kept + (size_t)n;
+        buf[len] = '\0';
+
+        // Every value of this block fits: at most one per two bytes
+        if (vec_reserve(v, len / 2 + 1) != 0) {
+            goto done;
+        }
+        int *out = v->data + v->count;
+        const unsigned char *p = (const unsigned char *)buf;
+        const unsigned char *end = p + len;
+        const unsigned char *token = end;
+
+        for (;;) {
+            while (p < end && is_space(*p)) {
+                p++;
+            }
+            if (p == end) {
+                token = end;
+                break;
+            }
+            token = p;
+
+            int negative = *p == '-';
+            p += negative || *p == '+';
+            const unsigned char *digits = p;
+            uint64_t value = 0;
+            while ((unsigned)(*p - '0') < 10) {
+                value = value * 10 + (unsigned)(*p - '0');
+                if (value > (uint64_t)INT_MAX + 1) {
+                    while ((unsigned)(*p - '0') < 10) {
+                        p++;
+                    }
+                    if (p == end && !eof) {
+                        break;  // Let the next block see the whole token
+                    }
+                    errno = ERANGE;
+                    goto done;
+                }
+                p++;
+            }
+            if (p == end && !eof) {
+                break;  // Cut by the block end
+            }
+            if (p == digits || (p < end && !is_space(*p)) ||
+                value > (uint64_t)INT_MAX + (uint64_t)negative) {
+                errno = value > (uint64_t)INT_MAX ? ERANGE : EINVAL;
+                goto done;
+            }
+            *out++ = negative ? (int)(0u - (unsigned)value) : (int)value;
+        }
+        v->count = (size_t)(out - v->data);
+
+        if (eof) {
+            break;
+        }
+        kept = (size_t)(end - token);
+        if (kept > INT_IO_TOKEN_MAX) {
+            errno = EINVAL;
+            goto done;
+        }
+        memmove(buf, token, kept);
+    }
+    status = 0;
+
+done:
+    free(buf);
+    return status;
+}
+
+int int_io_read(const char *path, int_io_format format, int **values, size_t *count) {
+    int fd = is_stdio(path) ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int_vec v = {NULL, 0, 0};
+    int status = format == INT_IO_BINARY ? read_binary(fd, &v) : read_text(fd, &v);
+    int saved_errno = errno;
+    if (fd != STDIN_FILENO) {
+        close(fd);
+    }
+    if (status != 0) {
+        free(v.data);
+        errno = saved_errno;
+        return -1;
+    }
+    *values = v.data;
+    *count = v.count;
+    return 0;
+}
+
+/**
+ * Decimal text of value plus '\n' at p (at most 12 bytes); returns the end
+ */
+static char *format_int(char *p, int value) {
+    uint32_t v = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    char digits[10];
+    char *d = digits + sizeof(digits);
+
+    if (value < 0) {
+        *p++ = '-';
+    }
+    while (v >= 100) {
+        uint32_t pair = v % 100;
+        v /= 100;
+        d -= 2;
+        memcpy(d, DIGIT_PAIRS + 2 * pair, 2);
+    }
+    if (v >= 10) {
+        d -= 2;
+        memcpy(d, DIGIT_PAIRS + 2 * v, 2);
+    } else {
+        *--d = (char)('0' + v);
+    }
+    size_t len = (size_t)(digits + sizeof(digits) - d);
+    memcpy(p, d, len);
+    p[len] = '\n';
+    return p + len + 1;
+}
+
+static int write_text(FILE *f, const int *values, size_t count) {
+    char *buf = malloc(INT_IO_BLOCK);
+    if (buf == NULL) {
+        return -1;
+    }
+    char *p = buf;
+    char *limit = buf + INT_IO_BLOCK - 12;
+    int status = 0;
+
+    for (size_t i = 0; i < count && status == 0; i++) {
+        p = format_int(p, values[i]);
+        if (p > limit) {
+            status = fwrite(buf, 1, (size_t)(p - buf), f) == (size_t)(p - buf) ? 0 : -1;
+            p = buf;
+        }
+    }
+    if (status == 0 && p > buf && fwrite(buf, 1, (size_t)(p - buf), f) != (size_t)(p - buf)) {
+        status = -1;
+    }
+    free(buf);
+    return status;
+}
+
+uint64_t int_io_checksum(const int *values, size_t count) {
+    uint64_t hash = UINT64_C(0xcbf29ce484222325) ^ (uint64_t)count;
+    for (size_t i = 0; i < count; i++) {
+        hash = (hash ^ (uint32_t)values[i]) * UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+int int_io_write(const char *path, int_io_format format, const int *values, size_t count) {
+    FILE *f = is_stdio(path) ? stdout : fopen(path, "wb");
+    if (f == NULL) {
+        return -1;
+    }
+
+    int status = 0;
+    switch (format) {
+    case INT_IO_BINARY:
+        status = fwrite(values, sizeof(int), count, f) == count ? 0 : -1;
+        break;
+    case INT_IO_CHECKSUM:
+        status = fprintf(f, "count %zu checksum %016" PRIx64 "\n", count,
+                         int_io_checksum(values, count)) > 0
+                     ? 0
+                     : -1;
+        break;
+    default:
+        status = write_text(f, values, count);
+        break;
+    }
+
+    if (f == stdout) {
+        status |= fflush(f) == 0 ? 0 : -1;
+    } else {
+        status |= fclose(f) == 0 ? 0 : -1;
+    }
+    return status;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+int int_io_run_sort(const int_io_options *options, const char *name, int (*fn)(int *, int)) {
+    int *values = NULL;
+    size_t count = 0;
+
+    double t0 = now_ms();
+    if (int_io_read(options->input, options->input_format, &values, &count) != 0) {
+        perror(is_stdio(options->input) ? "stdin" : options->input);
+        return 1;
+    }
+    if (count > INT_MAX) {
+        fprintf(stderr, "Error: %zu values exceed the int-sized API\n", count);
+        free(values);
+        return 1;
+    }
+
+    double t1 = now_ms();
+    int failed = fn(values, (int)count) != 0;
+    double t2 = now_ms();
+    if (failed) {
+        fprintf(stderr, "Error: %s failed\n", name);
+        free(values);
+        return 1;
+    }
+
+    if (int_io_write(options->output, options->output_format, values, count) != 0) {
+        perror(is_stdio(options->output) ? "stdout" : options->output);
+        free(values);
+        return 1;
+    }
+    double t3 = now_ms();
+
+    if (options->report_time) {
+        fprintf(stderr, "%s: n=%zu  read %.3f ms  sort %.3f ms  write %.3f ms\n", name, count,
+                t1 - t0, t2 - t1, t3 - t2);
+    }
+    free(values);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * Bulk Integer Input / Output for the Algorithm CLIs
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Reading millions of values through argv/atoi() and printing them with
+ * one printf() per element costs far more than sorting them. These
+ * helpers move whole arrays instead:
+ *
+ * - input: raw native-endian int32 or whitespace-separated decimal text
+ *   from a file or stdin, pulled through 1 MiB read() calls and parsed
+ *   by a hand-written scanner (no stdio, no strtol)
+ * - output: raw int32 in one fwrite(), decimal text formatted two digits
+ *   at a time into 1 MiB fwrite() blocks, or just a count and an
+ *   order-sensitive checksum
+ *
+ * int_io_run_sort() wraps a sort in that pipeline and can report the
+ * read / sort / write phases separately, so a timing of the sort itself
+ * does not include I/O.
+ */
+
+#ifndef ROSETTA_INT_IO_H
+#define ROSETTA_INT_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    INT_IO_TEXT,
+    INT_IO_BINARY,
+    INT_IO_CHECKSUM,  // Output only: "count <n> checksum <hex>"
+} int_io_format;
+
+typedef struct {
+    const char *input;    // NULL or "-": stdin
+    const char *output;   // NULL or "-": stdout
+    const char *queries;  // Second input (search CLIs); NULL: none
+    int_io_format input_format;
+    int_io_format output_format;
+    int report_time;  // Phase timings on stderr
+} int_io_options;
+
+// Usage text of the options int_io_parse_args() accepts
+#define INT_IO_USAGE                                                                           \
+    "[--in PATH] [--in-format text|binary] [--out PATH] "                                      \
+    "[--out-format text|binary|checksum] [--time]"
+
+/**
+ * Parse argv[first..argc) into options (defaults: stdin text to stdout
+ * text). queries_allowed enables --queries PATH. Returns 0, or -1 after
+ * printing an error.
+ */
+int int_io_parse_args(int argc, char *argv[], int first, int queries_allowed,
+                      int_io_options *options);
+
+/**
+ * Read every value of path (NULL or "-": stdin) into a malloc()ed array.
+ * Returns 0, or -1 with errno set (EINVAL: malformed text or a binary
+ * size that is not a whole number of int32; ERANGE: value out of range).
+ */
+int int_io_read(const char *path, int_io_format format, int **values, size_t *count);
+
+/**
+ * Write values to path (NULL or "-": stdout). Returns 0, or -1 with errno set.
+ */
+int int_io_write(const char *path, int_io_format format, const int *values, size_t count);
+
+/**
+ * FNV-1a over the 32-bit values (and their count): equal for equal
+ * sequences, different for almost every reordering
+ */
+uint64_t int_io_checksum(const int *values, size_t count);
+
+/**
+ * Sort CLI: read options->input, sort with fn (nonzero return: failure),
+ * write options->output. Returns a process exit status.
+ */
+int int_io_run_sort(const int_io_options *options, const char *name, int (*fn)(int *, int));
+
+#endif  // ROSETTA_INT_IO_H
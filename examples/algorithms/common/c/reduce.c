@@ -0,0 +1,636 @@
+/**
+ * Vectorized Min/Max Reductions over int Arrays
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * min/max keep four vector accumulators, so consecutive loads never wait
+ * on each other. argmin/argmax take one of two routes:
+ * - two-pass (arrays up to REDUCE_TWO_PASS_MAX keys): reduce the value,
+ *   then find its first occurrence with compare + movemask. Both passes
+ *   are pure load/compare streams and the array is still in cache for
+ *   the second one.
+ * - one-pass (larger arrays): each lane carries its best key and the
+ *   block offset it was seen at, updated with a compare and a blend, so
+ *   the data is read from memory once. Offsets are 32-bit, so the array
+ *   is scanned in REDUCE_CHUNK pieces.
+ * Ties go to the lowest index on every path.
+ *
+ * x86 kernels are compiled with per-function target attributes, as in
+ * sortnet.c, so this file needs no -m flags.
+ */
+
+#include "reduce.h"
+
+#include <limits.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define REDUCE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define REDUCE_ARM_NEON 1
+#include <arm_neon.h>
+#endif
+
+// argmin/argmax re-read arrays up to this many keys instead of tracking
+// indices (256 KiB: L2-resident on current cores)
+#define REDUCE_TWO_PASS_MAX (1u << 16)
+// One-pass index tracking scans at most this many keys per 32-bit chunk
+#define REDUCE_CHUNK ((size_t)1 << 30)
+
+#define LESS(a, b) ((a) < (b))
+#define GREATER(a, b) ((a) > (b))
+
+typedef int (*value_fn)(const int arr[], size_t n);
+typedef size_t (*index_fn)(const int arr[], size_t n);
+typedef void (*minmax_fn)(const int arr[], size_t n, int *min_out, int *max_out);
+
+// ---------------------------------------------------------------------------
+// Portable C: four interleaved accumulators
+// ---------------------------------------------------------------------------
+
+#define DEFINE_SCALAR_REDUCE(kind, ID, BETTER)                                                 \
+    static int scalar_##kind(const int a[], size_t n) {                                        \
+        int b0 = ID, b1 = ID, b2 = ID, b3 = ID;                                                \
+        size_t i = 0;                                                                          \
+        for (; i + 4 <= n; i += 4) {                                                           \
+            b0 = BETTER(a[i], b0) ? a[i] : b0;                                                 \
+            b1 = BETTER(a[i + 1], b1) ? a[i + 1] : b1;                                         \
+            b2 = BETTER(a[i + 2], b2) ? a[i + 2] : b2;                                         \
+            b3 = BETTER(a[i + 3], b3) ? a[i + 3] : b3;                                         \
+        }                                                                                      \
+        for (; i < n; i++) {                                                                   \
+            b0 = BETTER(a[i], b0) ? a[i] : b0;                                                 \
+        }                                                                                      \
+        b0 = BETTER(b1, b0) ? b1 : b0;                                                         \
+        b2 = BETTER(b3, b2) ? b3 : b2;                                                         \
+        return BETTER(b2, b0) ? b2 : b0;                                                       \
+    }                                                                                          \
+                                                                                               \
+    /* Lane j tracks keys j, j+4, ...; lanes merge on (key, index) */                          \
+    static size_t scalar_arg##kind(const int a[], size_t n) {                                  \
+        if (n < 8) {                                                                           \
+            size_t best = 0;                                                                   \
+            for (size_t i = 1; i < n; i++) {                                                   \
+                best = BETTER(a[i], a[best]) ? i : best;                                       \
+            }                                                                                  \
+            return best;                                                                       \
+        }                                                                                      \
+        int v[4] = {a[0], a[1], a[2], a[3]};                                                   \
+        size_t idx[4] = {0, 1, 2, 3};                                                          \
+        size_t i = 4;                                                                          \
+        for (; i + 4 <= n; i += 4) {                                                           \
+            for (int j = 0; j < 4; j++) {                                                      \
+                bool take = BETTER(a[i + j], v[j]);                                            \
+                v[j] = take ? a[i + j] : v[j];                                                 \
+                idx[j] = take ? i + j : idx[j];                                                \
+            }                                                                                  \
+        }                                                                                      \
+        size_t best = idx[0];                                                                  \
+        for (int j = 1; j < 4; j++) {                                                          \
+            if (BETTER(v[j], a[best]) || (v[j] == a[best] && idx[j] < best)) {                 \
+                best = idx[j];                                                                 \
+            }                                                                                  \
+        }                                                                                      \
+        for (; i < n; i++) {                                                                   \
+            best = BETTER(a[i], a[best]) ? i : best;                                           \
+        }                                                                                      \
+        return best;                                                                           \
+    }
+
+DEFINE_SCALAR_REDUCE(min, INT_MAX, LESS)
+DEFINE_SCALAR_REDUCE(max, INT_MIN, GREATER)
+
+static void scalar_minmax(const int a[], size_t n, int *min_out, int *max_out) {
+    int lo0 = INT_MAX, lo1 = INT_MAX, hi0 = INT_MIN, hi1 = INT_MIN;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        lo0 = a[i] < lo0 ? a[i] : lo0;
+        hi0 = a[i] > hi0 ? a[i] : hi0;
+        lo1 = a[i + 1] < lo1 ? a[i + 1] : lo1;
+        hi1 = a[i + 1] > hi1 ? a[i + 1] : hi1;
+    }
+    if (i < n) {
+        lo0 = a[i] < lo0 ? a[i] : lo0;
+        hi0 = a[i] > hi0 ? a[i] : hi0;
+    }
+    *min_out = lo1 < lo0 ? lo1 : lo0;
+    *max_out = hi1 > hi0 ? hi1 : hi0;
+}
+
+/**
+ * Merge per-chunk results of a one-pass argmin/argmax: a later chunk only
+ * wins with a strictly better key, which keeps the first occurrence
+ */
+#define DEFINE_CHUNKED_ARG(prefix, kind, BETTER)                                               \
+    static size_t prefix##_arg##kind##_chunked(const int a[], size_t n) {                      \
+        size_t best_i = 0;                                                                     \
+        int best = a[0];                                                                       \
+        for (size_t base = 0; base < n; base += REDUCE_CHUNK) {                                \
+            size_t len = n - base < REDUCE_CHUNK ? n - base : REDUCE_CHUNK;                    \
+            int v;                                                                             \
+            size_t j = base + prefix##_arg##kind##_chunk(a + base, len, &v);                   \
+            if (BETTER(v, best)) {                                                             \
+                best = v;                                                                      \
+                best_i = j;                                                                    \
+            }                                                                                  \
+        }                                                                                      \
+        return best_i;                                                                         \
+    }
+
+/**
+ * Resolve the lanes of a one-pass kernel (stored accumulator after
+ * accumulator, so lane l saw its best key at offsets[l] + l) together with
+ * the scalar tail a[from..n). lanes_valid is false when no block ran.
+ */
+#define DEFINE_LANE_RESOLVE(kind, BETTER)                                                      \
+    static size_t resolve_arg##kind(const int a[], size_t n, size_t from, const int vals[],    \
+                                    const int offsets[], size_t count, bool lanes_valid,       \
+                                    int *value) {                                              \
+        size_t best_i = 0;                                                                     \
+        int best = a[0];                                                                       \
+        for (size_t l = 0; lanes_valid && l < count; l++) {                                    \
+            size_t j = (size_t)offsets[l] + l;                                                 \
+            if (BETTER(vals[l], best) || (vals[l] == best && j < best_i)) {                    \
+                best = vals[l];                                                                \
+                best_i = j;                                                                    \
+            }                                                                                  \
+        }                                                                                      \
+        for (size_t j = from; j < n; j++) {                                                    \
+            if (BETTER(a[j], best)) {                                                          \
+                best = a[j];                                                                   \
+                best_i = j;                                                                    \
+            }                                                                                  \
+        }                                                                                      \
+        *value = best;                                                                         \
+        return best_i;                                                                         \
+    }
+
+DEFINE_LANE_RESOLVE(min, LESS)
+DEFINE_LANE_RESOLVE(max, GREATER)
+
+// ---------------------------------------------------------------------------
+// x86: AVX2 (8 lanes) and AVX-512F (16 lanes)
+// ---------------------------------------------------------------------------
+
+#ifdef REDUCE_X86
+
+#define AVX2_ATTR __attribute__((target("avx2")))
+
+AVX2_ATTR static inline __m256i avx2_load(const int *p) {
+    return _mm256_loadu_si256((const __m256i *)p);
+}
+
+AVX2_ATTR static inline int avx2_hmin(__m256i v) {
+    __m128i x = _mm_min_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+    x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(x);
+}
+
+AVX2_ATTR static inline int avx2_hmax(__m256i v) {
+    __m128i x = _mm_max_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    x = _mm_max_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+    x = _mm_max_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(x);
+}
+
+// Lanes where x beats the accumulator
+#define AVX2_BEATS_MIN(acc, x) _mm256_cmpgt_epi32(acc, x)
+#define AVX2_BEATS_MAX(acc, x) _mm256_cmpgt_epi32(x, acc)
+
+/**
+ * Index of the first key equal to `key` (n if there is none)
+ */
+AVX2_ATTR static size_t avx2_find(const int a[], size_t n, int key) {
+    __m256i k = _mm256_set1_epi32(key);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i e0 = _mm256_cmpeq_epi32(avx2_load(a + i), k);
+        __m256i e1 = _mm256_cmpeq_epi32(avx2_load(a + i + 8), k);
+        __m256i e2 = _mm256_cmpeq_epi32(avx2_load(a + i + 16), k);
+        __m256i e3 = _mm256_cmpeq_epi32(avx2_load(a + i + 24), k);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (!_mm256_testz_si256(any, any)) {
+            uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(e0)) |
+                            (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(e1)) << 8 |
+                            (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(e2)) << 16 |
+                            (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(e3)) << 24;
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+    for (; i < n; i++) {
+        if (a[i] == key) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#define DEFINE_AVX2_REDUCE(kind, ID, BETTER, VBEST, BEATS, HBEST)                              \
+    AVX2_ATTR static int avx2_##kind(const int a[], size_t n) {                                \
+        __m256i b0 = _mm256_set1_epi32(ID), b1 = b0, b2 = b0, b3 = b0;                         \
+        size_t i = 0;                                                                          \
+        for (; i + 32 <= n; i += 32) {                                                         \
+            b0 = VBEST(b0, avx2_load(a + i));                                                  \
+            b1 = VBEST(b1, avx2_load(a + i + 8));                                              \
+            b2 = VBEST(b2, avx2_load(a + i + 16));                                             \
+            b3 = VBEST(b3, avx2_load(a + i + 24));                                             \
+        }                                                                                      \
+        for (; i + 8 <= n; i += 8) {                                                           \
+            b0 = VBEST(b0, avx2_load(a + i));                                                  \
+        }                                                                                      \
+        int best = HBEST(VBEST(VBEST(b0, b1), VBEST(b2, b3)));                                 \
+        for (; i < n; i++) {                                                                   \
+            best = BETTER(a[i], best) ? a[i] : best;                                           \
+        }                                                                                      \
+        return best;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    AVX2_ATTR static size_t avx2_arg##kind##_chunk(const int a[], size_t n, int *value) {      \
+        __m256i b0 = _mm256_set1_epi32(ID), b1 = b0;                                           \
+        __m256i i0 = _mm256_setzero_si256(), i1 = i0;                                          \
+        size_t i = 0;                                                                          \
+        for (; i + 16 <= n; i += 16) {                                                         \
+            __m256i base = _mm256_set1_epi32((int)i);                                          \
+            __m256i x0 = avx2_load(a + i);                                                     \
+            __m256i x1 = avx2_load(a + i + 8);                                                 \
+            i0 = _mm256_blendv_epi8(i0, base, BEATS(b0, x0));                                  \
+            i1 = _mm256_blendv_epi8(i1, base, BEATS(b1, x1));                                  \
+            b0 = VBEST(b0, x0);                                                                \
+            b1 = VBEST(b1, x1);                                                                \
+        }                                                                                      \
+        alignas(32) int vals[16];                                                              \
+        alignas(32) int offsets[16];                                                           \
+        _mm256_store_si256((__m256i *)vals, b0);                                               \
+        _mm256_store_si256((__m256i *)(vals + 8), b1);                                         \
+        _mm256_store_si256((__m256i *)offsets, i0);                                            \
+        _mm256_store_si256((__m256i *)(offsets + 8), i1);                                      \
+        return resolve_arg##kind(a, n, i, vals, offsets, 16, i > 0, value);                    \
+    }                                                                                          \
+                                                                                               \
+    DEFINE_CHUNKED_ARG(avx2, kind, BETTER)                                                     \
+                                                                                               \
+    AVX2_ATTR static size_t avx2_arg##kind(const int a[], size_t n) {                          \
+        if (n <= REDUCE_TWO_PASS_MAX) {                                                        \
+            return n == 0 ? 0 : avx2_find(a, n, avx2_##kind(a, n));                            \
+        }                                                                                      \
+        return avx2_arg##kind##_chunked(a, n);                                                 \
+    }
+
+DEFINE_AVX2_REDUCE(min, INT_MAX, LESS, _mm256_min_epi32, AVX2_BEATS_MIN, avx2_hmin)
+DEFINE_AVX2_REDUCE(max, INT_MIN, GREATER, _mm256_max_epi32, AVX2_BEATS_MAX, avx2_hmax)
+
+AVX2_ATTR static void avx2_minmax(const int a[], size_t n, int *min_out, int *max_out) {
+    __m256i lo0 = _mm256_set1_epi32(INT_MAX), lo1 = lo0;
+    __m256i hi0 = _mm256_set1_epi32(INT_MIN), hi1 = hi0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i x0 = avx2_load(a + i);
+        __m256i x1 = avx2_load(a + i + 8);
+        lo0 = _mm256_min_epi32(lo0, x0);
+        hi0 = _mm256_max_epi32(hi0, x0);
+        lo1 = _mm256_min_epi32(lo1, x1);
+        hi1 = _mm256_max_epi32(hi1, x1);
+    }
+    int lo = avx2_hmin(_mm256_min_epi32(lo0, lo1));
+    int hi = avx2_hmax(_mm256_max_epi32(hi0, hi1));
+    for (; i < n; i++) {
+        lo = a[i] < lo ? a[i] : lo;
+        hi = a[i] > hi ? a[i] : hi;
+    }
+    *min_out = lo;
+    *max_out = hi;
+}
+
+#define AVX512_ATTR __attribute__((target("avx512f")))
+
+AVX512_ATTR static inline __m512i avx512_load(const int *p) {
+    return _mm512_loadu_si512((const void *)p);
+}
+
+#define AVX512_BEATS_MIN(acc, x) _mm512_cmplt_epi32_mask(x, acc)
+#define AVX512_BEATS_MAX(acc, x) _mm512_cmpgt_epi32_mask(x, acc)
+
+AVX512_ATTR static size_t avx512_find(const int a[], size_t n, int key) {
+    __m512i k = _mm512_set1_epi32(key);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __mmask16 e0 = _mm512_cmpeq_epi32_mask(avx512_load(a + i), k);
+        __mmask16 e1 = _mm512_cmpeq_epi32_mask(avx512_load(a + i + 16), k);
+        __mmask16 e2 = _mm512_cmpeq_epi32_mask(avx512_load(a + i + 32), k);
+        __mmask16 e3 = _mm512_cmpeq_epi32_mask(avx512_load(a + i + 48), k);
+        if ((e0 | e1 | e2 | e3) != 0) {
+            uint64_t mask = (uint64_t)e0 | (uint64_t)e1 << 16 | (uint64_t)e2 << 32 |
+                            (uint64_t)e3 << 48;
+            return i + (size_t)__builtin_ctzll(mask);
+        }
+    }
+    for (; i < n; i++) {
+        if (a[i] == key) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#define DEFINE_AVX512_REDUCE(kind, ID, BETTER, VBEST, BEATS, HBEST)                            \
+    AVX512_ATTR static int avx512_##kind(const int a[], size_t n) {                            \
+        __m512i b0 = _mm512_set1_epi32(ID), b1 = b0, b2 = b0, b3 = b0;                         \
+        size_t i = 0;                                                                          \
+        for (; i + 64 <= n; i += 64) {                                                         \
+            b0 = VBEST(b0, avx512_load(a + i));                                                \
+            b1 = VBEST(b1, avx512_load(a + i + 16));                                           \
+            b2 = VBEST(b2, avx512_load(a + i + 32));                                           \
+            b3 = VBEST(b3, avx512_load(a + i + 48));                                           \
+        }                                                                                      \
+        for (; i + 16 <= n; i += 16) {                                                         \
+            b0 = VBEST(b0, avx512_load(a + i));                                                \
+        }                                                                                      \
+        int best = HBEST(VBEST(VBEST(b0, b1), VBEST(b2, b3)));                                 \
+        for (; i < n; i++) {                                                                   \
+            best = BETTER(a[i], best) ? a[i] : best;                                           \
+        }                                                                                      \
+        return best;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    AVX512_ATTR static size_t avx512_arg##kind##_chunk(const int a[], size_t n, int *value) {  \
+        __m512i b0 = _mm512_set1_epi32(ID), b1 = b0;                                           \
+        __m512i i0 = _mm512_setzero_si512(), i1 = i0;                                          \
+        size_t i = 0;                                                                          \
+        for (; i + 32 <= n; i += 32) {                                                         \
+            __m512i base = _mm512_set1_epi32((int)i);                                          \
+            __m512i x0 = avx512_load(a + i);                                                   \
+            __m512i x1 = avx512_load(a + i + 16);                                              \
+            i0 = _mm512_mask_mov_epi32(i0, BEATS(b0, x0), base);                               \
+            i1 = _mm512_mask_mov_epi32(i1, BEATS(b1, x1), base);                               \
+            b0 = VBEST(b0, x0);                                                                \
+            b1 = VBEST(b1, x1);                                                                \
+        }                                                                                      \
+        alignas(64) int vals[32];                                                              \
+        alignas(64) int offsets[32];                                                           \
+        _mm512_store_si512((void *)vals, b0);                                                  \
+        _mm512_store_si512((void *)(vals + 16), b1);                                           \
+        _mm512_store_si512((void *)offsets, i0);                                               \
+        _mm512_store_si512((void *)(offsets + 16), i1);                                        \
+        return resolve_arg##kind(a, n, i, vals, offsets, 32, i > 0, value);                    \
+    }                                                                                          \
+                                                                                               \
+    DEFINE_CHUNKED_ARG(avx512, kind, BETTER)                                                   \
+                                                                                               \
+    AVX512_ATTR static size_t avx512_arg##kind(const int a[], size_t n) {                      \
+        if (n <= REDUCE_TWO_PASS_MAX) {                                                        \
+            return n == 0 ? 0 : avx512_find(a, n, avx512_##kind(a, n));                        \
+        }                                                                                      \
+        return avx512_arg##kind##_chunked(a, n);                                               \
+    }
+
+DEFINE_AVX512_REDUCE(min, INT_MAX, LESS, _mm512_min_epi32, AVX512_BEATS_MIN,
+                     _mm512_reduce_min_epi32)
+DEFINE_AVX512_REDUCE(max, INT_MIN, GREATER, _mm512_max_epi32, AVX512_BEATS_MAX,
+                     _mm512_reduce_max_epi32)
+
+AVX512_ATTR static void avx512_minmax(const int a[], size_t n, int *min_out, int *max_out) {
+    __m512i lo0 = _mm512_set1_epi32(INT_MAX), lo1 = lo0;
+    __m512i hi0 = _mm512_set1_epi32(INT_MIN), hi1 = hi0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512i x0 = avx512_load(a + i);
+        __m512i x1 = avx512_load(a + i + 16);
+        lo0 = _mm512_min_epi32(lo0, x0);
+        hi0 = _mm512_max_epi32(hi0, x0);
+        lo1 = _mm512_min_epi32(lo1, x1);
+        hi1 = _mm512_max_epi32(hi1, x1);
+    }
+    int lo = _mm512_reduce_min_epi32(_mm512_min_epi32(lo0, lo1));
+    int hi = _mm512_reduce_max_epi32(_mm512_max_epi32(hi0, hi1));
+    for (; i < n; i++) {
+        lo = a[i] < lo ? a[i] : lo;
+        hi = a[i] > hi ? a[i] : hi;
+    }
+    *min_out = lo;
+    *max_out = hi;
+}
+
+#endif  // REDUCE_X86
+
+// ---------------------------------------------------------------------------
+// AArch64: NEON (4 lanes, part of the base ISA)
+// ---------------------------------------------------------------------------
+
+#ifdef REDUCE_ARM_NEON
+
+#define NEON_BEATS_MIN(acc, x) vcltq_s32(x, acc)
+#define NEON_BEATS_MAX(acc, x) vcgtq_s32(x, acc)
+
+static size_t neon_find(const int a[], size_t n, int key) {
+    int32x4_t k = vdupq_n_s32(key);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint32x4_t e0 = vceqq_s32(vld1q_s32(a + i), k);
+        uint32x4_t e1 = vceqq_s32(vld1q_s32(a + i + 4), k);
+        uint32x4_t e2 = vceqq_s32(vld1q_s32(a + i + 8), k);
+        uint32x4_t e3 = vceqq_s32(vld1q_s32(a + i + 12), k);
+        if (vmaxvq_u32(vorrq_u32(vorrq_u32(e0, e1), vorrq_u32(e2, e3))) != 0) {
+            break;  // The scalar loop below pins down the lane
+        }
+    }
+    for (; i < n; i++) {
+        if (a[i] == key) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#define DEFINE_NEON_REDUCE(kind, ID, BETTER, VBEST, BEATS, HBEST)                              \
+    static int neon_##kind(const int a[], size_t n) {                                          \
+        int32x4_t b0 = vdupq_n_s32(ID), b1 = b0, b2 = b0, b3 = b0;                             \
+        size_t i = 0;                                                                          \
+        for (; i + 16 <= n; i += 16) {                                                         \
+            b0 = VBEST(b0, vld1q_s32(a + i));                                                  \
+            b1 = VBEST(b1, vld1q_s32(a + i + 4));                                              \
+            b2 = VBEST(b2, vld1q_s32(a + i + 8));                                              \
+            b3 = VBEST(b3, vld1q_s32(a + i + 12));                                             \
+        }                                                                                      \
+        int best = HBEST(VBEST(VBEST(b0, b1), VBEST(b2, b3)));                                 \
+        for (; i < n; i++) {                                                                   \
+            best = BETTER(a[i], best) ? a[i] : best;                                           \
+        }                                                                                      \
+        return best;                                                                           \
+    }                                                                                          \
+                                                                                               \
+    static size_t neon_arg##kind##_chunk(const int a[], size_t n, int *value) {                \
+        int32x4_t b0 = vdupq_n_s32(ID), b1 = b0;                                               \
+        int32x4_t i0 = vdupq_n_s32(0), i1 = i0;                                                \
+        size_t i = 0;                                                                          \
+        for (; i + 8 <= n; i += 8) {                                                           \
+            int32x4_t base = vdupq_n_s32((int)i);                                              \
+            int32x4_t x0 = vld1q_s32(a + i);                                                   \
+            int32x4_t x1 = vld1q_s32(a + i + 4);                                               \
+            i0 = vbslq_s32(BEATS(b0, x0), base, i0);                                           \
+            i1 = vbslq_s32(BEATS(b1, x1), base, i1);                                           \
+            b0 = VBEST(b0, x0);                                                                \
+            b1 = VBEST(b1, x1);                                                                \
+        }                                                                                      \
+        int vals[8];                                                                           \
+        int offsets[8];                                                                        \
+        vst1q_s32(vals, b0);                                                                   \
+        vst1q_s32(vals + 4, b1);                                                               \
+        vst1q_s32(offsets, i0);                                                                \
+        vst1q_s32(offsets + 4, i1);                                                            \
+        return resolve_arg##kind(a, n, i, vals, offsets, 8, i > 0, value);                     \
+    }                                                                                          \
+                                                                                               \
+    DEFINE_CHUNKED_ARG(neon, kind, BETTER)                                                     \
+                                                                                               \
+    static size_t neon_arg##kind(const int a[], size_t n) {                                    \
+        if (n <= REDUCE_TWO_PASS_MAX) {                                                        \
+            return n == 0 ? 0 : neon_find(a, n, neon_##kind(a, n));                            \
+        }                                                                                      \
+        return neon_arg##kind##_chunked(a, n);                                                 \
+    }
+
+DEFINE_NEON_REDUCE(min, INT_MAX, LESS, vminq_s32, NEON_BEATS_MIN, vminvq_s32)
+DEFINE_NEON_REDUCE(max, INT_MIN, GREATER, vmaxq_s32, NEON_BEATS_MAX, vmaxvq_s32)
+
+static void neon_minmax(const int a[], size_t n, int *min_out, int *max_out) {
+    int32x4_t lo0 = vdupq_n_s32(INT_MAX), lo1 = lo0;
+    int32x4_t hi0 = vdupq_n_s32(INT_MIN), hi1 = hi0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int32x4_t x0 = vld1q_s32(a + i);
+        int32x4_t x1 = vld1q_s32(a + i + 4);
+        lo0 = vminq_s32(lo0, x0);
+        hi0 = vmaxq_s32(hi0, x0);
+        lo1 = vminq_s32(lo1, x1);
+        hi1 = vmaxq_s32(hi1, x1);
+    }
+    int lo = vminvq_s32(vminq_s32(lo0, lo1));
+    int hi = vmaxvq_s32(vmaxq_s32(hi0, hi1));
+    for (; i < n; i++) {
+        lo = a[i] < lo ? a[i] : lo;
+        hi = a[i] > hi ? a[i] : hi;
+    }
+    *min_out = lo;
+    *max_out = hi;
+}
+
+#endif  // REDUCE_ARM_NEON
+
+// ---------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    value_fn min;
+    value_fn max;
+    index_fn argmin;
+    index_fn argmax;
+    minmax_fn minmax;
+} reduce_impl;
+
+#define SCALAR_IMPL {scalar_min, scalar_max, scalar_argmin, scalar_argmax, scalar_minmax}
+
+// Paths this build cannot run fall back to portable C; reduce_force()
+// refuses them anyway
+static const reduce_impl implementations[REDUCE_ISA_COUNT] = {
+    SCALAR_IMPL,
+#ifdef REDUCE_X86
+    {avx2_min, avx2_max, avx2_argmin, avx2_argmax, avx2_minmax},
+    {avx512_min, avx512_max, avx512_argmin, avx512_argmax, avx512_minmax},
+#else
+    SCALAR_IMPL,
+    SCALAR_IMPL,
+#endif
+#ifdef REDUCE_ARM_NEON
+    {neon_min, neon_max, neon_argmin, neon_argmax, neon_minmax},
+#else
+    SCALAR_IMPL,
+#endif
+};
+
+static const char *const isa_names[REDUCE_ISA_COUNT] = {"scalar", "avx2", "avx512", "neon"};
+
+static atomic_int active_isa = -1;  // Resolved on first use
+
+static bool isa_supported(reduce_isa isa) {
+    switch (isa) {
+    case REDUCE_SCALAR:
+        return true;
+#ifdef REDUCE_X86
+    case REDUCE_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    case REDUCE_AVX512:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f");
+#endif
+#ifdef REDUCE_ARM_NEON
+    case REDUCE_NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+reduce_isa reduce_detect(void) {
+    if (isa_supported(REDUCE_AVX512)) {
+        return REDUCE_AVX512;
+    }
+    if (isa_supported(REDUCE_AVX2)) {
+        return REDUCE_AVX2;
+    }
+    if (isa_supported(REDUCE_NEON)) {
+        return REDUCE_NEON;
+    }
+    return REDUCE_SCALAR;
+}
+
+reduce_isa reduce_active(void) {
+    int isa = atomic_load_explicit(&active_isa, memory_order_relaxed);
+    if (isa < 0) {
+        isa = (int)reduce_detect();
+        atomic_store_explicit(&active_isa, isa, memory_order_relaxed);
+    }
+    return (reduce_isa)isa;
+}
+
+int reduce_force(reduce_isa isa) {
+    if (isa >= REDUCE_ISA_COUNT || !isa_supported(isa)) {
+        return -1;
+    }
+    atomic_store_explicit(&active_isa, (int)isa, memory_order_relaxed);
+    return 0;
+}
+
+const char *reduce_isa_name(reduce_isa isa) {
+    return isa < REDUCE_ISA_COUNT ? isa_names[isa] : "unknown";
+}
+
+int reduce_min(const int arr[], size_t n) {
+    return implementations[reduce_active()].min(arr, n);
+}
+
+int reduce_max(const int arr[], size_t n) {
+    return implementations[reduce_active()].max(arr, n);
+}
+
+size_t reduce_argmin(const int arr[], size_t n) {
+    return implementations[reduce_active()].argmin(arr, n);
+}
+
+size_t reduce_argmax(const int arr[], size_t n) {
+    return implementations[reduce_active()].argmax(arr, n);
+}
+
+void reduce_minmax(const int arr[], size_t n, int *min_out, int *max_out) {
+    implementations[reduce_active()].minmax(arr, n, min_out, max_out);
+}
@@ -0,0 +1,66 @@
+/**
+ * Vectorized Min/Max Reductions over int Arrays
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * min, max, argmin, argmax and a one-pass minmax, shared by selection
+ * sort's min-scan and the range scans of the radix and counting sorts.
+ * The implementation is chosen once at runtime, as in sortnet.h:
+ * AVX-512F or AVX2 from CPUID on x86, NEON on AArch64, else portable C.
+ * Every path keeps several independent accumulators, so the loop-carried
+ * chain is one min/max per accumulator rather than one per element.
+ */
+
+#ifndef ROSETTA_REDUCE_H
+#define ROSETTA_REDUCE_H
+
+#include <stddef.h>
+
+typedef enum {
+    REDUCE_SCALAR = 0,
+    REDUCE_AVX2,
+    REDUCE_AVX512,
+    REDUCE_NEON,
+    REDUCE_ISA_COUNT
+} reduce_isa;
+
+/**
+ * Smallest / largest of arr[0..n); INT_MAX / INT_MIN when n == 0
+ */
+int reduce_min(const int arr[], size_t n);
+int reduce_max(const int arr[], size_t n);
+
+/**
+ * Index of the first smallest / largest key of arr[0..n); 0 when n == 0
+ */
+size_t reduce_argmin(const int arr[], size_t n);
+size_t reduce_argmax(const int arr[], size_t n);
+
+/**
+ * Smallest and largest key in one pass (INT_MAX / INT_MIN when n == 0)
+ */
+void reduce_minmax(const int arr[], size_t n, int *min_out, int *max_out);
+
+/**
+ * Best instruction set this CPU supports
+ */
+reduce_isa reduce_detect(void);
+
+/**
+ * Instruction set currently in use
+ */
+reduce_isa reduce_active(void);
+
+/**
+ * Use a specific instruction set (e.g. to benchmark each path).
+ * Returns 0 on success, -1 if the CPU does not support it.
+ */
+int reduce_force(reduce_isa isa);
+
+/**
+ * Display name ("scalar", "avx2", "avx512", "neon")
+ */
+const char *reduce_isa_name(reduce_isa isa);
+
+#endif  // ROSETTA_REDUCE_H
@@ -0,0 +1,355 @@
+/**
+ * Type-Generic Sorting of Keys and Records
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Header-only and generated per element type, so the key comparison is
+ * inlined into every engine rather than called through qsort()'s
+ * comparator: SORT_DEFINE(name, type, key_type, key_of, bits_type,
+ * to_bits) emits
+ *
+ *   name##_quicksort()     introsort (median-of-3 Hoare, heap fallback)
+ *   name##_mergesort()     stable bottom-up mergesort
+ *   name##_heapsort()      bottom-up (Floyd) heap sort
+ *   name##_radix_sort()    stable LSD radix sort, 8-bit digits
+ *   name##_sort_indexed()  stable key-index sort: radix-sorts (key, u32
+ *                          index) pairs, then moves each record once
+ *   name##_is_sorted()
+ *
+ * key_of(const type *) extracts the key (a macro or inline function);
+ * engines compare keys with `<`, so float keys must not be NaN.
+ * to_bits(key_type) maps the key to an unsigned bits_type with the same
+ * order, for the radix engines; sort_bits_*() cover the usual key types.
+ *
+ * Records wider than the (key, index) pair are where the key-index mode
+ * pays: every radix pass scatters 8 or 16 bytes instead of the record,
+ * and the records move once, in the final gather.
+ *
+ * The engines that allocate (mergesort, radix, indexed) take one n-sized
+ * buffer and return 0, or -1 with the array unchanged on failure.
+ * sort_u64 (uint64_t arrays) and sort_float (float arrays) are
+ * instantiated below.
+ */
+
+#ifndef ROSETTA_SORT_GENERIC_H
+#define ROSETTA_SORT_GENERIC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Partitions at most this long are insertion-sorted
+#define SORT_INSERTION_MAX 16
+
+// Initial run length of the bottom-up mergesort
+#define SORT_RUN 32
+
+// Key extractor for arrays of bare keys
+#define SORT_KEY_SELF(p) (*(p))
+
+/**
+ * Order-preserving maps of keys to unsigned bits, for the radix engines
+ */
+static inline uint32_t sort_bits_u32(uint32_t key) {
+    return key;
+}
+
+static inline uint32_t sort_bits_i32(int32_t key) {
+    return (uint32_t)key ^ UINT32_C(0x80000000);
+}
+
+static inline uint64_t sort_bits_u64(uint64_t key) {
+    return key;
+}
+
+static inline uint64_t sort_bits_i64(int64_t key) {
+    return (uint64_t)key ^ UINT64_C(0x8000000000000000);
+}
+
+// Negative floats: flip every bit; positive: flip the sign bit
+static inline uint32_t sort_bits_f32(float key) {
+    uint32_t bits;
+    memcpy(&bits, &key, sizeof(bits));
+    return bits ^ ((uint32_t)-(int32_t)(bits >> 31) | UINT32_C(0x80000000));
+}
+
+static inline uint64_t sort_bits_f64(double key) {
+    uint64_t bits;
+    memcpy(&bits, &key, sizeof(bits));
+    return bits ^ ((uint64_t)-(int64_t)(bits >> 63) | UINT64_C(0x8000000000000000));
+}
+
+#define SORT_DEFINE_LSD(fn, elem_type, bits_type, bits_of)                                     \
+    /* LSD radix sort of n elems on bits(&elem), 8-bit digits, stable */                       \
+    static inline int fn(elem_type *a, size_t n) {                                             \
+        size_t counts[sizeof(bits_type)][256];                                                 \
+        memset(counts, 0, sizeof(counts));                                                     \
+        for (size_t i = 0; i < n; i++) {                                                       \
+            bits_type b = bits_of(&a[i]);                                                      \
+            for (size_t p = 0; p < sizeof(bits_type); p++) {                                   \
+                counts[p][(b >> (8 * p)) & 255]++;                                             \
+            }                                                                                  \
+        }                                                                                      \
+        if (n < 2) {                                                                           \
+            return 0;                                                                          \
+        }                                                                                      \
+        elem_type *buf = malloc(n * sizeof(elem_type));                                        \
+        if (buf == NULL) {                                                                     \
+            return -1;                                                                         \
+        }                                                                                      \
+        elem_type *src = a;                                                                    \
+        elem_type *dst = buf;                                                                  \
+        for (size_t p = 0; p < sizeof(bits_type); p++) {                                       \
+            size_t *count = counts[p];                                                         \
+            if (count[(bits_of(&src[0]) >> (8 * p)) & 255] == n) {                             \
+                continue; /* Every key has this digit: the pass would copy */                  \
+            }                                                                                  \
+            size_t offset = 0;                                                                 \
+            for (int d = 0; d < 256; d++) {                                                    \
+                size_t c = count[d];                                                           \
+                count[d] = offset;                                                             \
+                offset += c;                                                                   \
+            }                                                                                  \
+            for (size_t i = 0; i < n; i++) {                                                   \
+                dst[count[(bits_of(&src[i]) >> (8 * p)) & 255]++] = src[i];                    \
+            }                                                                                  \
+            elem_type *t = src;                                                                \
+            src = dst;                                                                         \
+            dst = t;                                                                           \
+        }                                                                                      \
+        if (src != a) {                                                                        \
+            memcpy(a, src, n * sizeof(elem_type));                                             \
+        }                                                                                      \
+        free(buf);                                                                             \
+        return 0;                                                                              \
+    }
+
+#define SORT_DEFINE(name, type, key_type, key_of, bits_type, to_bits)                          \
+    static inline int name##_less(const type *x, const type *y) {                              \
+        return key_of(x) < key_of(y);                                                          \
+    }                                                                                          \
+                                                                                               \
+    static inline bits_type name##_bits(const type *r) {                                       \
+        return to_bits(key_of(r));                                                             \
+    }                                                                                          \
+                                                                                               \
+    /* Key-index pair: the radix passes move these instead of records */                       \
+    typedef struct {                                                                           \
+        bits_type key;                                                                         \
+        uint32_t index;                                                                        \
+    } name##_pair;                                                                             \
+                                                                                               \
+    static inline bits_type name##_pair_bits(const name##_pair *p) {                           \
+        return p->key;                                                                         \
+    }                                                                                          \
+                                                                                               \
+    SORT_DEFINE_LSD(name##_lsd, type, bits_type, name##_bits)                                  \
+    SORT_DEFINE_LSD(name##_pair_lsd, name##_pair, bits_type, name##_pair_bits)                 \
+                                                                                               \
+    static inline int name##_is_sorted(const type *a, size_t n) {                              \
+        for (size_t i = 1; i < n; i++) {                                                       \
+            if (name##_less(&a[i], &a[i - 1])) {                                               \
+                return 0;                                                                      \
+            }                                                                                  \
+        }                                                                                      \
+        return 1;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    /* Stable insertion sort of a[lo..hi) */                                                   \
+    static inline void name##_insertion(type *a, size_t lo, size_t hi) {                       \
+        for (size_t i = lo + 1; i < hi; i++) {                                                 \
+            type x = a[i];                                                                     \
+            size_t j = i;                                                                      \
+            while (j > lo && name##_less(&x, &a[j - 1])) {                                     \
+                a[j] = a[j - 1];                                                               \
+                j--;                                                                           \
+            }                                                                                  \
+            a[j] = x;                                                                          \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    /* Floyd sift: the hole at i descends through the larger children to a */                  \
+    /* leaf, then the displaced key climbs back up */                                          \
+    static inline void name##_sift(type *a, size_t i, size_t n) {                              \
+        type x = a[i];                                                                         \
+        size_t top = i;                                                                        \
+        size_t child;                                                                          \
+        while ((child = 2 * i + 1) < n) {                                                      \
+            if (child + 1 < n && name##_less(&a[child], &a[child + 1])) {                      \
+                child++;                                                                       \
+            }                                                                                  \
+            a[i] = a[child];                                                                   \
+            i = child;                                                                         \
+        }                                                                                      \
+        while (i > top) {                                                                      \
+            size_t parent = (i - 1) / 2;                                                       \
+            if (!name##_less(&a[parent], &x)) {                                                \
+                break;                                                                         \
+            }                                                                                  \
+            a[i] = a[parent];                                                                  \
+            i = parent;                                                                        \
+        }                                                                                      \
+        a[i] = x;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    static inline void name##_heapsort(type *a, size_t n) {                                    \
+        for (size_t i = n / 2; i-- > 0;) {                                                     \
+            name##_sift(a, i, n);                                                              \
+        }                                                                                      \
+        for (size_t end = n; end-- > 1;) {                                                     \
+            type x = a[end];                                                                   \
+            a[end] = a[0];                                                                     \
+            a[0] = x;                                                                          \
+            name##_sift(a, 0, end);                                                            \
+        }                                                                                      \
+    }                                                                                          \
+                                                                                               \
+    static inline void name##_introsort(type *a, size_t n, int depth) {                        \
+        while (n > SORT_INSERTION_MAX) {                                                       \
+            if (depth-- == 0) {                                                                \
+                name##_heapsort(a, n);                                                         \
+                return;                                                                        \
+            }                                                                                  \
+            /* Median of three as the Hoare pivot value */                                     \
+            type *lo = &a[0];                                                                  \
+            type *mid = &a[n / 2];                                                             \
+            type *hi = &a[n - 1];                                                              \
+            if (name##_less(mid, lo)) {                                                        \
+                type *t = lo;                                                                  \
+                lo = mid;                                                                      \
+                mid = t;                                                                       \
+            }                                                                                  \
+            if (name##_less(hi, mid)) {                                                        \
+                mid = name##_less(hi, lo) ? lo : hi;                                           \
+            }                                                                                  \
+            type pivot = *mid;                                                                 \
+            size_t i = 0;                                                                      \
+            size_t j = n - 1;                                                                  \
+            for (;;) {                                                                         \
+                while (name##_less(&a[i], &pivot)) {                                           \
+                    i++;                                                                       \
+                }                                                                              \
+                while (name##_less(&pivot, &a[j])) {                                           \
+                    j--;                                                                       \
+                }                                                                              \
+                if (i >= j) {                                                                  \
+                    break;                                                                     \
+                }                                                                              \
+                type t = a[i];                                                                 \
+                a[i] = a[j];                                                                   \
+                a[j] = t;                                                                      \
+                i++;                                                                           \
+                j--;                                                                           \
+            }                                                                                  \
+            /* a[0..j] <= pivot <= a[j+1..n): recurse on the smaller side */                   \
+            size_t left = j + 1;                                                               \
+            if (left < n - left) {                                                             \
+                name##_introsort(a, left, depth);                                              \
+                a += left;                                                                     \
+                n -= left;                                                                     \
+            } else {                                                                           \
+                name##_introsort(a + left, n - left, depth);                                   \
+                n = left;                                                                      \
+            }                                                                                  \
+        }                                                                                      \
+        name##_insertion(a, 0, n);                                                             \
+    }                                                                                          \
+                                                                                               \
+    /* Introsort: median-of-3 Hoare quicksort, heap sort past 2 log2(n) */                     \
+    /* levels, insertion sort below SORT_INSERTION_MAX. Not stable. */                         \
+    static inline void name##_quicksort(type *a, size_t n) {                                   \
+        int depth = 0;                                                                         \
+        for (size_t m = n; m > 1; m >>= 1) {                                                   \
+            depth += 2;                                                                        \
+        }                                                                                      \
+        name##_introsort(a, n, depth);                                                         \
+    }                                                                                          \
+                                                                                               \
+    /* Stable bottom-up mergesort: insertion-sorted runs, then merge passes */                 \
+    /* between a and one n-record buffer. Returns 0, or -1 (a unchanged). */                   \
+    static inline int name##_mergesort(type *a, size_t n) {                                    \
+        for (size_t lo = 0; lo < n; lo += SORT_RUN) {                                          \
+            name##_insertion(a, lo, lo + SORT_RUN < n ? lo + SORT_RUN : n);                    \
+        }                                                                                      \
+        if (n <= SORT_RUN) {                                                                   \
+            return 0;                                                                          \
+        }                                                                                      \
+        type *buf = malloc(n * sizeof(type));                                                  \
+        if (buf == NULL) {                                                                     \
+            return -1;                                                                         \
+        }                                                                                      \
+        type *src = a;                                                                         \
+        type *dst = buf;                                                                       \
+        for (size_t width = SORT_RUN; width < n; width *= 2) {                                 \
+            for (size_t lo = 0; lo < n; lo += 2 * width) {                                     \
+                size_t mid = lo + width < n ? lo + width : n;                                  \
+                size_t hi = lo + 2 * width < n ? lo + 2 * width : n;                           \
+                size_t i = lo;                                                                 \
+                size_t j = mid;                                                                \
+                size_t k = lo;                                                                 \
+                while (i < mid && j < hi) {                                                    \
+                    dst[k++] = name##_less(&src[j], &src[i]) ? src[j++] : src[i++];            \
+                }                                                                              \
+                while (i < mid) {                                                              \
+                    dst[k++] = src[i++];                                                       \
+                }                                                                              \
+                while (j < hi) {                                                               \
+                    dst[k++] = src[j++];                                                       \
+                }                                                                              \
+            }                                                                                  \
+            type *t = src;                                                                     \
+            src = dst;                                                                         \
+            dst = t;                                                                           \
+        }                                                                                      \
+        if (src != a) {                                                                        \
+            memcpy(a, src, n * sizeof(type));                                                  \
+        }                                                                                      \
+        free(buf);                                                                             \
+        return 0;                                                                              \
+    }                                                                                          \
+                                                                                               \
+    /* Stable LSD radix sort moving whole records every pass */                                \
+    static inline int name##_radix_sort(type *a, size_t n) {                                   \
+        return name##_lsd(a, n);                                                               \
+    }                                                                                          \
+                                                                                               \
+    /* Key-index sort: radix-sort (key, u32 index) pairs, then gather the */                   \
+    /* records once. Stable. Returns 0, or -1 (memory, n > UINT32_MAX). */                     \
+    static inline int name##_sort_indexed(type *a, size_t n) {                                 \
+        if (n > UINT32_MAX) {                                                                  \
+            return -1;                                                                         \
+        }                                                                                      \
+        if (n < 2) {                                                                           \
+            return 0;                                                                          \
+        }                                                                                      \
+        name##_pair *pairs = malloc(n * sizeof(name##_pair));                                  \
+        type *out = malloc(n * sizeof(type));                                                  \
+        if (pairs == NULL || out == NULL) {                                                    \
+            free(pairs);                                                                       \
+            free(out);                                                                         \
+            return -1;                                                                         \
+        }                                                                                      \
+        for (size_t i = 0; i < n; i++) {                                                       \
+            pairs[i].key = name##_bits(&a[i]);                                                 \
+            pairs[i].index = (uint32_t)i;                                                      \
+        }                                                                                      \
+        if (name##_pair_lsd(pairs, n) != 0) {                                                  \
+            free(pairs);                                                                       \
+            free(out);                                                                         \
+            return -1;                                                                         \
+        }                                                                                      \
+        for (size_t i = 0; i < n; i++) {                                                       \
+            out[i] = a[pairs[i].index];                                                        \
+        }                                                                                      \
+        memcpy(a, out, n * sizeof(type));                                                      \
+        free(pairs);                                                                           \
+        free(out);                                                                             \
+        return 0;                                                                              \
+    }
+
+SORT_DEFINE(sort_u64, uint64_t, uint64_t, SORT_KEY_SELF, uint64_t, sort_bits_u64)
+SORT_DEFINE(sort_float, float, float, SORT_KEY_SELF, uint32_t, sort_bits_f32)
+
+#endif  // ROSETTA_SORT_GENERIC_H
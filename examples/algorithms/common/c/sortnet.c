@@ -0,0 +1,434 @@
+/**
+ * SIMD Sorting-Network Kernels for Small Blocks
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Every vector width uses the same scheme:
+ * - sort each register in-lane with a bitonic network (compare-exchange
+ *   stages built from one shuffle, min, max and blend)
+ * - merge sorted register groups pairwise: reverse the second group so the
+ *   pair is bitonic, half-clean across registers, then finish in-lane
+ *
+ * Kernels are compiled with per-function target attributes, so this file
+ * needs no -m flags and the binary still runs on CPUs without AVX.
+ */
+
+#include "sortnet.h"
+
+#include <limits.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SORTNET_X86 1
+#include <immintrin.h>
+#endif
+
+typedef void (*sort_fn)(int arr[], size_t n);
+typedef void (*merge_fn)(const int a[], size_t na, const int b[], size_t nb, int out[]);
+
+static void insertion_sort(int arr[], size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        int key = arr[i];
+        size_t j = i;
+        while (j > 0 && arr[j - 1] > key) {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = key;
+    }
+}
+
+static void merge_scalar(const int a[], size_t na, const int b[], size_t nb, int out[]) {
+    size_t i = 0;
+    size_t j = 0;
+    size_t k = 0;
+
+    while (i < na && j < nb) {
+        out[k++] = b[j] < a[i] ? b[j++] : a[i++];
+    }
+    memcpy(out + k, a + i, (na - i) * sizeof(int));
+    k += na - i;
+    memcpy(out + k, b + j, (nb - j) * sizeof(int));
+}
+
+/**
+ * Registers needed for n elements: ceil(n / lanes) rounded up to a power
+ * of two, since the register-level merges pair groups of equal size
+ */
+static size_t register_count(size_t n, size_t lanes) {
+    size_t count = 1;
+    while (count * lanes < n) {
+        count *= 2;
+    }
+    return count;
+}
+
+/**
+ * Register-level bitonic sort shared by every vector width. Expects the
+ * in-lane helpers prefix##_sort1 (sort one register), prefix##_clean1
+ * (sort one bitonic register) and prefix##_reverse1 (reverse lanes).
+ */
+#define DEFINE_REGISTER_SORT(prefix, vec, lanes, ATTR, vmin, vmax, vload, vstore)  \
+    /* Merge sorted v[0..count/2) and v[count/2..count) in place */                 \
+    ATTR static void prefix##_merge_regs(vec v[], size_t count) {                    \
+        size_t half = count / 2;                                                     \
+        for (size_t i = 0; i < half / 2; i++) {                                      \
+            vec t = v[half + i];                                                     \
+            v[half + i] = v[count - 1 - i];                                          \
+            v[count - 1 - i] = t;                                                    \
+        }                                                                            \
+        for (size_t i = half; i < count; i++) {                                      \
+            v[i] = prefix##_reverse1(v[i]);                                          \
+        }                                                                            \
+        for (size_t d = half; d >= 1; d /= 2) {                                      \
+            for (size_t i = 0; i < count; i++) {                                     \
+                if ((i & d) == 0) {                                                  \
+                    vec lo = vmin(v[i], v[i + d]);                                   \
+                    vec hi = vmax(v[i], v[i + d]);                                   \
+                    v[i] = lo;                                                       \
+                    v[i + d] = hi;                                                   \
+                }                                                                    \
+            }                                                                        \
+        }                                                                            \
+        for (size_t i = 0; i < count; i++) {                                         \
+            v[i] = prefix##_clean1(v[i]);                                            \
+        }                                                                            \
+    }                                                                                \
+                                                                                     \
+    ATTR static void prefix##_sort(int arr[], size_t n) {                            \
+        if (n <= 1) {                                                                \
+            return;                                                                  \
+        }                                                                            \
+        if (n > SORTNET_MAX) {                                                       \
+            insertion_sort(arr, n);                                                  \
+            return;                                                                  \
+        }                                                                            \
+                                                                                     \
+        /* Pad to whole registers with INT_MAX, which sorts to the end */            \
+        alignas(64) int buf[SORTNET_MAX];                                            \
+        size_t count = register_count(n, lanes);                                     \
+        memcpy(buf, arr, n * sizeof(int));                                           \
+        for (size_t i = n; i < count * (lanes); i++) {                               \
+            buf[i] = INT_MAX;                                                        \
+        }                                                                            \
+                                                                                     \
+        vec v[SORTNET_MAX / (lanes)];                                                \
+        for (size_t i = 0; i < count; i++) {                                         \
+            v[i] = prefix##_sort1(vload(buf + i * (lanes)));                         \
+        }                                                                            \
+        for (size_t width = 1; width < count; width *= 2) {                          \
+            for (size_t g = 0; g < count; g += 2 * width) {                          \
+                prefix##_merge_regs(v + g, 2 * width);                               \
+            }                                                                        \
+        }                                                                            \
+        for (size_t i = 0; i < count; i++) {                                         \
+            vstore(buf + i * (lanes), v[i]);                                         \
+        }                                                                            \
+        memcpy(arr, buf, n * sizeof(int));                                           \
+    }
+
+#ifdef SORTNET_X86
+
+// --- SSE4.1: 4 lanes ---
+
+#define SSE41_ATTR __attribute__((target("sse4.1")))
+#define SSE41_INLINE static inline __attribute__((target("sse4.1"), always_inline))
+
+// Compare-exchange with the lanes picked by shuffle; lanes set in the
+// 16-bit blend mask keep the maximum
+#define SSE41_STAGE(v, shuf, mask)                                     \
+    do {                                                               \
+        __m128i p_ = _mm_shuffle_epi32(v, shuf);                       \
+        v = _mm_blend_epi16(_mm_min_epi32(v, p_), _mm_max_epi32(v, p_), mask); \
+    } while (0)
+
+SSE41_INLINE __m128i sse41_sort1(__m128i v) {
+    SSE41_STAGE(v, _MM_SHUFFLE(2, 3, 0, 1), 0xCC);
+    SSE41_STAGE(v, _MM_SHUFFLE(0, 1, 2, 3), 0xF0);
+    SSE41_STAGE(v, _MM_SHUFFLE(2, 3, 0, 1), 0xCC);
+    return v;
+}
+
+SSE41_INLINE __m128i sse41_clean1(__m128i v) {
+    SSE41_STAGE(v, _MM_SHUFFLE(1, 0, 3, 2), 0xF0);
+    SSE41_STAGE(v, _MM_SHUFFLE(2, 3, 0, 1), 0xCC);
+    return v;
+}
+
+SSE41_INLINE __m128i sse41_reverse1(__m128i v) {
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+SSE41_INLINE __m128i sse41_min(__m128i a, __m128i b) {
+    return _mm_min_epi32(a, b);
+}
+
+SSE41_INLINE __m128i sse41_max(__m128i a, __m128i b) {
+    return _mm_max_epi32(a, b);
+}
+
+SSE41_INLINE __m128i sse41_load(const int *p) {
+    return _mm_load_si128((const __m128i *)p);
+}
+
+SSE41_INLINE void sse41_store(int *p, __m128i v) {
+    _mm_store_si128((__m128i *)p, v);
+}
+
+DEFINE_REGISTER_SORT(sse41, __m128i, 4, SSE41_ATTR, sse41_min, sse41_max, sse41_load, sse41_store)
+
+// --- AVX2: 8 lanes ---
+
+#define AVX2_ATTR __attribute__((target("avx2")))
+#define AVX2_INLINE static inline __attribute__((target("avx2"), always_inline))
+
+// Compare-exchange with partner vector p; lanes set in mask keep the maximum
+#define AVX2_STAGE(v, p, mask)                                              \
+    do {                                                                    \
+        __m256i p_ = (p);                                                   \
+        v = _mm256_blend_epi32(_mm256_min_epi32(v, p_), _mm256_max_epi32(v, p_), mask); \
+    } while (0)
+
+AVX2_INLINE __m256i avx2_reverse1(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+AVX2_INLINE __m256i avx2_sort1(__m256i v) {
+    AVX2_STAGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+    AVX2_STAGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)), 0xCC);
+    AVX2_STAGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+    AVX2_STAGE(v, avx2_reverse1(v), 0xF0);
+    AVX2_STAGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0xCC);
+    AVX2_STAGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+    return v;
+}
+
+AVX2_INLINE __m256i avx2_clean1(__m256i v) {
+    AVX2_STAGE(v, _mm256_permute2x128_si256(v, v, 0x01), 0xF0);
+    AVX2_STAGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0xCC);
+    AVX2_STAGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+    return v;
+}
+
+AVX2_INLINE __m256i avx2_min(__m256i a, __m256i b) {
+    return _mm256_min_epi32(a, b);
+}
+
+AVX2_INLINE __m256i avx2_max(__m256i a, __m256i b) {
+    return _mm256_max_epi32(a, b);
+}
+
+AVX2_INLINE __m256i avx2_load(const int *p) {
+    return _mm256_load_si256((const __m256i *)p);
+}
+
+AVX2_INLINE void avx2_store(int *p, __m256i v) {
+    _mm256_store_si256((__m256i *)p, v);
+}
+
+DEFINE_REGISTER_SORT(avx2, __m256i, 8, AVX2_ATTR, avx2_min, avx2_max, avx2_load, avx2_store)
+
+/**
+ * Vectorized merge: keep the upper 8 of each 8+8 register merge, emit the
+ * lower 8, and refill from whichever input has the smaller next key
+ */
+AVX2_ATTR static void avx2_merge(const int a[], size_t na, const int b[], size_t nb, int out[]) {
+    if (na < 8 || nb < 8) {
+        merge_scalar(a, na, b, nb, out);
+        return;
+    }
+
+    __m256i v[2];
+    v[0] = _mm256_loadu_si256((const __m256i *)a);
+    v[1] = _mm256_loadu_si256((const __m256i *)b);
+    size_t ia = 8;
+    size_t ib = 8;
+    size_t k = 0;
+    int take_a;
+
+    for (;;) {
+        avx2_merge_regs(v, 2);
+        _mm256_storeu_si256((__m256i *)(out + k), v[0]);
+        k += 8;
+
+        take_a = ib >= nb || (ia < na && a[ia] <= b[ib]);
+        if (take_a ? na - ia < 8 : nb - ib < 8) {
+            break;
+        }
+        if (take_a) {
+            v[0] = _mm256_loadu_si256((const __m256i *)(a + ia));
+            ia += 8;
+        } else {
+            v[0] = _mm256_loadu_si256((const __m256i *)(b + ib));
+            ib += 8;
+        }
+    }
+
+    // Tail: 8 pending keys, a short remainder on the side that would have
+    // been loaded next, and the rest of the other side
+    alignas(32) int pending[8];
+    int merged[16];
+    _mm256_store_si256((__m256i *)pending, v[1]);
+
+    const int *short_tail = take_a ? a + ia : b + ib;
+    size_t short_len = take_a ? na - ia : nb - ib;
+    const int *long_tail = take_a ? b + ib : a + ia;
+    size_t long_len = take_a ? nb - ib : na - ia;
+
+    merge_scalar(pending, 8, short_tail, short_len, merged);
+    merge_scalar(merged, 8 + short_len, long_tail, long_len, out + k);
+}
+
+// --- AVX-512F: 16 lanes ---
+
+#define AVX512_ATTR __attribute__((target("avx512f")))
+#define AVX512_INLINE static inline __attribute__((target("avx512f"), always_inline))
+
+/**
+ * Compare-exchange lane i with lane i ^ partner_xor; lanes with hi_bit set
+ * keep the maximum
+ */
+AVX512_INLINE __m512i avx512_stage(__m512i v, int partner_xor, int hi_bit) {
+    __m512i iota = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    __m512i idx = _mm512_xor_si512(iota, _mm512_set1_epi32(partner_xor));
+    __mmask16 hi_lanes = _mm512_test_epi32_mask(iota, _mm512_set1_epi32(hi_bit));
+    __m512i p = _mm512_permutexvar_epi32(idx, v);
+    return _mm512_mask_mov_epi32(_mm512_min_epi32(v, p), hi_lanes, _mm512_max_epi32(v, p));
+}
+
+AVX512_INLINE __m512i avx512_sort1(__m512i v) {
+    // Reversal stages (xor 2^k - 1) merge sorted groups; xor stages clean
+    v = avx512_stage(v, 1, 1);
+    v = avx512_stage(v, 3, 2);
+    v = avx512_stage(v, 1, 1);
+    v = avx512_stage(v, 7, 4);
+    v = avx512_stage(v, 2, 2);
+    v = avx512_stage(v, 1, 1);
+    v = avx512_stage(v, 15, 8);
+    v = avx512_stage(v, 4, 4);
+    v = avx512_stage(v, 2, 2);
+    v = avx512_stage(v, 1, 1);
+    return v;
+}
+
+AVX512_INLINE __m512i avx512_clean1(__m512i v) {
+    v = avx512_stage(v, 8, 8);
+    v = avx512_stage(v, 4, 4);
+    v = avx512_stage(v, 2, 2);
+    v = avx512_stage(v, 1, 1);
+    return v;
+}
+
+AVX512_INLINE __m512i avx512_reverse1(__m512i v) {
+    return _mm512_permutexvar_epi32(
+        _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), v);
+}
+
+AVX512_INLINE __m512i avx512_min(__m512i a, __m512i b) {
+    return _mm512_min_epi32(a, b);
+}
+
+AVX512_INLINE __m512i avx512_max(__m512i a, __m512i b) {
+    return _mm512_max_epi32(a, b);
+}
+
+AVX512_INLINE __m512i avx512_load(const int *p) {
+    return _mm512_load_si512(p);
+}
+
+AVX512_INLINE void avx512_store(int *p, __m512i v) {
+    _mm512_store_si512(p, v);
+}
+
+DEFINE_REGISTER_SORT(avx512, __m512i, 16, AVX512_ATTR, avx512_min, avx512_max, avx512_load,
+                     avx512_store)
+
+/**
+ * Blocks that fit one AVX2 register are cheaper there than padded to 16
+ */
+static void avx512_sort_blocks(int arr[], size_t n) {
+    if (n <= 8) {
+        avx2_sort(arr, n);
+    } else {
+        avx512_sort(arr, n);
+    }
+}
+
+#endif  // SORTNET_X86
+
+static void sort_scalar(int arr[], size_t n) {
+    insertion_sort(arr, n);
+}
+
+typedef struct {
+    sort_fn sort;
+    merge_fn merge;
+} sortnet_impl;
+
+// The 16-lane merge has twice the latency per step, so AVX-512 merges
+// with the AVX2 kernel
+static const sortnet_impl implementations[SORTNET_ISA_COUNT] = {
+#ifdef SORTNET_X86
+    {sort_scalar, merge_scalar},
+    {sse41_sort, merge_scalar},
+    {avx2_sort, avx2_merge},
+    {avx512_sort_blocks, avx2_merge},
+#else
+    {sort_scalar, merge_scalar},
+    {sort_scalar, merge_scalar},
+    {sort_scalar, merge_scalar},
+    {sort_scalar, merge_scalar},
+#endif
+};
+
+static const char *const isa_names[SORTNET_ISA_COUNT] = {"scalar", "sse4.1", "avx2", "avx512"};
+
+static atomic_int active_isa = -1;  // Resolved on first use
+
+sortnet_isa sortnet_detect(void) {
+#ifdef SORTNET_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SORTNET_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SORTNET_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SORTNET_SSE41;
+    }
+#endif
+    return SORTNET_SCALAR;
+}
+
+sortnet_isa sortnet_active(void) {
+    int isa = atomic_load_explicit(&active_isa, memory_order_relaxed);
+    if (isa < 0) {
+        isa = (int)sortnet_detect();
+        atomic_store_explicit(&active_isa, isa, memory_order_relaxed);
+    }
+    return (sortnet_isa)isa;
+}
+
+int sortnet_force(sortnet_isa isa) {
+    if (isa >= SORTNET_ISA_COUNT || isa > sortnet_detect()) {
+        return -1;
+    }
+    atomic_store_explicit(&active_isa, (int)isa, memory_order_relaxed);
+    return 0;
+}
+
+const char *sortnet_isa_name(sortnet_isa isa) {
+    return isa < SORTNET_ISA_COUNT ? isa_names[isa] : "unknown";
+}
+
+void sortnet_sort(int arr[], size_t n) {
+    implementations[sortnet_active()].sort(arr, n);
+}
+
+void sortnet_merge(const int a[], size_t na, const int b[], size_t nb, int out[]) {
+    implementations[sortnet_active()].merge(a, na, b, nb, out);
+}
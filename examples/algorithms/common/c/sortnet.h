@@ -0,0 +1,65 @@
+/**
+ * SIMD Sorting-Network Kernels for Small Blocks
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Bitonic sorting networks over blocks of up to SORTNET_MAX ints, run in
+ * registers (8/16/32/64 elements = 1..8 AVX2 registers), and a vectorized
+ * merge built on the same 8+8 register merge. The implementation is
+ * chosen once at runtime from CPUID: AVX-512F, AVX2, SSE4.1, else scalar,
+ * so one binary runs on every fleet generation. Sort leaves of quicksort
+ * and mergesort call sortnet_sort() instead of insertion sort.
+ *
+ * Networks are not stable; for plain int keys that is unobservable.
+ */
+
+#ifndef ROSETTA_SORTNET_H
+#define ROSETTA_SORTNET_H
+
+#include <stddef.h>
+
+// Largest block sortnet_sort() handles with a network
+#define SORTNET_MAX 64
+
+typedef enum {
+    SORTNET_SCALAR = 0,
+    SORTNET_SSE41,
+    SORTNET_AVX2,
+    SORTNET_AVX512,
+    SORTNET_ISA_COUNT
+} sortnet_isa;
+
+/**
+ * Sort arr[0..n) ascending. Blocks larger than SORTNET_MAX fall back to
+ * insertion sort, so callers should stay at leaf sizes.
+ */
+void sortnet_sort(int arr[], size_t n);
+
+/**
+ * Merge sorted a[0..na) and sorted b[0..nb) into out (no overlap)
+ */
+void sortnet_merge(const int a[], size_t na, const int b[], size_t nb, int out[]);
+
+/**
+ * Best instruction set this CPU supports
+ */
+sortnet_isa sortnet_detect(void);
+
+/**
+ * Instruction set currently in use
+ */
+sortnet_isa sortnet_active(void);
+
+/**
+ * Use a specific instruction set (e.g. to benchmark each level).
+ * Returns 0 on success, -1 if the CPU does not support it.
+ */
+int sortnet_force(sortnet_isa isa);
+
+/**
+ * Display name ("scalar", "sse4.1", "avx2", "avx512")
+ */
+const char *sortnet_isa_name(sortnet_isa isa);
+
+#endif  // ROSETTA_SORTNET_H
@@ -0,0 +1,512 @@
+/**
+ * Work-Stealing Task Pool
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Deque operations follow Lê, Pop, Cohen, Zappa Nardelli, "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013), with a
+ * fixed-capacity ring instead of a growable one.
+ */
+
+#define _GNU_SOURCE
+
+#include "task_pool.h"
+
+#include "topology.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define CACHE_LINE 64
+
+/**
+ * Deque slot; fields are atomics because a thief may read a slot the
+ * owner is concurrently reusing (the thief's CAS on top then fails)
+ */
+typedef struct {
+    _Atomic(task_fn) fn;
+    _Atomic(void *) ctx;
+    atomic_size_t begin;
+    atomic_size_t end;
+    atomic_uint depth;
+} task_slot;
+
+typedef struct {
+    task_fn fn;
+    void *ctx;
+    size_t begin;
+    size_t end;
+    unsigned depth;
+} task;
+
+typedef struct {
+    alignas(CACHE_LINE) atomic_llong top;     // Next slot to steal
+    alignas(CACHE_LINE) atomic_llong bottom;  // Next slot to push
+    alignas(CACHE_LINE) task_slot slots[TASK_POOL_DEQUE_CAPACITY];
+} work_deque;
+
+typedef struct {
+    task_pool *pool;
+    int id;
+    int cpu;         // Pinned pools only
+    int node;
+    int node_begin;  // Workers [node_begin, node_end) share this worker's node
+    int node_end;
+} worker_arg;
+
+struct task_pool {
+    int size;
+    int pinned;
+    work_deque *deques;
+    pthread_t *threads;
+    worker_arg *args;
+    void *scratch;  // task_pool_scratch(), freed with the pool
+    size_t scratch_bytes;
+    alignas(CACHE_LINE) atomic_long pending;  // Spawned but unfinished tasks
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    unsigned long generation;  // Bumped by every task_pool_run()
+    int shutdown;
+};
+
+static atomic_int default_affinity = TASK_POOL_AFFINITY_AUTO;
+
+// task_pool_acquire(): one pool kept between calls, lent to one caller at a time
+static pthread_mutex_t shared_lock = PTHREAD_MUTEX_INITIALIZER;
+static task_pool *shared_pool = NULL;
+static int shared_busy = 0;
+
+static _Thread_local const task_pool *current_pool = NULL;
+static _Thread_local int current_worker = -1;
+
+static void slot_store(task_slot *slot, const task *t) {
+    atomic_store_explicit(&slot->fn, t->fn, memory_order_relaxed);
+    atomic_store_explicit(&slot->ctx, t->ctx, memory_order_relaxed);
+    atomic_store_explicit(&slot->begin, t->begin, memory_order_relaxed);
+    atomic_store_explicit(&slot->end, t->end, memory_order_relaxed);
+    atomic_store_explicit(&slot->depth, t->depth, memory_order_relaxed);
+}
+
+static void slot_load(task_slot *slot, task *t) {
+    t->fn = atomic_load_explicit(&slot->fn, memory_order_relaxed);
+    t->ctx = atomic_load_explicit(&slot->ctx, memory_order_relaxed);
+    t->begin = atomic_load_explicit(&slot->begin, memory_order_relaxed);
+    t->end = atomic_load_explicit(&slot->end, memory_order_relaxed);
+    t->depth = atomic_load_explicit(&slot->depth, memory_order_relaxed);
+}
+
+static task_slot *slot_at(work_deque *dq, long long index) {
+    return &dq->slots[(size_t)index & (TASK_POOL_DEQUE_CAPACITY - 1)];
+}
+
+/**
+ * Owner push at the bottom; returns 0 if the deque is full
+ */
+static int deque_push(work_deque *dq, const task *t) {
+    long long b = atomic_load_explicit(&dq->bottom, memory_order_relaxed);
+    long long top = atomic_load_explicit(&dq->top, memory_order_acquire);
+    if (b - top >= TASK_POOL_DEQUE_CAPACITY) {
+        return 0;
+    }
+
+    slot_store(slot_at(dq, b), t);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+    return 1;
+}
+
+/**
+ * Owner pop from the bottom; returns 0 if the deque is empty
+ */
+static int deque_take(work_deque *dq, task *t) {
+    long long b = atomic_load_explicit(&dq->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&dq->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long top = atomic_load_explicit(&dq->top, memory_order_relaxed);
+
+    if (top > b) {
+        atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+        return 0;
+    }
+
+    slot_load(slot_at(dq, b), t);
+    if (top == b) {
+        // Last element: race thieves for it
+        int won = atomic_compare_exchange_strong_explicit(
+            &dq->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&dq->bottom, b + 1, memory_order_relaxed);
+        return won;
+    }
+    return 1;
+}
+
+/**
+ * Thief pop from the top; returns 0 if empty or the race was lost
+ */
+static int deque_steal(work_deque *dq, task *t) {
+    long long top = atomic_load_explicit(&dq->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long b = atomic_load_explicit(&dq->bottom, memory_order_acquire);
+    if (top >= b) {
+        return 0;
+    }
+
+    slot_load(slot_at(dq, top), t);
+    return atomic_compare_exchange_strong_explicit(
+        &dq->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+static void execute(task_pool *pool, const task *t) {
+    t->fn(pool, t->ctx, t->begin, t->end, t->depth);
+    atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_acq_rel);
+}
+
+/**
+ * Try every other worker once, starting at a random victim: first the
+ * workers of this node, whose tasks cover memory local to it, then the
+ * rest (for unpinned pools every worker counts as local)
+ */
+static int steal_any(task_pool *pool, int id, uint64_t *rng, task *t) {
+    if (pool->size < 2) {
+        return 0;
+    }
+
+    *rng ^= *rng << 13;
+    *rng ^= *rng >> 7;
+    *rng ^= *rng << 17;
+    const worker_arg *self = &pool->args[id];
+    int local = self->node_end - self->node_begin;
+
+    int start = (int)(*rng % (uint64_t)local);
+    for (int i = 0; i < local; i++) {
+        int victim = self->node_begin + (start + i) % local;
+        if (victim != id && deque_steal(&pool->deques[victim], t)) {
+            return 1;
+        }
+    }
+    if (local == pool->size) {
+        return 0;
+    }
+
+    start = (int)(*rng % (uint64_t)pool->size);
+    for (int i = 0; i < pool->size; i++) {
+        int victim = (start + i) % pool->size;
+        if ((victim < self->node_begin || victim >= self->node_end) &&
+            deque_steal(&pool->deques[victim], t)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Run local and stolen tasks until the current job has drained
+ */
+static void work_until_idle(task_pool *pool, int id) {
+    uint64_t rng = 0x9E3779B97F4A7C15ull * (uint64_t)(id + 1);
+    work_deque *own = &pool->deques[id];
+    task t;
+
+    while (atomic_load_explicit(&pool->pending, memory_order_acquire) > 0) {
+        if (deque_take(own, &t) || steal_any(pool, id, &rng, &t)) {
+            execute(pool, &t);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+static void *worker_main(void *arg) {
+    worker_arg *wa = arg;
+    task_pool *pool = wa->pool;
+    unsigned long seen = 0;
+
+    current_pool = pool;
+    current_worker = wa->id;
+    if (pool->pinned) {
+        (void)topology_pin_thread(wa->cpu);  // Best effort: unpinned still works
+    }
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->shutdown) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        work_until_idle(pool, wa->id);
+    }
+    return NULL;
+}
+
+int task_pool_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+void task_pool_set_default_affinity(task_pool_affinity affinity) {
+    atomic_store_explicit(&default_affinity, affinity, memory_order_relaxed);
+}
+
+task_pool *task_pool_create(int threads) {
+    return task_pool_create_with_affinity(
+        threads, atomic_load_explicit(&default_affinity, memory_order_relaxed));
+}
+
+static int affinity_pinned(task_pool_affinity affinity) {
+    return affinity == TASK_POOL_AFFINITY_PINNED ||
+           (affinity == TASK_POOL_AFFINITY_AUTO && topology_get()->node_count > 1);
+}
+
+task_pool *task_pool_create_with_affinity(int threads, task_pool_affinity affinity) {
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    task_pool *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    size_t deque_bytes = (size_t)threads * sizeof(work_deque);
+    pool->size = threads;
+    pool->deques = aligned_alloc(CACHE_LINE, deque_bytes);
+    pool->threads = calloc((size_t)threads, sizeof(pthread_t));
+    pool->args = calloc((size_t)threads, sizeof(worker_arg));
+    if (pool->deques == NULL || pool->threads == NULL || pool->args == NULL) {
+        free(pool->deques);
+        free(pool->threads);
+        free(pool->args);
+        free(pool);
+        return NULL;
+    }
+
+    const topology *topo = topology_get();
+    pool->pinned = affinity_pinned(affinity);
+
+    for (int i = 0; i < threads; i++) {
+        atomic_init(&pool->deques[i].top, 0);
+        atomic_init(&pool->deques[i].bottom, 0);
+
+        worker_arg *wa = &pool->args[i];
+        wa->pool = pool;
+        wa->id = i;
+        wa->cpu = topology_worker_cpu(topo, i, threads);
+        wa->node = pool->pinned ? topology_worker_node(topo, i, threads) : 0;
+        // Node blocks are contiguous (see topology_worker_node())
+        wa->node_begin =
+            i > 0 && pool->args[i - 1].node == wa->node ? pool->args[i - 1].node_begin : i;
+    }
+    for (int i = threads - 1; i >= 0; i--) {
+        worker_arg *wa = &pool->args[i];
+        wa->node_end = i + 1 < threads && pool->args[i + 1].node == wa->node
+                           ? pool->args[i + 1].node_end
+                           : i + 1;
+    }
+    atomic_init(&pool->pending, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    // Worker 0 is whichever thread calls task_pool_run()
+    for (int i = 1; i < threads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, &pool->args[i]) != 0) {
+            pool->size = i;
+            task_pool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void task_pool_destroy(task_pool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->size; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->deques);
+    free(pool->threads);
+    free(pool->args);
+    topology_free(pool->scratch, pool->scratch_bytes);
+    free(pool);
+}
+
+task_pool *task_pool_acquire(int threads) {
+    task_pool_affinity affinity = atomic_load_explicit(&default_affinity, memory_order_relaxed);
+    int pinned = affinity_pinned(affinity);
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    // A shared pool of another size or affinity is replaced, unless it is lent out
+    task_pool *stale = NULL;
+    task_pool *pool = NULL;
+    pthread_mutex_lock(&shared_lock);
+    if (!shared_busy && shared_pool != NULL &&
+        (shared_pool->size != threads || shared_pool->pinned != pinned)) {
+        stale = shared_pool;
+        shared_pool = NULL;
+    }
+    if (!shared_busy && shared_pool != NULL) {
+        pool = shared_pool;
+        shared_busy = 1;
+    }
+    pthread_mutex_unlock(&shared_lock);
+    task_pool_destroy(stale);
+    if (pool != NULL) {
+        return pool;
+    }
+
+    pool = task_pool_create_with_affinity(threads, affinity);
+    pthread_mutex_lock(&shared_lock);
+    if (pool != NULL && !shared_busy && shared_pool == NULL) {
+        shared_pool = pool;
+        shared_busy = 1;
+    }
+    pthread_mutex_unlock(&shared_lock);
+    return pool;
+}
+
+void task_pool_release(task_pool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&shared_lock);
+    int shared = pool == shared_pool;
+    if (shared) {
+        shared_busy = 0;
+    }
+    pthread_mutex_unlock(&shared_lock);
+    if (!shared) {
+        task_pool_destroy(pool);
+    }
+}
+
+void *task_pool_scratch(task_pool *pool, size_t bytes) {
+    if (bytes > pool->scratch_bytes) {
+        void *scratch = topology_alloc(bytes, TOPOLOGY_INTERLEAVE | TOPOLOGY_HUGE_PAGES);
+        if (scratch == NULL) {
+            return NULL;
+        }
+        topology_free(pool->scratch, pool->scratch_bytes);
+        pool->scratch = scratch;
+        pool->scratch_bytes = bytes;
+    }
+    return pool->scratch;
+}
+
+int task_pool_size(const task_pool *pool) {
+    return pool->size;
+}
+
+int task_pool_worker_node(const task_pool *pool, int worker) {
+    return worker >= 0 && worker < pool->size ? pool->args[worker].node : 0;
+}
+
+int task_pool_worker_id(const task_pool *pool) {
+    return current_pool == pool ? current_worker : -1;
+}
+
+void task_pool_run(task_pool *pool, task_fn fn, void *ctx, size_t begin, size_t end,
+                   unsigned depth) {
+    const task_pool *saved_pool = current_pool;
+    int saved_worker = current_worker;
+    current_pool = pool;
+    current_worker = 0;
+
+    // The caller is worker 0 only for this run; give its own mask back after
+    cpu_set_t saved_mask;
+    int restore_mask = pool->pinned &&
+                       sched_getaffinity(0, sizeof(saved_mask), &saved_mask) == 0 &&
+                       topology_pin_thread(pool->args[0].cpu) == 0;
+
+    // Count the root before waking anyone so workers do not see an empty job
+    atomic_store_explicit(&pool->pending, 1, memory_order_release);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    task root = {fn, ctx, begin, end, depth};
+    execute(pool, &root);
+    work_until_idle(pool, 0);
+
+    if (restore_mask) {
+        sched_setaffinity(0, sizeof(saved_mask), &saved_mask);
+    }
+    current_pool = saved_pool;
+    current_worker = saved_worker;
+}
+
+void task_pool_spawn(task_pool *pool, task_fn fn, void *ctx, size_t begin, size_t end,
+                     unsigned depth) {
+    task t = {fn, ctx, begin, end, depth};
+    int id = task_pool_worker_id(pool);
+
+    if (id >= 0) {
+        // Count first: the task may be stolen and finished before push returns
+        atomic_fetch_add_explicit(&pool->pending, 1, memory_order_relaxed);
+        if (deque_push(&pool->deques[id], &t)) {
+            return;
+        }
+        atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_relaxed);
+    }
+
+    fn(pool, ctx, begin, end, depth);
+}
+
+typedef struct {
+    task_fn fn;
+    void *ctx;
+} parallel_for_ctx;
+
+/**
+ * Split [begin, end) in halves, spawning the upper half each time, until
+ * a single index is left
+ */
+static void parallel_for_split(task_pool *pool, void *ctx, size_t begin, size_t end,
+                               unsigned depth) {
+    parallel_for_ctx *pf = ctx;
+    (void)depth;
+
+    while (end - begin > 1) {
+        size_t mid = begin + (end - begin) / 2;
+        task_pool_spawn(pool, parallel_for_split, pf, mid, end, 0);
+        end = mid;
+    }
+    pf->fn(pool, pf->ctx, begin, end, 0);
+}
+
+void task_pool_parallel_for(task_pool *pool, task_fn fn, void *ctx, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    parallel_for_ctx pf = {fn, ctx};
+    task_pool_run(pool, parallel_for_split, &pf, 0, count, 0);
+}
@@ -0,0 +1,131 @@
+/**
+ * Work-Stealing Task Pool
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Fixed set of pthread workers, each owning a Chase-Lev deque: the owner
+ * pushes and pops at the bottom (LIFO, cache-warm), idle workers steal
+ * from the top (FIFO, the oldest and therefore largest subproblems).
+ * Tasks are small value types (function, shared context, index range,
+ * recursion budget), so spawning never allocates.
+ *
+ * The thread calling task_pool_run() participates as worker 0 and returns
+ * once every spawned task has finished.
+ *
+ * Pinned pools place worker i on topology_worker_cpu(i, size) (see
+ * topology.h), so workers form one block per NUMA node; worker 0 is
+ * pinned for the duration of each task_pool_run() only. Idle workers
+ * steal from workers of their own node before crossing to another.
+ */
+
+#ifndef ROSETTA_TASK_POOL_H
+#define ROSETTA_TASK_POOL_H
+
+#include <stddef.h>
+
+// Slots per worker deque; spawning into a full deque runs the task inline
+#define TASK_POOL_DEQUE_CAPACITY 4096
+
+typedef struct task_pool task_pool;
+
+typedef enum {
+    TASK_POOL_AFFINITY_AUTO = 0,  // Pinned on machines with several NUMA nodes
+    TASK_POOL_AFFINITY_NONE,      // Placed by the scheduler
+    TASK_POOL_AFFINITY_PINNED,    // One CPU per worker, in node blocks
+} task_pool_affinity;
+
+/**
+ * Task body: shared ctx plus the [begin, end) range it owns and a
+ * per-task depth budget (e.g. introsort's remaining recursion limit)
+ */
+typedef void (*task_fn)(task_pool *pool, void *ctx, size_t begin, size_t end,
+                        unsigned depth);
+
+/**
+ * Start a pool with `threads` workers in total (including the caller of
+ * task_pool_run). Returns NULL on failure.
+ */
+task_pool *task_pool_create(int threads);
+
+/**
+ * task_pool_create() with an explicit affinity instead of the default
+ */
+task_pool *task_pool_create_with_affinity(int threads, task_pool_affinity affinity);
+
+/**
+ * Affinity of pools task_pool_create() starts from now on (initially
+ * TASK_POOL_AFFINITY_AUTO); lets benchmarks compare pinned and unpinned
+ * runs of the parallel sorts
+ */
+void task_pool_set_default_affinity(task_pool_affinity affinity);
+
+/**
+ * Stop and join all workers
+ */
+void task_pool_destroy(task_pool *pool);
+
+/**
+ * Pool of `threads` workers with the default affinity for one parallel
+ * sort. A single pool is kept between calls, so repeated sorts neither
+ * start nor join threads; it is replaced when the size or affinity
+ * asked for changes, and lent to one caller at a time (others get a
+ * pool of their own). Returns NULL on failure.
+ */
+task_pool *task_pool_acquire(int threads);
+
+/**
+ * Hand back a pool from task_pool_acquire(); pools that are not the
+ * kept one are destroyed
+ */
+void task_pool_release(task_pool *pool);
+
+/**
+ * Scratch memory of at least `bytes` owned by the pool, interleaved over
+ * the NUMA nodes on huge pages (see topology.h). It is kept, and only
+ * regrown, across acquisitions of the shared pool and freed with the
+ * pool; contents are unspecified. NULL if out of memory.
+ */
+void *task_pool_scratch(task_pool *pool, size_t bytes);
+
+/**
+ * Number of workers, including the caller
+ */
+int task_pool_size(const task_pool *pool);
+
+/**
+ * Run fn as the root task and block until it and everything it spawned
+ * has completed
+ */
+void task_pool_run(task_pool *pool, task_fn fn, void *ctx, size_t begin, size_t end,
+                   unsigned depth);
+
+/**
+ * Make a task available to other workers. Must be called from inside a
+ * running task. Runs the task immediately if the local deque is full.
+ */
+void task_pool_spawn(task_pool *pool, task_fn fn, void *ctx, size_t begin, size_t end,
+                     unsigned depth);
+
+/**
+ * Run fn(pool, ctx, i, i + 1, 0) for every i in [0, count) and wait for
+ * all of them; one parallel phase with an implicit barrier at the end
+ */
+void task_pool_parallel_for(task_pool *pool, task_fn fn, void *ctx, size_t count);
+
+/**
+ * Index of the calling worker in [0, size), or -1 outside the pool
+ */
+int task_pool_worker_id(const task_pool *pool);
+
+/**
+ * NUMA node (dense number, see topology.h) of a worker; 0 when unpinned
+ */
+int task_pool_worker_node(const task_pool *pool, int worker);
+
+/**
+ * Online CPU count (at least 1)
+ */
+int task_pool_cpu_count(void);
+
+#endif  // ROSETTA_TASK_POOL_H
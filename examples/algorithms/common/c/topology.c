@@ -0,0 +1,356 @@
+/**
+ * NUMA Topology and Memory Placement
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#define _GNU_SOURCE
+
+#include "topology.h"
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SYSFS_NODE_DIR "/sys/devices/system/node"
+
+// <linux/mempolicy.h> modes, spelled out so libnuma's headers are not needed
+#define TOPOLOGY_MPOL_PREFERRED 1
+#define TOPOLOGY_MPOL_INTERLEAVE 3
+
+// Node mask of mbind(2): one bit per kernel node number below CPU_SETSIZE
+#define NODE_MASK_WORDS (CPU_SETSIZE / (8 * sizeof(unsigned long)))
+
+// Copies timed per topology_node_bandwidth() (the fastest counts)
+#define BANDWIDTH_REPEATS 5
+
+// Buffer size topology_report() measures with
+#define REPORT_BANDWIDTH_BYTES (64u << 20)
+
+static topology detected;
+static pthread_once_t detect_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Parse a sysfs list ("0-3,8,10-11") into set. Returns 0, or -1 if the
+ * file is missing or malformed.
+ */
+static int read_list(const char *path, cpu_set_t *set) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    char text[4096];
+    int status = fgets(text, sizeof(text), f) != NULL ? 0 : -1;
+    fclose(f);
+    if (status != 0) {
+        return -1;
+    }
+
+    CPU_ZERO(set);
+    char *p = text;
+    while (*p != '\0' && *p != '\n') {
+        char *end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        if (end == p || first < 0) {
+            return -1;
+        }
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first) {
+                return -1;
+            }
+            p = end;
+        }
+        for (long i = first; i <= last && i < CPU_SETSIZE; i++) {
+            CPU_SET((int)i, set);
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Move the CPUs of node_cpus that are still in *unplaced to the end of
+ * t->cpus; returns how many moved
+ */
+static int place_cpus(topology *t, const cpu_set_t *node_cpus, cpu_set_t *unplaced) {
+    int placed = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE && t->cpu_count < TOPOLOGY_MAX_CPUS; cpu++) {
+        if (CPU_ISSET(cpu, node_cpus) && CPU_ISSET(cpu, unplaced)) {
+            t->cpus[t->cpu_count++] = cpu;
+            CPU_CLR(cpu, unplaced);
+            placed++;
+        }
+    }
+    return placed;
+}
+
+static void detect(void) {
+    topology *t = &detected;
+    cpu_set_t unplaced;
+
+    if (sched_getaffinity(0, sizeof(unplaced), &unplaced) != 0 || CPU_COUNT(&unplaced) == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        CPU_ZERO(&unplaced);
+        for (long cpu = 0; cpu < (online > 0 ? online : 1) && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET((int)cpu, &unplaced);
+        }
+    }
+
+    // Nodes without a usable CPU (memory-only, or outside the mask) are left out
+    cpu_set_t nodes;
+    if (read_list(SYSFS_NODE_DIR "/online", &nodes) == 0) {
+        for (int node = 0; node < CPU_SETSIZE && t->node_count < TOPOLOGY_MAX_NODES; node++) {
+            char path[64];
+            cpu_set_t node_cpus;
+            snprintf(path, sizeof(path), SYSFS_NODE_DIR "/node%d/cpulist", node);
+            if (!CPU_ISSET(node, &nodes) || read_list(path, &node_cpus) != 0) {
+                continue;
+            }
+            int first = t->cpu_count;
+            if (place_cpus(t, &node_cpus, &unplaced) > 0) {
+                t->node_id[t->node_count] = node;
+                t->node_first[t->node_count] = first;
+                t->node_count++;
+            }
+        }
+    }
+
+    if (t->node_count == 0) {
+        t->node_first[0] = 0;
+        t->node_count = 1;
+    } else {
+        t->from_sysfs = 1;
+    }
+    // CPUs sysfs did not list join the last node
+    cpu_set_t all;
+    memset(&all, 0xff, sizeof(all));
+    place_cpus(t, &all, &unplaced);
+    t->node_first[t->node_count] = t->cpu_count;
+}
+
+const topology *topology_get(void) {
+    pthread_once(&detect_once, detect);
+    return &detected;
+}
+
+int topology_worker_node(const topology *t, int worker, int workers) {
+    if (workers < 1 || worker < 0) {
+        return 0;
+    }
+    return (int)((long long)(worker % workers) * t->node_count / workers);
+}
+
+int topology_worker_cpu(const topology *t, int worker, int workers) {
+    if (workers < 1 || worker < 0) {
+        return t->cpus[0];
+    }
+    worker %= workers;
+    int node = topology_worker_node(t, worker, workers);
+    // First worker of this node's block
+    int first = (int)(((long long)node * workers + t->node_count - 1) / t->node_count);
+    int count = t->node_first[node + 1] - t->node_first[node];
+    return t->cpus[t->node_first[node] + (worker - first) % count];
+}
+
+int topology_pin_thread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        errno = EINVAL;
+        return -1;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set);
+}
+
+static size_t mapped_length(size_t bytes) {
+    long page = sysconf(_SC_PAGESIZE);
+    size_t unit = bytes >= TOPOLOGY_HUGE_PAGE_SIZE ? TOPOLOGY_HUGE_PAGE_SIZE
+                                                   : (size_t)(page > 0 ? page : 4096);
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    return (bytes + unit - 1) / unit * unit;
+}
+
+/**
+ * Set the memory policy of [p, p + len) for nodes (dense numbers) in
+ * [first, last); failures leave the kernel default (first touch)
+ */
+static void set_policy(void *p, size_t len, int mode, const topology *t, int first, int last) {
+#ifdef SYS_mbind
+    unsigned long mask[NODE_MASK_WORDS] = {0};
+    const size_t bits = 8 * sizeof(unsigned long);
+    for (int i = first; i < last; i++) {
+        size_t id = (size_t)t->node_id[i];
+        mask[id / bits] |= 1ul << (id % bits);
+    }
+    // The kernel reads maxnode - 1 bits
+    (void)syscall(SYS_mbind, p, len, mode, mask, (unsigned long)(NODE_MASK_WORDS * bits + 1), 0);
+#else
+    (void)p;
+    (void)len;
+    (void)mode;
+    (void)t;
+    (void)first;
+    (void)last;
+#endif
+}
+
+void *topology_alloc(size_t bytes, unsigned flags) {
+    size_t len = mapped_length(bytes);
+    int huge = (flags & TOPOLOGY_HUGE_PAGES) && len % TOPOLOGY_HUGE_PAGE_SIZE == 0;
+    void *p = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    // Fails at once (ENOMEM) when the hugetlb pool is short
+    if (huge) {
+        p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                 -1, 0);
+    }
+#endif
+    if (p == MAP_FAILED) {
+        p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            return NULL;
+        }
+#ifdef MADV_HUGEPAGE
+        if (huge) {
+            (void)madvise(p, len, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    // Policies apply when pages are first touched, so set them before use
+    const topology *t = topology_get();
+    if (t->node_count > 1 && (flags & TOPOLOGY_INTERLEAVE)) {
+        set_policy(p, len, TOPOLOGY_MPOL_INTERLEAVE, t, 0, t->node_count);
+    } else if (t->node_count > 1 && (flags & TOPOLOGY_BLOCKED)) {
+        size_t unit = huge ? TOPOLOGY_HUGE_PAGE_SIZE : mapped_length(1);
+        size_t slice = (len / (size_t)t->node_count + unit - 1) / unit * unit;
+        for (int i = 0; i < t->node_count && (size_t)i * slice < len; i++) {
+            size_t offset = (size_t)i * slice;
+            size_t part = len - offset < slice ? len - offset : slice;
+            set_policy((unsigned char *)p + offset, part, TOPOLOGY_MPOL_PREFERRED, t, i, i + 1);
+        }
+    }
+    return p;
+}
+
+void topology_free(void *p, size_t bytes) {
+    if (p != NULL) {
+        munmap(p, mapped_length(bytes));
+    }
+}
+
+typedef struct {
+    int cpu;
+    unsigned char *src;
+    unsigned char *dst;
+    size_t bytes;
+    double seconds;  // Fastest copy; 0 if the thread could not be pinned
+} bandwidth_job;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void *bandwidth_thread(void *arg) {
+    bandwidth_job *job = arg;
+    if (topology_pin_thread(job->cpu) != 0) {
+        return NULL;
+    }
+
+    // Fault every page in from this node before timing
+    memset(job->src, 1, job->bytes);
+    memset(job->dst, 0, job->bytes);
+
+    double best = INFINITY;
+    for (int r = 0; r < BANDWIDTH_REPEATS; r++) {
+        double start = now_seconds();
+        memcpy(job->dst, job->src, job->bytes);
+        double elapsed = now_seconds() - start;
+        best = elapsed < best ? elapsed : best;
+        // Make each copy depend on the last so none can be dropped
+        job->src[r] = job->dst[job->bytes - 1 - (size_t)r];
+    }
+    job->seconds = best;
+    return NULL;
+}
+
+double topology_node_bandwidth(int node, size_t bytes) {
+    const topology *t = topology_get();
+    if (node < 0 || node >= t->node_count || bytes < BANDWIDTH_REPEATS) {
+        return -1.0;
+    }
+
+    bandwidth_job job = {t->cpus[t->node_first[node]], NULL, NULL, bytes, 0.0};
+    job.src = topology_alloc(bytes, TOPOLOGY_HUGE_PAGES);
+    job.dst = topology_alloc(bytes, TOPOLOGY_HUGE_PAGES);
+    if (job.src != NULL && job.dst != NULL && t->node_count > 1) {
+        set_policy(job.src, mapped_length(bytes), TOPOLOGY_MPOL_PREFERRED, t, node, node + 1);
+        set_policy(job.dst, mapped_length(bytes), TOPOLOGY_MPOL_PREFERRED, t, node, node + 1);
+    }
+
+    pthread_t thread;
+    if (job.src != NULL && job.dst != NULL &&
+        pthread_create(&thread, NULL, bandwidth_thread, &job) == 0) {
+        pthread_join(thread, NULL);
+    }
+    topology_free(job.src, bytes);
+    topology_free(job.dst, bytes);
+    return job.seconds > 0.0 ? 2.0 * (double)bytes / job.seconds : -1.0;
+}
+
+/**
+ * Print cpus[0..count) as ranges ("0-15,32-47")
+ */
+static void print_cpus(FILE *out, const int *cpus, int count) {
+    for (int i = 0; i < count;) {
+        int j = i;
+        while (j + 1 < count && cpus[j + 1] == cpus[j] + 1) {
+            j++;
+        }
+        fprintf(out, i > 0 ? ",%d" : "%d", cpus[i]);
+        if (j > i) {
+            fprintf(out, "-%d", cpus[j]);
+        }
+        i = j + 1;
+    }
+}
+
+void topology_report(FILE *out) {
+    const topology *t = topology_get();
+    fprintf(out, "NUMA topology: %d node(s), %d CPU(s)%s\n", t->node_count, t->cpu_count,
+            t->from_sysfs ? "" : " (no sysfs node information)");
+
+    for (int node = 0; node < t->node_count; node++) {
+        int first = t->node_first[node];
+        int count = t->node_first[node + 1] - first;
+        fprintf(out, "  node %d: %d CPU(s) [", t->node_id[node], count);
+        print_cpus(out, t->cpus + first, count);
+
+        double bandwidth = topology_node_bandwidth(node, REPORT_BANDWIDTH_BYTES);
+        if (bandwidth > 0.0) {
+            fprintf(out, "]  copy bandwidth %.2f GB/s\n", bandwidth / 1e9);
+        } else {
+            fprintf(out, "]  copy bandwidth unavailable\n");
+        }
+    }
+}
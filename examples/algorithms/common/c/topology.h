@@ -0,0 +1,88 @@
+/**
+ * NUMA Topology and Memory Placement
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Nodes and their CPUs come from /sys/devices/system/node, restricted to
+ * the CPUs this process may run on; without sysfs NUMA information every
+ * CPU is on one node. Node numbers are dense here (0 .. node_count) and
+ * mapped to the kernel's numbering only for memory policies.
+ *
+ * Workers of a pool of `workers` threads are laid out in node blocks:
+ * worker w runs on node w * node_count / workers, so consecutive workers
+ * (and the consecutive chunks the parallel sorts hand them) share a node.
+ *
+ * Memory comes from mmap() so placement and huge pages apply to whole
+ * pages: TOPOLOGY_INTERLEAVE spreads pages round-robin over the nodes,
+ * TOPOLOGY_BLOCKED prefers node i for slice i of node_count (matching
+ * the worker layout), and TOPOLOGY_HUGE_PAGES maps from the hugetlb pool
+ * when it has room and asks for transparent huge pages otherwise. The
+ * memory policies are set with mbind(2) directly, so libnuma is not
+ * needed; placement is best effort and never makes an allocation fail.
+ */
+
+#ifndef ROSETTA_TOPOLOGY_H
+#define ROSETTA_TOPOLOGY_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define TOPOLOGY_MAX_NODES 64
+#define TOPOLOGY_MAX_CPUS 1024
+
+// Huge page size assumed for rounding (x86-64 and arm64 with 4K pages)
+#define TOPOLOGY_HUGE_PAGE_SIZE (2u << 20)
+
+// topology_alloc() flags
+#define TOPOLOGY_INTERLEAVE 1u  // Pages round-robin over all nodes
+#define TOPOLOGY_BLOCKED 2u     // Slice i of node_count on node i
+#define TOPOLOGY_HUGE_PAGES 4u  // hugetlb pool, else transparent huge pages
+
+typedef struct {
+    int node_count;                          // Nodes with a usable CPU (at least 1)
+    int cpu_count;                           // CPUs in the affinity mask
+    int node_id[TOPOLOGY_MAX_NODES];         // Kernel node number (sysfs nodeN)
+    int node_first[TOPOLOGY_MAX_NODES + 1];  // cpus[node_first[i]..node_first[i + 1]) on node i
+    int cpus[TOPOLOGY_MAX_CPUS];             // Usable CPUs, grouped by node
+    int from_sysfs;                          // 0: no NUMA information, one node assumed
+} topology;
+
+/**
+ * Topology of this machine, detected on first use
+ */
+const topology *topology_get(void);
+
+/**
+ * Node and CPU of worker `worker` in a pool of `workers`; several
+ * workers share a CPU when there are more workers than CPUs
+ */
+int topology_worker_node(const topology *t, int worker, int workers);
+int topology_worker_cpu(const topology *t, int worker, int workers);
+
+/**
+ * Restrict the calling thread to one CPU. Returns 0, or -1 with errno set.
+ */
+int topology_pin_thread(int cpu);
+
+/**
+ * Map bytes (rounded up to pages, and to TOPOLOGY_HUGE_PAGE_SIZE from
+ * that size up) of zeroed memory placed as flags ask; NULL if out of
+ * memory. Release with topology_free() and the same bytes.
+ */
+void *topology_alloc(size_t bytes, unsigned flags);
+void topology_free(void *p, size_t bytes);
+
+/**
+ * Copy bandwidth (bytes read plus written per second) of one thread
+ * pinned to `node` copying between two buffers of `bytes` on that node;
+ * -1.0 if the buffers or the thread cannot be set up
+ */
+double topology_node_bandwidth(int node, size_t bytes);
+
+/**
+ * Print the nodes, their CPUs and topology_node_bandwidth() of each
+ */
+void topology_report(FILE *out);
+
+#endif  // ROSETTA_TOPOLOGY_H
@@ -0,0 +1,567 @@
+/**
+ * Shared C Benchmark Harness
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#define _GNU_SOURCE
+
+#include "bench.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef CLOCK_MONOTONIC_RAW
+#define CLOCK_MONOTONIC_RAW CLOCK_MONOTONIC
+#endif
+
+#define BENCH_MAX_ITERATIONS 1000000000ULL
+
+static const char *session_example = NULL;
+static bench_result session_results[BENCH_MAX_RESULTS];
+static int session_count = 0;
+
+static perf_counters session_counters;
+static int counters_state = 0;  // 0 = not probed, 1 = open, -1 = off
+
+/**
+ * Counters for this session, opened on first use when BENCH_PERF is set
+ */
+static perf_counters *active_counters(void) {
+    if (counters_state == 0) {
+        const char *flag = getenv("BENCH_PERF");
+        counters_state = -1;
+        if (flag != NULL && *flag != '\0' && strcmp(flag, "0") != 0) {
+            if (perf_counters_open(&session_counters) > 0) {
+                counters_state = 1;
+            } else {
+                fprintf(stderr, "Warning: BENCH_PERF set but no hardware counters available\n");
+            }
+        }
+    }
+    return counters_state == 1 ? &session_counters : NULL;
+}
+
+/**
+ * Monotonic raw clock in nanoseconds
+ */
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Core clock from a chain of dependent register adds: the empty asm pins
+ * each add to its own instruction, so the chain runs at one add per
+ * cycle. Best of five trials, so a preempted trial does not lower the
+ * estimate.
+ */
+double bench_cpu_ghz(void) {
+    static double ghz = 0.0;
+    if (ghz > 0.0) {
+        return ghz;
+    }
+    const uint64_t rounds = 1u << 22;  // 8 adds each: ~10 ms at 3 GHz
+    for (int trial = 0; trial < 5; trial++) {
+        uint64_t x = 0;
+        uint64_t step = 1;
+        __asm__ volatile("" : "+r"(step));  // Unknown addend: no immediate folding
+        uint64_t start = bench_now_ns();
+        for (uint64_t i = 0; i < rounds; i++) {
+            for (int j = 0; j < 8; j++) {
+                __asm__ volatile("" : "+r"(x));
+                x += step;
+            }
+        }
+        uint64_t elapsed = bench_now_ns() - start;
+        BENCH_DO_NOT_OPTIMIZE(x);
+        double estimate = elapsed > 0 ? (double)(rounds * 8) / (double)elapsed : 0.0;
+        ghz = estimate > ghz ? estimate : ghz;
+    }
+    return ghz;
+}
+
+double bench_cycles(const bench_result *result, int *measured) {
+    int counted = (result->counter_mask & (1u << PERF_CYCLES)) != 0;
+    if (measured != NULL) {
+        *measured = counted;
+    }
+    return counted ? result->counters[PERF_CYCLES] : result->median_ns * bench_cpu_ghz();
+}
+
+/**
+ * Read a positive integer from the environment
+ */
+static uint64_t env_u64(const char *name, uint64_t fallback) {
+    const char *value = getenv(name);
+    if (value == NULL || *value == '\0') {
+        return fallback;
+    }
+
+    char *end = NULL;
+    unsigned long long parsed = strtoull(value, &end, 10);
+    if (*end != '\0' || parsed == 0) {
+        return fallback;
+    }
+    return (uint64_t)parsed;
+}
+
+bench_config bench_default_config(void) {
+    bench_config config;
+    config.warmup_samples = (int)env_u64("BENCH_WARMUP", 5);
+    config.samples = (int)env_u64("BENCH_SAMPLES", 30);
+    config.min_sample_ns = env_u64("BENCH_MIN_SAMPLE_NS", 1000000);
+
+    if (config.samples > BENCH_MAX_SAMPLES) {
+        config.samples = BENCH_MAX_SAMPLES;
+    }
+    return config;
+}
+
+/**
+ * Time one sample of `iterations` calls.
+ * With a setup hook each call is timed individually so setup is excluded.
+ * Counters (if any) cover exactly the timed region.
+ */
+static uint64_t run_sample(bench_fn fn, bench_fn setup, void *ctx, uint64_t iterations,
+                           perf_counters *pc) {
+    if (setup == NULL) {
+        if (pc != NULL) {
+            perf_counters_enable(pc);
+        }
+        uint64_t start = bench_now_ns();
+        for (uint64_t i = 0; i < iterations; i++) {
+            fn(ctx);
+            bench_clobber();
+        }
+        uint64_t elapsed = bench_now_ns() - start;
+        if (pc != NULL) {
+            perf_counters_disable(pc);
+        }
+        return elapsed;
+    }
+
+    uint64_t total = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        setup(ctx);
+        bench_clobber();
+        if (pc != NULL) {
+            perf_counters_enable(pc);
+        }
+        uint64_t start = bench_now_ns();
+        fn(ctx);
+        bench_clobber();
+        total += bench_now_ns() - start;
+        if (pc != NULL) {
+            perf_counters_disable(pc);
+        }
+    }
+    return total;
+}
+
+/**
+ * Double the iteration count until one sample reaches min_sample_ns
+ */
+static uint64_t calibrate(bench_fn fn, bench_fn setup, void *ctx, uint64_t min_sample_ns) {
+    uint64_t iterations = 1;
+
+    while (iterations < BENCH_MAX_ITERATIONS) {
+        uint64_t elapsed = run_sample(fn, setup, ctx, iterations, NULL);
+        if (elapsed >= min_sample_ns) {
+            break;
+        }
+        if (elapsed == 0) {
+            iterations *= 10;
+            continue;
+        }
+
+        // Jump close to the target, then round up
+        uint64_t estimate = iterations * min_sample_ns / elapsed + 1;
+        iterations = estimate > iterations * 2 ? estimate : iterations * 2;
+    }
+
+    return iterations < BENCH_MAX_ITERATIONS ? iterations : BENCH_MAX_ITERATIONS;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+/**
+ * Linear-interpolated percentile, same definition as the Rust runner
+ */
+static double percentile(const double sorted[], int count, double pct) {
+    if (count == 0) {
+        return 0.0;
+    }
+    if (count == 1) {
+        return sorted[0];
+    }
+
+    double index = (pct / 100.0) * (double)(count - 1);
+    int lower = (int)floor(index);
+    int upper = (int)ceil(index);
+    if (lower == upper) {
+        return sorted[lower];
+    }
+
+    double weight = index - (double)lower;
+    return sorted[lower] * (1.0 - weight) + sorted[upper] * weight;
+}
+
+static void summarize(double samples[], int count, bench_result *result) {
+    qsort(samples, (size_t)count, sizeof(double), compare_doubles);
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    double mean = sum / count;
+
+    double sq = 0.0;
+    for (int i = 0; i < count; i++) {
+        sq += (samples[i] - mean) * (samples[i] - mean);
+    }
+    double std_dev = count > 1 ? sqrt(sq / (count - 1)) : 0.0;
+
+    // Normal approximation; samples default to 30 (runner minimum)
+    double margin = 1.96 * std_dev / sqrt((double)count);
+
+    result->sample_count = count;
+    result->min_ns = samples[0];
+    result->max_ns = samples[count - 1];
+    result->mean_ns = mean;
+    result->median_ns = percentile(samples, count, 50.0);
+    result->std_dev_ns = std_dev;
+    result->p95_ns = percentile(samples, count, 95.0);
+    result->p99_ns = percentile(samples, count, 99.0);
+    result->ci95_low_ns = mean - margin > 0.0 ? mean - margin : 0.0;
+    result->ci95_high_ns = mean + margin;
+}
+
+int bench_run(const char *name, bench_fn fn, bench_fn setup, void *ctx,
+              const bench_config *config, bench_result *result) {
+    if (fn == NULL || config == NULL || result == NULL ||
+        config->samples <= 0 || config->samples > BENCH_MAX_SAMPLES) {
+        return -1;
+    }
+
+    memset(result, 0, sizeof(*result));
+    snprintf(result->name, sizeof(result->name), "%s", name);
+
+    uint64_t iterations = calibrate(fn, setup, ctx, config->min_sample_ns);
+    result->iterations = iterations;
+
+    for (int i = 0; i < config->warmup_samples; i++) {
+        run_sample(fn, setup, ctx, iterations, NULL);
+    }
+
+    perf_counters *pc = active_counters();
+    if (pc != NULL) {
+        perf_counters_reset(pc);
+    }
+
+    double samples[BENCH_MAX_SAMPLES];
+    for (int i = 0; i < config->samples; i++) {
+        uint64_t elapsed = run_sample(fn, setup, ctx, iterations, pc);
+        samples[i] = (double)elapsed / (double)iterations;
+    }
+
+    summarize(samples, config->samples, result);
+
+    if (pc != NULL) {
+        perf_sample totals;
+        perf_counters_read(pc, &totals);
+
+        double ops = (double)iterations * (double)config->samples;
+        result->counter_mask = totals.mask;
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            result->counters[i] = (double)totals.values[i] / ops;
+        }
+    }
+    return 0;
+}
+
+void bench_begin(const char *example) {
+    session_example = example;
+    session_count = 0;
+}
+
+void bench_record(const bench_result *result) {
+    if (session_count < BENCH_MAX_RESULTS) {
+        session_results[session_count++] = *result;
+    }
+}
+
+void bench_report(const bench_result *result) {
+    printf("  %-32s median %12.1f ns  (min %.1f, p99 %.1f, sd %.1f, n=%d x %llu)\n",
+           result->name, result->median_ns, result->min_ns, result->p99_ns,
+           result->std_dev_ns, result->sample_count,
+           (unsigned long long)result->iterations);
+
+    if (result->counter_mask != 0) {
+        printf("  %-32s", "");
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            if (result->counter_mask & (1u << i)) {
+                printf(" %s %.1f", perf_counter_name((perf_counter_id)i), result->counters[i]);
+            }
+        }
+        printf("  (per op)\n");
+    }
+    bench_record(result);
+}
+
+int bench_measure(const char *name, bench_fn fn, bench_fn setup, void *ctx) {
+    bench_config config = bench_default_config();
+    bench_result result;
+
+    int status = bench_run(name, fn, setup, ctx, &config, &result);
+    if (status == 0) {
+        bench_report(&result);
+    }
+    return status;
+}
+
+int bench_end(void) {
+    const char *path = getenv("BENCH_JSON");
+    int status = 0;
+
+    if (path != NULL && *path != '\0') {
+        if (strcmp(path, "-") == 0) {
+            bench_write_json(stdout, session_example, session_results, session_count);
+        } else {
+            FILE *out = fopen(path, "w");
+            if (out == NULL) {
+                fprintf(stderr, "Error: Cannot write benchmark report to %s\n", path);
+                status = -1;
+            } else {
+                bench_write_json(out, session_example, session_results, session_count);
+                fclose(out);
+            }
+        }
+    }
+
+    if (counters_state == 1) {
+        perf_counters_close(&session_counters);
+    }
+    counters_state = 0;
+    session_example = NULL;
+    session_count = 0;
+    return status;
+}
+
+static void write_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; s != NULL && *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+/**
+ * Per-iteration hardware counters, or null when not captured
+ */
+static void write_json_counters(FILE *out, const bench_result *r) {
+    fprintf(out, "      \"hardware_counters\": ");
+    if (r->counter_mask == 0) {
+        fprintf(out, "null");
+        return;
+    }
+
+    fprintf(out, "{");
+    const char *sep = "";
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (r->counter_mask & (1u << i)) {
+            fprintf(out, "%s\n        \"%s\": %.3f", sep, perf_counter_name((perf_counter_id)i),
+                    r->counters[i]);
+            sep = ",";
+        }
+    }
+
+    unsigned ipc_mask = (1u << PERF_CYCLES) | (1u << PERF_INSTRUCTIONS);
+    if ((r->counter_mask & ipc_mask) == ipc_mask && r->counters[PERF_CYCLES] > 0.0) {
+        fprintf(out, ",\n        \"instructions_per_cycle\": %.3f",
+                r->counters[PERF_INSTRUCTIONS] / r->counters[PERF_CYCLES]);
+    }
+    fprintf(out, "\n      }");
+}
+
+void bench_write_json(FILE *out, const char *example,
+                      const bench_result results[], int count) {
+    fprintf(out, "{\n  \"language\": \"c\",\n  \"example\": ");
+    write_json_string(out, example != NULL ? example : "");
+    fprintf(out, ",\n  \"benchmarks\": [");
+
+    for (int i = 0; i < count; i++) {
+        const bench_result *r = &results[i];
+        fprintf(out, "%s\n    {\n      \"name\": ", i == 0 ? "" : ",");
+        write_json_string(out, r->name);
+        fprintf(out, ",\n      \"iterations_per_sample\": %llu,\n",
+                (unsigned long long)r->iterations);
+        fprintf(out, "      \"execution_time\": {\n");
+        fprintf(out, "        \"mean_ns\": %llu,\n", (unsigned long long)llround(r->mean_ns));
+        fprintf(out, "        \"median_ns\": %llu,\n", (unsigned long long)llround(r->median_ns));
+        fprintf(out, "        \"std_dev_ns\": %llu,\n", (unsigned long long)llround(r->std_dev_ns));
+        fprintf(out, "        \"min_ns\": %llu,\n", (unsigned long long)llround(r->min_ns));
+        fprintf(out, "        \"max_ns\": %llu,\n", (unsigned long long)llround(r->max_ns));
+        fprintf(out, "        \"p95_ns\": %llu,\n", (unsigned long long)llround(r->p95_ns));
+        fprintf(out, "        \"p99_ns\": %llu,\n", (unsigned long long)llround(r->p99_ns));
+        fprintf(out, "        \"confidence_interval\": [%llu, %llu],\n",
+                (unsigned long long)llround(r->ci95_low_ns),
+                (unsigned long long)llround(r->ci95_high_ns));
+        fprintf(out, "        \"sample_count\": %d\n", r->sample_count);
+        fprintf(out, "      },\n");
+        write_json_counters(out, r);
+        fprintf(out, "\n    }");
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+}
+
+/**
+ * One xorshift64* step; the top 31 bits are returned so results fit an int
+ */
+static int next_random(uint64_t *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return (int)((*state * 0x2545F4914F6CDD1DULL) >> 33);
+}
+
+static uint64_t seed_state(uint64_t seed) {
+    return seed != 0 ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+void bench_fill_random(int arr[], size_t size, uint64_t seed, int max_value) {
+    uint64_t state = seed_state(seed);
+
+    for (size_t i = 0; i < size; i++) {
+        int r = next_random(&state);
+        arr[i] = max_value > 0 ? r % max_value : r;
+    }
+}
+
+void bench_fill_sorted_fraction(int arr[], size_t size, uint64_t seed, double fraction) {
+    uint64_t state = seed_state(seed);
+    // Compare against 31-bit draws; fraction >= 1 never perturbs
+    double threshold = fraction * 2147483648.0;
+
+    for (size_t i = 0; i < size; i++) {
+        arr[i] = (int)i;
+        if ((double)next_random(&state) >= threshold) {
+            arr[i] = next_random(&state) % (int)size;
+        }
+    }
+}
+
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+void bench_fill_runs(int arr[], size_t size, uint64_t seed, size_t runs) {
+    bench_fill_random(arr, size, seed, (int)size);
+    if (runs == 0) {
+        runs = 1;
+    }
+
+    for (size_t r = 0; r < runs; r++) {
+        size_t begin = size * r / runs;
+        size_t end = size * (r + 1) / runs;
+        qsort(arr + begin, end - begin, sizeof(int), compare_ints);
+    }
+}
+
+void bench_fill_reversed_blocks(int arr[], size_t size, size_t block) {
+    if (block == 0) {
+        block = 1;
+    }
+
+    for (size_t begin = 0; begin < size; begin += block) {
+        size_t end = begin + block < size ? begin + block : size;
+        for (size_t i = begin; i < end; i++) {
+            arr[i] = (int)(begin + end - 1 - i);
+        }
+    }
+}
+
+// Distinct keys of the ZIPF shape (at most)
+#define BENCH_ZIPF_KEYS 65536
+
+static const char *const shape_names[BENCH_SHAPE_COUNT] = {
+    "random", "sorted", "reversed", "few_unique", "organ_pipe", "zipf"};
+
+const char *bench_shape_name(bench_shape shape) {
+    return shape >= 0 && shape < BENCH_SHAPE_COUNT ? shape_names[shape] : "unknown";
+}
+
+/**
+ * Zipf(1) ranks by inverse transform: binary search of a uniform draw in
+ * the cumulative weights 1, 1/2, 1/3, ...
+ */
+static int fill_zipf(int arr[], size_t size, uint64_t seed) {
+    size_t keys = size < BENCH_ZIPF_KEYS ? size : BENCH_ZIPF_KEYS;
+    double *cdf = malloc(keys * sizeof(double));
+    if (cdf == NULL) {
+        return -1;
+    }
+    double total = 0.0;
+    for (size_t k = 0; k < keys; k++) {
+        total += 1.0 / (double)(k + 1);
+        cdf[k] = total;
+    }
+
+    uint64_t state = seed_state(seed);
+    for (size_t i = 0; i < size; i++) {
+        double u = (double)next_random(&state) / 2147483648.0 * total;
+        size_t lo = 0;
+        size_t hi = keys - 1;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (cdf[mid] <= u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        arr[i] = (int)lo;
+    }
+    free(cdf);
+    return 0;
+}
+
+int bench_fill_shape(int arr[], size_t size, uint64_t seed, bench_shape shape) {
+    switch (shape) {
+    case BENCH_SHAPE_SORTED:
+        for (size_t i = 0; i < size; i++) {
+            arr[i] = (int)i;
+        }
+        return 0;
+    case BENCH_SHAPE_REVERSED:
+        bench_fill_reversed_blocks(arr, size, size);
+        return 0;
+    case BENCH_SHAPE_FEW_UNIQUE:
+        bench_fill_random(arr, size, seed, 16);
+        return 0;
+    case BENCH_SHAPE_ORGAN_PIPE:
+        for (size_t i = 0; i < size; i++) {
+            arr[i] = (int)(i < size / 2 ? i : size - 1 - i);
+        }
+        return 0;
+    case BENCH_SHAPE_ZIPF:
+        return size > 0 ? fill_zipf(arr, size, seed) : 0;
+    default:
+        bench_fill_random(arr, size, seed, 0);
+        return 0;
+    }
+}
@@ -0,0 +1,208 @@
+/**
+ * Shared C Benchmark Harness
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Replaces the per-file clock() timing in the C implementations with:
+ * - CLOCK_MONOTONIC_RAW timing (immune to NTP slewing)
+ * - Warmup samples followed by measured samples
+ * - Auto-calibrated iteration counts so each sample is well above timer
+ *   granularity
+ * - Dead-code elimination barriers
+ * - JSON output matching the runner's TimeStatistics schema
+ *   (harness/runner/src/main.rs), with percentiles computed the same way
+ *   as harness/runner/src/statistics.rs
+ *
+ * Environment overrides:
+ *   BENCH_SAMPLES        measured samples per benchmark (default 30)
+ *   BENCH_WARMUP         warmup samples per benchmark (default 5)
+ *   BENCH_MIN_SAMPLE_NS  minimum duration of one sample (default 1000000)
+ *   BENCH_JSON           write the JSON report to this path ("-" = stdout)
+ *   BENCH_PERF           non-zero: capture hardware counters around every
+ *                        measured iteration (see perf_counters.h)
+ */
+
+#ifndef ROSETTA_BENCH_H
+#define ROSETTA_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "perf_counters.h"
+
+#define BENCH_MAX_SAMPLES 1000
+#define BENCH_MAX_RESULTS 1024
+#define BENCH_NAME_LEN 64
+
+/**
+ * Benchmark body; ctx is passed through untouched
+ */
+typedef void (*bench_fn)(void *ctx);
+
+/**
+ * Sampling configuration
+ */
+typedef struct {
+    int warmup_samples;
+    int samples;
+    uint64_t min_sample_ns;
+} bench_config;
+
+/**
+ * Per-iteration timing summary of one benchmark (nanoseconds)
+ */
+typedef struct {
+    char name[BENCH_NAME_LEN];
+    uint64_t iterations;  // Iterations folded into each sample
+    int sample_count;
+    double min_ns;
+    double max_ns;
+    double mean_ns;
+    double median_ns;
+    double std_dev_ns;
+    double p95_ns;
+    double p99_ns;
+    double ci95_low_ns;
+    double ci95_high_ns;
+    unsigned counter_mask;                // Valid entries in counters[]
+    double counters[PERF_COUNTER_COUNT];  // Per-iteration hardware counts
+} bench_result;
+
+/**
+ * Keep a value alive so the compiler cannot drop the computation behind it
+ */
+#define BENCH_DO_NOT_OPTIMIZE(value) __asm__ volatile("" : : "g"(value) : "memory")
+
+/**
+ * Force pending stores to memory to be treated as observable
+ */
+static inline void bench_clobber(void) {
+    __asm__ volatile("" : : : "memory");
+}
+
+/**
+ * Keep the memory behind a pointer alive
+ */
+static inline void bench_escape(const void *p) {
+    __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+/**
+ * Monotonic raw clock in nanoseconds
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * Estimated core clock in GHz (measured once per process). Lets results be
+ * expressed in cycles when hardware counters are unavailable.
+ */
+double bench_cpu_ghz(void);
+
+/**
+ * Cycles per iteration of a result: the PERF_CYCLES counter when it was
+ * captured (BENCH_PERF), else median_ns * bench_cpu_ghz(). *measured (if
+ * non-NULL) is set to 1 for a counter reading, 0 for an estimate.
+ */
+double bench_cycles(const bench_result *result, int *measured);
+
+/**
+ * Defaults, overridden by BENCH_* environment variables
+ */
+bench_config bench_default_config(void);
+
+/**
+ * Measure fn(ctx).
+ *
+ * If setup is non-NULL it runs before every iteration and is excluded from
+ * the measurement (e.g. restoring an unsorted copy before each sort).
+ * Returns 0 on success, -1 on invalid configuration.
+ */
+int bench_run(const char *name, bench_fn fn, bench_fn setup, void *ctx,
+              const bench_config *config, bench_result *result);
+
+/**
+ * Start a benchmark session for an example (e.g. "algorithms/002-quicksort")
+ */
+void bench_begin(const char *example);
+
+/**
+ * Record a result for the JSON report without printing it
+ */
+void bench_record(const bench_result *result);
+
+/**
+ * Print a result line and record it for the JSON report
+ */
+void bench_report(const bench_result *result);
+
+/**
+ * Run and report in one call; returns the same status as bench_run()
+ */
+int bench_measure(const char *name, bench_fn fn, bench_fn setup, void *ctx);
+
+/**
+ * Finish the session, writing the JSON report if BENCH_JSON is set.
+ * Returns 0 on success, -1 if the report could not be written.
+ */
+int bench_end(void);
+
+/**
+ * Write recorded results as JSON
+ */
+void bench_write_json(FILE *out, const char *example,
+                      const bench_result results[], int count);
+
+/**
+ * Deterministic pseudo-random fill in [0, max_value) (xorshift64*)
+ */
+void bench_fill_random(int arr[], size_t size, uint64_t seed, int max_value);
+
+/**
+ * Presorted inputs for adaptive sorts, values in [0, size):
+ *
+ * bench_fill_sorted_fraction  ascending, with each position replaced by a
+ *                             random value with probability 1 - fraction
+ *                             (appended log with late arrivals)
+ * bench_fill_runs             `runs` ascending runs of random values
+ * bench_fill_reversed_blocks  ascending, with every `block` elements
+ *                             reversed
+ */
+void bench_fill_sorted_fraction(int arr[], size_t size, uint64_t seed, double fraction);
+void bench_fill_runs(int arr[], size_t size, uint64_t seed, size_t runs);
+void bench_fill_reversed_blocks(int arr[], size_t size, size_t block);
+
+/**
+ * Input shapes of the cross-algorithm sort matrix (harness/benchmarking/c/matrix)
+ *
+ * RANDOM      uniform in [0, 2^31)
+ * SORTED      0, 1, ..., size - 1
+ * REVERSED    size - 1, ..., 1, 0
+ * FEW_UNIQUE  uniform over 16 values
+ * ORGAN_PIPE  ascending to the middle, then descending
+ * ZIPF        Zipf(s = 1) ranks over min(size, 65536) keys: a handful of
+ *             keys cover most positions, over a long tail
+ */
+typedef enum {
+    BENCH_SHAPE_RANDOM = 0,
+    BENCH_SHAPE_SORTED,
+    BENCH_SHAPE_REVERSED,
+    BENCH_SHAPE_FEW_UNIQUE,
+    BENCH_SHAPE_ORGAN_PIPE,
+    BENCH_SHAPE_ZIPF,
+    BENCH_SHAPE_COUNT
+} bench_shape;
+
+/**
+ * Deterministic fill of one shape. Returns 0, or -1 if the Zipf table
+ * cannot be allocated.
+ */
+int bench_fill_shape(int arr[], size_t size, uint64_t seed, bench_shape shape);
+
+/**
+ * Lower-case name of a shape ("organ_pipe", ...)
+ */
+const char *bench_shape_name(bench_shape shape);
+
+#endif  // ROSETTA_BENCH_H
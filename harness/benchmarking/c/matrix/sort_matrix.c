@@ -0,0 +1,292 @@
+/**
+ * Cross-Algorithm Sort Benchmark Matrix
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Runs every C sort of examples/algorithms over the same inputs: each
+ * size given on the command line times each bench_shape (bench.h), the
+ * input regenerated from the same seed for every algorithm. Results
+ * are recorded as "<algorithm>/<shape>/n=<size>" for the BENCH_JSON
+ * report, which harness/runner compares against a stored baseline
+ * (rosetta-runner regression). Every output is checked once, so a
+ * miscompile under one of the build flavors fails the run.
+ *
+ * The Makefile beside this file builds one binary per flavor
+ * (-O2, -O3, -O3 -march=native, + LTO, + PGO); MATRIX_FLAVOR names it
+ * in the report.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "counting_sort.h"
+#include "heap_sort.h"
+#include "mergesort.h"
+#include "quicksort.h"
+#include "radix_sort.h"
+#include "selection_sort.h"
+#include "sort_auto.h"
+
+#ifndef MATRIX_FLAVOR
+#define MATRIX_FLAVOR "custom"
+#endif
+
+// Samples per point from this size up (fewer, each long enough)
+#define MATRIX_LARGE_N 1000000
+#define MATRIX_LARGE_SAMPLES 5
+
+// Sizes of the PGO training run
+#define MATRIX_TRAIN_SMALL 1000
+#define MATRIX_TRAIN_LARGE 200000
+
+typedef struct {
+    const char *name;
+    int (*sort)(int arr[], int size);  // 0, or -1 if it could not run
+    size_t max_n;                      // Skipped above this size (quadratic sorts)
+} matrix_algorithm;
+
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int run_qsort(int arr[], int size) {
+    qsort(arr, (size_t)size, sizeof(int), compare_ints);
+    return 0;
+}
+
+static int run_quicksort_block(int arr[], int size) {
+    quicksort_block(arr, size);
+    return 0;
+}
+
+static int run_quicksort_intro(int arr[], int size) {
+    quicksort_intro(arr, size);
+    return 0;
+}
+
+static int run_heap_sort(int arr[], int size) {
+    heap_sort(arr, size);
+    return 0;
+}
+
+static int run_american_flag(int arr[], int size) {
+    radix_sort_american_flag(arr, size);
+    return 0;
+}
+
+static int run_counting_sort(int arr[], int size) {
+    counting_sort(arr, size);
+    return 0;
+}
+
+static int run_sort_auto(int arr[], int size) {
+    sort_auto(arr, size);
+    return 0;
+}
+
+static int run_selection_sort(int arr[], int size) {
+    selection_sort(arr, size);
+    return 0;
+}
+
+static const matrix_algorithm ALGORITHMS[] = {
+    {"qsort", run_qsort, SIZE_MAX},
+    {"quicksort_block", run_quicksort_block, SIZE_MAX},
+    {"quicksort_intro", run_quicksort_intro, SIZE_MAX},
+    {"mergesort_bottomup", mergesort_bottomup, SIZE_MAX},
+    {"mergesort_adaptive", mergesort_adaptive, SIZE_MAX},
+    {"heap_sort", run_heap_sort, SIZE_MAX},
+    {"heap_sort_dary", heap_sort_dary, SIZE_MAX},
+    {"radix_lsd2048", radix_sort_lsd2048, SIZE_MAX},
+    {"radix_american_flag", run_american_flag, SIZE_MAX},
+    {"counting_sort", run_counting_sort, SIZE_MAX},
+    {"sort_auto", run_sort_auto, SIZE_MAX},
+    {"selection_sort", run_selection_sort, 10000},
+};
+
+#define ALGORITHM_COUNT (sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]))
+
+typedef struct {
+    const matrix_algorithm *algorithm;
+    const int *input;
+    int *work;
+    int size;
+    int failed;
+} matrix_ctx;
+
+static void restore_input(void *ctx) {
+    matrix_ctx *c = ctx;
+    memcpy(c->work, c->input, (size_t)c->size * sizeof(int));
+}
+
+static void bench_sort(void *ctx) {
+    matrix_ctx *c = ctx;
+    c->failed |= c->algorithm->sort(c->work, c->size) != 0;
+    bench_escape(c->work);
+}
+
+static int is_sorted(const int arr[], int size) {
+    for (int i = 1; i < size; i++) {
+        if (arr[i - 1] > arr[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * One size of the matrix: every shape and algorithm. Returns the number
+ * of failed runs (wrong output or an error return), or -1 if the two
+ * arrays would not fit in 80% of physical memory.
+ */
+static int run_size(int size) {
+    // malloc() would overcommit; the sorts would then touch the pages
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+    double needed = 2.0 * (double)size * sizeof(int);
+    if (pages > 0 && page_size > 0 && needed > 0.8 * (double)pages * (double)page_size) {
+        return -1;
+    }
+
+    int *input = malloc((size_t)size * sizeof(int));
+    int *work = malloc((size_t)size * sizeof(int));
+    if (input == NULL || work == NULL) {
+        free(input);
+        free(work);
+        return -1;
+    }
+
+    bench_config config = bench_default_config();
+    if (size >= MATRIX_LARGE_N) {
+        config.warmup_samples = 1;
+        if (config.samples > MATRIX_LARGE_SAMPLES) {
+            config.samples = MATRIX_LARGE_SAMPLES;
+        }
+    }
+    bench_result result;
+    char name[BENCH_NAME_LEN];
+    int failures = 0;
+
+    for (int shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+        const char *shape_name = bench_shape_name((bench_shape)shape);
+        if (bench_fill_shape(input, (size_t)size, 42, (bench_shape)shape) != 0) {
+            fprintf(stderr, "Error: Memory allocation failed (%s input)\n", shape_name);
+            failures++;
+            continue;
+        }
+
+        for (size_t a = 0; a < ALGORITHM_COUNT; a++) {
+            const matrix_algorithm *algorithm = &ALGORITHMS[a];
+            if ((size_t)size > algorithm->max_n) {
+                continue;
+            }
+            matrix_ctx ctx = {algorithm, input, work, size, 0};
+            snprintf(name, sizeof(name), "%s/%s/n=%d", algorithm->name, shape_name, size);
+            if (bench_run(name, bench_sort, restore_input, &ctx, &config, &result) != 0) {
+                failures++;
+                continue;
+            }
+            if (ctx.failed || !is_sorted(work, size)) {
+                fprintf(stderr, "Error: %s left its output unsorted\n", name);
+                failures++;
+                continue;
+            }
+            bench_record(&result);
+            printf("  %-20s %-11s n=%-10d median %12.3f ms\n", algorithm->name, shape_name, size,
+                   result.median_ns / 1e6);
+        }
+    }
+
+    free(input);
+    free(work);
+    return failures;
+}
+
+/**
+ * PGO training: every algorithm once per shape at two sizes, covering
+ * the small-n and large-n paths without the cost of timing them
+ */
+static int run_training(void) {
+    static const int sizes[] = {MATRIX_TRAIN_SMALL, MATRIX_TRAIN_LARGE};
+    int failures = 0;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int size = sizes[s];
+        int *input = malloc((size_t)size * sizeof(int));
+        int *work = malloc((size_t)size * sizeof(int));
+        if (input == NULL || work == NULL) {
+            fprintf(stderr, "Error: Memory allocation failed\n");
+            free(input);
+            free(work);
+            return 1;
+        }
+        for (int shape = 0; shape < BENCH_SHAPE_COUNT; shape++) {
+            failures += bench_fill_shape(input, (size_t)size, 7, (bench_shape)shape) != 0;
+            for (size_t a = 0; a < ALGORITHM_COUNT; a++) {
+                if ((size_t)size > ALGORITHMS[a].max_n) {
+                    continue;
+                }
+                memcpy(work, input, (size_t)size * sizeof(int));
+                failures += ALGORITHMS[a].sort(work, size) != 0 || !is_sorted(work, size);
+            }
+        }
+        free(input);
+        free(work);
+    }
+    printf("Training run (%s): %s\n", MATRIX_FLAVOR, failures == 0 ? "ok" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
+
+/**
+ * Main entry point
+ */
+int main(int argc, char *argv[]) {
+    if (argc == 2 && strcmp(argv[1], "train") == 0) {
+        return run_training();
+    }
+    if (argc < 2) {
+        printf("Usage: %s <size> [size ...]\n", argv[0]);
+        printf("       %s train\n", argv[0]);
+        printf("\nExample: BENCH_JSON=o3.json %s 1000 100000 10000000\n", argv[0]);
+        return 1;
+    }
+
+    int failures = 0;
+    char example[BENCH_NAME_LEN];
+    snprintf(example, sizeof(example), "algorithms/sort-matrix/%s", MATRIX_FLAVOR);
+
+    bench_begin(example);
+    printf("Sort matrix (%s):\n", MATRIX_FLAVOR);
+    for (int i = 1; i < argc; i++) {
+        long size = strtol(argv[i], NULL, 10);
+        if (size < 1 || size > 2147483647L) {
+            fprintf(stderr, "Error: Invalid size %s\n", argv[i]);
+            return 1;
+        }
+        int status = run_size((int)size);
+        if (status < 0) {
+            // Not an error: the matrix reaches sizes beyond small machines
+            printf("  n=%ld skipped: two arrays of %.2f GiB do not fit in memory\n", size,
+                   (double)size * sizeof(int) / (1u << 30));
+            continue;
+        }
+        failures += status;
+    }
+
+    if (bench_end() != 0) {
+        return 1;
+    }
+    if (failures != 0) {
+        fprintf(stderr, "Error: %d benchmark(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * Peak Memory Measurement for the C Benchmark Harness
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#include "memory_profile.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define BYTES_PER_MB 1048576.0
+
+/**
+ * Value of a "<key>: <n> kB" line of /proc/self/status, in bytes
+ */
+static uint64_t status_bytes(const char *key) {
+#ifdef __linux__
+    FILE *status = fopen("/proc/self/status", "r");
+    if (status == NULL) {
+        return 0;
+    }
+
+    size_t key_len = strlen(key);
+    char line[256];
+    unsigned long long kb = 0;
+    while (fgets(line, sizeof(line), status) != NULL) {
+        if (strncmp(line, key, key_len) == 0 && line[key_len] == ':') {
+            sscanf(line + key_len + 1, "%llu", &kb);
+            break;
+        }
+    }
+    fclose(status);
+    return (uint64_t)kb * 1024;
+#else
+    (void)key;
+    return 0;
+#endif
+}
+
+/**
+ * Reset VmHWM to the current RSS (Linux 4.0+); returns 1 on success
+ */
+static int reset_peak(void) {
+#ifdef __linux__
+    FILE *clear_refs = fopen("/proc/self/clear_refs", "w");
+    if (clear_refs == NULL) {
+        return 0;
+    }
+    int ok = fputs("5", clear_refs) >= 0;
+    return fclose(clear_refs) == 0 && ok;
+#else
+    return 0;
+#endif
+}
+
+uint64_t memory_rss_bytes(void) {
+    return status_bytes("VmRSS");
+}
+
+void memory_profile_begin(memory_profile *mp) {
+    mp->peak_is_scoped = reset_peak();
+    mp->initial_usage_bytes = memory_rss_bytes();
+    mp->peak_usage_bytes = 0;
+    mp->final_usage_bytes = 0;
+}
+
+void memory_profile_end(memory_profile *mp) {
+    mp->final_usage_bytes = memory_rss_bytes();
+    mp->peak_usage_bytes = status_bytes("VmHWM");
+    if (mp->peak_usage_bytes < mp->final_usage_bytes) {
+        mp->peak_usage_bytes = mp->final_usage_bytes;
+    }
+}
+
+uint64_t memory_profile_growth_bytes(const memory_profile *mp) {
+    return mp->peak_usage_bytes > mp->initial_usage_bytes
+               ? mp->peak_usage_bytes - mp->initial_usage_bytes
+               : 0;
+}
+
+void memory_profile_report(const char *name, const memory_profile *mp) {
+    printf("  %-32s peak %9.2f MB  (+%.2f MB over initial %.2f MB, final %.2f MB)%s\n",
+           name, mp->peak_usage_bytes / BYTES_PER_MB,
+           memory_profile_growth_bytes(mp) / BYTES_PER_MB,
+           mp->initial_usage_bytes / BYTES_PER_MB, mp->final_usage_bytes / BYTES_PER_MB,
+           mp->peak_is_scoped ? "" : "  [process peak]");
+}
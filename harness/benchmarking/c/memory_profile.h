@@ -0,0 +1,54 @@
+/**
+ * Peak Memory Measurement for the C Benchmark Harness
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * C counterpart of harness/runner/src/memory_profiler.rs: the same
+ * /proc/<pid>/status source (VmRSS, plus the kernel's VmHWM high-water
+ * mark instead of sampling), the same initial/peak/final fields, and
+ * sizes reported in MB (2^20 bytes) with two decimals. The high-water
+ * mark is reset through /proc/self/clear_refs so a profile covers only
+ * the code between begin and end; where that is not possible the peak is
+ * the process-lifetime one and `peak_is_scoped` is 0. Off Linux every
+ * field reads 0.
+ */
+
+#ifndef ROSETTA_MEMORY_PROFILE_H
+#define ROSETTA_MEMORY_PROFILE_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint64_t initial_usage_bytes;  // RSS at memory_profile_begin()
+    uint64_t peak_usage_bytes;     // Highest RSS up to memory_profile_end()
+    uint64_t final_usage_bytes;    // RSS at memory_profile_end()
+    int peak_is_scoped;            // Peak was reset at begin
+} memory_profile;
+
+/**
+ * Current resident set size in bytes (0 if unavailable)
+ */
+uint64_t memory_rss_bytes(void);
+
+/**
+ * Reset the high-water mark and record the initial RSS
+ */
+void memory_profile_begin(memory_profile *mp);
+
+/**
+ * Record the peak and final RSS
+ */
+void memory_profile_end(memory_profile *mp);
+
+/**
+ * Peak above the initial RSS: what the profiled code added at its worst
+ */
+uint64_t memory_profile_growth_bytes(const memory_profile *mp);
+
+/**
+ * One line: name, peak, growth over initial, final
+ */
+void memory_profile_report(const char *name, const memory_profile *mp);
+
+#endif  // ROSETTA_MEMORY_PROFILE_H
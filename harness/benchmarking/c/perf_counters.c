@@ -0,0 +1,176 @@
+/**
+ * Hardware Performance Counters for the C Benchmark Harness
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ */
+
+#define _GNU_SOURCE
+
+#include "perf_counters.h"
+
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const char *const counter_names[PERF_COUNTER_COUNT] = {
+    "cycles",
+    "instructions",
+    "branch_misses",
+    "l1d_read_misses",
+    "llc_misses",
+};
+
+const char *perf_counter_name(perf_counter_id id) {
+    return id < PERF_COUNTER_COUNT ? counter_names[id] : "unknown";
+}
+
+#ifdef __linux__
+
+/**
+ * Event type/config pairs, indexed by perf_counter_id
+ */
+static void event_config(perf_counter_id id, __u32 *type, __u64 *config) {
+    switch (id) {
+    case PERF_CYCLES:
+        *type = PERF_TYPE_HARDWARE;
+        *config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PERF_INSTRUCTIONS:
+        *type = PERF_TYPE_HARDWARE;
+        *config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PERF_BRANCH_MISSES:
+        *type = PERF_TYPE_HARDWARE;
+        *config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case PERF_L1D_READ_MISSES:
+        *type = PERF_TYPE_HW_CACHE;
+        *config = PERF_COUNT_HW_CACHE_L1D |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    default:
+        *type = PERF_TYPE_HARDWARE;
+        *config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    }
+}
+
+int perf_counters_open(perf_counters *pc) {
+    int opened = 0;
+    pc->mask = 0;
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        event_config((perf_counter_id)i, &attr.type, &attr.config);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        pc->fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (pc->fds[i] >= 0) {
+            pc->mask |= 1u << i;
+            opened++;
+        }
+    }
+
+    return opened;
+}
+
+static void ioctl_all(const perf_counters *pc, unsigned long request) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->mask & (1u << i)) {
+            ioctl(pc->fds[i], request, 0);
+        }
+    }
+}
+
+void perf_counters_reset(perf_counters *pc) {
+    ioctl_all(pc, PERF_EVENT_IOC_RESET);
+}
+
+void perf_counters_enable(perf_counters *pc) {
+    ioctl_all(pc, PERF_EVENT_IOC_ENABLE);
+}
+
+void perf_counters_disable(perf_counters *pc) {
+    ioctl_all(pc, PERF_EVENT_IOC_DISABLE);
+}
+
+void perf_counters_read(const perf_counters *pc, perf_sample *sample) {
+    memset(sample, 0, sizeof(*sample));
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (!(pc->mask & (1u << i))) {
+            continue;
+        }
+
+        // value, time_enabled, time_running
+        uint64_t data[3];
+        if (read(pc->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            continue;
+        }
+
+        // Scale up when the PMU multiplexed this counter
+        uint64_t value = data[0];
+        if (data[2] > 0 && data[2] < data[1]) {
+            value = (uint64_t)((double)value * (double)data[1] / (double)data[2]);
+        }
+        if (data[2] > 0) {
+            sample->values[i] = value;
+            sample->mask |= 1u << i;
+        }
+    }
+}
+
+void perf_counters_close(perf_counters *pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->mask & (1u << i)) {
+            close(pc->fds[i]);
+        }
+        pc->fds[i] = -1;
+    }
+    pc->mask = 0;
+}
+
+#else  // !__linux__
+
+int perf_counters_open(perf_counters *pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        pc->fds[i] = -1;
+    }
+    pc->mask = 0;
+    return 0;
+}
+
+void perf_counters_reset(perf_counters *pc) {
+    (void)pc;
+}
+
+void perf_counters_enable(perf_counters *pc) {
+    (void)pc;
+}
+
+void perf_counters_disable(perf_counters *pc) {
+    (void)pc;
+}
+
+void perf_counters_read(const perf_counters *pc, perf_sample *sample) {
+    (void)pc;
+    memset(sample, 0, sizeof(*sample));
+}
+
+void perf_counters_close(perf_counters *pc) {
+    (void)pc;
+}
+
+#endif  // __linux__
@@ -0,0 +1,79 @@
+/**
+ * Hardware Performance Counters for the C Benchmark Harness
+ *
+ * Part of rosetta-ruchy Tier 0 implementations for transpiler validation
+ * Sister project: decy (https://github.com/paiml/decy)
+ *
+ * Thin wrapper around Linux perf_event_open(2). Counters are user-space
+ * only (exclude_kernel) so they work at perf_event_paranoid <= 2, and each
+ * counter is opened independently so a PMU that lacks one event (common in
+ * VMs) still reports the others. On other platforms nothing opens and the
+ * harness falls back to wall time only.
+ */
+
+#ifndef ROSETTA_PERF_COUNTERS_H
+#define ROSETTA_PERF_COUNTERS_H
+
+#include <stdint.h>
+
+typedef enum {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_READ_MISSES,
+    PERF_LLC_MISSES,
+    PERF_COUNTER_COUNT
+} perf_counter_id;
+
+/**
+ * Set of open counter file descriptors (-1 when unavailable)
+ */
+typedef struct {
+    int fds[PERF_COUNTER_COUNT];
+    unsigned mask;  // Bit i set when counter i is open
+} perf_counters;
+
+/**
+ * Counter totals, scaled for multiplexing
+ */
+typedef struct {
+    uint64_t values[PERF_COUNTER_COUNT];
+    unsigned mask;
+} perf_sample;
+
+/**
+ * Open all counters (disabled). Returns the number that opened.
+ */
+int perf_counters_open(perf_counters *pc);
+
+/**
+ * Zero all counters
+ */
+void perf_counters_reset(perf_counters *pc);
+
+/**
+ * Start counting (accumulates across enable/disable pairs)
+ */
+void perf_counters_enable(perf_counters *pc);
+
+/**
+ * Stop counting
+ */
+void perf_counters_disable(perf_counters *pc);
+
+/**
+ * Read accumulated totals
+ */
+void perf_counters_read(const perf_counters *pc, perf_sample *sample);
+
+/**
+ * Close all counters
+ */
+void perf_counters_close(perf_counters *pc);
+
+/**
+ * JSON key for a counter (e.g. "branch_misses")
+ */
+const char *perf_counter_name(perf_counter_id id);
+
+#endif  // ROSETTA_PERF_COUNTERS_H
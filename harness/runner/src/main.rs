@@ -1129,11 +1129,11 @@ pub async fn run_app(cli: Cli) -> Result<()> {
             handle_validate_command().await?;
         }
         Commands::Regression {
-            baseline: _,
-            current: _,
+            baseline,
+            current,
             threshold,
         } => {
-            handle_regression_command(threshold)?;
+            handle_regression_command(&baseline, &current, threshold)?;
         }
     }
 
@@ -1374,13 +1374,48 @@ fn print_recommendations(state: &isolation::EnvironmentState) -> Result<()> {
 /// Handle the 'regression' command - check for performance regressions
 ///
 /// Extracted from run_app() for complexity reduction (Sprint 43 Ticket 4)
-fn handle_regression_command(threshold: f64) -> Result<()> {
+fn handle_regression_command(baseline: &Path, current: &Path, threshold: f64) -> Result<()> {
     info!(
         "🚨 Checking for performance regressions (threshold: {}%)",
         threshold
     );
-    // Note: Regression detection tracked in GitHub issue
-    println!("Regression detection not yet implemented - coming in ROSETTA-009");
+    let baseline_report = regression::load_harness_report(baseline)?;
+    let current_report = regression::load_harness_report(current)?;
+
+    let detector = RegressionDetector::new().with_threshold(threshold);
+    let analysis = detector.compare_reports(&baseline_report, &current_report);
+
+    let violations: Vec<_> = analysis
+        .comparisons
+        .iter()
+        .filter(|c| c.quality_gate_violation)
+        .collect();
+    for violation in &violations {
+        println!(
+            "❌ {}: {:+.1}% ({:.0} ns -> {:.0} ns, {:?})",
+            violation.implementation,
+            violation.comparison.percent_change,
+            violation.comparison.baseline_mean,
+            violation.comparison.current_mean,
+            violation.severity
+        );
+    }
+    println!(
+        "{}: {} benchmarks compared, {} significant slowdowns of {}% or more ({:?})",
+        current_report.example,
+        analysis.comparisons.len(),
+        violations.len(),
+        threshold,
+        analysis.overall_status
+    );
+
+    if !violations.is_empty() {
+        anyhow::bail!(
+            "{} benchmark(s) regressed against {}",
+            violations.len(),
+            baseline.display()
+        );
+    }
     Ok(())
 }
 
@@ -12,7 +12,8 @@ use std::fs;
 use std::path::{Path, PathBuf};
 
 use crate::statistics::{
-    ComparisonResult, PerformanceComparator, SignificanceLevel, StatisticalAnalysis,
+    ComparisonResult, ConfidenceIntervals, DistributionMetrics, OutlierAnalysis, Percentiles,
+    PerformanceComparator, Quartiles, SampleStatistics, SignificanceLevel, StatisticalAnalysis,
 };
 
 /// Performance regression detector with configurable thresholds
@@ -130,6 +131,109 @@ pub struct AlertConfiguration {
     pub alert_threshold: RegressionSeverity,
 }
 
+/// Benchmark report written by the C harness (`BENCH_JSON`, see
+/// harness/benchmarking/c/bench.h): one example, many named benchmarks
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct HarnessReport {
+    /// Implementation language ("c")
+    pub language: String,
+    /// Example identifier (e.g. "algorithms/sort-matrix/o3")
+    pub example: String,
+    /// Results in run order
+    pub benchmarks: Vec<HarnessBenchmark>,
+}
+
+/// One benchmark of a harness report
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct HarnessBenchmark {
+    /// Benchmark name (e.g. "radix_lsd2048/zipf/n=1000000")
+    pub name: String,
+    /// Per-iteration timing summary
+    pub execution_time: HarnessTiming,
+}
+
+/// Per-iteration timing summary of a harness benchmark (nanoseconds)
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct HarnessTiming {
+    pub mean_ns: f64,
+    pub median_ns: f64,
+    pub std_dev_ns: f64,
+    pub min_ns: f64,
+    pub max_ns: f64,
+    pub p95_ns: f64,
+    pub p99_ns: f64,
+    /// 95% confidence interval of the mean
+    pub confidence_interval: (f64, f64),
+    pub sample_count: usize,
+}
+
+impl HarnessTiming {
+    /// Statistical analysis of this summary. The harness reports no
+    /// quartiles, outliers or higher moments, so those fields are
+    /// approximated from the median and extremes (comparisons only read
+    /// the mean and its confidence intervals).
+    pub fn to_statistical_analysis(&self) -> StatisticalAnalysis {
+        let count = self.sample_count.max(1);
+        let std_error = self.std_dev_ns / (count as f64).sqrt();
+        let (ci_low, ci_high) = self.confidence_interval;
+        // Widen the 95% interval to 99% by the ratio of the normal quantiles
+        let half_99 = (ci_high - ci_low) / 2.0 * (2.576 / 1.960);
+
+        StatisticalAnalysis {
+            sample_stats: SampleStatistics {
+                count: self.sample_count,
+                mean: self.mean_ns,
+                median: self.median_ns,
+                std_dev: self.std_dev_ns,
+                std_error,
+                min: self.min_ns,
+                max: self.max_ns,
+            },
+            confidence_intervals: ConfidenceIntervals {
+                ci_95: (ci_low, ci_high),
+                ci_99: (self.mean_ns - half_99, self.mean_ns + half_99),
+            },
+            outliers: OutlierAnalysis {
+                outlier_count: 0,
+                outlier_percentage: 0.0,
+                outlier_values: Vec::new(),
+                quartiles: Quartiles {
+                    q1: self.median_ns,
+                    q3: self.median_ns,
+                    iqr: 0.0,
+                    lower_fence: self.min_ns,
+                    upper_fence: self.max_ns,
+                },
+            },
+            distribution: DistributionMetrics {
+                skewness: 0.0,
+                kurtosis: 0.0,
+                coefficient_of_variation: if self.mean_ns > 0.0 {
+                    self.std_dev_ns / self.mean_ns
+                } else {
+                    0.0
+                },
+                percentiles: Percentiles {
+                    p5: self.min_ns,
+                    p25: self.median_ns,
+                    p50: self.median_ns,
+                    p75: self.median_ns,
+                    p95: self.p95_ns,
+                    p99: self.p99_ns,
+                },
+            },
+        }
+    }
+}
+
+/// Load a C harness report from disk
+pub fn load_harness_report(path: &Path) -> Result<HarnessReport> {
+    let content = fs::read_to_string(path)
+        .with_context(|| format!("Failed to read benchmark report: {}", path.display()))?;
+    serde_json::from_str(&content)
+        .with_context(|| format!("Failed to parse benchmark report: {}", path.display()))
+}
+
 impl Default for RegressionDetector {
     fn default() -> Self {
         Self::new()
@@ -207,38 +311,78 @@ impl RegressionDetector {
         example: &str,
     ) -> Result<RegressionAnalysis> {
         let mut comparisons = Vec::new();
-        let mut has_critical_regression = false;
-        let mut has_warning_regression = false;
-
         for (implementation, current_stats) in current_results {
             if let Some(baseline) = self.load_baseline(implementation, example).await? {
-                let comparison =
-                    PerformanceComparator::compare_performance(&baseline.statistics, current_stats);
-
-                let severity = self.classify_regression_severity(&comparison);
-                let quality_gate_violation = self.is_quality_gate_violation(&severity, &comparison);
-
-                if matches!(
-                    severity,
-                    RegressionSeverity::Major | RegressionSeverity::Critical
-                ) {
-                    has_critical_regression = true;
-                } else if matches!(severity, RegressionSeverity::Moderate) {
-                    has_warning_regression = true;
-                }
+                comparisons.push(self.assess(implementation, &baseline.statistics, current_stats));
+            }
+        }
 
-                let recommendations =
-                    self.generate_regression_recommendations(&severity, &comparison);
+        Ok(self.summarize(comparisons))
+    }
 
-                comparisons.push(ImplementationRegression {
-                    implementation: implementation.clone(),
-                    comparison,
-                    severity,
-                    quality_gate_violation,
-                    recommendations,
-                });
-            }
+    /// Compare every benchmark of a harness report with the benchmark of
+    /// the same name in a baseline report. Benchmarks missing from either
+    /// side are not compared.
+    pub fn compare_reports(
+        &self,
+        baseline: &HarnessReport,
+        current: &HarnessReport,
+    ) -> RegressionAnalysis {
+        let baseline_by_name: HashMap<&str, &HarnessTiming> = baseline
+            .benchmarks
+            .iter()
+            .map(|b| (b.name.as_str(), &b.execution_time))
+            .collect();
+
+        let comparisons = current
+            .benchmarks
+            .iter()
+            .filter_map(|b| {
+                baseline_by_name.get(b.name.as_str()).map(|base| {
+                    self.assess(
+                        &b.name,
+                        &base.to_statistical_analysis(),
+                        &b.execution_time.to_statistical_analysis(),
+                    )
+                })
+            })
+            .collect();
+
+        self.summarize(comparisons)
+    }
+
+    /// Compare one implementation with its baseline
+    fn assess(
+        &self,
+        implementation: &str,
+        baseline: &StatisticalAnalysis,
+        current: &StatisticalAnalysis,
+    ) -> ImplementationRegression {
+        let comparison = PerformanceComparator::compare_performance(baseline, current);
+        let severity = self.classify_regression_severity(&comparison);
+        let quality_gate_violation = self.is_quality_gate_violation(&severity, &comparison);
+        let recommendations = self.generate_regression_recommendations(&severity, &comparison);
+
+        ImplementationRegression {
+            implementation: implementation.to_string(),
+            comparison,
+            severity,
+            quality_gate_violation,
+            recommendations,
         }
+    }
+
+    /// Overall status and recommendations for a set of comparisons
+    fn summarize(&self, comparisons: Vec<ImplementationRegression>) -> RegressionAnalysis {
+        let has_critical_regression = comparisons.iter().any(|c| {
+            matches!(
+                c.severity,
+                RegressionSeverity::Major | RegressionSeverity::Critical
+            )
+        });
+        let has_warning_regression = comparisons
+            .iter()
+            .any(|c| matches!(c.severity, RegressionSeverity::Moderate));
 
         let overall_status = if has_critical_regression {
             RegressionStatus::Critical
@@ -253,15 +397,13 @@ impl RegressionDetector {
         let overall_recommendations =
             self.generate_overall_recommendations(&overall_status, &comparisons);
 
-        let analysis = RegressionAnalysis {
+        RegressionAnalysis {
             regression_detected: has_critical_regression || has_warning_regression,
             comparisons,
             overall_status,
             recommendations: overall_recommendations,
             analyzed_at: Utc::now(),
-        };
-
-        Ok(analysis)
+        }
     }
 
     /// Generate regression report
@@ -648,6 +790,62 @@ mod tests {
         Ok(())
     }
 
+    fn harness_report(benchmarks: &[(&str, f64, f64)]) -> HarnessReport {
+        let json = benchmarks
+            .iter()
+            .map(|(name, mean, half_width)| {
+                format!(
+                    r#"{{"name": "{}", "iterations_per_sample": 1, "execution_time": {{
+                        "mean_ns": {}, "median_ns": {}, "std_dev_ns": 10, "min_ns": 0,
+                        "max_ns": 0, "p95_ns": 0, "p99_ns": 0,
+                        "confidence_interval": [{}, {}], "sample_count": 30}},
+                        "counters": {{}}}}"#,
+                    name,
+                    mean,
+                    mean,
+                    mean - half_width,
+                    mean + half_width
+                )
+            })
+            .collect::<Vec<_>>()
+            .join(",");
+        serde_json::from_str(&format!(
+            r#"{{"language": "c", "example": "algorithms/sort-matrix/o3", "benchmarks": [{}]}}"#,
+            json
+        ))
+        .expect("harness report should parse")
+    }
+
+    #[test]
+    fn test_compare_reports_flags_significant_slowdown() {
+        let detector = RegressionDetector::new().with_threshold(10.0);
+        let baseline = harness_report(&[("qsort/random/n=1000", 1000.0, 10.0), ("gone", 1.0, 0.1)]);
+        let current = harness_report(&[("qsort/random/n=1000", 1200.0, 10.0), ("new", 1.0, 0.1)]);
+
+        let analysis = detector.compare_reports(&baseline, &current);
+        assert_eq!(analysis.comparisons.len(), 1);
+        assert!(analysis.comparisons[0].quality_gate_violation);
+        assert!(matches!(
+            analysis.comparisons[0].severity,
+            RegressionSeverity::Major
+        ));
+        assert!(matches!(
+            analysis.overall_status,
+            RegressionStatus::Critical
+        ));
+    }
+
+    #[test]
+    fn test_compare_reports_ignores_overlapping_intervals() {
+        let detector = RegressionDetector::new().with_threshold(10.0);
+        let baseline = harness_report(&[("heap_sort/zipf/n=1000", 1000.0, 200.0)]);
+        let current = harness_report(&[("heap_sort/zipf/n=1000", 1200.0, 200.0)]);
+
+        let analysis = detector.compare_reports(&baseline, &current);
+        assert!(!analysis.comparisons[0].quality_gate_violation);
+        assert!(matches!(analysis.overall_status, RegressionStatus::Healthy));
+    }
+
     #[test]
     fn test_detector_builder_pattern() {
         let detector = RegressionDetector::new()